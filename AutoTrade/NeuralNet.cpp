@@ -19,15 +19,107 @@
  * Created: 2023/07/03 16:49:40
  */
 
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
 #include "NeuralNet.hpp"
 
 namespace {
+
   double c_LearningRate( 0.1 );
-}
+
+  // runs the shards of a batch on the calling thread plus nThreads - 1 workers,
+  //   shard s is processed by thread s % nThreads
+  class ShardRunner {
+  public:
+
+    using fShard_t = std::function<void(std::size_t)>;
+
+    ShardRunner( std::size_t nThreads )
+    : m_nThreads( std::max<std::size_t>( 1, nThreads ) )
+    , m_nGeneration {}, m_nShards {}, m_nPending {}, m_bStop( false )
+    {
+      for ( std::size_t ix = 1; ix < m_nThreads; ix++ ) {
+        m_vThread.emplace_back( [this,ix](){ Worker( ix ); } );
+      }
+    }
+
+    ~ShardRunner() {
+      {
+        std::scoped_lock<std::mutex> lock( m_mutex );
+        m_bStop = true;
+      }
+      m_cvStart.notify_all();
+      for ( std::thread& thread: m_vThread ) thread.join();
+    }
+
+    void Run( std::size_t nShards, fShard_t&& f ) {
+      if ( ( 1 == m_nThreads ) || ( 1 == nShards ) ) {
+        for ( std::size_t ix = 0; ix < nShards; ix++ ) f( ix );
+      }
+      else {
+        {
+          std::scoped_lock<std::mutex> lock( m_mutex );
+          m_fShard = std::move( f );
+          m_nShards = nShards;
+          m_nPending = m_nThreads - 1;
+          m_nGeneration++;
+        }
+        m_cvStart.notify_all();
+        for ( std::size_t ix = 0; ix < nShards; ix += m_nThreads ) m_fShard( ix );
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_cvDone.wait( lock, [this](){ return 0 == m_nPending; } );
+      }
+    }
+
+  private:
+
+    const std::size_t m_nThreads;
+    std::vector<std::thread> m_vThread;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cvStart;
+    std::condition_variable m_cvDone;
+
+    fShard_t m_fShard;
+    std::size_t m_nGeneration;
+    std::size_t m_nShards;
+    std::size_t m_nPending;
+    bool m_bStop;
+
+    void Worker( std::size_t ixThread ) {
+      std::size_t nGeneration {};
+      while ( true ) {
+        {
+          std::unique_lock<std::mutex> lock( m_mutex );
+          m_cvStart.wait( lock, [this,&nGeneration](){ return m_bStop || ( nGeneration != m_nGeneration ); } );
+          if ( m_bStop ) return;
+          nGeneration = m_nGeneration;
+        }
+        for ( std::size_t ix = ixThread; ix < m_nShards; ix += m_nThreads ) m_fShard( ix );
+        {
+          std::scoped_lock<std::mutex> lock( m_mutex );
+          m_nPending--;
+        }
+        m_cvDone.notify_one();
+      }
+    }
+
+  };
+
+} // namespace anonymous
 
 NeuralNet::NeuralNet()
 : m_nTrainingSteps {}
+, m_nOptimizerSteps {}
 {
+  m_vecInputLayer.setZero();
   SetInitialState();
 }
 
@@ -39,33 +131,60 @@ void NeuralNet::SetInitialState() {
   m_vecHiddenLayerBiasWeights = 0.5 * vecHiddenLayer_t::Random();
   m_matOutputLayerWeights     = 0.5 * matOutputLayerWeights_t::Random();
   m_vecOutputLayerBiasWeights = 0.5 * vecOutputLayer_t::Random();
+  m_velocity.Zero();
+  m_moment2.Zero();
+  m_nOptimizerSteps = 0;
 }
 
-void NeuralNet::TrainingStepPattern( const Input& input, const Output& expected ) {
+void NeuralNet::SetInitialState( std::uint32_t seed ) {
+  std::mt19937 generator( seed );
+  std::uniform_real_distribution<double> distribution( -0.5, 0.5 );
+  auto random = [&generator,&distribution]( double ){ return distribution( generator ); };
+  m_matHiddenLayerWeights     = m_matHiddenLayerWeights.unaryExpr( random );
+  m_vecHiddenLayerBiasWeights = m_vecHiddenLayerBiasWeights.unaryExpr( random );
+  m_matOutputLayerWeights     = m_matOutputLayerWeights.unaryExpr( random );
+  m_vecOutputLayerBiasWeights = m_vecOutputLayerBiasWeights.unaryExpr( random );
+  m_velocity.Zero();
+  m_moment2.Zero();
+  m_nOptimizerSteps = 0;
+}
 
-  m_outputExpected = expected;
+bool NeuralNet::Shift( const Input& input ) {
 
-  std::size_t nCountDown = c_nTimeSteps - 1;
-  vecInputLayer_t::iterator iter;
-  for ( iter = m_vecInputLayer.begin(); iter != m_vecInputLayer.end(); iter++ ) {
-    for ( std::size_t nStride = c_nStrideSize; 0 != nStride; nStride-- ) {
-      *iter = *(iter + c_nStrideSize );
-      iter++;
-    }
-    nCountDown--;
-    if ( 0 == nCountDown ) break;
+  // slide the window one stride towards the front, the new input goes at the back
+  for ( std::size_t ix = 0; ix < ( c_nInputLayerNodes - c_nStrideSize ); ix++ ) {
+    m_vecInputLayer[ ix ] = m_vecInputLayer[ ix + c_nStrideSize ];
   }
 
-  *iter++ = input.stochastic;
-  *iter++ = input.tick;
+  m_vecInputLayer[ c_nInputLayerNodes - 2 ] = input.stochastic;
+  m_vecInputLayer[ c_nInputLayerNodes - 1 ] = input.tick;
 
   m_nTrainingSteps++;
 
-  if ( c_nTimeSteps <= m_nTrainingSteps ) {
+  return c_nTimeSteps <= m_nTrainingSteps;
+}
+
+void NeuralNet::TrainingStepPattern( const Input& input, const Output& expected ) {
+
+  m_outputExpected = expected;
+
+  if ( Shift( input ) ) {
     TrainingStep();
   }
 }
 
+void NeuralNet::QueuePattern( const Input& input, const Output& expected ) {
+  if ( Shift( input ) ) {
+    m_vPatternInput.push_back( m_vecInputLayer );
+    m_vPatternExpected.push_back( vecOutputLayer_t( expected.buy, expected.neutral, expected.sell ) );
+  }
+}
+
+void NeuralNet::ClearPatterns() {
+  m_vPatternInput.clear();
+  m_vPatternExpected.clear();
+}
+
 namespace {
 
   // this book covered the implementation details, as well as the partial deriviatives of the sigmoid functions
@@ -154,16 +273,17 @@ void NeuralNet::TrainingStep() {
 
   const vecOutputLayer_t vecOutputBiasCorrection = c_LearningRate * vecOutputLayerDelta;
 
-  vecHiddenLayer_t vecHiddenLayerDelta = vecOutputLayerDelta * matOutputWeightCorrection;
+  // propagate through the weights (prior to their update), derivative taken at the hidden activation
+  vecHiddenLayer_t vecHiddenLayerDelta = vecOutputLayerDelta * m_matOutputLayerWeights.transpose();
 
   // https://iamfaisalkhan.com/matrix-manipulations-using-eigen-cplusplus/
   // Array class may help with this
   vecHiddenLayer_t::iterator iterDelta = vecHiddenLayerDelta.begin();
-  vecHiddenLayer_t::const_iterator iterHiddenIn = vecHiddenLayerIn.begin();
+  vecHiddenLayer_t::const_iterator iterHidden = m_vecHiddenLayer.begin();
   while ( vecHiddenLayerDelta.end() != iterDelta ) {
-    *iterDelta *= bipolar_sigmoid_pd2( *iterHiddenIn );
+    *iterDelta *= bipolar_sigmoid_pd2( *iterHidden );
     iterDelta++;
-    iterHiddenIn++;
+    iterHidden++;
   }
 
   matHiddenLayerWeights_t matHiddenLayerCorrection
@@ -181,6 +301,176 @@ void NeuralNet::TrainingStep() {
 
 }
 
+// == minibatch
+
+void NeuralNet::Gradient::Zero() {
+  matHiddenLayerWeights.setZero();
+  vecHiddenLayerBiasWeights.setZero();
+  matOutputLayerWeights.setZero();
+  vecOutputLayerBiasWeights.setZero();
+  sse = 0.0;
+}
+
+void NeuralNet::Gradient::Add( const Gradient& rhs ) {
+  matHiddenLayerWeights += rhs.matHiddenLayerWeights;
+  vecHiddenLayerBiasWeights += rhs.vecHiddenLayerBiasWeights;
+  matOutputLayerWeights += rhs.matOutputLayerWeights;
+  vecOutputLayerBiasWeights += rhs.vecOutputLayerBiasWeights;
+  sse += rhs.sse;
+}
+
+// same activations as TrainingStep, a row per pattern
+void NeuralNet::Forward( const Eigen::Ref<const matInput_t>& input, matShardHidden_t& hidden, matShardOutput_t& output ) const {
+
+  hidden.noalias() = input * m_matHiddenLayerWeights;
+  hidden.rowwise() += m_vecHiddenLayerBiasWeights;
+  hidden = ( ( 2.0 / ( 1.0 + ( -hidden.array() ).exp() ) ) - 1.0 ).matrix(); // bipolar_sigmoid
+
+  output.noalias() = hidden * m_matOutputLayerWeights;
+  output.rowwise() += m_vecOutputLayerBiasWeights;
+  output = ( 1.0 / ( 1.0 + ( -output.array() ).exp() ) ).matrix(); // binary_sigmoid
+}
+
+void NeuralNet::Accumulate(
+  const Eigen::Ref<const matInput_t>& input, const Eigen::Ref<const matOutput_t>& expected, Gradient& gradient
+) const {
+
+  matShardHidden_t hidden;
+  matShardOutput_t output;
+
+  Forward( input, hidden, output );
+
+  const matShardOutput_t error = expected - output;
+
+  // binary_sigmoid_pd2, bipolar_sigmoid_pd2 on the activations
+  const matShardOutput_t deltaOutput = ( error.array() * output.array() * ( 1.0 - output.array() ) ).matrix();
+  matShardHidden_t deltaHidden;
+  deltaHidden.noalias() = deltaOutput * m_matOutputLayerWeights.transpose();
+  deltaHidden.array() *= 0.5 * ( 1.0 + hidden.array() ) * ( 1.0 - hidden.array() );
+
+  gradient.matOutputLayerWeights.noalias() += hidden.transpose() * deltaOutput;
+  gradient.vecOutputLayerBiasWeights += deltaOutput.colwise().sum();
+  gradient.matHiddenLayerWeights.noalias() += input.transpose() * deltaHidden;
+  gradient.vecHiddenLayerBiasWeights += deltaHidden.colwise().sum();
+  gradient.sse += error.squaredNorm();
+}
+
+void NeuralNet::Apply( const Training& training, const Gradient& correction, std::size_t nRows ) {
+
+  m_nOptimizerSteps++;
+
+  const double scale = 1.0 / nRows; // mean over the batch
+  const double rate = training.learningRate;
+
+  switch ( training.eOptimizer ) {
+    case Training::EOptimizer::SGD: {
+        const double momentum = training.momentum;
+        auto step = [momentum,rate,scale]( auto& param, auto& velocity, const auto& corr ){
+          velocity = momentum * velocity + ( rate * scale ) * corr;
+          param += velocity;
+        };
+        step( m_matHiddenLayerWeights, m_velocity.matHiddenLayerWeights, correction.matHiddenLayerWeights );
+        step( m_vecHiddenLayerBiasWeights, m_velocity.vecHiddenLayerBiasWeights, correction.vecHiddenLayerBiasWeights );
+        step( m_matOutputLayerWeights, m_velocity.matOutputLayerWeights, correction.matOutputLayerWeights );
+        step( m_vecOutputLayerBiasWeights, m_velocity.vecOutputLayerBiasWeights, correction.vecOutputLayerBiasWeights );
+      }
+      break;
+    case Training::EOptimizer::Adam: {
+        const double beta1 = training.beta1;
+        const double beta2 = training.beta2;
+        const double epsilon = training.epsilon;
+        const double bias1 = 1.0 - std::pow( beta1, (double) m_nOptimizerSteps );
+        const double bias2 = 1.0 - std::pow( beta2, (double) m_nOptimizerSteps );
+        auto step = [=]( auto& param, auto& moment1, auto& moment2, const auto& corr ){
+          const auto gradient = ( -scale * corr.array() ).eval();
+          moment1 = ( beta1 * moment1.array() + ( 1.0 - beta1 ) * gradient ).matrix();
+          moment2 = ( beta2 * moment2.array() + ( 1.0 - beta2 ) * gradient.square() ).matrix();
+          param.array() -= rate * ( moment1.array() / bias1 ) / ( ( moment2.array() / bias2 ).sqrt() + epsilon );
+        };
+        step( m_matHiddenLayerWeights, m_velocity.matHiddenLayerWeights, m_moment2.matHiddenLayerWeights, correction.matHiddenLayerWeights );
+        step( m_vecHiddenLayerBiasWeights, m_velocity.vecHiddenLayerBiasWeights, m_moment2.vecHiddenLayerBiasWeights, correction.vecHiddenLayerBiasWeights );
+        step( m_matOutputLayerWeights, m_velocity.matOutputLayerWeights, m_moment2.matOutputLayerWeights, correction.matOutputLayerWeights );
+        step( m_vecOutputLayerBiasWeights, m_velocity.vecOutputLayerBiasWeights, m_moment2.vecOutputLayerBiasWeights, correction.vecOutputLayerBiasWeights );
+      }
+      break;
+  }
+}
+
+double NeuralNet::Train( const Training& training ) {
+
+  const std::size_t nPatterns = m_vPatternExpected.size();
+  if ( 0 == nPatterns ) return 0.0;
+
+  const std::size_t nBatchSize = std::max<std::size_t>( 1, training.nBatchSize );
+
+  std::vector<std::size_t> vOrder( nPatterns );
+  std::iota( vOrder.begin(), vOrder.end(), 0 );
+  std::mt19937 generator( training.seed );
+
+  matInput_t input( nBatchSize, (Eigen::Index) c_nInputLayerNodes );
+  matOutput_t expected( nBatchSize, (Eigen::Index) c_nOutputLayerNodes );
+
+  std::vector<Gradient> vGradient( ( nBatchSize + c_nShardRows - 1 ) / c_nShardRows );
+  Gradient total;
+
+  ShardRunner runner( training.nThreads );
+
+  double mse {};
+
+  for ( std::size_t nEpoch = 0; nEpoch < training.nEpochs; nEpoch++ ) {
+
+    if ( training.bShuffle ) {
+      std::shuffle( vOrder.begin(), vOrder.end(), generator );
+    }
+
+    double sse {};
+
+    for ( std::size_t ixBatch = 0; ixBatch < nPatterns; ixBatch += nBatchSize ) {
+
+      const Eigen::Index nRows = std::min( nBatchSize, nPatterns - ixBatch );
+      for ( Eigen::Index ixRow = 0; ixRow < nRows; ixRow++ ) {
+        const std::size_t ixPattern = vOrder[ ixBatch + ixRow ];
+        input.row( ixRow ) = m_vPatternInput[ ixPattern ];
+        expected.row( ixRow ) = m_vPatternExpected[ ixPattern ];
+      }
+
+      const std::size_t nShards = ( nRows + c_nShardRows - 1 ) / c_nShardRows;
+      runner.Run(
+        nShards,
+        [this,&input,&expected,&vGradient,nRows]( std::size_t ixShard ){
+          const Eigen::Index begin = ixShard * c_nShardRows;
+          const Eigen::Index n = std::min( c_nShardRows, nRows - begin );
+          Gradient& gradient( vGradient[ ixShard ] );
+          gradient.Zero();
+          Accumulate( input.middleRows( begin, n ), expected.middleRows( begin, n ), gradient );
+        } );
+
+      total = vGradient[ 0 ];
+      for ( std::size_t ixShard = 1; ixShard < nShards; ixShard++ ) {
+        total.Add( vGradient[ ixShard ] ); // shard order, so the sum is the same for any thread count
+      }
+
+      Apply( training, total, nRows );
+      sse += total.sse;
+    }
+
+    mse = sse / ( nPatterns * c_nOutputLayerNodes );
+  }
+
+  return mse;
+}
+
+void NeuralNet::Score( const matInput_t& input, matOutput_t& output ) const {
+  output.resize( input.rows(), c_nOutputLayerNodes );
+  matShardHidden_t hidden;
+  matShardOutput_t shard;
+  for ( Eigen::Index begin = 0; begin < input.rows(); begin += c_nShardRows ) {
+    const Eigen::Index n = std::min( c_nShardRows, input.rows() - begin );
+    Forward( input.middleRows( begin, n ), hidden, shard );
+    output.middleRows( begin, n ) = shard;
+  }
+}
+
 // Neural Networks Math by Michael Taylor: useful for understanding the chained partial derivative implications
 
 // timeseries LSTM with pytorch:
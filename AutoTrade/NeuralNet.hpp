@@ -21,6 +21,16 @@
 
 #pragma once
 
+// feed-forward network, one hidden layer, trained with back propagation
+//   TrainingStepPattern: online, one weight update per pattern
+//   QueuePattern + Train: minibatch, forward and backward passes are matrix-matrix products over a batch,
+//     the batch is split into fixed size shards whose gradients are summed in shard order,
+//     so results depend on the seed, not on the number of threads
+//   Score: inference only, one row of inputs per pattern
+
+#include <vector>
+#include <cstdint>
+
 #include <eigen3/Eigen/Eigen>
 
 class NeuralNet {
@@ -45,18 +55,50 @@ public:
     : buy( buy_ ), neutral( neutral_ ), sell( sell_ ) {}
   };
 
-  void SetInitialState();
-  void TrainingStepPattern( const Input&, const Output& );
-
-protected:
-private:
-
   static const std::size_t c_nTimeSteps = 4;
   static const std::size_t c_nStrideSize = 2; // based upon #elements in struct Input
   static const std::size_t c_nInputLayerNodes = c_nTimeSteps * c_nStrideSize;
   static const std::size_t c_nHiddenLayerNodes = c_nInputLayerNodes * 2;
   static const std::size_t c_nOutputLayerNodes = 3;
 
+  // one row per pattern, an input row is c_nTimeSteps consecutive Inputs, oldest first
+  using matInput_t =  Eigen::Matrix<double, Eigen::Dynamic, c_nInputLayerNodes, Eigen::RowMajor>;
+  using matOutput_t = Eigen::Matrix<double, Eigen::Dynamic, c_nOutputLayerNodes, Eigen::RowMajor>;
+
+  struct Training {
+    enum class EOptimizer { SGD, Adam };
+    EOptimizer eOptimizer;
+    std::size_t nBatchSize;
+    std::size_t nEpochs;
+    std::size_t nThreads; // gradient accumulation
+    double learningRate;
+    double momentum; // SGD, 0.0 for none
+    double beta1; // Adam
+    double beta2; // Adam
+    double epsilon; // Adam
+    std::uint32_t seed; // pattern order, shuffled each epoch
+    bool bShuffle;
+    Training()
+    : eOptimizer( EOptimizer::SGD ), nBatchSize( 32 ), nEpochs( 1 ), nThreads( 1 )
+    , learningRate( 0.1 ), momentum( 0.0 ), beta1( 0.9 ), beta2( 0.999 ), epsilon( 1e-8 )
+    , seed( 0 ), bShuffle( true )
+    {}
+  };
+
+  void SetInitialState();
+  void SetInitialState( std::uint32_t seed ); // reproducible weights
+  void TrainingStepPattern( const Input&, const Output& );
+
+  void QueuePattern( const Input&, const Output& ); // windowed as with TrainingStepPattern, kept for Train
+  std::size_t Patterns() const { return m_vPatternExpected.size(); }
+  void ClearPatterns();
+  double Train( const Training& ); // minibatch over the queued patterns, returns the mse of the last epoch
+
+  void Score( const matInput_t&, matOutput_t& ) const;
+
+protected:
+private:
+
   using vecInputLayer_t =         Eigen::Matrix<double, 1, c_nInputLayerNodes >;
   // Rows, Columns
   using matHiddenLayerWeights_t = Eigen::Matrix<double, c_nInputLayerNodes, c_nHiddenLayerNodes>;
@@ -78,6 +120,37 @@ private:
 
   std::size_t m_nTrainingSteps;
 
+  // queued patterns
+  std::vector<vecInputLayer_t, Eigen::aligned_allocator<vecInputLayer_t> > m_vPatternInput;
+  std::vector<vecOutputLayer_t, Eigen::aligned_allocator<vecOutputLayer_t> > m_vPatternExpected;
+
+  struct Gradient {
+    matHiddenLayerWeights_t matHiddenLayerWeights;
+    vecHiddenLayer_t vecHiddenLayerBiasWeights;
+    matOutputLayerWeights_t matOutputLayerWeights;
+    vecOutputLayer_t vecOutputLayerBiasWeights;
+    double sse; // sum of squared errors
+    void Zero();
+    void Add( const Gradient& );
+  };
+
+  // optimizer state, per parameter
+  Gradient m_velocity; // SGD momentum, Adam first moment
+  Gradient m_moment2;  // Adam second moment
+  std::size_t m_nOptimizerSteps;
+
+  // a shard is the unit of gradient accumulation, its work matrices live on the stack
+  static const Eigen::Index c_nShardRows = 64;
+  using matShardHidden_t = Eigen::Matrix<double, Eigen::Dynamic, c_nHiddenLayerNodes, Eigen::RowMajor, c_nShardRows, c_nHiddenLayerNodes>;
+  using matShardOutput_t = Eigen::Matrix<double, Eigen::Dynamic, c_nOutputLayerNodes, Eigen::RowMajor, c_nShardRows, c_nOutputLayerNodes>;
+
+  bool Shift( const Input& ); // true when the input layer holds a full window
   void TrainingStep();
 
+  void Forward( const Eigen::Ref<const matInput_t>&, matShardHidden_t&, matShardOutput_t& ) const; // up to c_nShardRows
+
+  // adds the corrections ( -gradient of 0.5 * sse ) for the rows
+  void Accumulate( const Eigen::Ref<const matInput_t>&, const Eigen::Ref<const matOutput_t>& expected, Gradient& ) const;
+  void Apply( const Training&, const Gradient&, std::size_t nRows );
+
 };
@@ -28,7 +28,7 @@
 namespace collect {
 
 ATM::ATM(
-  const std::string& sFilePath,
+  ou::tf::HDF5WriteService& service,
   const std::string& sDataPathPrefix,
   pWatch_t pWatchUnderlying,
   fBuildOption_t&& fBuildOption, fGatherOptions_t&& fGatherOptions,
@@ -51,7 +51,7 @@ ATM::ATM(
   {
     const std::string sFullDataPath( sDataPathPrefix + ou::tf::PriceIVs::Directory() + m_pWatchUnderlying->GetInstrumentName() );
     m_pfwATM = std::make_unique<fwATM_t>(
-      sFilePath, sFullDataPath,
+      service, sFullDataPath,
       [this]( ou::tf::HDF5Attributes& attr ){
         SetAttributes( attr, m_pWatchUnderlying );
       } );
@@ -46,7 +46,7 @@ public:
   using fEngine_t = std::function<void( pOption_t&, pWatch_t& )>;  // start / stop watch in option engine
 
   ATM(
-    const std::string& sFilePath,
+    ou::tf::HDF5WriteService& service,
     const std::string& sDataPathPrefix, pWatch_t /* underlying */,
     fBuildOption_t&&, fGatherOptions_t&&,
     fEngine_t&& start, fEngine_t&& stop,
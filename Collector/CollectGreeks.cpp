@@ -25,7 +25,7 @@
 
 namespace collect {
 
-Greeks::Greeks( const std::string& sFilePath, const std::string& sDataPathPrefix, pOption_t pOption )
+Greeks::Greeks( ou::tf::HDF5WriteService& service, const std::string& sDataPathPrefix, pOption_t pOption )
 {
 
   // TODO: watch built elsewhere, needs to be restartable for a new day?
@@ -41,7 +41,7 @@ Greeks::Greeks( const std::string& sFilePath, const std::string& sDataPathPrefix
   {
     const std::string sFullDataPath( sDataPathPrefix + ou::tf::Quotes::Directory() + pInstrument->GetInstrumentName() );
     m_pfwGreeks = std::make_unique<fwGreeks_t>(
-      sFilePath, sDataPathPrefix,
+      service, sDataPathPrefix,
       [this]( ou::tf::HDF5Attributes& attr ){
         SetAttributes( attr, m_pOption );
       } );
@@ -25,7 +25,7 @@
 
 namespace collect {
 
-L1::L1( const std::string& sFilePath, const std::string& sDataPathPrefix, pWatch_t pWatch )
+L1::L1( ou::tf::HDF5WriteService& service, const std::string& sDataPathPrefix, pWatch_t pWatch )
 {
 
   // TODO: watch built elsewhere, needs to be restartable for a new day?
@@ -41,7 +41,7 @@ L1::L1( const std::string& sFilePath, const std::string& sDataPathPrefix, pWatch
   {
     const std::string sFullDataPath( sDataPathPrefix + ou::tf::Quotes::Directory() + pInstrument->GetInstrumentName() );
     m_pfwQuotes = std::make_unique<fwQuotes_t>(
-      sFilePath, sFullDataPath,
+      service, sFullDataPath,
       [this]( ou::tf::HDF5Attributes& attr ){
         SetAttributes( attr, m_pWatch );
       } );
@@ -51,7 +51,7 @@ L1::L1( const std::string& sFilePath, const std::string& sDataPathPrefix, pWatch
   {
     const std::string sFullDataPath( sDataPathPrefix + ou::tf::Trades::Directory() + pInstrument->GetInstrumentName() );
     m_pfwTrades = std::make_unique<fwTrades_t>(
-      sFilePath, sFullDataPath,
+      service, sFullDataPath,
       [this]( ou::tf::HDF5Attributes& attr ){
          SetAttributes( attr, m_pWatch );
       } );
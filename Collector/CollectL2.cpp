@@ -25,7 +25,7 @@
 
 namespace collect {
 
-L2::L2( const std::string& sFilePath, const std::string& sDataPathPrefix, pWatch_t pWatch )
+L2::L2( ou::tf::HDF5WriteService& service, const std::string& sDataPathPrefix, pWatch_t pWatch )
 {
 
   // TODO: watch built elsewhere, needs to be restartable for a new day?
@@ -42,7 +42,7 @@ L2::L2( const std::string& sFilePath, const std::string& sDataPathPrefix, pWatch
   {
     const std::string sFullDataPath( sDataPathPrefix + ou::tf::Quotes::Directory() + pInstrument->GetInstrumentName() );
     m_pfwDepthsByOrder = std::make_unique<fwDepthsByOrder_t>(
-      sFilePath, sFullDataPath,
+      service, sFullDataPath,
       [this]( ou::tf::HDF5Attributes& attr ){
         SetAttributes( attr, m_pWatch );
       } );
@@ -30,6 +30,8 @@
 #include <TFHDF5TimeSeries/HDF5DataManager.h>
 #include <TFHDF5TimeSeries/HDF5WriteTimeSeries.h>
 
+#include "HDF5WriteService.hpp"
+
 namespace ou { // namespace one unified net
 namespace tf { // namespace tradeframe
 
@@ -39,12 +41,15 @@ template<typename T> // timeseries, eg, ou::tf::Trades, ou::tf::Quotes
 class FillWrite {
 public:
   FillWrite( const std::string& sFilePath, const std::string& sDataPath, fFillWrite_Hdf5Attribute_t&& );
+  FillWrite( HDF5WriteService&, const std::string& sDataPath, fFillWrite_Hdf5Attribute_t&& ); // written by the service
   ~FillWrite();
   void Append( const typename T::datum_t& );
   void Write(); // todo: use local timer
 protected:
 private:
 
+  void Submit(); // the writing buffer to the service
+
   using rFillWrite_t = std::array<T,2>;
   rFillWrite_t m_rFillWrite; // one writes while one collects
 
@@ -58,22 +63,51 @@ private:
   bool m_bHdf5AttributesSet;
   fFillWrite_Hdf5Attribute_t m_fFillWrite_Hdf5Attribute;
 
+  HDF5WriteService* m_pService;
+  HDF5WriteService::DataSet* m_pDataSet;
+  std::atomic<bool> m_bInFlight; // the writing buffer is with the service
+
 };
 
 template<typename T>
 FillWrite<T>::FillWrite( const std::string& sFilePath, const std::string& sDataPath, fFillWrite_Hdf5Attribute_t&& f )
-: m_bHdf5AttributesSet( false )
-, m_fFillWrite_Hdf5Attribute( std::move( f ) )
-, m_ixFilling( 0 )
+: m_ixFilling( 0 )
 , m_ixWriting( 1 )
 , m_sFilePath( sFilePath )
 , m_sDataPath( sDataPath )
+, m_bHdf5AttributesSet( false )
+, m_fFillWrite_Hdf5Attribute( std::move( f ) )
+, m_pService( nullptr )
+, m_pDataSet( nullptr )
+, m_bInFlight( false )
 {
   assert( m_fFillWrite_Hdf5Attribute );
 }
 
 template<typename T>
-FillWrite<T>::~FillWrite() {}
+FillWrite<T>::FillWrite( HDF5WriteService& service, const std::string& sDataPath, fFillWrite_Hdf5Attribute_t&& f )
+: m_ixFilling( 0 )
+, m_ixWriting( 1 )
+, m_sDataPath( sDataPath )
+, m_bHdf5AttributesSet( false )
+, m_pService( &service )
+, m_pDataSet( nullptr )
+, m_bInFlight( false )
+{
+  assert( f );
+  m_pDataSet = service.Register<T>( sDataPath, std::move( f ) );
+}
+
+template<typename T>
+FillWrite<T>::~FillWrite() {
+  if ( m_pService ) {
+    m_pService->Flush( true ); // anything in flight
+    Write(); // a failed write is re-submitted first
+    m_pService->Flush( true );
+    Write(); // what remains in the fill buffer
+    m_pService->Flush( true );
+  }
+}
 
 template<typename T>
 void FillWrite<T>::Append( const typename T::datum_t& t ) {
@@ -83,6 +117,14 @@ void FillWrite<T>::Append( const typename T::datum_t& t ) {
 template<typename T>
 void FillWrite<T>::Write() {
 
+  if ( m_bInFlight.load() ) return; // keeps filling, goes with the next write
+
+  if ( m_pService && ( 0 != m_rFillWrite[ m_ixWriting ].Size() ) ) {
+    // the service could not write it, try again, the fill buffer goes with the next write
+    Submit();
+    return;
+  }
+
   assert( 0 == m_rFillWrite[m_ixWriting].Size() );
 
   typename rFillWrite_t::size_type ix {};
@@ -91,6 +133,13 @@ void FillWrite<T>::Write() {
   ix = m_ixWriting.exchange( ix ); // and write what was being filled
   assert( 2 == ix );
 
+  if ( m_pService ) {
+    if ( 0 != m_rFillWrite[ m_ixWriting ].Size() ) {
+      Submit();
+    }
+    return;
+  }
+
   if ( 0 != m_rFillWrite[ m_ixWriting ].Size() ) {
     ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR, m_sFilePath );
     ou::tf::HDF5WriteTimeSeries<T> wts( dm, true, true, 5, 256 );
@@ -107,5 +156,17 @@ void FillWrite<T>::Write() {
   }
 }
 
+template<typename T>
+void FillWrite<T>::Submit() {
+  m_bInFlight.store( true );
+  T& series( m_rFillWrite[ m_ixWriting ] );
+  m_pService->Submit(
+    m_pDataSet, series,
+    [this,&series]( bool bWritten ){
+      if ( bWritten ) series.Clear(); // otherwise kept for the next Write
+      m_bInFlight.store( false );
+    } );
+}
+
 } // namespace tf
 } // namespace ou
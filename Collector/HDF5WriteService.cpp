@@ -0,0 +1,668 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HDF5WriteService.cpp
+ * Author:  raymond@burkholder.net
+ * Project: Collector
+ * Created: 2026
+ */
+
+#include <chrono>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#include <zlib.h>
+
+#include <boost/log/trivial.hpp>
+
+#include <TFTimeSeries/DatedDatum.h>
+
+#include "HDF5WriteService.hpp"
+
+namespace ou { // namespace one unified net
+namespace tf { // namespace tradeframe
+
+namespace {
+  const char c_szTimeIndex[] = "TimeIndex"; // as HDF5TimeSeriesAccessor
+  const unsigned int c_maskSkipDeflate( 1u << 1 ); // filter 0 is shuffle, filter 1 is deflate
+}
+
+// ********* DataSet *********
+
+class HDF5WriteService::DataSet {
+public:
+
+  using vByte_t = std::vector<std::uint8_t>;
+
+  const std::string sPath;
+  const fDefineDataType_t fDefineDataType;
+  const size_t nDatumSize; // in memory
+  const std::uint64_t nSignature;
+  fAttribute_t fAttribute;
+  fFallback_t fFallback;
+
+  bool bOpen;
+  bool bAttributesSet;
+
+  std::unique_ptr<H5::DataSet> pDataSet;
+  std::unique_ptr<H5::CompType> pTypeMemory;
+  std::unique_ptr<H5::CompType> pTypePacked; // as on disk
+  size_t nPacked;
+  size_t offsetDateTime; // in a packed datum
+
+  hsize_t nChunk;
+  hsize_t nElement; // on disk
+  std::vector<ptime> vTimeIndex; // as HDF5TimeSeriesAccessor, first time stamp of each chunk
+  hsize_t ixTail; // first element of the last chunk
+  vByte_t vTail; // packed elements from ixTail to nElement
+
+  DataSet(
+    const std::string& sPath_, fDefineDataType_t fDefineDataType_, size_t nDatumSize_, std::uint64_t nSignature_,
+    fAttribute_t&& fAttribute_, fFallback_t&& fFallback_ )
+  : sPath( sPath_ ), fDefineDataType( fDefineDataType_ ), nDatumSize( nDatumSize_ ), nSignature( nSignature_ )
+  , fAttribute( std::move( fAttribute_ ) ), fFallback( std::move( fFallback_ ) )
+  , bOpen( false ), bAttributesSet( false )
+  , nPacked {}, offsetDateTime {}, nChunk {}, nElement {}, ixTail {}
+  {}
+
+  ~DataSet() {
+    assert( !bOpen ); // closed on the writer thread
+  }
+
+  void Open( ou::tf::HDF5DataManager&, int nDeflate, hsize_t nChunkSize );
+  void Load(); // count, time index, tail from disk
+  void Close();
+
+  ptime DateTime( const std::uint8_t* pPacked ) const {
+    ptime dt;
+    static_assert( sizeof( ptime ) == sizeof( std::int64_t ) );
+    std::memcpy( static_cast<void*>( &dt ), pPacked + offsetDateTime, sizeof( ptime ) );
+    return dt;
+  }
+
+  void Pack( const void* pData, size_t nCount, vByte_t& ) const;
+  void WriteTimeIndex();
+
+};
+
+void HDF5WriteService::DataSet::Open( ou::tf::HDF5DataManager& dm, int nDeflate, hsize_t nChunkSize ) {
+
+  assert( !bOpen );
+
+  dm.AddGroup( sPath );
+
+  try {
+    pDataSet = std::make_unique<H5::DataSet>( dm.GetH5File()->openDataSet( sPath ) );
+  }
+  catch ( H5::FileIException& e ) { // as HDF5WriteTimeSeries
+    std::unique_ptr<H5::CompType> pdt( fDefineDataType( NULL ) );
+    pdt->pack();
+
+    hsize_t curSize = 0;
+    hsize_t maxSize = H5S_UNLIMITED;
+    H5::DataSpace ds( 1, &curSize, &maxSize );
+
+    H5::DSetCreatPropList pl;
+    pl.setChunk( 1, &nChunkSize );
+    pl.setShuffle();
+    pl.setDeflate( nDeflate );
+
+    pDataSet = std::make_unique<H5::DataSet>( dm.GetH5File()->createDataSet( sPath, *pdt, ds, pl ) );
+    pl.close();
+    ds.close();
+    pdt->close();
+  }
+
+  pTypeMemory.reset( fDefineDataType( NULL ) );
+  pTypePacked.reset( fDefineDataType( NULL ) ); // a copy would share the id
+  pTypePacked->pack();
+  nPacked = pTypePacked->getSize();
+  offsetDateTime = pTypePacked->getMemberOffset( pTypePacked->getMemberIndex( "DateTime" ) );
+
+  H5::DSetCreatPropList pl( pDataSet->getCreatePlist() );
+  nChunk = 0;
+  if ( H5D_CHUNKED == pl.getLayout() ) {
+    pl.getChunk( 1, &nChunk );
+  }
+  pl.close();
+  if ( 0 == nChunk ) {
+    throw std::runtime_error( "HDF5WriteService: dataset is not chunked " + sPath );
+  }
+
+  bOpen = true;
+
+  Load();
+}
+
+void HDF5WriteService::DataSet::Load() {
+
+  H5::DataSpace dsDisk( pDataSet->getSpace() );
+  hsize_t nMax {};
+  dsDisk.getSimpleExtentDims( &nElement, &nMax );
+
+  // time index: the attribute when it is current, otherwise from the first datum of each chunk
+  vTimeIndex.clear();
+  bool bIndexValid( false );
+  if ( pDataSet->attrExists( c_szTimeIndex ) ) {
+    H5::Attribute attribute( pDataSet->openAttribute( c_szTimeIndex ) );
+    H5::DataSpace dspace( attribute.getSpace() );
+    hsize_t nEntries {};
+    dspace.getSimpleExtentDims( &nEntries );
+    if ( 2 <= nEntries ) {
+      std::vector<std::int64_t> v( nEntries );
+      attribute.read( H5::PredType::NATIVE_INT64, v.data() );
+      if ( ( (hsize_t) v[ 0 ] == nChunk ) && ( (hsize_t) v[ 1 ] == nElement ) ) {
+        vTimeIndex.resize( nEntries - 2 );
+        std::memcpy( static_cast<void*>( vTimeIndex.data() ), &v[ 2 ], vTimeIndex.size() * sizeof( ptime ) );
+        bIndexValid = true;
+      }
+    }
+    dspace.close();
+    attribute.close();
+  }
+
+  if ( !bIndexValid && ( 0 < nElement ) ) {
+    hsize_t nEntries( ( nElement + nChunk - 1 ) / nChunk );
+    vTimeIndex.resize( nEntries );
+    H5::CompType typeTime( sizeof( ptime ) );
+    typeTime.insertMember( "DateTime", 0, H5::PredType::NATIVE_LLONG );
+    hsize_t ixStart( 0 );
+    hsize_t nStride( nChunk );
+    H5::DataSpace dsSelection( pDataSet->getSpace() );
+    dsSelection.selectHyperslab( H5S_SELECT_SET, &nEntries, &ixStart, &nStride );
+    H5::DataSpace dsMemory( 1, &nEntries );
+    pDataSet->read( vTimeIndex.data(), typeTime, dsMemory, dsSelection );
+    dsMemory.close();
+    dsSelection.close();
+    typeTime.close();
+  }
+
+  // tail: the last chunk, which the next write rewrites
+  ixTail = ( 0 == nElement ) ? 0 : ( ( nElement - 1 ) / nChunk ) * nChunk;
+  hsize_t nTail( nElement - ixTail );
+  vTail.resize( nTail * nPacked );
+  if ( 0 < nTail ) {
+    H5::DataSpace dsSelection( pDataSet->getSpace() );
+    dsSelection.selectHyperslab( H5S_SELECT_SET, &nTail, &ixTail );
+    H5::DataSpace dsMemory( 1, &nTail );
+    pDataSet->read( vTail.data(), *pTypePacked, dsMemory, dsSelection );
+    dsMemory.close();
+    dsSelection.close();
+  }
+
+  dsDisk.close();
+}
+
+void HDF5WriteService::DataSet::Close() {
+  if ( bOpen ) {
+    pTypePacked->close();
+    pTypeMemory->close();
+    pDataSet->close();
+    pTypePacked.reset();
+    pTypeMemory.reset();
+    pDataSet.reset();
+    bOpen = false;
+  }
+}
+
+void HDF5WriteService::DataSet::Pack( const void* pData, size_t nCount, vByte_t& v ) const {
+  // converted in place, so the buffer holds the larger of the two layouts
+  v.resize( nCount * std::max( nDatumSize, nPacked ) );
+  std::memcpy( v.data(), pData, nCount * nDatumSize );
+  vByte_t vBackground( nCount * nPacked );
+  if ( 0 > H5Tconvert( pTypeMemory->getId(), pTypePacked->getId(), nCount, v.data(), vBackground.data(), H5P_DEFAULT ) ) {
+    throw std::runtime_error( "HDF5WriteService: conversion failed for " + sPath );
+  }
+  v.resize( nCount * nPacked );
+}
+
+void HDF5WriteService::DataSet::WriteTimeIndex() { // as HDF5TimeSeriesAccessor::WriteTimeIndex
+
+  std::vector<std::int64_t> v( vTimeIndex.size() + 2 );
+  v[ 0 ] = nChunk;
+  v[ 1 ] = nElement;
+  std::memcpy( &v[ 2 ], static_cast<const void*>( vTimeIndex.data() ), vTimeIndex.size() * sizeof( ptime ) );
+
+  if ( pDataSet->attrExists( c_szTimeIndex ) ) {
+    pDataSet->removeAttr( c_szTimeIndex );
+  }
+  hsize_t nEntries( v.size() );
+  H5::DataSpace dspace( 1, &nEntries );
+  H5::Attribute attribute( pDataSet->createAttribute( c_szTimeIndex, H5::PredType::NATIVE_INT64, dspace ) );
+  attribute.write( H5::PredType::NATIVE_INT64, v.data() );
+  attribute.close();
+  dspace.close();
+}
+
+// ********* Chunk, Pending *********
+
+struct HDF5WriteService::Chunk {
+  DataSet* pDataSet;
+  hsize_t ixBegin; // first element
+  DataSet::vByte_t vRaw; // packed, a full chunk, zero past the end of the data
+  DataSet::vByte_t vFiltered;
+  unsigned int maskFilter;
+  Chunk( DataSet* pDataSet_, hsize_t ixBegin_ ): pDataSet( pDataSet_ ), ixBegin( ixBegin_ ), maskFilter {} {}
+};
+
+struct HDF5WriteService::Pending { // one data set within a flush
+  DataSet* pDataSet;
+  std::vector<Job*> vJob;
+  hsize_t nElement; // after the jobs
+  Pending( DataSet* pDataSet_ ): pDataSet( pDataSet_ ), nElement {} {}
+};
+
+// ********* HDF5WriteService *********
+
+HDF5WriteService::HDF5WriteService( const std::string& sFilePath, size_t nCompressors, int nDeflate, hsize_t nChunkSize )
+: m_sFilePath( sFilePath )
+, m_nDeflate( nDeflate )
+, m_nChunkSize( nChunkSize )
+, m_queueJob( 128 )
+, m_nFlushRequested {}, m_nFlushCompleted {}
+, m_bStop( false )
+, m_pvChunk( nullptr ), m_ixChunk {}, m_nCompressing {}, m_nCompressGeneration {}
+, m_bCompressStop( false )
+{
+  assert( 0 < nDeflate );
+  assert( 0 < nChunkSize );
+  for ( size_t ix = 0; ix < nCompressors; ix++ ) {
+    m_vThreadCompress.emplace_back( std::thread( [this](){ Compressor(); } ) );
+  }
+  m_threadWriter = std::thread( [this](){ Writer(); } );
+}
+
+HDF5WriteService::~HDF5WriteService() {
+
+  Flush( true );
+
+  {
+    std::scoped_lock<std::mutex> lock( m_mutex );
+    m_bStop = true;
+  }
+  m_cvWriter.notify_one();
+  m_threadWriter.join();
+
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexCompress );
+    m_bCompressStop = true;
+  }
+  m_cvCompress.notify_all();
+  for ( std::thread& thread: m_vThreadCompress ) thread.join();
+}
+
+HDF5WriteService::DataSet* HDF5WriteService::Register(
+  const std::string& sDataPath, fDefineDataType_t fDefineDataType, size_t nDatumSize, std::uint64_t nSignature,
+  fAttribute_t&& fAttribute, fFallback_t&& fFallback
+) {
+  std::scoped_lock<std::mutex> lock( m_mutexDataSet );
+  m_vDataSet.emplace_back(
+    std::make_unique<DataSet>( sDataPath, fDefineDataType, nDatumSize, nSignature, std::move( fAttribute ), std::move( fFallback ) ) );
+  return m_vDataSet.back().get();
+}
+
+void HDF5WriteService::Submit( DataSet* pDataSet, const void* pData, size_t nCount, fDone_t&& fDone ) {
+  assert( nullptr != pDataSet );
+  assert( 0 < nCount );
+  Job* pJob = new Job{ pDataSet, pData, nCount, std::move( fDone ) };
+  m_queueJob.push( pJob );
+}
+
+void HDF5WriteService::Flush( bool bWait ) {
+  std::unique_lock<std::mutex> lock( m_mutex );
+  const std::uint64_t nRequest( ++m_nFlushRequested );
+  m_cvWriter.notify_one();
+  if ( bWait ) {
+    m_cvFlushed.wait( lock, [this,nRequest](){ return nRequest <= m_nFlushCompleted; } );
+  }
+}
+
+HDF5WriteService::Stats HDF5WriteService::GetStats() const {
+  std::scoped_lock<std::mutex> lock( m_mutex );
+  return m_stats;
+}
+
+void HDF5WriteService::Writer() {
+
+  using clock_t = std::chrono::steady_clock;
+
+  std::vector<Job*> vJob;
+  bool bStop( false );
+
+  while ( !bStop ) {
+
+    std::uint64_t nRequest {};
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_cvWriter.wait( lock, [this](){ return m_bStop || ( m_nFlushCompleted < m_nFlushRequested ); } );
+      nRequest = m_nFlushRequested;
+      bStop = m_bStop;
+    }
+
+    const clock_t::time_point tpStart( clock_t::now() );
+
+    Job* pJob;
+    while ( m_queueJob.pop( pJob ) ) vJob.push_back( pJob );
+
+    Stats stats;
+    if ( !vJob.empty() ) {
+      try {
+        if ( !m_pdm ) {
+          m_pdm = std::make_unique<ou::tf::HDF5DataManager>( ou::tf::HDF5DataManager::RDWR, m_sFilePath );
+        }
+        Process( vJob, stats );
+      }
+      catch ( H5::Exception& e ) {
+        BOOST_LOG_TRIVIAL(error) << "HDF5WriteService H5::Exception " << e.getDetailMsg();
+        Reset();
+      }
+      catch ( std::runtime_error& e ) {
+        BOOST_LOG_TRIVIAL(error) << "HDF5WriteService " << e.what();
+        Reset();
+      }
+      for ( Job* pJob: vJob ) { // jobs not released by Process were not written
+        if ( pJob->fDone ) pJob->fDone( false );
+        delete pJob;
+      }
+      vJob.clear();
+    }
+
+    const double dblLatency( std::chrono::duration<double>( clock_t::now() - tpStart ).count() );
+
+    {
+      std::scoped_lock<std::mutex> lock( m_mutex );
+      if ( 0 < stats.nElement ) {
+        m_stats.nFlush++;
+        m_stats.nDataSet = stats.nDataSet;
+        m_stats.nElement = stats.nElement;
+        m_stats.nChunk = stats.nChunk;
+        m_stats.nBytesRaw = stats.nBytesRaw;
+        m_stats.nBytesWritten = stats.nBytesWritten;
+        m_stats.dblLatency = dblLatency;
+        m_stats.nTotalElement += stats.nElement;
+        m_stats.nTotalBytesWritten += stats.nBytesWritten;
+        m_stats.dblMaxLatency = std::max( m_stats.dblMaxLatency, dblLatency );
+      }
+      m_nFlushCompleted = nRequest;
+    }
+    m_cvFlushed.notify_all();
+
+    if ( 0 < stats.nElement ) {
+      BOOST_LOG_TRIVIAL(info)
+        << "hdf5 write: "
+        << stats.nDataSet << " datasets, "
+        << stats.nElement << " elements, "
+        << stats.nChunk << " chunks, "
+        << stats.nBytesRaw << " bytes packed, "
+        << stats.nBytesWritten << " bytes written, "
+        << (int)( dblLatency * 1000.0 ) << "ms"
+        ;
+    }
+  }
+
+  // hdf5 objects are released on the thread which used them
+  Reset();
+}
+
+// after a failed flush, the in memory state of a data set may be ahead of the file
+void HDF5WriteService::Reset() {
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexDataSet );
+    for ( std::unique_ptr<DataSet>& pDataSet: m_vDataSet ) {
+      try {
+        pDataSet->Close();
+      }
+      catch ( H5::Exception& e ) {
+        BOOST_LOG_TRIVIAL(error) << "HDF5WriteService close " << pDataSet->sPath << ' ' << e.getDetailMsg();
+      }
+    }
+  }
+  m_pdm.reset();
+}
+
+void HDF5WriteService::Process( std::vector<Job*>& vJob, Stats& stats ) {
+
+  // group by data set, submission order is kept within a data set
+  std::vector<Pending> vPending;
+  for ( Job* pJob: vJob ) {
+    std::vector<Pending>::iterator iter = std::find_if(
+      vPending.begin(), vPending.end(), [pJob]( const Pending& pending ){ return pending.pDataSet == pJob->pDataSet; } );
+    if ( vPending.end() == iter ) {
+      vPending.emplace_back( Pending( pJob->pDataSet ) );
+      iter = vPending.end() - 1;
+    }
+    iter->vJob.push_back( pJob );
+  }
+  stats.nDataSet = vPending.size();
+
+  std::vector<Chunk> vChunk;
+  DataSet::vByte_t vPacked;
+
+  // writes the chunks of a data set, and its meta data
+  auto fCommit =
+    [this,&stats]( DataSet& ds, std::vector<Chunk>::iterator begin, std::vector<Chunk>::iterator end, hsize_t nElement ) {
+      if ( nElement > ds.nElement ) {
+        ds.pDataSet->extend( &nElement );
+      }
+      for ( std::vector<Chunk>::iterator iter = begin; iter != end; iter++ ) {
+        if ( 0 > H5Dwrite_chunk(
+          ds.pDataSet->getId(), H5P_DEFAULT, iter->maskFilter, &iter->ixBegin, iter->vFiltered.size(), iter->vFiltered.data() )
+        ) {
+          throw std::runtime_error( "HDF5WriteService: chunk write failed for " + ds.sPath );
+        }
+        stats.nChunk++;
+        stats.nBytesRaw += iter->vRaw.size();
+        stats.nBytesWritten += iter->vFiltered.size();
+      }
+      if ( begin != end ) {
+        // the new tail is the last chunk written
+        const Chunk& last( *( end - 1 ) );
+        ds.ixTail = last.ixBegin;
+        ds.vTail.assign( last.vRaw.begin(), last.vRaw.begin() + ( nElement - last.ixBegin ) * ds.nPacked );
+      }
+      ds.nElement = nElement;
+      ds.WriteTimeIndex();
+      if ( !ds.bAttributesSet ) {
+        ds.bAttributesSet = true;
+        ou::tf::HDF5Attributes attrT( *m_pdm, ds.sPath );
+        attrT.SetSignature( ds.nSignature );
+        if ( ds.fAttribute ) ds.fAttribute( attrT ); // set typename T specific attributes
+      }
+    };
+
+  // stages the jobs of a data set over its tail, then cuts the changed chunks
+  auto fStage =
+    [this,&vChunk,&vPacked,&stats,&fCommit]( Pending& pending ) {
+
+      DataSet& ds( *pending.pDataSet );
+      if ( !ds.bOpen ) ds.Open( *m_pdm, m_nDeflate, m_nChunkSize );
+
+      DataSet::vByte_t vStage( ds.vTail ); // elements from ds.ixTail
+      hsize_t nEnd( ds.nElement );
+      hsize_t ixDirty( nEnd );
+
+      auto fCut = // the chunks from the one holding ixDirty
+        [&]() {
+          const size_t ixFirstChunk( vChunk.size() );
+          for ( hsize_t ixBegin = ( ixDirty / ds.nChunk ) * ds.nChunk; ixBegin < nEnd; ixBegin += ds.nChunk ) {
+            vChunk.emplace_back( Chunk( &ds, ixBegin ) );
+            Chunk& chunk( vChunk.back() );
+            chunk.vRaw.assign( ds.nChunk * ds.nPacked, 0 );
+            const hsize_t nCopy( std::min( ds.nChunk, nEnd - ixBegin ) );
+            std::memcpy( chunk.vRaw.data(), &vStage[ ( ixBegin - ds.ixTail ) * ds.nPacked ], nCopy * ds.nPacked );
+          }
+          return ixFirstChunk;
+        };
+
+      for ( Job*& pJob: pending.vJob ) {
+
+        ds.Pack( pJob->pData, pJob->nCount, vPacked );
+        const ptime dtFirst( ds.DateTime( vPacked.data() ) );
+
+        // HDF5TimeSeriesContainer::Write places the data at the lower bound of its first time stamp
+        hsize_t ixStart( ds.ixTail );
+        while ( ( ixStart < nEnd ) && ( ds.DateTime( &vStage[ ( ixStart - ds.ixTail ) * ds.nPacked ] ) < dtFirst ) ) ixStart++;
+
+        if ( ( ixStart == ds.ixTail ) && ( 0 < ds.ixTail ) ) {
+          // may land in an earlier chunk, commit what is staged, then write through the library
+          const size_t ixFirstChunk( fCut() );
+          Compress( vChunk );
+          fCommit( ds, vChunk.begin() + ixFirstChunk, vChunk.end(), nEnd );
+          vChunk.erase( vChunk.begin() + ixFirstChunk, vChunk.end() );
+          ds.fFallback( *m_pdm, ds.sPath, pJob->pData, pJob->nCount );
+          ds.Load();
+          vStage = ds.vTail;
+          nEnd = ds.nElement;
+          ixDirty = nEnd;
+        }
+        else {
+          const hsize_t nNewEnd( std::max<hsize_t>( nEnd, ixStart + pJob->nCount ) );
+          vStage.resize( ( nNewEnd - ds.ixTail ) * ds.nPacked, 0 );
+          std::memcpy( &vStage[ ( ixStart - ds.ixTail ) * ds.nPacked ], vPacked.data(), vPacked.size() );
+
+          // as HDF5TimeSeriesAccessor::WriteTimeIndex
+          ds.vTimeIndex.resize( ( nNewEnd + ds.nChunk - 1 ) / ds.nChunk );
+          for ( hsize_t ixEntry = ( ixStart + ds.nChunk - 1 ) / ds.nChunk; ixEntry < ds.vTimeIndex.size(); ixEntry++ ) {
+            const hsize_t ix( ixEntry * ds.nChunk );
+            if ( ix >= ( ixStart + pJob->nCount ) ) break;
+            ds.vTimeIndex[ ixEntry ] = ds.DateTime( &vPacked[ ( ix - ixStart ) * ds.nPacked ] );
+          }
+
+          ixDirty = std::min( ixDirty, ixStart );
+          nEnd = nNewEnd;
+        }
+
+        stats.nElement += pJob->nCount;
+      }
+
+      fCut();
+      pending.nElement = nEnd;
+    };
+
+  for ( Pending& pending: vPending ) {
+    fStage( pending );
+  }
+
+  Compress( vChunk ); // all data sets at once
+
+  std::vector<Chunk>::iterator iterChunk( vChunk.begin() );
+  for ( Pending& pending: vPending ) {
+    std::vector<Chunk>::iterator iterEnd( iterChunk );
+    while ( ( vChunk.end() != iterEnd ) && ( pending.pDataSet == iterEnd->pDataSet ) ) iterEnd++;
+    fCommit( *pending.pDataSet, iterChunk, iterEnd, pending.nElement );
+    iterChunk = iterEnd;
+  }
+
+  m_pdm->Flush();
+
+  // written, the collectors can re-use their series
+  for ( Job* pJob: vJob ) {
+    if ( pJob->fDone ) pJob->fDone( true );
+    pJob->fDone = nullptr;
+  }
+}
+
+// as the hdf5 shuffle and deflate filters, applied to the whole chunk
+void HDF5WriteService::Compress( Chunk& chunk ) {
+
+  const size_t nBytes( chunk.vRaw.size() );
+  const size_t nSize( chunk.pDataSet->nPacked );
+  const size_t nElements( nBytes / nSize );
+
+  DataSet::vByte_t vShuffled( nBytes );
+  if ( ( 1 < nSize ) && ( 1 < nElements ) ) {
+    const std::uint8_t* pSrc( chunk.vRaw.data() );
+    std::uint8_t* pDst( vShuffled.data() );
+    for ( size_t ixByte = 0; ixByte < nSize; ixByte++ ) {
+      for ( size_t ixElement = 0; ixElement < nElements; ixElement++ ) {
+        *pDst++ = pSrc[ ixElement * nSize + ixByte ];
+      }
+    }
+    const size_t nLeftOver( nBytes % nSize );
+    if ( 0 < nLeftOver ) {
+      std::memcpy( pDst, pSrc + nBytes - nLeftOver, nLeftOver );
+    }
+  }
+  else {
+    vShuffled = chunk.vRaw;
+  }
+
+  uLongf nCompressed( compressBound( nBytes ) );
+  chunk.vFiltered.resize( nCompressed );
+  if ( Z_OK == compress2( chunk.vFiltered.data(), &nCompressed, vShuffled.data(), nBytes, m_nDeflate ) ) {
+    chunk.vFiltered.resize( nCompressed );
+    chunk.maskFilter = 0;
+  }
+  else { // deflate is an optional filter, the chunk is recorded as only shuffled
+    chunk.vFiltered.swap( vShuffled );
+    chunk.maskFilter = c_maskSkipDeflate;
+  }
+}
+
+// the writer thread takes part, returns once all chunks are done
+void HDF5WriteService::Compress( std::vector<Chunk>& vChunk ) {
+
+  if ( vChunk.empty() ) return;
+
+  if ( m_vThreadCompress.empty() || ( 1 == vChunk.size() ) ) {
+    for ( Chunk& chunk: vChunk ) Compress( chunk );
+    return;
+  }
+
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexCompress );
+    m_pvChunk = &vChunk;
+    m_ixChunk.store( 0 );
+    m_nCompressing = m_vThreadCompress.size();
+    m_nCompressGeneration++;
+  }
+  m_cvCompress.notify_all();
+
+  size_t ix;
+  while ( ( ix = m_ixChunk.fetch_add( 1 ) ) < vChunk.size() ) {
+    Compress( vChunk[ ix ] );
+  }
+
+  std::unique_lock<std::mutex> lock( m_mutexCompress );
+  m_cvCompressed.wait( lock, [this](){ return 0 == m_nCompressing; } );
+  m_pvChunk = nullptr;
+}
+
+void HDF5WriteService::Compressor() {
+  std::uint64_t nGeneration {};
+  while ( true ) {
+    std::vector<Chunk>* pvChunk;
+    {
+      std::unique_lock<std::mutex> lock( m_mutexCompress );
+      m_cvCompress.wait( lock, [this,&nGeneration](){ return m_bCompressStop || ( nGeneration != m_nCompressGeneration ); } );
+      if ( m_bCompressStop ) return;
+      nGeneration = m_nCompressGeneration;
+      pvChunk = m_pvChunk;
+    }
+    size_t ix;
+    while ( ( ix = m_ixChunk.fetch_add( 1 ) ) < pvChunk->size() ) {
+      Compress( ( *pvChunk )[ ix ] );
+    }
+    {
+      std::scoped_lock<std::mutex> lock( m_mutexCompress );
+      m_nCompressing--;
+    }
+    m_cvCompressed.notify_one();
+  }
+}
+
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,169 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HDF5WriteService.hpp
+ * Author:  raymond@burkholder.net
+ * Project: Collector
+ * Created: 2026
+ */
+
+// one long lived writer for all collectors of a file
+//   the file and its datasets stay open, series are queued lock free by Submit and written by Flush
+//   submissions to the same dataset within a flush are merged into one pass over its chunks
+//   chunks are packed on the writer thread, shuffled + deflated on a pool, then written directly to the file,
+//     producing the same datasets as HDF5WriteTimeSeries( dm, true, true, nDeflate, nChunkSize ):
+//     same placement ( the lower bound of the first time stamp ), same chunk bytes, same TimeIndex attribute
+//   a write landing before the last chunk of a dataset goes through HDF5TimeSeriesContainer instead
+//   all HDF5 calls are made on the writer thread
+//   a series is released once its data set is committed, when a flush fails it is released unwritten,
+//     the open data sets are closed, and re-loaded from the file on the next write, so a re-submit is safe
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+#include <boost/lockfree/queue.hpp>
+
+#include <TFHDF5TimeSeries/HDF5Attribute.h>
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+
+namespace ou { // namespace one unified net
+namespace tf { // namespace tradeframe
+
+class HDF5WriteService {
+public:
+
+  using fAttribute_t = std::function<void(ou::tf::HDF5Attributes&)>; // one time callback on first write
+  using fDone_t = std::function<void(bool bWritten)>; // on the writer thread, once the series is no longer referenced
+
+  struct Stats {
+    std::uint64_t nFlush; // flushes with something written
+    std::uint64_t nDataSet; // in the last flush
+    std::uint64_t nElement;
+    std::uint64_t nChunk;
+    std::uint64_t nBytesRaw; // packed, before shuffle + deflate
+    std::uint64_t nBytesWritten; // chunk bytes handed to the file
+    double dblLatency; // seconds, flush request to completion
+    std::uint64_t nTotalElement;
+    std::uint64_t nTotalBytesWritten;
+    double dblMaxLatency;
+    Stats()
+    : nFlush {}, nDataSet {}, nElement {}, nChunk {}, nBytesRaw {}, nBytesWritten {}, dblLatency {}
+    , nTotalElement {}, nTotalBytesWritten {}, dblMaxLatency {}
+    {}
+  };
+
+  class DataSet; // per data path, opened on the first write
+
+  HDF5WriteService( const std::string& sFilePath, size_t nCompressors = 2, int nDeflate = 5, hsize_t nChunkSize = 256 );
+  ~HDF5WriteService(); // writes what remains queued
+
+  template<typename T> // timeseries, eg, ou::tf::Trades, ou::tf::Quotes
+  DataSet* Register( const std::string& sDataPath, fAttribute_t&& );
+
+  template<typename T> // the series is not to be changed until fDone
+  void Submit( DataSet*, T& series, fDone_t&& );
+
+  void Flush( bool bWait = false ); // bWait: return once everything submitted so far is written
+
+  Stats GetStats() const;
+
+protected:
+private:
+
+  struct Job {
+    DataSet* pDataSet;
+    const void* pData; // contiguous datums
+    size_t nCount;
+    fDone_t fDone;
+  };
+
+  struct Chunk;
+  struct Pending;
+
+  const std::string m_sFilePath;
+  const int m_nDeflate;
+  const hsize_t m_nChunkSize;
+
+  std::unique_ptr<ou::tf::HDF5DataManager> m_pdm; // writer thread
+
+  std::mutex m_mutexDataSet;
+  std::vector<std::unique_ptr<DataSet> > m_vDataSet;
+
+  boost::lockfree::queue<Job*> m_queueJob;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cvWriter;
+  std::condition_variable m_cvFlushed;
+  std::uint64_t m_nFlushRequested;
+  std::uint64_t m_nFlushCompleted;
+  bool m_bStop;
+  Stats m_stats;
+
+  std::thread m_threadWriter;
+
+  // compression pool: the writer thread posts a generation of chunks, workers and the writer take them by index
+  std::vector<std::thread> m_vThreadCompress;
+  std::mutex m_mutexCompress;
+  std::condition_variable m_cvCompress;
+  std::condition_variable m_cvCompressed;
+  std::vector<Chunk>* m_pvChunk;
+  std::atomic<size_t> m_ixChunk;
+  size_t m_nCompressing; // workers in the current generation
+  std::uint64_t m_nCompressGeneration;
+  bool m_bCompressStop;
+
+  using fDefineDataType_t = H5::CompType* (*)( H5::CompType* );
+  using fFallback_t = std::function<void(ou::tf::HDF5DataManager&, const std::string&, const void*, size_t)>;
+
+  DataSet* Register( const std::string& sDataPath, fDefineDataType_t, size_t nDatumSize, std::uint64_t nSignature, fAttribute_t&&, fFallback_t&& );
+  void Submit( DataSet*, const void* pData, size_t nCount, fDone_t&& );
+
+  void Writer();
+  void Reset(); // close the data sets and the file, on the writer thread
+  void Process( std::vector<Job*>&, Stats& );
+  void Compressor();
+  void Compress( std::vector<Chunk>& );
+  void Compress( Chunk& );
+};
+
+template<typename T>
+HDF5WriteService::DataSet* HDF5WriteService::Register( const std::string& sDataPath, fAttribute_t&& fAttribute ) {
+  using DD = typename T::datum_t;
+  return Register(
+    sDataPath, &DD::DefineDataType, sizeof( DD ), DD::Signature(), std::move( fAttribute ),
+    []( ou::tf::HDF5DataManager& dm, const std::string& sDataPath, const void* pData, size_t nCount ){
+      const DD* pBegin( reinterpret_cast<const DD*>( pData ) );
+      ou::tf::HDF5TimeSeriesContainer<DD> repository( dm, sDataPath );
+      repository.Write( pBegin, pBegin + nCount );
+    } );
+}
+
+template<typename T>
+void HDF5WriteService::Submit( DataSet* pDataSet, T& series, fDone_t&& fDone ) {
+  Submit( pDataSet, series.First(), series.Size(), std::move( fDone ) );
+}
+
+} // namespace tf
+} // namespace ou
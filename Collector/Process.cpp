@@ -27,6 +27,7 @@
 #include "CollectL2.hpp"
 #include "CollectGreeks.hpp"
 #include "CollectATM.hpp"
+#include "HDF5WriteService.hpp"
 
 #include "Process.hpp"
 
@@ -47,6 +48,8 @@ Process::Process(
 , m_dtStop( dtStop )
 {
 
+  m_pWriteService = std::make_unique<ou::tf::HDF5WriteService>( m_sFilePathName );
+
   OpenDB();
 
   auto f =
@@ -98,6 +101,8 @@ Process::~Process() {
     m_mapToCollect.erase( m_mapToCollect.begin() );
   }
 
+  m_pWriteService.reset(); // writes what remains, closes the file
+
   m_pComposeInstrumentIQFeed.reset();
 
   m_pOptionEngine.reset();
@@ -242,7 +247,7 @@ void Process::ConstructCollectorL1( pWatch_t pWatch ) {
 
   mapCollectL1_t::iterator iterCollectL1 = m_mapCollectL1.find( sSymbolName );
   if ( m_mapCollectL1.end() == iterCollectL1 ) {
-    auto result = m_mapCollectL1.emplace( sSymbolName, std::make_unique<collect::L1>( m_sFilePathName, m_sDataPathName, pWatch ) );
+    auto result = m_mapCollectL1.emplace( sSymbolName, std::make_unique<collect::L1>( *m_pWriteService, m_sDataPathName, pWatch ) );
     assert( result.second );
   }
   else {
@@ -265,7 +270,7 @@ void Process::ConstructCollectorL2( pWatch_t pWatch ) {
 
   mapCollectL2_t::iterator iterCollectL2 = m_mapCollectL2.find( sSymbolName );
   if ( m_mapCollectL2.end() == iterCollectL2 ) {
-    auto result = m_mapCollectL2.emplace( sSymbolName, std::make_unique<collect::L2>( m_sFilePathName, m_sDataPathName, pWatch ) );
+    auto result = m_mapCollectL2.emplace( sSymbolName, std::make_unique<collect::L2>( *m_pWriteService, m_sDataPathName, pWatch ) );
     assert( result.second );
   }
   else {
@@ -288,7 +293,7 @@ void Process::ConstructCollectorGreeks( pOption_t pOption ) {
 
   mapCollectGreeks_t::iterator iterCollectGreeks = m_mapCollectGreeks.find( sSymbolName );
   if ( m_mapCollectGreeks.end() == iterCollectGreeks ) {
-    auto result = m_mapCollectGreeks.emplace( sSymbolName, std::make_unique<collect::Greeks>( m_sFilePathName, m_sDataPathName, pOption ) );
+    auto result = m_mapCollectGreeks.emplace( sSymbolName, std::make_unique<collect::Greeks>( *m_pWriteService, m_sDataPathName, pOption ) );
     assert( result.second );
   }
   else {
@@ -321,7 +326,7 @@ void Process::ConstructCollectorATM( pWatch_t pWatch ) {
     auto result = m_mapCollectATM.emplace(
       sSymbolName,
       std::make_unique<collect::ATM>(
-        m_sFilePathName, m_sDataPathName,
+        *m_pWriteService, m_sDataPathName,
         pWatch,
         [this]( collect::ATM::pInstrument_t pInstrument )->collect::ATM::pOption_t { // fBuildOption_t
           pOption_t pOption = std::make_shared<ou::tf::option::Option>( pInstrument, m_piqfeed );
@@ -362,6 +367,7 @@ void Process::Write() {
   for ( mapCollectATM_t::value_type& vt: m_mapCollectATM ) {
     vt.second->Write();
   }
+  m_pWriteService->Flush(); // returns without waiting for the file
 }
 
 void Process::QueryChains( pInstrument_t pUnderlying, collect::ATM::fInstrumentOption_t&& fIO ) {
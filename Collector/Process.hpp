@@ -44,6 +44,7 @@
 namespace ou {
 namespace tf {
   class ComposeInstrument;
+  class HDF5WriteService;
 } // namespace tf
 } // namespace ou
 
@@ -82,6 +83,8 @@ private:
   const std::string m_sFilePathName;
   const std::string m_sDataPathName;
 
+  std::unique_ptr<ou::tf::HDF5WriteService> m_pWriteService; // shared by the collectors
+
   const config::Choices& m_choices;
   boost::posix_time::ptime m_dtStop;
 
@@ -11,6 +11,7 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <future>
 #include <algorithm>
 
 #include <boost/foreach.hpp>
@@ -34,8 +35,8 @@ Process::Process(
   ou::tf::iqfeed::InMemoryMktSymbolList& list,
   const std::string& sPrefixPath,
 	size_t nDatums )
-: ou::tf::iqfeed::HistoryBulkQuery<Process>(),
-	m_list( list ),
+:	m_list( list ),
+  m_pipeline( 15, 4 ), // connections, requests outstanding per connection
   m_sPrefixPath( sPrefixPath ), m_nDatums( nDatums )
   //m_cntBars( 25 )
 //  m_cntBars( 0 ) // 2013/09/17
@@ -93,65 +94,78 @@ void Process::Start() {
   m_list.SelectSymbolsByExchange( m_vExchanges.begin(), m_vExchanges.end(), SelectSymbols( setSelected ) );
   std::cout << "# symbols selected: " << setSelected.size() << std::endl;
 
-  SetMaxSimultaneousQueries( 15 );
-  SetSymbols( setSelected.begin(), setSelected.end() );
-  DailyBars( m_nDatums );
-  Block();
+  std::promise<void> promiseConnected;
+  std::future<void> futureConnected = promiseConnected.get_future();
+  m_pipeline.Connect( [&promiseConnected](){ promiseConnected.set_value(); } );
+  futureConnected.wait();
+
+  std::vector<std::string> vSymbol( setSelected.begin(), setSelected.end() );
+  m_pipeline.RetrieveNEndOfDays(
+    vSymbol, m_nDatums,
+    [this]( Result& result ){ OnBars( result ); },
+    [this](){ OnCompletion(); }
+  );
+  m_pipeline.Block();
+  m_pipeline.Disconnect();
+
+  const ou::tf::iqfeed::HistoryPipeline::Statistics& stats( m_pipeline.GetStatistics() );
+  std::cout
+    << stats.nRequests << " symbols, "
+    << stats.nErrors << " errors, "
+    << stats.nDatums << " bars in "
+    << stats.dblSeconds << "s, "
+    << stats.SymbolsPerSecond() << " symbols/s"
+    << std::endl;
 
   std::cout << "Process complete." << std::endl;
 
 }
 
-void Process::OnBars( inherited_t::structResultBar* bars ) {
+void Process::OnBars( Result& result ) {
 
-  // warning:  this section is re-entrant from multiple threads
+  // single consumer thread, so hdf5 writes are serialized
 
-  // save the data
+  assert( result.sSymbol.length() > 0 );
 
-  boost::mutex::scoped_lock lock( m_mutexProcessResults );
+  std::cout << result.sSymbol << ": " << result.bars.Size();
 
-  assert( bars->sSymbol.length() > 0 );
-
-  std::cout << bars->sSymbol << ": " << bars->bars.Size();
+  if ( !result.sError.empty() ) {
+    std::cout << " " << result.sError;
+  }
 
-  if ( 0 != bars->bars.Size() ) {
+  if ( 0 != result.bars.Size() ) {
 
     std::string sPath;
 
-    ou::tf::HDF5DataManager::DailyBarPath( bars->sSymbol, sPath );  // build hierarchical path based upon symbol name
+    ou::tf::HDF5DataManager::DailyBarPath( result.sSymbol, sPath );  // build hierarchical path based upon symbol name
 
     ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
     ou::tf::HDF5WriteTimeSeries<ou::tf::Bars> wts( dm, false, true, 0, 64 );
-    wts.Write( sPath, &bars->bars );
+    wts.Write( sPath, &result.bars );
   }
 
-  ReQueueBars( bars );
-
   std::cout << "." << std::endl;
 
 }
 
-void Process::OnTicks( inherited_t::structResultTicks* ticks ) {
-
-  boost::mutex::scoped_lock lock( m_mutexProcessResults );
+void Process::OnTicks( Result& result ) {
 
-  assert( ticks->sSymbol.length() > 0 );
+  assert( result.sSymbol.length() > 0 );
 
   ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RDWR );
 
-  if ( 0 != ticks->trades.Size() ) {
-    std::string sPath( "/optionables/trade/" + ticks->sSymbol );
+  if ( 0 != result.trades.Size() ) {
+    std::string sPath( "/optionables/trade/" + result.sSymbol );
     ou::tf::HDF5WriteTimeSeries<ou::tf::Trades> wtst( dm );
-    wtst.Write( sPath, &ticks->trades );
+    wtst.Write( sPath, &result.trades );
   }
 
-  if ( 0 != ticks->quotes.Size() ) {
-    std::string sPath( "/optionables/quote/" + ticks->sSymbol );
+  if ( 0 != result.quotes.Size() ) {
+    std::string sPath( "/optionables/quote/" + result.sSymbol );
     ou::tf::HDF5WriteTimeSeries<ou::tf::Quotes> wtsq( dm );
-    wtsq.Write( sPath, &ticks->quotes );
+    wtsq.Write( sPath, &result.quotes );
   }
 
-  ReQueueTicks( ticks );
 }
 
 void Process::OnCompletion() {
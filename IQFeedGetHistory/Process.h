@@ -24,19 +24,13 @@
 #include <set>
 #include <string>
 
-#include <boost/thread/mutex.hpp>
-#include <boost/thread/locks.hpp>
-
-#include <TFIQFeed/HistoryBulkQuery.h>
+#include <TFIQFeed/HistoryPipeline.h>
 #include <TFIQFeed/InMemoryMktSymbolList.h>
 
-class Process:
-  public ou::tf::iqfeed::HistoryBulkQuery<Process>
-{
-  friend ou::tf::iqfeed::HistoryBulkQuery<Process>;
+class Process {
 public:
 
-  typedef ou::tf::iqfeed::HistoryBulkQuery<Process> inherited_t;
+  using Result = ou::tf::iqfeed::HistoryPipeline::Result;
 
   Process(
     ou::tf::iqfeed::InMemoryMktSymbolList&,
@@ -48,28 +42,16 @@ public:
 
 protected:
 
-  // CRTP from HistoryBulkQuery<CProcess>
-  void OnBars( inherited_t::structResultBar* bars );
-  void OnTicks( inherited_t::structResultTicks* ticks );
+  // called from the pipeline's consumer thread, one at a time
+  void OnBars( Result& );
+  void OnTicks( Result& );
   void OnCompletion();
 
-  void OnBarsForDarvas( inherited_t::structResultBar* bars );
-
-  // CRTP prototypes
-  //void OnHistoryConnected( structQueryState* pqs );  // optional
-  //void OnHistoryDisconnected( structQueryState* pqs ); // optional
-  //void OnHistoryError( structQueryState* pqs, size_t e ); // optional
-  //void OnHistorySendDone( structQueryState* pqs ); // otional
-  //void OnHistoryTickDataPoint( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structTickDataPoint* pDP ); // for per tick processing
-  //void OnHistoryIntervalData( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structInterval* pDP ); // for per bar processing
-  //void OnHistorySummaryData( structQueryState* pqs, ou::tf::iqfeed::HistoryStructs::structSummary* pDP ); // for per bar processing
-  //void OnHistoryRequestDone( structQueryState* pqs ); // for processing finished ticks, bars
-
 private:
 
   ou::tf::iqfeed::InMemoryMktSymbolList& m_list;
 
-  boost::mutex m_mutexProcessResults;
+  ou::tf::iqfeed::HistoryPipeline m_pipeline;
 
   std::string m_sPrefixPath;
   const size_t m_nDatums;
@@ -82,4 +64,3 @@ private:
   //const size_t m_cntBars;
 
 };
-
@@ -0,0 +1,124 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    LSTM.cpp
+ * Author:  raymond@burkholder.net
+ * Project: SP500
+ * Created: 2026
+ */
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "LSTM.hpp"
+
+LSTMImpl::LSTMImpl( int input_size, int hidden_size, int num_layers, int output_size )
+: lstm( torch::nn::LSTMOptions( input_size, hidden_size ).num_layers( num_layers ).batch_first( true ) )
+, linear( hidden_size, output_size )
+{
+  register_module( "lstm", lstm );
+  register_module( "linear", linear );
+}
+
+torch::Tensor LSTMImpl::forward( torch::Tensor x, state_t& state ) {
+  torch::Tensor out;
+  std::tie( out, state ) = lstm->forward( x, state );
+  return linear->forward( out );
+}
+
+LSTMImpl::state_t LSTMImpl::init_hidden( int batch_size ) const {
+  torch::Tensor hidden_state = torch::zeros( { lstm->options.num_layers(), batch_size, lstm->options.hidden_size() } );
+  torch::Tensor   cell_state = torch::zeros( { lstm->options.num_layers(), batch_size, lstm->options.hidden_size() } );
+  return std::make_tuple( hidden_state, cell_state );
+}
+
+// ====
+
+LSTMStream::LSTMStream( LSTM model )
+: m_model( model )
+, m_nInput( model->input_size() )
+, m_nSteps {}
+{
+  m_model->eval();
+  c10::InferenceMode guard;
+  m_input = torch::zeros( { 1, 1, m_nInput } );
+  m_state = m_model->init_hidden( 1 );
+}
+
+LSTMStream::~LSTMStream() {}
+
+void LSTMStream::Reset() {
+  c10::InferenceMode guard;
+  std::get<0>( m_state ).zero_();
+  std::get<1>( m_state ).zero_();
+  m_nSteps = 0;
+}
+
+const float* LSTMStream::Step( const float* rInput ) {
+
+  const auto start( std::chrono::steady_clock::now() );
+
+  {
+    c10::InferenceMode guard;
+    std::copy( rInput, rInput + m_nInput, m_input.data_ptr<float>() );
+    m_output = m_model->forward( m_input, m_state ).contiguous();
+  }
+  m_nSteps++;
+
+  const double dblMicroSeconds( std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count() );
+  m_latency.nSteps++;
+  m_latency.dblLast = dblMicroSeconds;
+  m_latency.dblMean += ( dblMicroSeconds - m_latency.dblMean ) / m_latency.nSteps;
+  m_latency.dblMax = std::max( m_latency.dblMax, dblMicroSeconds );
+
+  return m_output.data_ptr<float>();
+}
+
+void LSTMStream::Save( Checkpoint& checkpoint ) const {
+  checkpoint.hidden = std::get<0>( m_state ).clone();
+  checkpoint.cell = std::get<1>( m_state ).clone();
+  checkpoint.nSteps = m_nSteps;
+}
+
+void LSTMStream::Restore( const Checkpoint& checkpoint ) {
+  if ( ( std::get<0>( m_state ).sizes() != checkpoint.hidden.sizes() ) || ( std::get<1>( m_state ).sizes() != checkpoint.cell.sizes() ) ) {
+    throw std::runtime_error( "LSTMStream: checkpoint does not match the model" );
+  }
+  c10::InferenceMode guard;
+  m_state = std::make_tuple( checkpoint.hidden.clone(), checkpoint.cell.clone() );
+  m_nSteps = checkpoint.nSteps;
+}
+
+// hidden, cell, and the step count as a tensor
+void LSTMStream::Save( const std::string& sFileName ) const {
+  std::vector<torch::Tensor> vTensor = {
+    std::get<0>( m_state ).clone(), std::get<1>( m_state ).clone(), torch::tensor( (int64_t) m_nSteps ) };
+  torch::save( vTensor, sFileName );
+}
+
+void LSTMStream::Load( const std::string& sFileName ) {
+  std::vector<torch::Tensor> vTensor;
+  torch::load( vTensor, sFileName );
+  if ( 3 != vTensor.size() ) {
+    throw std::runtime_error( "LSTMStream: " + sFileName + " is not a saved state" );
+  }
+  Checkpoint checkpoint;
+  checkpoint.hidden = vTensor[ 0 ];
+  checkpoint.cell = vTensor[ 1 ];
+  checkpoint.nSteps = vTensor[ 2 ].item<int64_t>();
+  Restore( checkpoint );
+}
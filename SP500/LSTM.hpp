@@ -0,0 +1,112 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    LSTM.hpp
+ * Author:  raymond@burkholder.net
+ * Project: SP500
+ * Created: 2026
+ */
+
+#pragma once
+
+#include <tuple>
+#include <string>
+#include <cstdint>
+
+#include <torch/torch.h>
+
+// the TorchTest_v2 model, batch first, so x is [ batch, sequence, input ]
+//   ( v2 is sequence first by default, which is its 'Expected hidden[0] size 2 20 32' error )
+
+class LSTMImpl: public torch::nn::Module {
+public:
+
+  using state_t = std::tuple<torch::Tensor, torch::Tensor>; // hidden, cell: [ layers, batch, hidden ]
+
+  LSTMImpl( int input_size, int hidden_size, int num_layers, int output_size );
+
+  // returns [ batch, sequence, output ], state is advanced to the end of x
+  torch::Tensor forward( torch::Tensor x, state_t& state );
+
+  state_t init_hidden( int batch_size ) const;
+
+  int input_size() const { return (int) lstm->options.input_size(); }
+  int output_size() const { return (int) linear->options.out_features(); }
+
+private:
+  torch::nn::LSTM lstm;
+  torch::nn::Linear linear;
+};
+
+TORCH_MODULE( LSTM );
+
+// inference one bar at a time, rather than rerunning the sequence of accumulated bars
+//   the hidden and cell state is carried from one Step to the next,
+//   so the output of a Step matches the last output of forward over all bars since Reset
+//   the input tensor is allocated once, Step copies the bar into it, and runs under InferenceMode
+//   Checkpoint/Restore ( Save/Load to a file ) carry the state across a session boundary
+
+class LSTMStream {
+public:
+
+  struct Checkpoint {
+    torch::Tensor hidden;
+    torch::Tensor cell;
+    std::uint64_t nSteps;
+    Checkpoint(): nSteps {} {}
+  };
+
+  struct Latency { // of Step, microseconds
+    std::uint64_t nSteps;
+    double dblLast;
+    double dblMean;
+    double dblMax;
+    Latency(): nSteps {}, dblLast {}, dblMean {}, dblMax {} {}
+  };
+
+  LSTMStream( LSTM ); // the model is put into eval mode
+  ~LSTMStream();
+
+  void Reset(); // zero state, eg, at the start of a session
+
+  // input_size() values of a completed bar, returns output_size() values, valid until the next Step
+  const float* Step( const float* rInput );
+
+  std::uint64_t Steps() const { return m_nSteps; }
+
+  void Save( Checkpoint& ) const;
+  void Restore( const Checkpoint& );
+
+  void Save( const std::string& sFileName ) const;
+  void Load( const std::string& sFileName ); // throws std::runtime_error when the shape does not match the model
+
+  const Latency& GetLatency() const { return m_latency; }
+  void ResetLatency() { m_latency = Latency(); }
+
+protected:
+private:
+
+  LSTM m_model;
+
+  const int m_nInput;
+
+  torch::Tensor m_input; // [ 1, 1, input ]
+  torch::Tensor m_output; // [ 1, 1, output ]
+  LSTMImpl::state_t m_state;
+  std::uint64_t m_nSteps;
+
+  Latency m_latency;
+
+};
@@ -1,9 +1,13 @@
 #include <cmath>
+#include <chrono>
+#include <cstdio>
 #include <vector>
 #include <iostream>
+#include <algorithm>
 
 #include <torch/torch.h>
 
+#include "LSTM.hpp"
 #include "Torch.hpp"
 
 // extracted from google search ai.
@@ -190,4 +194,72 @@ void TorchTest_v1() {
 
   // Print the output tensor
   std::cout << output.sizes() << std::endl;
-}
\ No newline at end of file
+}
+
+// =====================================
+
+// LSTMStream, one step per bar, against forward over the whole sequence
+void TorchTest_Stream() {
+
+  const int input_size = 8; // as Strategy::rValues_t
+  const int hidden_size = 32;
+  const int num_layers = 2;
+  const int output_size = 1;
+  const int num_bars = 390; // one bar per minute of a session
+
+  torch::manual_seed( 1 );
+  LSTM model( input_size, hidden_size, num_layers, output_size );
+  model->eval();
+
+  torch::Tensor bars = torch::randn( { 1, num_bars, input_size } );
+
+  // the whole sequence, as done now on each new bar
+  torch::Tensor full;
+  {
+    torch::NoGradGuard no_grad;
+    LSTMImpl::state_t state = model->init_hidden( 1 );
+    const auto start( std::chrono::steady_clock::now() );
+    full = model->forward( bars, state );
+    std::cout
+      << "full sequence of " << num_bars << " bars: "
+      << std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count() << "us"
+      << std::endl;
+  }
+  auto full_a = full.accessor<float, 3>();
+
+  // one step per bar, with a checkpoint at mid session
+  LSTMStream stream( model );
+  LSTMStream::Checkpoint checkpoint;
+  std::vector<float> step_outputs;
+  const float* bar = bars.data_ptr<float>();
+  float max_diff {};
+  for ( int ix = 0; ix < num_bars; ++ix ) {
+    if ( num_bars / 2 == ix ) stream.Save( checkpoint );
+    const float output = stream.Step( bar + ix * input_size )[ 0 ];
+    step_outputs.push_back( output );
+    max_diff = std::max( max_diff, std::abs( output - full_a[ 0 ][ ix ][ 0 ] ) );
+  }
+  const LSTMStream::Latency& latency( stream.GetLatency() );
+  std::cout
+    << "stepped " << latency.nSteps << " bars, max difference to full sequence " << max_diff
+    << ", step latency mean " << latency.dblMean << "us max " << latency.dblMax << "us"
+    << std::endl;
+
+  // restore the checkpoint, and through a file, the second half of the session replays exactly
+  int mismatches {};
+  stream.Restore( checkpoint );
+  for ( int ix = num_bars / 2; ix < num_bars; ++ix ) {
+    if ( step_outputs[ ix ] != stream.Step( bar + ix * input_size )[ 0 ] ) ++mismatches;
+  }
+  const std::string sFileName( "TorchTest_Stream.pt" );
+  stream.Restore( checkpoint );
+  stream.Save( sFileName );
+  stream.Reset();
+  stream.Load( sFileName );
+  std::remove( sFileName.c_str() );
+  for ( int ix = num_bars / 2; ix < num_bars; ++ix ) {
+    if ( step_outputs[ ix ] != stream.Step( bar + ix * input_size )[ 0 ] ) ++mismatches;
+  }
+  std::cout << "restored replay mismatches " << mismatches << ", steps " << stream.Steps() << std::endl;
+
+}
@@ -1,2 +1,3 @@
 void TorchTest_v1();
 void TorchTest_v2();
+void TorchTest_Stream();
@@ -0,0 +1,166 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    AhoCorasick.cpp
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created: 2026
+ */
+
+#include <limits>
+#include <stdexcept>
+
+#include "AhoCorasick.h"
+
+namespace ou {
+
+AhoCorasick::AhoCorasick() {
+  Clear();
+}
+
+AhoCorasick::~AhoCorasick() {}
+
+void AhoCorasick::Clear() {
+  for ( unsigned int ix = 0; ix < 256; ix++ ) m_rClass[ ix ] = 0;
+  m_nStride = 1;
+  m_vNode.clear();
+  m_vNode.emplace_back( 0, 0, 0 );
+  m_vDelta.assign( m_nStride, 0 );
+  m_vMatch.assign( 1, 0 );
+  m_cntPatterns = 0;
+  m_bCompiled = true;
+}
+
+// a character new to the alphabet widens every row of the table by one column
+std::uint8_t AhoCorasick::Class( unsigned char ch ) {
+
+  if ( '\t' == ch ) ch = ' ';
+  if ( ( 'A' <= ch ) && ( 'Z' >= ch ) ) ch = ch - 'A' + 'a';
+
+  if ( 0 == m_rClass[ ch ] ) {
+    if ( std::numeric_limits<std::uint8_t>::max() == m_nStride ) {
+      throw std::runtime_error( "AhoCorasick: alphabet full" );
+    }
+    const std::uint32_t nStride( m_nStride + 1 );
+    std::vector<std::uint32_t> vDelta( m_vNode.size() * nStride, 0 );
+    for ( size_t ix = 0; ix < m_vNode.size(); ix++ ) {
+      std::copy( &m_vDelta[ ix * m_nStride ], &m_vDelta[ ix * m_nStride ] + m_nStride, &vDelta[ ix * nStride ] );
+    }
+    m_vDelta.swap( vDelta );
+
+    m_rClass[ ch ] = m_nStride;
+    if ( ' ' == ch ) m_rClass[ (unsigned char) '\t' ] = m_nStride;
+    if ( ( 'a' <= ch ) && ( 'z' >= ch ) ) m_rClass[ ch - 'a' + 'A' ] = m_nStride;
+    m_nStride = nStride;
+  }
+
+  return m_rClass[ ch ];
+}
+
+AhoCorasick::idPattern_t AhoCorasick::Add( const std::string& sPattern ) {
+
+  if ( sPattern.empty() ) {
+    throw std::invalid_argument( "AhoCorasick: zero length pattern" );
+  }
+
+  std::uint32_t ixNode {};
+  for ( const char ch: sPattern ) {
+    const std::uint32_t nClass( Class( ch ) );
+    const std::uint32_t ixChild( m_vDelta[ ixNode * m_nStride + nClass ] );
+    if ( Edge( ixNode, nClass, ixChild ) ) {
+      ixNode = ixChild;
+    }
+    else {
+      const std::uint32_t ixNew( m_vNode.size() );
+      m_vNode.emplace_back( ixNode, nClass, m_vNode[ ixNode ].nLength + 1 );
+      m_vDelta.resize( m_vNode.size() * m_nStride, 0 );
+      m_vDelta[ ixNode * m_nStride + nClass ] = ixNew;
+      ixNode = ixNew;
+    }
+  }
+
+  Node& node( m_vNode[ ixNode ] );
+  if ( !node.bPattern ) {
+    node.bPattern = true;
+    m_cntPatterns++;
+    m_bCompiled = false;
+  }
+  return ixNode;
+}
+
+AhoCorasick::idPattern_t AhoCorasick::Find( const std::string& sPattern ) const {
+  std::uint32_t ixNode {};
+  for ( const char ch: sPattern ) {
+    const std::uint32_t nClass( m_rClass[ (unsigned char) ch ] );
+    const std::uint32_t ixChild( m_vDelta[ ixNode * m_nStride + nClass ] );
+    if ( ( 0 == nClass ) || !Edge( ixNode, nClass, ixChild ) ) return 0;
+    ixNode = ixChild;
+  }
+  return m_vNode[ ixNode ].bPattern ? ixNode : 0;
+}
+
+void AhoCorasick::Remove( idPattern_t id ) {
+  assert( id < m_vNode.size() );
+  Node& node( m_vNode[ id ] );
+  if ( node.bPattern ) {
+    node.bPattern = false;
+    m_cntPatterns--;
+    m_bCompiled = false;
+  }
+}
+
+// breadth first, a node's failure target is shallower, so its row is complete by the time it is needed
+//   entries which are not trie edges are overwritten, so earlier compilations leave nothing behind
+void AhoCorasick::Compile() {
+
+  m_vMatch.assign( m_vNode.size(), 0 );
+
+  std::vector<std::uint32_t> vQueue;
+  vQueue.reserve( m_vNode.size() );
+
+  std::uint32_t* row( m_vDelta.data() );
+  for ( std::uint32_t nClass = 0; nClass < m_nStride; nClass++ ) {
+    const std::uint32_t ixChild( row[ nClass ] );
+    if ( Edge( 0, nClass, ixChild ) ) {
+      Node& child( m_vNode[ ixChild ] );
+      child.ixFail = 0;
+      child.ixNextMatch = 0;
+      m_vMatch[ ixChild ] = child.bPattern ? ixChild : 0;
+      vQueue.push_back( ixChild );
+    }
+    else row[ nClass ] = 0;
+  }
+
+  for ( size_t ixQueue = 0; ixQueue < vQueue.size(); ixQueue++ ) {
+    const std::uint32_t ixNode( vQueue[ ixQueue ] );
+    const std::uint32_t* rowFail( &m_vDelta[ m_vNode[ ixNode ].ixFail * m_nStride ] );
+    row = &m_vDelta[ ixNode * m_nStride ];
+    for ( std::uint32_t nClass = 0; nClass < m_nStride; nClass++ ) {
+      const std::uint32_t ixChild( row[ nClass ] );
+      if ( Edge( ixNode, nClass, ixChild ) ) {
+        Node& child( m_vNode[ ixChild ] );
+        child.ixFail = rowFail[ nClass ];
+        child.ixNextMatch = m_vMatch[ child.ixFail ];
+        m_vMatch[ ixChild ] = child.bPattern ? ixChild : child.ixNextMatch;
+        vQueue.push_back( ixChild );
+      }
+      else row[ nClass ] = rowFail[ nClass ];
+    }
+  }
+
+  m_bCompiled = true;
+}
+
+} // ou
@@ -0,0 +1,102 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    AhoCorasick.h
+ * Author:  raymond@burkholder.net
+ * Project: OUCommon
+ * Created: 2026
+ */
+
+#pragma once
+
+// Aho Corasick multi-pattern search, KeyWordMatch with the on-failure coding
+//   every occurrence of every pattern in one pass over the text, one table lookup per character
+//   matching is case insensitive, tabs match spaces
+//   the alphabet is only the characters used in the patterns, so a table row stays small
+//   patterns can be added and removed between searches, Compile then relinks the existing trie,
+//     removed patterns leave their nodes behind until Clear
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+
+namespace ou {
+
+class AhoCorasick {
+public:
+
+  using idPattern_t = std::uint32_t; // 0 is not a pattern, stable until Clear
+
+  AhoCorasick();
+  ~AhoCorasick();
+
+  idPattern_t Add( const std::string& ); // the same pattern, in any case, returns the same id
+  idPattern_t Find( const std::string& ) const; // 0 when not a pattern
+  void Remove( idPattern_t );
+  void Clear();
+
+  void Compile(); // required after Add/Remove before the next Search
+  bool Compiled() const { return m_bCompiled; }
+
+  size_t GetNodeCount() const { return m_vNode.size(); }
+  size_t GetPatternCount() const { return m_cntPatterns; }
+
+  // f( idPattern_t, const char* bgn, const char* end ) for each occurrence, in order of the end of the occurrence
+  template<typename F>
+  void Search( const char* bgn, const char* end, F&& f ) const {
+    assert( m_bCompiled );
+    const std::uint32_t* delta( m_vDelta.data() );
+    const std::uint32_t* match( m_vMatch.data() );
+    std::uint32_t ixState {};
+    for ( const char* p = bgn; p != end; p++ ) {
+      ixState = delta[ ixState * m_nStride + m_rClass[ (unsigned char) *p ] ];
+      for ( std::uint32_t ix = match[ ixState ]; 0 != ix; ix = m_vNode[ ix ].ixNextMatch ) {
+        f( ix, p + 1 - m_vNode[ ix ].nLength, p + 1 );
+      }
+    }
+  }
+
+protected:
+private:
+
+  struct Node {
+    std::uint32_t ixParent;
+    std::uint32_t ixFail; // longest proper suffix which is in the trie
+    std::uint32_t ixNextMatch; // next pattern on the suffix chain, for patterns only
+    std::uint32_t nLength; // depth
+    std::uint8_t nClass; // of the character into this node
+    bool bPattern;
+    Node( std::uint32_t ixParent_, std::uint8_t nClass_, std::uint32_t nLength_ )
+    : ixParent( ixParent_ ), ixFail {}, ixNextMatch {}, nLength( nLength_ ), nClass( nClass_ ), bPattern( false ) {}
+  };
+
+  bool m_bCompiled;
+  size_t m_cntPatterns;
+
+  std::uint8_t m_rClass[ 256 ]; // character to column, 0 is any character not in a pattern
+  std::uint32_t m_nStride; // columns
+
+  std::vector<Node> m_vNode; // 0 is the root
+  std::vector<std::uint32_t> m_vDelta; // m_vNode.size() x m_nStride, trie edges only until compiled
+  std::vector<std::uint32_t> m_vMatch; // first pattern on the suffix chain of a node, 0 when none
+
+  std::uint8_t Class( unsigned char ); // adds the character to the alphabet
+  bool Edge( std::uint32_t ixNode, std::uint32_t nClass, std::uint32_t ixChild ) const {
+    return ( 0 != ixChild ) && ( ixNode == m_vNode[ ixChild ].ixParent ) && ( nClass == m_vNode[ ixChild ].nClass );
+  }
+};
+
+} // ou
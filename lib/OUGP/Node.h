@@ -17,6 +17,7 @@
 #include <cassert>
 #include <sstream>
 #include <vector>
+#include <utility>
 #include <stdexcept>
 
 #include <boost/shared_ptr.hpp>
@@ -77,6 +78,12 @@ public:
 
   virtual void PreProcess( void ) {}; // used with Genetic Programming Module for initializating time series
 
+  // used by Program for terminals reading a data series, value at bar ix is what EvaluateDouble returns
+  //   when the series holds ix + 1 entries
+  typedef std::pair<const void*, const void*> ColumnKey_t; // data source, field
+  virtual bool ColumnKey( ColumnKey_t& ) const { return false; };
+  virtual void FillColumn( std::vector<double>& ) const {};
+
 protected:
 
   NodeType::E m_ReturnType;
@@ -0,0 +1,334 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Program.cpp
+ * Author:  raymond@burkholder.net
+ * Project: OUGP
+ * Created: 2026
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "RootNode.h"
+#include "NodeDouble.h"
+#include "NodeBoolean.h"
+#include "NodeCompare.h"
+
+#include "Program.h"
+
+namespace ou { // One Unified
+namespace gp { // genetic programming
+
+namespace {
+  const size_t c_nBlock( 256 ); // bars per pass over the program, keeps the stack in cache
+}
+
+// ********* ColumnSet *********
+
+ColumnSet::ColumnSet( void ) {
+}
+
+ColumnSet::~ColumnSet( void ) {
+}
+
+size_t ColumnSet::Register( const Node& node ) {
+  Node::ColumnKey_t key;
+  if ( !node.ColumnKey( key ) ) {
+    throw std::runtime_error( "ColumnSet::Register: node is not a column" );
+  }
+  mapKey_t::iterator iter = m_mapKey.find( key );
+  if ( m_mapKey.end() == iter ) {
+    const size_t ix( m_vColumn.size() );
+    m_vColumn.emplace_back( std::vector<double>() );
+    node.FillColumn( m_vColumn.back() );
+    iter = m_mapKey.insert( mapKey_t::value_type( key, ix ) ).first;
+  }
+  return iter->second;
+}
+
+size_t ColumnSet::Bars( void ) const {
+  if ( m_vColumn.empty() ) return 0;
+  size_t nBars( std::numeric_limits<size_t>::max() );
+  for ( const std::vector<double>& column: m_vColumn ) {
+    nBars = std::min( nBars, column.size() );
+  }
+  return nBars;
+}
+
+void ColumnSet::Clear( void ) {
+  m_mapKey.clear();
+  m_vColumn.clear();
+}
+
+// ********* Program *********
+
+struct Program::Fragment {
+  bool bConstant;
+  NodeType::E type;
+  vInstruction_t code;
+  size_t nDepth;
+  Fragment( void ): bConstant( false ), type( NodeType::Bool ), nDepth( 0 ) {};
+  void Append( const Fragment& rhs ) {
+    code.insert( code.end(), rhs.code.begin(), rhs.code.end() );
+  }
+};
+
+Program::Program( void )
+: m_ReturnType( NodeType::Bool ), m_nStackDepth( 0 )
+{
+}
+
+Program::~Program( void ) {
+}
+
+void Program::Compile( Node& node, ColumnSet& columns ) {
+  m_vInstruction.clear();
+  m_vConstant.clear();
+  Fragment fragment;
+  if ( 0 != dynamic_cast<RootNode*>( &node ) ) {
+    Compile( node.ChildCenter(), columns, fragment );
+  }
+  else {
+    Compile( node, columns, fragment );
+  }
+  m_ReturnType = fragment.type;
+  m_vInstruction.swap( fragment.code );
+  m_nStackDepth = fragment.nDepth;
+}
+
+void Program::Constant( double value, Fragment& fragment ) {
+  fragment.bConstant = true;
+  fragment.code.clear();
+  fragment.code.emplace_back( Instruction( EOp::Constant, m_vConstant.size() ) );
+  fragment.nDepth = 1;
+  m_vConstant.push_back( value );
+}
+
+void Program::Compile( Node& node, ColumnSet& columns, Fragment& fragment ) {
+
+  fragment.type = node.ReturnType();
+
+  switch ( node.NodeCount() ) {
+    case 0: {
+        Node::ColumnKey_t key;
+        if ( node.ColumnKey( key ) ) {
+          fragment.bConstant = false;
+          fragment.code.emplace_back( Instruction( EOp::Column, columns.Register( node ) ) );
+          fragment.nDepth = 1;
+        }
+        else
+        if ( ( 0 != dynamic_cast<NodeDoubleZero*>( &node ) ) || ( 0 != dynamic_cast<NodeDoubleRandom*>( &node ) ) ) {
+          Constant( node.EvaluateDouble(), fragment );
+        }
+        else
+        if ( ( 0 != dynamic_cast<NodeBooleanTrue*>( &node ) ) || ( 0 != dynamic_cast<NodeBooleanFalse*>( &node ) ) ) {
+          Constant( node.EvaluateBoolean() ? 1.0 : 0.0, fragment );
+        }
+        else {
+          throw std::runtime_error( "Program::Compile: unknown terminal" );
+        }
+      }
+      break;
+    case 1: {
+        EOp op;
+        if ( 0 != dynamic_cast<NodeDoubleAbs*>( &node ) ) op = EOp::Abs;
+        else
+        if ( 0 != dynamic_cast<NodeBooleanNot*>( &node ) ) op = EOp::Not;
+        else {
+          throw std::runtime_error( "Program::Compile: unknown single node" );
+        }
+        Fragment child;
+        Compile( node.ChildCenter(), columns, child );
+        if ( child.bConstant ) {
+          Constant( ( EOp::Abs == op ) ? node.EvaluateDouble() : ( node.EvaluateBoolean() ? 1.0 : 0.0 ), fragment );
+        }
+        else
+        if ( ( EOp::Not == op ) && ( EOp::Not == child.code.back().op ) ) { // !!x is x
+          child.code.pop_back();
+          fragment.code.swap( child.code );
+          fragment.nDepth = child.nDepth;
+        }
+        else {
+          fragment.code.swap( child.code );
+          fragment.code.emplace_back( Instruction( op ) );
+          fragment.nDepth = child.nDepth;
+        }
+      }
+      break;
+    case 2: {
+        EOp op;
+        if ( 0 != dynamic_cast<NodeDoubleAdd*>( &node ) ) op = EOp::Add;
+        else if ( 0 != dynamic_cast<NodeDoubleSub*>( &node ) ) op = EOp::Sub;
+        else if ( 0 != dynamic_cast<NodeDoubleMlt*>( &node ) ) op = EOp::Mlt;
+        else if ( 0 != dynamic_cast<NodeDoubleDvd*>( &node ) ) op = EOp::Dvd;
+        else if ( 0 != dynamic_cast<NodeCompareGT*>( &node ) ) op = EOp::GT;
+        else if ( 0 != dynamic_cast<NodeCompareGE*>( &node ) ) op = EOp::GE;
+        else if ( 0 != dynamic_cast<NodeCompareLT*>( &node ) ) op = EOp::LT;
+        else if ( 0 != dynamic_cast<NodeCompareLE*>( &node ) ) op = EOp::LE;
+        else if ( 0 != dynamic_cast<NodeBooleanAnd*>( &node ) ) op = EOp::And;
+        else if ( 0 != dynamic_cast<NodeBooleanOr*>( &node ) ) op = EOp::Or;
+        else {
+          throw std::runtime_error( "Program::Compile: unknown node" );
+        }
+
+        Fragment left;
+        Compile( node.ChildLeft(), columns, left );
+        Fragment right;
+        Compile( node.ChildRight(), columns, right );
+
+        if ( left.bConstant && right.bConstant ) {
+          Constant( ( NodeType::Double == fragment.type ) ? node.EvaluateDouble() : ( node.EvaluateBoolean() ? 1.0 : 0.0 ), fragment );
+          // the children's constants are left unused in m_vConstant
+          break;
+        }
+
+        if ( ( EOp::And == op ) || ( EOp::Or == op ) ) {
+          // the operands have no side effects, so a constant operand decides or drops out
+          const double dominant( ( EOp::And == op ) ? 0.0 : 1.0 );
+          Fragment* pConstant( left.bConstant ? &left : ( right.bConstant ? &right : 0 ) );
+          if ( 0 != pConstant ) {
+            const double value( m_vConstant[ pConstant->code.front().arg ] );
+            if ( dominant == value ) {
+              Constant( value, fragment );
+            }
+            else {
+              Fragment& other( left.bConstant ? right : left );
+              fragment.code.swap( other.code );
+              fragment.nDepth = other.nDepth;
+            }
+            break;
+          }
+        }
+
+        fragment.bConstant = false;
+        fragment.code.swap( left.code );
+        fragment.Append( right );
+        fragment.code.emplace_back( Instruction( op ) );
+        fragment.nDepth = std::max( left.nDepth, right.nDepth + 1 );
+      }
+      break;
+  }
+}
+
+void Program::Evaluate( const ColumnSet& columns, std::vector<double>& vResult ) const {
+
+  const size_t nBars( columns.Bars() );
+  vResult.resize( nBars );
+
+  if ( m_vInstruction.empty() ) return;
+
+  std::vector<double> vStack( m_nStackDepth * c_nBlock );
+  double* const rStack( vStack.data() );
+
+  for ( size_t ixBar = 0; ixBar < nBars; ixBar += c_nBlock ) {
+
+    const size_t n( std::min( c_nBlock, nBars - ixBar ) );
+    size_t nTop( 0 ); // entries on the stack, each entry is a block of bars
+
+    for ( const Instruction& instruction: m_vInstruction ) {
+      double* top( rStack + ( nTop - 1 ) * c_nBlock ); // the operand of a single node, right operand otherwise
+      double* a( top - c_nBlock ); // left operand, result
+      const double* b( top );
+      switch ( instruction.op ) {
+        case EOp::Constant:
+          top += c_nBlock;
+          std::fill( top, top + n, m_vConstant[ instruction.arg ] );
+          nTop++;
+          break;
+        case EOp::Column: {
+            const double* column( columns.Column( instruction.arg ) + ixBar );
+            top += c_nBlock;
+            std::copy( column, column + n, top );
+            nTop++;
+          }
+          break;
+        case EOp::Abs:
+          for ( size_t ix = 0; ix < n; ix++ ) top[ ix ] = std::abs( top[ ix ] );
+          break;
+        case EOp::Not:
+          for ( size_t ix = 0; ix < n; ix++ ) top[ ix ] = ( 0.0 == top[ ix ] ) ? 1.0 : 0.0;
+          break;
+        case EOp::Add:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = a[ ix ] + b[ ix ];
+          nTop--;
+          break;
+        case EOp::Sub:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = a[ ix ] - b[ ix ];
+          nTop--;
+          break;
+        case EOp::Mlt:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = a[ ix ] * b[ ix ];
+          nTop--;
+          break;
+        case EOp::Dvd: // as NodeDoubleDvd
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = ( 0.0 == b[ ix ] ) ? HUGE_VAL : a[ ix ] / b[ ix ];
+          nTop--;
+          break;
+        case EOp::GT:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = ( a[ ix ] > b[ ix ] ) ? 1.0 : 0.0;
+          nTop--;
+          break;
+        case EOp::GE:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = ( a[ ix ] >= b[ ix ] ) ? 1.0 : 0.0;
+          nTop--;
+          break;
+        case EOp::LT:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = ( a[ ix ] < b[ ix ] ) ? 1.0 : 0.0;
+          nTop--;
+          break;
+        case EOp::LE:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = ( a[ ix ] <= b[ ix ] ) ? 1.0 : 0.0;
+          nTop--;
+          break;
+        case EOp::And:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = ( ( 0.0 != a[ ix ] ) && ( 0.0 != b[ ix ] ) ) ? 1.0 : 0.0;
+          nTop--;
+          break;
+        case EOp::Or:
+          for ( size_t ix = 0; ix < n; ix++ ) a[ ix ] = ( ( 0.0 != a[ ix ] ) || ( 0.0 != b[ ix ] ) ) ? 1.0 : 0.0;
+          nTop--;
+          break;
+      }
+    }
+
+    assert( 1 == nTop );
+    std::copy( rStack, rStack + n, vResult.begin() + ixBar );
+  }
+}
+
+void Program::ToString( std::stringstream& ss ) const {
+  static const char* rName[] = {
+    "const", "column", "abs", "+", "-", "*", "/", ">", ">=", "<", "<=", "!", "&&", "||"
+  };
+  for ( const Instruction& instruction: m_vInstruction ) {
+    ss << rName[ static_cast<size_t>( instruction.op ) ];
+    switch ( instruction.op ) {
+      case EOp::Constant:
+        ss << '(' << m_vConstant[ instruction.arg ] << ')';
+        break;
+      case EOp::Column:
+        ss << '(' << instruction.arg << ')';
+        break;
+      default:
+        break;
+    }
+    ss << ' ';
+  }
+}
+
+} // namespace gp
+} // namespace ou
@@ -0,0 +1,110 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Program.h
+ * Author:  raymond@burkholder.net
+ * Project: OUGP
+ * Created: 2026
+ */
+
+#pragma once
+
+// a tree flattened to postfix bytecode, evaluated over all bars of its columns at once
+//   constant sub-trees are folded by evaluating them with the tree itself,
+//   && and || with a constant operand are reduced, !! is removed
+//   results match Node::EvaluateBoolean / EvaluateDouble at each bar bit for bit,
+//   booleans are 0.0 / 1.0
+//   Compile throws std::runtime_error on a node type it does not know, the tree can still be used directly
+
+#include <map>
+#include <vector>
+#include <cstdint>
+
+#include "Node.h"
+
+namespace ou { // One Unified
+namespace gp { // genetic programming
+
+// data of the column terminals, shared by the programs of a population
+//   columns are aligned by bar index, Bars() is the shortest column
+class ColumnSet {
+public:
+
+  ColumnSet( void );
+  ~ColumnSet( void );
+
+  size_t Register( const Node& ); // a column terminal, the column is filled on first registration
+
+  size_t Columns( void ) const { return m_vColumn.size(); };
+  size_t Bars( void ) const;
+  const double* Column( size_t ix ) const { return m_vColumn[ ix ].data(); };
+
+  void Clear( void );
+
+protected:
+private:
+  typedef std::map<Node::ColumnKey_t, size_t> mapKey_t;
+  mapKey_t m_mapKey;
+  std::vector<std::vector<double> > m_vColumn;
+};
+
+class Program {
+public:
+
+  Program( void );
+  ~Program( void );
+
+  void Compile( Node&, ColumnSet& ); // a RootNode compiles its child
+
+  NodeType::E ReturnType( void ) const { return m_ReturnType; };
+  size_t Size( void ) const { return m_vInstruction.size(); };
+  size_t StackDepth( void ) const { return m_nStackDepth; };
+
+  void Evaluate( const ColumnSet&, std::vector<double>& vResult ) const; // one result per bar
+
+  void ToString( std::stringstream& ) const;
+
+protected:
+private:
+
+  enum class EOp: std::uint8_t {
+    Constant, Column, // push
+    Abs,
+    Add, Sub, Mlt, Dvd,
+    GT, GE, LT, LE,
+    Not, And, Or
+  };
+
+  struct Instruction {
+    EOp op;
+    std::uint32_t arg; // Constant: index into m_vConstant, Column: index into ColumnSet
+    Instruction( EOp op_, std::uint32_t arg_ = 0 ): op( op_ ), arg( arg_ ) {};
+  };
+
+  typedef std::vector<Instruction> vInstruction_t;
+
+  struct Fragment;
+
+  NodeType::E m_ReturnType;
+  vInstruction_t m_vInstruction;
+  std::vector<double> m_vConstant;
+  size_t m_nStackDepth;
+
+  void Compile( Node&, ColumnSet&, Fragment& );
+  void Constant( double, Fragment& );
+};
+
+} // namespace gp
+} // namespace ou
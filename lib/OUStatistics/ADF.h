@@ -1,4 +1,5 @@
 #pragma once
 
 void adfTest(double* x, int obs, int k, double* dfs, double* pv);
+double adfPValue(double tStatistic, int rows); // table lookup used by adfTest, rows in the regression
 
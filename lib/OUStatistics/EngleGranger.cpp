@@ -0,0 +1,143 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    EngleGranger.cpp
+ * Author:  raymond@burkholder.net
+ * Project: OUStatistics
+ * Created: 2026
+ */
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+
+#include "EngleGranger.h"
+
+namespace ou { // One Unified
+namespace statistics {
+
+EngleGranger::EngleGranger( int nObservations, int nLags )
+: m_nObservations( nObservations )
+, m_nLags( nLags )
+{
+  RollingADF adf( nObservations, nLags ); // validates the window against the lags
+}
+
+EngleGranger::~EngleGranger() {}
+
+EngleGranger::Moments EngleGranger::Window( const std::vector<double>& v ) const {
+
+  if ( v.size() < (size_t) m_nObservations ) {
+    throw std::runtime_error( "EngleGranger: series shorter than the window" );
+  }
+
+  Moments moments;
+  moments.p = v.data() + ( v.size() - m_nObservations );
+
+  double sum {};
+  for ( int ix = 0; ix < m_nObservations; ix++ ) sum += moments.p[ ix ];
+  moments.dblMean = sum / m_nObservations;
+
+  double sxx {};
+  for ( int ix = 0; ix < m_nObservations; ix++ ) {
+    const double d( moments.p[ ix ] - moments.dblMean );
+    sxx += d * d;
+  }
+  moments.dblSxx = sxx;
+
+  return moments;
+}
+
+void EngleGranger::Test( const Moments& y, const Moments& x, RollingADF& adf, std::vector<double>& vSpread, Result& result ) const {
+
+  // step 1, centered least squares
+  double sxy {};
+  for ( int ix = 0; ix < m_nObservations; ix++ ) {
+    sxy += ( x.p[ ix ] - x.dblMean ) * ( y.p[ ix ] - y.dblMean );
+  }
+  result.dblBeta = ( 0.0 == x.dblSxx ) ? 0.0 : sxy / x.dblSxx;
+  result.dblAlpha = y.dblMean - result.dblBeta * x.dblMean;
+
+  // step 2, the residual spread
+  vSpread.resize( m_nObservations );
+  for ( int ix = 0; ix < m_nObservations; ix++ ) {
+    vSpread[ ix ] = y.p[ ix ] - result.dblAlpha - result.dblBeta * x.p[ ix ];
+  }
+  adf.Assign( vSpread.data() );
+  result.adf = adf.Evaluate();
+}
+
+EngleGranger::Result EngleGranger::Test( const std::vector<double>& y, const std::vector<double>& x ) const {
+  Result result;
+  result.ixY = 0;
+  result.ixX = 1;
+  RollingADF adf( m_nObservations, m_nLags );
+  std::vector<double> vSpread;
+  Test( Window( y ), Window( x ), adf, vSpread, result );
+  return result;
+}
+
+void EngleGranger::Scan( const vSeries_t& vSeries, vResult_t& vResult, size_t nThreads ) const {
+
+  const size_t nSeries( vSeries.size() );
+
+  std::vector<Moments> vMoments;
+  vMoments.reserve( nSeries );
+  for ( const vSeries_t::value_type& v: vSeries ) {
+    vMoments.emplace_back( Window( v ) );
+  }
+
+  vResult.clear();
+  if ( 2 > nSeries ) return;
+  vResult.resize( nSeries * ( nSeries - 1 ) / 2 );
+  size_t ix {};
+  for ( size_t ixY = 0; ixY < nSeries; ixY++ ) {
+    for ( size_t ixX = ixY + 1; ixX < nSeries; ixX++ ) {
+      vResult[ ix ].ixY = ixY;
+      vResult[ ix ].ixX = ixX;
+      ix++;
+    }
+  }
+
+  // pairs are taken in blocks from a shared counter, each thread has its own regression state
+  static const size_t c_nBlock( 64 );
+  std::atomic<size_t> ixNext( 0 );
+  auto f =
+    [this,&vMoments,&vResult,&ixNext](){
+      RollingADF adf( m_nObservations, m_nLags );
+      std::vector<double> vSpread;
+      size_t ixBegin;
+      while ( ( ixBegin = ixNext.fetch_add( c_nBlock ) ) < vResult.size() ) {
+        const size_t ixEnd( std::min( ixBegin + c_nBlock, vResult.size() ) );
+        for ( size_t ix = ixBegin; ix < ixEnd; ix++ ) {
+          Result& result( vResult[ ix ] );
+          Test( vMoments[ result.ixY ], vMoments[ result.ixX ], adf, vSpread, result );
+        }
+      }
+    };
+
+  if ( 1 >= nThreads ) {
+    f();
+  }
+  else {
+    std::vector<std::thread> vThread;
+    for ( size_t ix = 0; ix < nThreads; ix++ ) vThread.emplace_back( f );
+    for ( std::thread& thread: vThread ) thread.join();
+  }
+}
+
+} // namespace statistics
+} // namespace ou
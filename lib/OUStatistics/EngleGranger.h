@@ -0,0 +1,77 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    EngleGranger.h
+ * Author:  raymond@burkholder.net
+ * Project: OUStatistics
+ * Created: 2026
+ */
+
+#pragma once
+
+// engle-granger two step over every pair of a universe
+//   step 1: y = alpha + beta * x by least squares over the window
+//   step 2: the adfTest regression on the residuals ( RollingADF::Assign )
+//   pairs are ( y, x ) with ixY < ixX, spread over nThreads, results are in pair order whatever the thread count
+//   pValue is the adfTest table value, it does not allow for the estimated beta, so it is optimistic,
+//     rank pairs by tStatistic ( more negative is stronger )
+
+#include <vector>
+
+#include "RollingADF.h"
+
+namespace ou { // One Unified
+namespace statistics {
+
+class EngleGranger {
+public:
+
+  struct Result {
+    size_t ixY;
+    size_t ixX;
+    double dblAlpha;
+    double dblBeta; // hedge ratio, units of x per unit of y
+    RollingADF::Result adf;
+    Result(): ixY {}, ixX {}, dblAlpha {}, dblBeta {} {}
+  };
+
+  using vSeries_t = std::vector<std::vector<double> >; // one series per symbol, aligned
+  using vResult_t = std::vector<Result>;
+
+  EngleGranger( int nObservations, int nLags ); // the last nObservations of each series are tested
+  ~EngleGranger();
+
+  void Scan( const vSeries_t&, vResult_t&, size_t nThreads = 1 ) const; // throws std::runtime_error on a short series
+
+  Result Test( const std::vector<double>& y, const std::vector<double>& x ) const; // one pair
+
+protected:
+private:
+
+  const int m_nObservations;
+  const int m_nLags;
+
+  struct Moments { // of a series over the window
+    const double* p;
+    double dblMean;
+    double dblSxx; // sum of squared deviations
+  };
+
+  Moments Window( const std::vector<double>& ) const;
+  void Test( const Moments& y, const Moments& x, RollingADF&, std::vector<double>& vSpread, Result& ) const;
+};
+
+} // namespace statistics
+} // namespace ou
@@ -0,0 +1,280 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    RollingADF.cpp
+ * Author:  raymond@burkholder.net
+ * Project: OUStatistics
+ * Created: 2026
+ */
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <stdexcept>
+
+#include "ADF.h"
+#include "RollingADF.h"
+
+namespace {
+  // a downdate leaving less than this fraction of a diagonal has lost too many digits, rebuild instead
+  const double c_dblDowndateLimit( 1e-8 );
+}
+
+namespace ou { // One Unified
+namespace statistics {
+
+RollingADF::RollingADF( int nObservations, int nLags )
+: m_nLags( nLags )
+, m_nCols( nLags + 3 )
+, m_nRowsInWindow( nObservations - ( nLags + 1 ) )
+, m_nStride( nLags + 4 )
+, m_nX {}
+, m_ixRowOldest {}, m_nRows {}
+, m_nSinceRebuild {}
+, m_dblOriginLevel {}, m_dblOriginTrend {}
+{
+  if ( 0 > nLags ) {
+    throw std::runtime_error( "RollingADF: negative lags" );
+  }
+  if ( m_nRowsInWindow <= m_nCols ) {
+    throw std::runtime_error( "RollingADF: window too short for the lags" );
+  }
+  m_vX.resize( m_nLags + 2 );
+  m_vRow.resize( m_nRowsInWindow * m_nStride );
+  m_vR.resize( m_nStride * m_nStride );
+  m_vScratch.resize( 3 * m_nStride ); // rotation vector, solve, new row
+}
+
+RollingADF::~RollingADF() {}
+
+void RollingADF::Reset() {
+  m_nX = 0;
+  m_ixRowOldest = 0;
+  m_nRows = 0;
+  m_nSinceRebuild = 0;
+  std::fill( m_vR.begin(), m_vR.end(), 0.0 );
+}
+
+// the row for the newest value, as built by adfTest, nullptr until x(t-k-1) is available
+const double* RollingADF::Push( double x ) {
+
+  const int nRing( m_vX.size() );
+  m_vX[ m_nX % nRing ] = x;
+  m_nX++;
+
+  if ( m_nX < (std::uint64_t) nRing ) return nullptr;
+
+  auto X = // x( t - j )
+    [this,nRing]( int j )->double { return m_vX[ ( m_nX - 1 - j ) % nRing ]; };
+
+  double* row( m_vScratch.data() + 2 * m_nStride );
+  row[ 0 ] = 1.0;
+  row[ 1 ] = X( 1 );
+  row[ 2 ] = (double) ( m_nX - 1 );
+  for ( int j = 1; j <= m_nLags; j++ ) {
+    row[ 2 + j ] = X( j ) - X( j + 1 );
+  }
+  row[ m_nCols ] = X( 0 ) - X( 1 );
+
+  return row;
+}
+
+void RollingADF::Append( double x ) {
+
+  const double* row( Push( x ) );
+  if ( nullptr == row ) return;
+
+  if ( 0 == m_nRows ) {
+    m_dblOriginLevel = row[ 1 ];
+    m_dblOriginTrend = row[ 2 ];
+  }
+
+  bool bOk( true );
+  int ixRow;
+  if ( m_nRows == m_nRowsInWindow ) {
+    ixRow = m_ixRowOldest;
+    bOk = Downdate( &m_vRow[ ixRow * m_nStride ] );
+    m_ixRowOldest = ( m_ixRowOldest + 1 ) % m_nRowsInWindow;
+    m_nSinceRebuild++;
+  }
+  else {
+    ixRow = ( m_ixRowOldest + m_nRows ) % m_nRowsInWindow;
+    m_nRows++;
+  }
+  std::copy( row, row + m_nStride, &m_vRow[ ixRow * m_nStride ] );
+
+  if ( !bOk || ( m_nSinceRebuild >= m_nRowsInWindow ) ) {
+    Rebuild();
+  }
+  else {
+    Update( row );
+  }
+}
+
+// a whole window at once: the cross products of [ X | y ], then one cholesky factorization
+//   fewer operations than rotating in each row, falls back to Rebuild when X is (nearly) singular
+void RollingADF::Assign( const double* x ) {
+
+  Reset();
+
+  const int nObservations( m_nRowsInWindow + m_nLags + 1 );
+  for ( int ix = 0; ix < nObservations; ix++ ) {
+    const double* row( Push( x[ ix ] ) );
+    if ( nullptr != row ) {
+      std::copy( row, row + m_nStride, &m_vRow[ m_nRows * m_nStride ] );
+      m_nRows++;
+    }
+  }
+  assert( m_nRows == m_nRowsInWindow );
+
+  m_dblOriginLevel = m_vRow[ 1 ];
+  m_dblOriginTrend = m_vRow[ 2 ];
+
+  double* G( m_vR.data() ); // upper triangle, factored in place
+  double* v( m_vScratch.data() );
+  for ( int ixRow = 0; ixRow < m_nRows; ixRow++ ) {
+    Relative( &m_vRow[ ixRow * m_nStride ], v );
+    for ( int i = 0; i < m_nStride; i++ ) {
+      double* gi( G + i * m_nStride );
+      const double vi( v[ i ] );
+      for ( int j = i; j < m_nStride; j++ ) gi[ j ] += vi * v[ j ];
+    }
+  }
+
+  for ( int i = 0; i < m_nStride; i++ ) {
+    double* ri( G + i * m_nStride );
+    const double gii( ri[ i ] );
+    double d( gii );
+    for ( int k = 0; k < i; k++ ) d -= G[ k * m_nStride + i ] * G[ k * m_nStride + i ];
+    if ( i == m_nCols ) { // residual sum of squares, may round below zero on an exact fit
+      ri[ i ] = std::sqrt( std::max( d, 0.0 ) );
+      break;
+    }
+    if ( d <= c_dblDowndateLimit * gii ) {
+      Rebuild();
+      return;
+    }
+    ri[ i ] = std::sqrt( d );
+    for ( int j = i + 1; j < m_nStride; j++ ) {
+      double sum( ri[ j ] );
+      for ( int k = 0; k < i; k++ ) sum -= G[ k * m_nStride + i ] * G[ k * m_nStride + j ];
+      ri[ j ] = sum / ri[ i ];
+    }
+  }
+}
+
+void RollingADF::Relative( const double* row, double* v ) const {
+  std::copy( row, row + m_nStride, v );
+  v[ 1 ] -= m_dblOriginLevel;
+  v[ 2 ] -= m_dblOriginTrend;
+}
+
+// refactor the rows in the window, with the origin at the oldest row
+void RollingADF::Rebuild() {
+  std::fill( m_vR.begin(), m_vR.end(), 0.0 );
+  const double* pOldest( &m_vRow[ m_ixRowOldest * m_nStride ] );
+  m_dblOriginLevel = pOldest[ 1 ];
+  m_dblOriginTrend = pOldest[ 2 ];
+  for ( int ix = 0; ix < m_nRows; ix++ ) {
+    Update( &m_vRow[ ( ( m_ixRowOldest + ix ) % m_nRowsInWindow ) * m_nStride ] );
+  }
+  m_nSinceRebuild = 0;
+}
+
+// R'R' = R'R + vv', givens rotations
+void RollingADF::Update( const double* row ) {
+  double* v( m_vScratch.data() );
+  Relative( row, v );
+  for ( int k = 0; k < m_nStride; k++ ) {
+    if ( 0.0 == v[ k ] ) continue;
+    double* rk( &m_vR[ k * m_nStride ] );
+    const double r( std::sqrt( rk[ k ] * rk[ k ] + v[ k ] * v[ k ] ) ); // values are well scaled, hypot is slow
+    const double c( rk[ k ] / r );
+    const double s( v[ k ] / r );
+    rk[ k ] = r;
+    for ( int j = k + 1; j < m_nStride; j++ ) {
+      const double rkj( rk[ j ] );
+      rk[ j ] = c * rkj + s * v[ j ];
+      v[ j ] = c * v[ j ] - s * rkj;
+    }
+  }
+}
+
+// R'R' = R'R - vv', hyperbolic rotations, false when the result is not safely positive definite
+bool RollingADF::Downdate( const double* row ) {
+  double* v( m_vScratch.data() );
+  Relative( row, v );
+  for ( int k = 0; k < m_nStride; k++ ) {
+    double* rk( &m_vR[ k * m_nStride ] );
+    const double rkk( rk[ k ] );
+    const double d( ( rkk - v[ k ] ) * ( rkk + v[ k ] ) );
+    if ( d <= c_dblDowndateLimit * rkk * rkk ) return false;
+    const double r( std::sqrt( d ) );
+    const double c( r / rkk );
+    const double s( v[ k ] / rkk );
+    rk[ k ] = r;
+    for ( int j = k + 1; j < m_nStride; j++ ) {
+      rk[ j ] = ( rk[ j ] - s * v[ j ] ) / c;
+      v[ j ] = c * v[ j ] - s * rk[ j ];
+    }
+  }
+  return true;
+}
+
+// t-statistic of the x(t-1) coefficient, as adfTest
+RollingADF::Result RollingADF::Evaluate() const {
+
+  Result result;
+
+  const int df( m_nRows - m_nCols );
+  if ( 0 >= df ) return result;
+
+  const int n( m_nCols );
+  auto R = [this]( int i, int j )->double { return m_vR[ i * m_nStride + j ]; };
+
+  for ( int i = 0; i < n; i++ ) {
+    if ( 0.0 == R( i, i ) ) return result; // singular, eg, a constant series
+  }
+
+  // beta: R beta = z, z is the y column of the factor
+  double* beta( m_vScratch.data() );
+  for ( int i = n - 1; i >= 0; i-- ) {
+    double sum( R( i, n ) );
+    for ( int j = i + 1; j < n; j++ ) sum -= R( i, j ) * beta[ j ];
+    beta[ i ] = sum / R( i, i );
+  }
+
+  // ( X'X )^-1 (1,1) = | w |^2, R' w = e1
+  double* w( m_vScratch.data() + m_nStride );
+  double dblInverse {};
+  for ( int j = 1; j < n; j++ ) {
+    double sum( 1 == j ? 1.0 : 0.0 );
+    for ( int i = 1; i < j; i++ ) sum -= R( i, j ) * w[ i ];
+    w[ j ] = sum / R( j, j );
+    dblInverse += w[ j ] * w[ j ];
+  }
+
+  const double rss( R( n, n ) * R( n, n ) );
+  const double sigma2( rss / df );
+  const double se( std::sqrt( dblInverse * sigma2 ) );
+  if ( 0.0 == se ) return result;
+
+  result.tStatistic = beta[ 1 ] / se;
+  result.pValue = adfPValue( result.tStatistic, m_nRows );
+  return result;
+}
+
+} // namespace statistics
+} // namespace ou
@@ -0,0 +1,88 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    RollingADF.h
+ * Author:  raymond@burkholder.net
+ * Project: OUStatistics
+ * Created: 2026
+ */
+
+#pragma once
+
+// adfTest over a sliding window, updated per value
+//   the regression is the one in adfTest: dx(t) on 1, x(t-1), t, dx(t-1) .. dx(t-k)
+//   the triangular factor of [ X | y ] is kept, a new row is rotated in, the oldest row is rotated out,
+//     so a step is O( cols^2 ) rather than a rebuild of the window
+//   Assign factors a whole window from its cross products, for one off tests such as EngleGranger
+//   the trend and level columns are kept relative to an origin, which moves when the factor is rebuilt
+//     ( once per window, or when a downdate loses definiteness ), the t-statistic of x(t-1) does not depend on it
+//   agrees with adfTest on the same window to rounding
+
+#include <vector>
+#include <cstdint>
+
+namespace ou { // One Unified
+namespace statistics {
+
+class RollingADF {
+public:
+
+  struct Result {
+    double tStatistic;
+    double pValue; // adfPValue
+    Result(): tStatistic {}, pValue( 1.0 ) {}
+  };
+
+  RollingADF( int nObservations, int nLags ); // as adfTest( x, nObservations, nLags, ... )
+  ~RollingADF();
+
+  void Append( double x );
+  void Assign( const double* x ); // replaces the window with nObservations values, Append continues from there
+  void Reset();
+
+  bool Ready() const { return m_nRows == m_nRowsInWindow; } // a full window
+  Result Evaluate() const; // of the current window, once Ready
+
+protected:
+private:
+
+  const int m_nLags;
+  const int m_nCols; // regressors
+  const int m_nRowsInWindow;
+  const int m_nStride; // m_nCols + 1, the row and y
+
+  std::vector<double> m_vX; // the last m_nLags + 1 values, ring
+  std::uint64_t m_nX; // values appended
+
+  std::vector<double> m_vRow; // rows in the window, ring, level and trend are absolute
+  int m_ixRowOldest;
+  int m_nRows;
+
+  int m_nSinceRebuild;
+  double m_dblOriginLevel;
+  double m_dblOriginTrend;
+
+  std::vector<double> m_vR; // upper triangular, m_nStride x m_nStride, row major
+  mutable std::vector<double> m_vScratch;
+
+  const double* Push( double x );
+  void Rebuild();
+  void Update( const double* row );
+  bool Downdate( const double* row );
+  void Relative( const double* row, double* v ) const;
+};
+
+} // namespace statistics
+} // namespace ou
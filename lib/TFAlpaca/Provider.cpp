@@ -56,7 +56,6 @@ namespace {
 
 Provider::Provider()
 : ProviderInterface<Provider,Asset>()
-, m_kwmEvent( EEvent::unknown, 20 )
 , m_state( EState::start )
 , m_ssl_context( ssl::context::tlsv12_client )
 {
@@ -64,23 +63,6 @@ Provider::Provider()
   m_nID = keytypes::EProviderAlpaca;
   m_bProvidesBrokerInterface = true;
 
-  m_kwmEvent.AddPattern( "new", EEvent::new_ );
-  m_kwmEvent.AddPattern( "fill", EEvent::fill );
-  m_kwmEvent.AddPattern( "partial_fill", EEvent::partial_fill );
-  m_kwmEvent.AddPattern( "canceled", EEvent::canceled );
-  m_kwmEvent.AddPattern( "expired", EEvent::expired );
-  m_kwmEvent.AddPattern( "done_for_day", EEvent::done_for_day );
-  m_kwmEvent.AddPattern( "replaced", EEvent::replaced );
-  m_kwmEvent.AddPattern( "rejected", EEvent::rejected );
-  m_kwmEvent.AddPattern( "pending_new", EEvent::pending_new );
-  m_kwmEvent.AddPattern( "stopped", EEvent::stopped );
-  m_kwmEvent.AddPattern( "pending_cancel", EEvent::pending_cancel );
-  m_kwmEvent.AddPattern( "pending_replace", EEvent::pending_replace );
-  m_kwmEvent.AddPattern( "calculated", EEvent::calculated );
-  m_kwmEvent.AddPattern( "suspended", EEvent::suspended );
-  m_kwmEvent.AddPattern( "order_replace_rejected", EEvent::order_replace_rejected );
-  m_kwmEvent.AddPattern( "order_cancel_rejected", EEvent::order_cancel_rejected );
-
   if ( 0 == GetThreadCount() ) {
     SetThreadCount( 1 ); // need at least one thread for websocket processing
   }
@@ -288,219 +270,98 @@ void Provider::TradeUpdates() {
       m_bConnected = true;
       ProviderInterfaceBase::OnConnected( 0 );
     },
-    [this]( std::string&& sMessage){ // fMessage_t
-      //std::cout << "order update message: " << sMessage << std::endl;
-      json::error_code jec;
-      json::value jv = json::parse( sMessage, jec );
-      if ( jec.failed() ) {
-        BOOST_LOG_TRIVIAL(error) << "provider/alpaca failed to parse web_socket stream: " << sMessage;
+    [this]( std::string_view sFrame ){ // fMessage_t
+      //std::cout << "order update message: " << sFrame << std::endl;
+      if ( !m_decoder.Decode( sFrame, m_message ) ) {
+        BOOST_LOG_TRIVIAL(error) << "provider/alpaca failed to parse web_socket stream: " << sFrame;
       }
       else {
-
-        // TODO: encase in try/catch
-
-        struct Stream {
-          std::string sType;
-          json::object object;
-        } stream;
-
-        json::object const& obj = jv.as_object();
-        extract( obj, stream.sType, "stream" );
-        extract( obj, stream.object, "data" );
-
-        // todo use kvm or spirit to parse
-        bool bFound( false );
-
-        if ( "authorization" == stream.sType ) {
-          bFound = true;
-          BOOST_LOG_TRIVIAL(info) << "authorization: " << stream.object;
-          // {"stream":"authorization","data":{"action":"authenticate","status":"authorized"}}
-
-          struct Auth {
-            std::string sAction;
-            std::string sStatus;
-          } auth;
-
-          extract( stream.object, auth.sAction, "action" );
-          assert( "authenticate" == auth.sAction );
-          extract( stream.object, auth.sStatus, "status" );
-          assert( "authorized" == auth.sStatus );
-
-          m_state = EState::authorized;
-        }
-
-        if ( "listening" == stream.sType ) {
-          bFound = true;
-          BOOST_LOG_TRIVIAL(error) << "listening status: " << stream.object << std::endl;
-          // {"stream":"listening","data":{"streams":["trade_updates"]}}
-
-          json::array objStreams;
-          extract( stream.object, objStreams, "streams" );
-          //assert( "[\"trade_updates\"]" == json::to( objStreams ) );
-
-          m_state = EState::listening;
-        }
-
-        if ( "trade_updates" == stream.sType ) {
-          bFound = true;
-          std::cout << "trade update: " << stream.object << std::endl;
-          // {"stream":"trade_updates","data":{"event":"new",
-          // {"stream":"trade_updates","data":{"event":"fill",
-          TradeUpdate( stream.object );
-        }
-        if ( !bFound ) {
-          BOOST_LOG_TRIVIAL(warning) << "provider/alpaca unknown order update message: " << sMessage << std::endl;
+        switch ( m_message.eStream ) {
+          case stream::EStream::authorization:
+            // {"stream":"authorization","data":{"action":"authenticate","status":"authorized"}}
+            BOOST_LOG_TRIVIAL(info) << "authorization: " << m_message.action.view() << "," << m_message.status.view();
+            assert( m_message.action == "authenticate" );
+            assert( m_message.status == "authorized" );
+            m_state = EState::authorized;
+            break;
+          case stream::EStream::listening:
+            // {"stream":"listening","data":{"streams":["trade_updates"]}}
+            BOOST_LOG_TRIVIAL(info) << "listening status: " << m_message.nStreams << " streams, trade_updates " << m_message.bTradeUpdates;
+            m_state = EState::listening;
+            break;
+          case stream::EStream::trade_updates:
+            // {"stream":"trade_updates","data":{"event":"new",
+            // {"stream":"trade_updates","data":{"event":"fill",
+            std::cout << "trade update: " << sFrame << std::endl;
+            TradeUpdate( m_message );
+            break;
+          case stream::EStream::unknown:
+            BOOST_LOG_TRIVIAL(warning) << "provider/alpaca unknown order update message: " << sFrame << std::endl;
+            break;
         }
       }
     }
   );
 }
 
-void Provider::TradeUpdate( const json::object& obj ) {
-
-  struct Update {
-    std::string id;
-    std::string event;
-    std::string execution_id;
-    std::string timestamp;
-
-    std::string position_qty;
-    std::string price;
-    std::string qty;
-  } update;
-
-  //json::value order;
-  order::Status status;
+void Provider::TradeUpdate( const stream::Message& update ) {
 
-  extract( obj, update.event, "event" );
-  extract( obj, update.timestamp, "timestamp" );
-
-  EEvent event = m_kwmEvent.FindMatch( update.event );
-  switch ( event ) {
-    case EEvent::new_:
-      {
-        //extract( obj, update.id, "id" );
-        json::object order;
-        extract( obj, order, "order" );
-        //order::Decode( order, status ); // is the full decode necessary, just extract other desired fields?
-        std::string id;
-        extract( order, id, "id" );
-        //std::string sIdOrder;
-        //extract( order, sIdOrder, "client_order_id" );
-        //try {
-          ou::tf::Order::idOrder_t idOrder;
-          //idOrder = boost::lexical_cast<ou::tf::Order::idOrder_t>( status.client_order_id );
-
-          //umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( id );
-          //assert( m_umapOrderLookup.end() != iter );
-          //OrderManager::GlobalInstance().UpdateReference( iter->second, id );
-        //}
-        //catch ( boost::bad_lexical_cast& e ) {
-        //  std::cout << "alpaca provider: can not decode order " << status.client_order_id << std::endl;
-        //}
-      }
+  switch ( update.eEvent ) {
+    case stream::EEvent::new_:
+      // order reference is recorded at PlaceOrder
       break;
-    case EEvent::partial_fill:
+    case stream::EEvent::partial_fill:
+    case stream::EEvent::fill:
       {
-        json::value order;
-
-        extract( obj, update.qty, "qty" );
-        extract( obj, update.price, "price" );
-        extract( obj, update.execution_id, "execution_id" );
-
-        extract( obj, order, "order" );
-        order::Decode( order, status );
-        OrderSide::EOrderSide side( OrderSide::Unknown );
-        if ( "sell" == status.side ) side = OrderSide::Sell;
-        if ( "buy"  == status.side ) side = OrderSide::Buy;
-        auto price = boost::lexical_cast<double>( update.price );
-        auto volume = boost::lexical_cast<ou::tf::Price::volume_t>( update.qty );
-        ou::tf::Execution exec(
-          price,
-          volume,
-          side,
-          std::string( "alpaca" ),
-          update.execution_id
-        );
-        //ou::tf::Order::idOrder_t idOrder;
-        //idOrder = boost::lexical_cast<ou::tf::Order::idOrder_t>( status.client_order_id );
-        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( status.id );
-        if ( m_umapOrderLookup.end() != iter ) { // there may be unknown manual orders
-          OrderManager::GlobalInstance().ReportExecution( iter->second->GetOrderId(), exec );
-        }
-      }
-      break;
-    case EEvent::fill:
-      try {
-        json::value order; // TODO: use object instead like with new_?
-
-        extract( obj, update.qty, "qty" );
-        extract( obj, update.price, "price" );
-        extract( obj, update.execution_id, "execution_id" );
-
-        extract( obj, order, "order" );
-        order::Decode( order, status );
         OrderSide::EOrderSide side( OrderSide::Unknown );
-        if ( "sell" == status.side ) side = OrderSide::Sell;
-        if ( "buy"  == status.side ) side = OrderSide::Buy;
-        auto price = boost::lexical_cast<double>( update.price );
-        auto volume = boost::lexical_cast<ou::tf::Price::volume_t>( update.qty );
+        if ( update.order.side == "sell" ) side = OrderSide::Sell;
+        if ( update.order.side == "buy"  ) side = OrderSide::Buy;
         ou::tf::Execution exec(
-          price,
-          volume,
+          update.price,
+          static_cast<ou::tf::Price::volume_t>( update.qty ),
           side,
           std::string( "alpaca" ),
-          update.execution_id
+          std::string( update.execution_id.view() )
         );
-        //ou::tf::Order::idOrder_t idOrder;
-        //idOrder = boost::lexical_cast<ou::tf::Order::idOrder_t>( status.client_order_id );
-        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( status.id );
+        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( std::string( update.order.id.view() ) );
         if ( m_umapOrderLookup.end() != iter ) { // there may be unknown manual orders
           OrderManager::GlobalInstance().ReportExecution( iter->second->GetOrderId(), exec );
         }
       }
-      catch(...) {
-        BOOST_LOG_TRIVIAL(error) << "provider/alpaca EEVent::fill broke";
-      }
       break;
-    case EEvent::canceled:
+    case stream::EEvent::canceled:
       {
-        json::value order; // TODO: use object instead?
-        extract( obj, order, "order" );
-        order::Decode( order, status );
-        //ou::tf::Order::idOrder_t idOrder;
-        //idOrder = boost::lexical_cast<ou::tf::Order::idOrder_t>( status.client_order_id );
-        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( status.id );
+        umapOrderLookup_t::iterator iter = m_umapOrderLookup.find( std::string( update.order.id.view() ) );
         if ( m_umapOrderLookup.end() != iter ) { // there may be unknown manual orders
           OrderManager::GlobalInstance().ReportCancellation( iter->second->GetOrderId() );
         }
       }
       break;
-    case EEvent::expired:
+    case stream::EEvent::expired:
       //break;
-    case EEvent::done_for_day:
+    case stream::EEvent::done_for_day:
       //break;
-    case EEvent::replaced:
+    case stream::EEvent::replaced:
       //break;
-    case EEvent::rejected:
+    case stream::EEvent::rejected:
       //break;
-    case EEvent::pending_new:
+    case stream::EEvent::pending_new:
       //break;
-    case EEvent::stopped:
+    case stream::EEvent::stopped:
       //break;
-    case EEvent::pending_cancel:
+    case stream::EEvent::pending_cancel:
       //break;
-    case EEvent::pending_replace:
+    case stream::EEvent::pending_replace:
       //break;
-    case EEvent::calculated:
+    case stream::EEvent::calculated:
       //break;
-    case EEvent::suspended:
+    case stream::EEvent::suspended:
       //break;
-    case EEvent::order_replace_rejected:
+    case stream::EEvent::order_replace_rejected:
       //break;
-    case EEvent::order_cancel_rejected:
+    case stream::EEvent::order_cancel_rejected:
       //break;
-    case EEvent::unknown:
+    case stream::EEvent::unknown:
       assert( false ); // fix as they occur
       break;
   }
@@ -28,21 +28,14 @@
 
 #include <boost/asio/ssl.hpp>
 
-#include <OUCommon/KeyWordMatch.h>
-
 #include <TFTrading/ProviderInterface.h>
 
 #include "Asset.hpp"
+#include "Stream.hpp"
 
 namespace asio = boost::asio; // from <boost/asio.hpp>
 namespace ssl  = asio::ssl;   // from <boost/asio/ssl.hpp>
 
-namespace boost {
-namespace json {
-  class object;
-}
-}
-
 namespace ou {
 namespace tf {
 namespace alpaca {
@@ -93,14 +86,9 @@ private:
 
   enum EState { start, connect, authorized, listening, error } m_state;
 
-  // https://alpaca.markets/deprecated/docs/api-documentation/api-v2/streaming/
-  enum EEvent { new_, fill, partial_fill, canceled, expired, done_for_day
-              , replaced, rejected, pending_new, stopped, pending_cancel
-              , pending_replace, calculated, suspended
-              , order_replace_rejected, order_cancel_rejected
-              , unknown };
-
-  ou::KeyWordMatch<EEvent> m_kwmEvent;
+  // web_socket frames are decoded in place, both are used only on the web_socket strand
+  stream::Decoder m_decoder;
+  stream::Message m_message;
 
   ssl::context m_ssl_context;
 
@@ -139,7 +127,7 @@ private:
   void Positions();
   void TradeUpdates();
 
-  void TradeUpdate( const boost::json::object& obj );
+  void TradeUpdate( const stream::Message& );
 
 };
 
@@ -0,0 +1,285 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Stream.cpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFAlpaca
+ * Created: 2026
+ */
+
+#include <cstdlib>
+#include <cstdint>
+
+#include <boost/json/basic_parser_impl.hpp> // instantiates basic_parser for the handler below
+
+#include "Stream.hpp"
+
+namespace json = boost::json;
+
+namespace ou {
+namespace tf {
+namespace alpaca {
+namespace stream {
+
+namespace {
+
+  // a sample trade update, other keys in 'data' and 'order' are skipped:
+  // {"stream":"trade_updates","data":{"event":"fill","execution_id":"8ed5bc3f-...","order":{
+  //   "id":"61e69015-...","client_order_id":"1045","symbol":"SPY","side":"buy","type":"limit",
+  //   "status":"filled","filled_qty":"100","filled_avg_price":"409.01",...},
+  //   "position_qty":"100","price":"409.01","qty":"100","timestamp":"2023-02-13T15:17:08.126Z"}}
+
+  enum class EScope: std::uint8_t { other, root, data, order, streams };
+
+  enum class EField: std::uint8_t {
+    none, stream, data, action, status, streams, event, timestamp, execution_id,
+    price, qty, position_qty, order,
+    order_id, order_client_order_id, order_symbol, order_side, order_status, order_type
+  };
+
+  struct Key {
+    std::string_view sKey;
+    EField eField;
+  };
+
+  const Key c_rKeyRoot[] = {
+    { "stream", EField::stream }, { "data", EField::data }
+  };
+
+  const Key c_rKeyData[] = {
+    { "event", EField::event }, { "order", EField::order },
+    { "price", EField::price }, { "qty", EField::qty },
+    { "execution_id", EField::execution_id }, { "timestamp", EField::timestamp },
+    { "position_qty", EField::position_qty },
+    { "action", EField::action }, { "status", EField::status },
+    { "streams", EField::streams }
+  };
+
+  const Key c_rKeyOrder[] = {
+    { "id", EField::order_id }, { "client_order_id", EField::order_client_order_id },
+    { "symbol", EField::order_symbol }, { "side", EField::order_side },
+    { "status", EField::order_status }, { "type", EField::order_type }
+  };
+
+  template<std::size_t N>
+  EField Lookup( const Key (&rKey)[ N ], std::string_view sKey ) {
+    for ( const Key& key: rKey ) {
+      if ( key.sKey == sKey ) return key.eField;
+    }
+    return EField::none;
+  }
+
+  struct Event {
+    std::string_view sEvent;
+    EEvent eEvent;
+  };
+
+  const Event c_rEvent[] = {
+    { "new", EEvent::new_ }, { "fill", EEvent::fill }, { "partial_fill", EEvent::partial_fill },
+    { "canceled", EEvent::canceled }, { "expired", EEvent::expired },
+    { "done_for_day", EEvent::done_for_day }, { "replaced", EEvent::replaced },
+    { "rejected", EEvent::rejected }, { "pending_new", EEvent::pending_new },
+    { "stopped", EEvent::stopped }, { "pending_cancel", EEvent::pending_cancel },
+    { "pending_replace", EEvent::pending_replace }, { "calculated", EEvent::calculated },
+    { "suspended", EEvent::suspended },
+    { "order_replace_rejected", EEvent::order_replace_rejected },
+    { "order_cancel_rejected", EEvent::order_cancel_rejected }
+  };
+
+  EEvent LookupEvent( std::string_view sEvent ) {
+    for ( const Event& event: c_rEvent ) {
+      if ( event.sEvent == sEvent ) return event.eEvent;
+    }
+    return EEvent::unknown;
+  }
+
+  struct Handler {
+
+    static constexpr std::size_t max_object_size = std::size_t( -1 );
+    static constexpr std::size_t max_array_size = std::size_t( -1 );
+    static constexpr std::size_t max_key_size = std::size_t( -1 );
+    static constexpr std::size_t max_string_size = std::size_t( -1 );
+
+    static const std::size_t c_nMaxDepth = 8; // deeper scopes are counted, but not tracked
+
+    Message* pMessage;
+
+    EScope rScope[ c_nMaxDepth ];
+    std::size_t nDepth;
+    EField eField; // destination for the next value
+
+    Text<31> key; // keys and values may arrive in parts
+    Text<95> value;
+
+    Handler(): pMessage( nullptr ), nDepth {}, eField( EField::none ) {}
+
+    EScope Scope() const {
+      return ( 0 == nDepth ) ? EScope::other : ( ( c_nMaxDepth >= nDepth ) ? rScope[ nDepth - 1 ] : EScope::other );
+    }
+
+    void Push( EScope scope ) {
+      if ( c_nMaxDepth > nDepth ) rScope[ nDepth ] = scope;
+      ++nDepth;
+      eField = EField::none;
+    }
+
+    void Pop() {
+      --nDepth;
+      eField = EField::none;
+    }
+
+    bool Wanted() const { // skip accumulating text for unknown keys
+      return ( EField::none != eField ) || ( EScope::streams == Scope() );
+    }
+
+    bool on_document_begin( json::error_code& ) {
+      nDepth = 0;
+      eField = EField::none;
+      key.clear();
+      value.clear();
+      return true;
+    }
+    bool on_document_end( json::error_code& ) { return true; }
+
+    bool on_object_begin( json::error_code& ) {
+      EScope scope( EScope::other );
+      if ( 0 == nDepth ) scope = EScope::root;
+      else {
+        switch ( eField ) {
+          case EField::data: scope = EScope::data; break;
+          case EField::order: scope = EScope::order; break;
+          default: break;
+        }
+      }
+      Push( scope );
+      return true;
+    }
+    bool on_object_end( std::size_t, json::error_code& ) { Pop(); return true; }
+
+    bool on_array_begin( json::error_code& ) {
+      Push( ( EField::streams == eField ) ? EScope::streams : EScope::other );
+      return true;
+    }
+    bool on_array_end( std::size_t, json::error_code& ) { Pop(); return true; }
+
+    bool on_key_part( json::string_view s, std::size_t, json::error_code& ) {
+      key.append( s.data(), s.size() );
+      return true;
+    }
+    bool on_key( json::string_view s, std::size_t, json::error_code& ) {
+      key.append( s.data(), s.size() );
+      switch ( Scope() ) {
+        case EScope::root: eField = Lookup( c_rKeyRoot, key.view() ); break;
+        case EScope::data: eField = Lookup( c_rKeyData, key.view() ); break;
+        case EScope::order: eField = Lookup( c_rKeyOrder, key.view() ); break;
+        default: eField = EField::none; break;
+      }
+      key.clear();
+      return true;
+    }
+
+    bool on_string_part( json::string_view s, std::size_t, json::error_code& ) {
+      if ( Wanted() ) value.append( s.data(), s.size() );
+      return true;
+    }
+    bool on_string( json::string_view s, std::size_t, json::error_code& ) {
+      if ( Wanted() ) {
+        value.append( s.data(), s.size() );
+        String();
+      }
+      value.clear();
+      eField = EField::none;
+      return true;
+    }
+
+    void String() {
+      Message& message( *pMessage );
+      if ( EScope::streams == Scope() ) {
+        ++message.nStreams;
+        if ( value == "trade_updates" ) message.bTradeUpdates = true;
+        return;
+      }
+      switch ( eField ) {
+        case EField::stream:
+          if ( value == "trade_updates" ) message.eStream = EStream::trade_updates;
+          else if ( value == "authorization" ) message.eStream = EStream::authorization;
+          else if ( value == "listening" ) message.eStream = EStream::listening;
+          break;
+        case EField::action: message.action.assign( value.sz, value.n ); break;
+        case EField::status: message.status.assign( value.sz, value.n ); break;
+        case EField::event: message.eEvent = LookupEvent( value.view() ); break;
+        case EField::timestamp: message.timestamp.assign( value.sz, value.n ); break;
+        case EField::execution_id: message.execution_id.assign( value.sz, value.n ); break;
+        case EField::price: message.price = std::strtod( value.c_str(), nullptr ); break;
+        case EField::qty: message.qty = std::strtod( value.c_str(), nullptr ); break;
+        case EField::position_qty: message.position_qty = std::strtod( value.c_str(), nullptr ); break;
+        case EField::order_id: message.order.id.assign( value.sz, value.n ); break;
+        case EField::order_client_order_id: message.order.client_order_id.assign( value.sz, value.n ); break;
+        case EField::order_symbol: message.order.symbol.assign( value.sz, value.n ); break;
+        case EField::order_side: message.order.side.assign( value.sz, value.n ); break;
+        case EField::order_status: message.order.status.assign( value.sz, value.n ); break;
+        case EField::order_type: message.order.type.assign( value.sz, value.n ); break;
+        default: break;
+      }
+    }
+
+    void Number( double dbl ) {
+      Message& message( *pMessage );
+      switch ( eField ) {
+        case EField::price: message.price = dbl; break;
+        case EField::qty: message.qty = dbl; break;
+        case EField::position_qty: message.position_qty = dbl; break;
+        default: break;
+      }
+      eField = EField::none;
+    }
+
+    bool on_number_part( json::string_view, json::error_code& ) { return true; }
+    bool on_int64( std::int64_t i, json::string_view, json::error_code& ) { Number( (double)i ); return true; }
+    bool on_uint64( std::uint64_t u, json::string_view, json::error_code& ) { Number( (double)u ); return true; }
+    bool on_double( double d, json::string_view, json::error_code& ) { Number( d ); return true; }
+    bool on_bool( bool, json::error_code& ) { eField = EField::none; return true; }
+    bool on_null( json::error_code& ) { eField = EField::none; return true; }
+    bool on_comment_part( json::string_view, json::error_code& ) { return true; }
+    bool on_comment( json::string_view, json::error_code& ) { return true; }
+  };
+
+} // namespace anonymous
+
+struct Decoder::Parser {
+  json::basic_parser<Handler> parser;
+  Parser(): parser( json::parse_options() ) {}
+};
+
+Decoder::Decoder()
+: m_pParser( std::make_unique<Parser>() )
+{}
+
+Decoder::~Decoder() {}
+
+bool Decoder::Decode( std::string_view sFrame, Message& message ) {
+  message.Clear();
+  json::basic_parser<Handler>& parser( m_pParser->parser );
+  parser.reset();
+  parser.handler().pMessage = &message;
+  json::error_code ec;
+  parser.write_some( false, sFrame.data(), sFrame.size(), ec );
+  return !ec && parser.done();
+}
+
+} // namespace stream
+} // namespace alpaca
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,125 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Stream.hpp
+ * Author:  raymond@burkholder.net
+ * Project: lib/TFAlpaca
+ * Created: 2026
+ */
+
+#pragma once
+
+// decodes web_socket stream frames without building a json document
+//   a sax style handler maps known keys straight into a re-usable Message
+//   text fields are fixed capacity, unknown keys and values are skipped
+
+#include <memory>
+#include <cstring>
+#include <string_view>
+
+namespace ou {
+namespace tf {
+namespace alpaca {
+namespace stream {
+
+template<std::size_t N>
+struct Text {
+  char sz[ N + 1 ];
+  std::size_t n;
+  Text(): n {} { sz[ 0 ] = 0; }
+  void clear() { n = 0; sz[ 0 ] = 0; }
+  void append( const char* p, std::size_t len ) { // truncates at capacity
+    const std::size_t m = ( len < ( N - n ) ) ? len : ( N - n );
+    std::memcpy( sz + n, p, m );
+    n += m;
+    sz[ n ] = 0;
+  }
+  void assign( const char* p, std::size_t len ) { clear(); append( p, len ); }
+  bool empty() const { return 0 == n; }
+  std::string_view view() const { return std::string_view( sz, n ); }
+  const char* c_str() const { return sz; }
+  bool operator==( std::string_view sv ) const { return view() == sv; }
+  bool operator!=( std::string_view sv ) const { return view() != sv; }
+};
+
+enum class EStream { unknown, authorization, listening, trade_updates };
+
+// https://alpaca.markets/deprecated/docs/api-documentation/api-v2/streaming/
+enum class EEvent { new_, fill, partial_fill, canceled, expired, done_for_day
+                  , replaced, rejected, pending_new, stopped, pending_cancel
+                  , pending_replace, calculated, suspended
+                  , order_replace_rejected, order_cancel_rejected
+                  , unknown };
+
+struct Message {
+
+  EStream eStream;
+
+  // authorization: {"stream":"authorization","data":{"action":"authenticate","status":"authorized"}}
+  Text<32> action;
+  Text<32> status;
+
+  // listening: {"stream":"listening","data":{"streams":["trade_updates"]}}
+  std::size_t nStreams;
+  bool bTradeUpdates;
+
+  // trade_updates: {"stream":"trade_updates","data":{"event":"fill","execution_id":"...","order":{...},...}}
+  EEvent eEvent;
+  Text<40> timestamp;
+  Text<64> execution_id;
+  double price; // supplied as strings or numbers, converted in place
+  double qty;
+  double position_qty;
+
+  struct Order {
+    Text<64> id;
+    Text<64> client_order_id;
+    Text<32> symbol;
+    Text<16> side;
+    Text<32> status;
+    Text<16> type;
+    void Clear() {
+      id.clear(); client_order_id.clear(); symbol.clear();
+      side.clear(); status.clear(); type.clear();
+    }
+  } order;
+
+  Message() { Clear(); }
+
+  void Clear() {
+    eStream = EStream::unknown;
+    action.clear(); status.clear();
+    nStreams = 0; bTradeUpdates = false;
+    eEvent = EEvent::unknown;
+    timestamp.clear(); execution_id.clear();
+    price = qty = position_qty = 0.0;
+    order.Clear();
+  }
+};
+
+class Decoder {
+public:
+  Decoder();
+  ~Decoder();
+  bool Decode( std::string_view, Message& ); // false on malformed frame
+private:
+  struct Parser; // wraps boost::json::basic_parser, keeps json out of the header
+  std::unique_ptr<Parser> m_pParser;
+};
+
+} // namespace stream
+} // namespace alpaca
+} // namespace tf
+} // namespace ou
@@ -255,13 +255,10 @@ void web_socket::on_read_auth(
     // The make_printable() function helps print a ConstBufferSequence
     //std::cout << "ws.on_read_auth: " << beast::make_printable( m_buffer.data() ) << std::endl;
 
-    std::string sMessage( beast::buffers_to_string( m_buffer.data() ) );
-    //std::cout << "ws.on_read_auth: " << sMessage << std::endl;
-
     m_bConnected = true;
 
     if ( m_fConnected ) m_fConnected( true );
-    if ( m_fMessage ) m_fMessage( std::move( sMessage ) );
+    if ( m_fMessage ) m_fMessage( frame() );
     m_buffer.clear();
 
     // wait for more reads
@@ -276,6 +273,12 @@ void web_socket::on_read_auth(
 
 }
 
+// flat_buffer is contiguous, the frame is handed out in place rather than copied to a string
+std::string_view web_socket::frame() const {
+  const auto buffer( m_buffer.cdata() );
+  return std::string_view( static_cast<const char*>( buffer.data() ), buffer.size() );
+}
+
 void web_socket::trade_updates( bool bEnable ) {
 
   json::object listen;
@@ -336,10 +339,7 @@ void web_socket::on_read_listen(
     // The make_printable() function helps print a ConstBufferSequence
     //std::cout << "ws.on_read_listen: " << beast::make_printable( m_buffer.data() ) << std::endl;
 
-    std::string sMessage( beast::buffers_to_string( m_buffer.data() ) );
-    //std::cout << "ws.on_read_listen: " << sMessage << std::endl;
-
-    if ( m_fMessage ) m_fMessage( std::move( sMessage ) );
+    if ( m_fMessage ) m_fMessage( frame() );
     m_buffer.clear();
 
     if ( m_bConnected ) {
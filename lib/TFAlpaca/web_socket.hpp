@@ -24,6 +24,7 @@
 #include <memory>
 #include <string>
 #include <functional>
+#include <string_view>
 
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/core.hpp>
@@ -55,7 +56,7 @@ public:
   ~web_socket();
 
   using fConnected_t = std::function<void(bool)>;
-  using fMessage_t = std::function<void(std::string&&)>;
+  using fMessage_t = std::function<void(std::string_view)>; // frame is valid for the duration of the call
 
   // Start the asynchronous operation
   void connect(
@@ -77,7 +78,7 @@ private:
   tcp::resolver m_resolver;
   websocket::stream<
     beast::ssl_stream<beast::tcp_stream>> m_ws;
-  beast::flat_buffer m_buffer;
+  beast::flat_buffer m_buffer; // re-used for each frame, capacity is retained across clear()
 
   std::string m_host;
 
@@ -121,6 +122,8 @@ private:
 
   void on_close( beast::error_code );
 
+  std::string_view frame() const;
+
 };
 
 } // namespace session
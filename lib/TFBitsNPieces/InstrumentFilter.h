@@ -99,8 +99,8 @@ void InstrumentFilter<S,TS>::HandleObject( const std::string& sPath, const std::
   if ( m_bSendThroughFilter ) {
     typename ou::tf::HDF5TimeSeriesContainer<typename TS::datum_t> tsRepository( m_dm, sPath );
     typename ou::tf::HDF5TimeSeriesContainer<typename TS::datum_t>::iterator begin, end;
-    begin = std::lower_bound( tsRepository.begin(), tsRepository.end(), m_dtDate1 );
-    end   = std::lower_bound( begin, tsRepository.end(), m_dtDate2 );
+    begin = tsRepository.lower_bound( m_dtDate1 );
+    end   = tsRepository.lower_bound( m_dtDate2 );
     hsize_t cnt = end - begin;
     if ( m_nRequiredDays <= cnt ) {
       TS timeseries;
@@ -25,7 +25,7 @@ NodeTSTrade::~NodeTSTrade(void) {
 }
 
 double NodeTSTrade::EvaluateDouble( void ) {
-  return TimeSeries()->Last()->Price();
+  return Field( *TimeSeries()->Last() );
 }
 
 // =======================
@@ -38,7 +38,7 @@ NodeTSQuoteBid::~NodeTSQuoteBid(void) {
 }
 
 double NodeTSQuoteBid::EvaluateDouble( void ) {
-  return TimeSeries()->Last()->Bid();
+  return Field( *TimeSeries()->Last() );
 }
 
 // =======================
@@ -51,7 +51,7 @@ NodeTSQuoteAsk::~NodeTSQuoteAsk(void) {
 }
 
 double NodeTSQuoteAsk::EvaluateDouble( void ) {
-  return TimeSeries()->Last()->Ask();
+  return Field( *TimeSeries()->Last() );
 }
 
 // =======================
@@ -64,7 +64,7 @@ NodeTSQuoteMid::~NodeTSQuoteMid(void) {
 }
 
 double NodeTSQuoteMid::EvaluateDouble( void ) {
-  return TimeSeries()->Last()->Midpoint();
+  return Field( *TimeSeries()->Last() );
 }
 
 // =======================
@@ -77,7 +77,7 @@ NodeTSPrice::~NodeTSPrice(void) {
 }
 
 double NodeTSPrice::EvaluateDouble( void ) {
-  return TimeSeries()->Last()->Value();
+  return Field( *TimeSeries()->Last() );
 }
 
 // =======================
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include <TFTimeSeries/TimeSeries.h>
 
 #include <OUGP/Node.h>
@@ -33,6 +35,17 @@ public:
   virtual void PreProcess( void ) {
     TimeSeriesRegistration<TS>::SetTimeSeries( &this->m_pTimeSeries, this->m_ixTimeSeries );
   }
+  virtual bool ColumnKey( Node::ColumnKey_t& key ) const { // the series and the field read from it
+    key = Node::ColumnKey_t( this->m_pTimeSeries, &typeid( N ) );
+    return true;
+  }
+  virtual void FillColumn( std::vector<double>& column ) const {
+    const typename TS::size_type nSize( this->m_pTimeSeries->Size() );
+    column.resize( nSize );
+    for ( typename TS::size_type ix = 0; ix < nSize; ix++ ) {
+      column[ ix ] = N::Field( this->m_pTimeSeries->At( ix ) );
+    }
+  }
 protected:
 private:
 };
@@ -57,6 +70,7 @@ class NodeTSTrade: public NodeTimeSeries<NodeTSTrade, ou::tf::Trades> {
 public:
   NodeTSTrade(void);
   ~NodeTSTrade(void);
+  static double Field( const ou::tf::Trade& trade ) { return trade.Price(); };
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".price()"; };
   double EvaluateDouble( void );
 protected:
@@ -69,6 +83,7 @@ class NodeTSQuoteBid: public NodeTimeSeries<NodeTSQuoteBid, ou::tf::Quotes> {
 public:
   NodeTSQuoteBid(void);
   ~NodeTSQuoteBid(void);
+  static double Field( const ou::tf::Quote& quote ) { return quote.Bid(); };
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".bid()"; };
   double EvaluateDouble( void );
 protected:
@@ -79,6 +94,7 @@ class NodeTSQuoteAsk: public NodeTimeSeries<NodeTSQuoteAsk, ou::tf::Quotes> {
 public:
   NodeTSQuoteAsk(void);
   ~NodeTSQuoteAsk(void);
+  static double Field( const ou::tf::Quote& quote ) { return quote.Ask(); };
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".ask()"; };
   double EvaluateDouble( void );
 protected:
@@ -89,6 +105,7 @@ class NodeTSQuoteMid: public NodeTimeSeries<NodeTSQuoteMid, ou::tf::Quotes> {
 public:
   NodeTSQuoteMid(void);
   ~NodeTSQuoteMid(void);
+  static double Field( const ou::tf::Quote& quote ) { return quote.Midpoint(); };
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".mid()"; };
   double EvaluateDouble( void );
 protected:
@@ -101,6 +118,7 @@ class NodeTSPrice: public NodeTimeSeries<NodeTSPrice, ou::tf::Prices> {
 public:
   NodeTSPrice(void);
   ~NodeTSPrice(void);
+  static double Field( const ou::tf::Price& price ) { return price.Value(); };
   void ToString( std::stringstream& ss ) const { ss << m_pTimeSeries->GetName() << ".value()"; };
   double EvaluateDouble( void );
 protected:
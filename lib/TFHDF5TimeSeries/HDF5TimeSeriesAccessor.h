@@ -14,8 +14,14 @@
 
 #pragma once
 
-#include <stdexcept>
+#include <future>
 #include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
 
 #include <TFTimeSeries/DatedDatum.h>
 
@@ -29,6 +35,13 @@ namespace tf { // TradeFrame
 // purpose is to get around the other circular reference of iterator needs to
 //  know about the container, and the container issues the iterator
 
+// single element reads are served from a block buffer aligned to the dataset chunking,
+//   so a chunk is decompressed once per block rather than once per element.
+//   On a forward miss, the following block is prefetched on a worker when the hdf5 library is thread safe.
+// a sparse time index (one timestamp per block) is kept in the 'TimeIndex' attribute,
+//   written with each Write, or built with a single strided read when absent or stale.
+//   LowerBound/UpperBound use it to locate the containing block, which is then searched in memory.
+
 // class DD needs to be composed from the CDatedDatum class for access to ptime element
 template<class DD> class HDF5TimeSeriesAccessor {
 public:
@@ -39,6 +52,9 @@ public:
   void Read( hsize_t index, DD* );
   void Read( hsize_t ixStart, hsize_t count, H5::DataSpace *pMemoryDataSpace, DD* pDatedDatum );
   void Write( hsize_t ixStart, size_t count, const DD* );
+  hsize_t LowerBound( const ptime& dt ); // index of first element not before dt
+  hsize_t UpperBound( const ptime& dt ); // index of first element after dt
+  hsize_t BlockSize() const { return m_nBlockSize; }
 protected:
   std::string m_sPathName;
   H5::DataSet* m_pDiskDataSet;
@@ -47,7 +63,41 @@ protected:
   virtual void SetNewSize( size_type size ) {};
   void UpdateElementCount( void );
 private:
+
+  static const hsize_t c_nDefaultBlockSize = 1024;
+  static const char c_szTimeIndex[];
+  static const size_t c_nMaxTimeIndexBytes = 64000;
+
+  struct Block {
+    hsize_t ixBegin;
+    hsize_t nCount;
+    std::vector<DD> vDD;
+    Block(): ixBegin( 0 ), nCount( 0 ) {}
+    bool Contains( hsize_t ix ) const { return ( ixBegin <= ix ) && ( ix < ( ixBegin + nCount ) ); }
+    void Invalidate() { ixBegin = 0; nCount = 0; }
+  };
+
   HDF5DataManager& m_dm;
+
+  hsize_t m_nBlockSize;
+  Block m_blockCurrent;
+  Block m_blockPrefetch;
+  bool m_bPrefetchable;
+  std::future<void> m_futurePrefetch;
+
+  using vTimeIndex_t = std::vector<ptime>;
+  vTimeIndex_t m_vTimeIndex; // timestamp of every m_nBlockSize'th element
+  bool m_bTimeIndexValid;
+
+  void LoadBlock( hsize_t ixBlock, Block& );
+  const DD& At( hsize_t ix );
+  void WaitPrefetch();
+  void InvalidateBlocks();
+
+  void ReadTimeIndex();
+  void BuildTimeIndex();
+  void WriteTimeIndex( hsize_t ixStart, size_t count, const DD* );
+  std::pair<hsize_t,hsize_t> IndexWindow( const ptime& dt ); // block range which may hold dt
   HDF5TimeSeriesAccessor( const HDF5TimeSeriesAccessor& ); // copy constructor not implemented
   HDF5TimeSeriesAccessor& operator=( const HDF5TimeSeriesAccessor& ); // assignment constructor not implemented
 };
@@ -61,9 +111,14 @@ template<class DD> void HDF5TimeSeriesAccessor<DD>::UpdateElementCount( void ) {
   SetNewSize( m_curElementCount );
 }
 
+template<class DD> const char HDF5TimeSeriesAccessor<DD>::c_szTimeIndex[] = "TimeIndex";
+
 template<class DD> HDF5TimeSeriesAccessor<DD>::HDF5TimeSeriesAccessor( HDF5DataManager& dm, const std::string &sPathName):
   m_dm( dm ),
-  m_sPathName( sPathName ) {
+  m_sPathName( sPathName ),
+  m_nBlockSize( c_nDefaultBlockSize ),
+  m_bPrefetchable( false ),
+  m_bTimeIndexValid( false ) {
 
   try {
     m_pDiskDataSet = new H5::DataSet( m_dm.GetH5File()->openDataSet( m_sPathName.c_str() ) );
@@ -78,6 +133,21 @@ template<class DD> HDF5TimeSeriesAccessor<DD>::HDF5TimeSeriesAccessor( HDF5DataM
     delete pMemCompType;
 
     UpdateElementCount();
+
+    // align blocks with the chunking so each block read decompresses whole chunks
+    H5::DSetCreatPropList pl( m_pDiskDataSet->getCreatePlist() );
+    if ( H5D_CHUNKED == pl.getLayout() ) {
+      hsize_t nChunk {};
+      pl.getChunk( 1, &nChunk );
+      if ( 0 < nChunk ) m_nBlockSize = nChunk;
+    }
+    pl.close();
+
+    hbool_t bThreadSafe( false );
+    H5is_library_threadsafe( &bThreadSafe );
+    m_bPrefetchable = bThreadSafe;
+
+    ReadTimeIndex();
   }
   catch ( H5::AttributeIException& e ) {
     std::cout << "HDF5TimeSeriesAccessor<DD>::HDF5TimeSeriesAccessor AttributeIException (" << m_sPathName << ") " << e.getDetailMsg() << std::endl;
@@ -100,6 +170,7 @@ template<class DD> HDF5TimeSeriesAccessor<DD>::HDF5TimeSeriesAccessor( HDF5DataM
 }
 
 template<class DD> HDF5TimeSeriesAccessor<DD>::~HDF5TimeSeriesAccessor() {
+  WaitPrefetch();
   m_pDiskCompType->close();
   delete m_pDiskCompType;
   //m_pDiskDataSet->flush( H5F_SCOPE_LOCAL );
@@ -111,40 +182,71 @@ template<class DD> void HDF5TimeSeriesAccessor<DD>::Read( hsize_t ixSource, DD*
   // store the retrieved value in pDatedDatum
   assert( ixSource < m_curElementCount );
   try {
-    hsize_t dim = 1;
-    hsize_t coord1[] = { ixSource };  // index on disk
-    hsize_t coord2[] = { 0 };      // only one item in memory
-    try {
-      H5::CompType *pComp = pDatedDatum->DefineDataType();
-
-      H5::DataSpace MemoryDataspace(1, &dim ); // create one element dataspace to get requested element of dataset
-      MemoryDataspace.selectElements( H5S_SELECT_SET, 1, coord2 );
-
-      H5::DataSpace *pDiskDataSpaceSelection = new H5::DataSpace( m_pDiskDataSet->getSpace() );
-      pDiskDataSpaceSelection->selectElements( H5S_SELECT_SET, 1, coord1 );
-
-      m_pDiskDataSet->read( pDatedDatum, *pComp, MemoryDataspace, *pDiskDataSpaceSelection );
+    *pDatedDatum = At( ixSource );
+  }
+  catch ( H5::Exception& e ) {
+    std::cout << "HDF5TimeSeriesAccessor<DD>::Retrieve H5::Exception " << e.getDetailMsg() << std::endl;
+    e.walkErrorStack( H5E_WALK_DOWNWARD, (H5E_walk2_t) &HDF5DataManager::PrintH5ErrorStackItem, this );
+  }
+  catch (...) {
+    std::cout << "unknown error in HDF5TimeSeriesAccessor<DD>::Retrieve" << std::endl;
+  }
+}
 
-      pDiskDataSpaceSelection->close();
-      delete pDiskDataSpaceSelection;
+template<class DD> const DD& HDF5TimeSeriesAccessor<DD>::At( hsize_t ix ) {
 
-      MemoryDataspace.close();
+  if ( !m_blockCurrent.Contains( ix ) ) {
 
-      pComp->close();
-      delete pComp;
+    const hsize_t ixBlock( ix / m_nBlockSize );
+    bool bSequential( false );
 
-      //cout << "read from index " << ixSource << endl;
+    WaitPrefetch();
+    if ( m_blockPrefetch.Contains( ix ) ) {
+      std::swap( m_blockCurrent, m_blockPrefetch );
+      bSequential = true;
     }
-    catch ( H5::Exception e ) {
-      std::cout << "HDF5TimeSeriesAccessor<DD>::Retrieve H5::Exception " << e.getDetailMsg() << std::endl;
-      e.walkErrorStack( H5E_WALK_DOWNWARD, (H5E_walk2_t) &HDF5DataManager::PrintH5ErrorStackItem, this );
+    else {
+      bSequential = ( 0 < m_blockCurrent.nCount ) && ( ( m_blockCurrent.ixBegin + m_blockCurrent.nCount ) == ( ixBlock * m_nBlockSize ) );
+      LoadBlock( ixBlock, m_blockCurrent );
+    }
+
+    // iteration moving forward, so have the next block ready
+    const hsize_t ixNext( ( ixBlock + 1 ) * m_nBlockSize );
+    if ( bSequential && m_bPrefetchable && ( ixNext < m_curElementCount ) ) {
+      m_futurePrefetch = std::async(
+        std::launch::async,
+        [this,ixBlock](){ LoadBlock( ixBlock + 1, m_blockPrefetch ); } );
     }
   }
-  catch (...) {
-    std::cout << "unknown error in HDF5TimeSeriesAccessor<DD>::Retrieve" << std::endl;
+
+  return m_blockCurrent.vDD[ ix - m_blockCurrent.ixBegin ];
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::LoadBlock( hsize_t ixBlock, Block& block ) {
+  const hsize_t ixBegin( ixBlock * m_nBlockSize );
+  assert( ixBegin < m_curElementCount );
+  const hsize_t nCount( std::min<hsize_t>( m_nBlockSize, m_curElementCount - ixBegin ) );
+  block.Invalidate();
+  block.vDD.resize( nCount );
+  H5::DataSpace dsMemory( 1, &nCount );
+  Read( ixBegin, nCount, &dsMemory, block.vDD.data() );
+  dsMemory.close();
+  block.ixBegin = ixBegin;
+  block.nCount = nCount;
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::WaitPrefetch() {
+  if ( m_futurePrefetch.valid() ) {
+    m_futurePrefetch.get();
   }
 }
 
+template<class DD> void HDF5TimeSeriesAccessor<DD>::InvalidateBlocks() {
+  WaitPrefetch();
+  m_blockCurrent.Invalidate();
+  m_blockPrefetch.Invalidate();
+}
+
 template <class DD> void HDF5TimeSeriesAccessor<DD>::Read( hsize_t ixStart, hsize_t count, H5::DataSpace *pMemoryDataSpace, DD *pDatedDatum ) {
   try {
     hsize_t dim[] = { count };
@@ -180,6 +282,7 @@ template <class DD> void HDF5TimeSeriesAccessor<DD>::Read( hsize_t ixStart, hsiz
 
 template<class DD> void HDF5TimeSeriesAccessor<DD>::Write( hsize_t ixStart, size_t count, const DD* pDatedDatum ) {
   assert( ixStart <= m_curElementCount );  // at an existing position, or one past the end (sparseness not allowed)
+  InvalidateBlocks();
   try {
     hsize_t oldElementCount = m_curElementCount;  // keep for later comparison
     hsize_t dim[] = { count };
@@ -211,6 +314,8 @@ template<class DD> void HDF5TimeSeriesAccessor<DD>::Write( hsize_t ixStart, size
       if ( m_curElementCount == oldElementCount ) {
         //cout << "Dataset did not expand" << endl;
       }
+
+      WriteTimeIndex( ixStart, count, pDatedDatum );
       //cout << "Wrote " << count << ", total " << m_curElementCount << endl;
     }
     catch ( H5::Exception e ) {
@@ -223,5 +328,133 @@ template<class DD> void HDF5TimeSeriesAccessor<DD>::Write( hsize_t ixStart, size
   }
 }
 
+template<class DD> void HDF5TimeSeriesAccessor<DD>::ReadTimeIndex() {
+  // index is usable only if it covers the current element count with the current block size
+  m_vTimeIndex.clear();
+  m_bTimeIndexValid = false;
+  if ( m_pDiskDataSet->attrExists( c_szTimeIndex ) ) {
+    H5::Attribute attribute( m_pDiskDataSet->openAttribute( c_szTimeIndex ) );
+    H5::DataSpace dspace( attribute.getSpace() );
+    hsize_t nEntries {};
+    dspace.getSimpleExtentDims( &nEntries );
+    if ( 2 <= nEntries ) {
+      std::vector<std::int64_t> v( nEntries );
+      attribute.read( H5::PredType::NATIVE_INT64, v.data() );
+      const hsize_t nStride( v[ 0 ] );
+      const hsize_t nCovered( v[ 1 ] );
+      if ( ( nStride == m_nBlockSize ) && ( nCovered == m_curElementCount ) ) {
+        m_vTimeIndex.resize( nEntries - 2 );
+        assert( sizeof( ptime ) == sizeof( std::int64_t ) );
+        std::memcpy( static_cast<void*>( m_vTimeIndex.data() ), &v[ 2 ], m_vTimeIndex.size() * sizeof( ptime ) );
+        m_bTimeIndexValid = true;
+      }
+    }
+    dspace.close();
+    attribute.close();
+  }
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::BuildTimeIndex() {
+  // one strided read of the DateTime member of the first element of each block
+  WaitPrefetch(); // the dataset is not read from two threads at once
+  m_vTimeIndex.clear();
+  if ( 0 < m_curElementCount ) {
+    hsize_t nEntries( ( m_curElementCount + m_nBlockSize - 1 ) / m_nBlockSize );
+    m_vTimeIndex.resize( nEntries );
+
+    H5::CompType typeTime( sizeof( ptime ) );
+    typeTime.insertMember( "DateTime", 0, H5::PredType::NATIVE_LLONG );
+
+    hsize_t ixStart( 0 );
+    hsize_t nStride( m_nBlockSize );
+    H5::DataSpace dsDisk( m_pDiskDataSet->getSpace() );
+    dsDisk.selectHyperslab( H5S_SELECT_SET, &nEntries, &ixStart, &nStride );
+    H5::DataSpace dsMemory( 1, &nEntries );
+
+    m_pDiskDataSet->read( m_vTimeIndex.data(), typeTime, dsMemory, dsDisk );
+
+    dsMemory.close();
+    dsDisk.close();
+    typeTime.close();
+  }
+  m_bTimeIndexValid = true;
+}
+
+template<class DD> void HDF5TimeSeriesAccessor<DD>::WriteTimeIndex( hsize_t ixStart, size_t count, const DD* pDatedDatum ) {
+
+  // entries before ixStart are unchanged, entries within the write come from the supplied data
+  if ( !m_bTimeIndexValid ) {
+    // UpdateElementCount has already extended the size, so rebuild from disk
+    BuildTimeIndex();
+  }
+  else {
+    const hsize_t nEntries( ( m_curElementCount + m_nBlockSize - 1 ) / m_nBlockSize );
+    m_vTimeIndex.resize( nEntries );
+    for ( hsize_t ixEntry = ( ixStart + m_nBlockSize - 1 ) / m_nBlockSize; ixEntry < nEntries; ixEntry++ ) {
+      const hsize_t ix( ixEntry * m_nBlockSize );
+      if ( ix >= ( ixStart + count ) ) break; // beyond the write, and was pre-existing
+      m_vTimeIndex[ ixEntry ] = pDatedDatum[ ix - ixStart ].DateTime();
+    }
+  }
+
+  std::vector<std::int64_t> v( m_vTimeIndex.size() + 2 );
+  v[ 0 ] = m_nBlockSize;
+  v[ 1 ] = m_curElementCount;
+  std::memcpy( &v[ 2 ], static_cast<const void*>( m_vTimeIndex.data() ), m_vTimeIndex.size() * sizeof( ptime ) );
+
+  // attribute extent changes with the data, so replace it
+  if ( m_pDiskDataSet->attrExists( c_szTimeIndex ) ) {
+    m_pDiskDataSet->removeAttr( c_szTimeIndex );
+  }
+  // attributes are held in the object header, which limits them to 64KiB,
+  //   a larger index is not stored, and is built with the strided read on open
+  if ( c_nMaxTimeIndexBytes < ( v.size() * sizeof( std::int64_t ) ) ) return;
+  hsize_t nEntries( v.size() );
+  H5::DataSpace dspace( 1, &nEntries );
+  H5::Attribute attribute( m_pDiskDataSet->createAttribute( c_szTimeIndex, H5::PredType::NATIVE_INT64, dspace ) );
+  attribute.write( H5::PredType::NATIVE_INT64, v.data() );
+  attribute.close();
+  dspace.close();
+}
+
+template<class DD> std::pair<hsize_t,hsize_t> HDF5TimeSeriesAccessor<DD>::IndexWindow( const ptime& dt ) {
+  if ( !m_bTimeIndexValid ) {
+    BuildTimeIndex();
+  }
+  // blocks [first,second) may contain the boundary for dt
+  typename vTimeIndex_t::const_iterator iter = std::lower_bound( m_vTimeIndex.begin(), m_vTimeIndex.end(), dt );
+  const hsize_t ixEntry( iter - m_vTimeIndex.begin() );
+  return std::pair<hsize_t,hsize_t>( ( 0 == ixEntry ) ? 0 : ixEntry - 1, ixEntry );
+}
+
+template<class DD> hsize_t HDF5TimeSeriesAccessor<DD>::LowerBound( const ptime& dt ) {
+  if ( 0 == m_curElementCount ) return 0;
+  std::pair<hsize_t,hsize_t> window( IndexWindow( dt ) );
+  if ( window.first == window.second ) return 0; // dt at or before the first element
+  // first element not before dt is in block window.first, or is the first element of block window.second
+  const hsize_t ixBegin( window.first * m_nBlockSize );
+  At( ixBegin );
+  typename std::vector<DD>::const_iterator iter
+    = std::lower_bound( m_blockCurrent.vDD.begin(), m_blockCurrent.vDD.end(), dt,
+        []( const DD& dd, const ptime& dt ){ return dd.DateTime() < dt; } );
+  return ixBegin + ( iter - m_blockCurrent.vDD.begin() );
+}
+
+template<class DD> hsize_t HDF5TimeSeriesAccessor<DD>::UpperBound( const ptime& dt ) {
+  if ( 0 == m_curElementCount ) return 0;
+  if ( !m_bTimeIndexValid ) {
+    BuildTimeIndex();
+  }
+  typename vTimeIndex_t::const_iterator iter = std::upper_bound( m_vTimeIndex.begin(), m_vTimeIndex.end(), dt );
+  const hsize_t ixEntry( iter - m_vTimeIndex.begin() );
+  if ( 0 == ixEntry ) return 0; // dt before the first element
+  const hsize_t ixBegin( ( ixEntry - 1 ) * m_nBlockSize );
+  At( ixBegin );
+  typename std::vector<DD>::const_iterator iterBlock
+    = std::upper_bound( m_blockCurrent.vDD.begin(), m_blockCurrent.vDD.end(), dt,
+        []( const ptime& dt, const DD& dd ){ return dt < dd.DateTime(); } );
+  return ixBegin + ( iterBlock - m_blockCurrent.vDD.begin() );
+}
+
 } // namespace tf
 } // namespace ou
@@ -38,6 +38,8 @@ public:
   typedef typename HDF5TimeSeriesAccessor<DD>::size_type size_type;
   iterator begin();
   const iterator &end();
+  iterator lower_bound( const ptime& dt ); // uses the time index rather than probing through iterators
+  iterator upper_bound( const ptime& dt );
   //void Read( const iterator &_begin, const iterator &_end, T* _dest );
   void Read( iterator &_begin, iterator &_end, typename ou::tf::TimeSeries<DD>* _dest );
   void Write( const DD* _begin, const DD* _end );
@@ -70,6 +72,16 @@ template<class DD> const typename HDF5TimeSeriesContainer<DD>::iterator &HDF5Tim
   return* m_end;
 }
 
+template<class DD> typename HDF5TimeSeriesContainer<DD>::iterator HDF5TimeSeriesContainer<DD>::lower_bound( const ptime& dt ) {
+  iterator result( this, this->LowerBound( dt ) );
+  return result;
+}
+
+template<class DD> typename HDF5TimeSeriesContainer<DD>::iterator HDF5TimeSeriesContainer<DD>::upper_bound( const ptime& dt ) {
+  iterator result( this, this->UpperBound( dt ) );
+  return result;
+}
+
 template<class DD> void HDF5TimeSeriesContainer<DD>::SetNewSize( size_type newsize ) {
   delete m_end;
   m_end = new iterator( this, newsize );
@@ -88,10 +100,8 @@ template<class DD> void HDF5TimeSeriesContainer<DD>::Read( iterator& _begin, ite
 template<class DD> void HDF5TimeSeriesContainer<DD>::Write( const DD* _begin, const DD* _end ) {
   size_t cnt = _end - _begin;
   if ( cnt > 0 ) {
-    std::pair<HDF5TimeSeriesContainer<DD>::iterator, HDF5TimeSeriesContainer<DD>::iterator> p;
-    p = std::equal_range( begin(), end(), *_begin );
-    // whether we found something or not, p.first is insertion point
-    HDF5TimeSeriesAccessor<DD>::Write( p.first.m_ItemIndex, cnt, _begin );
+    // whether we found something or not, lower bound is insertion point
+    HDF5TimeSeriesAccessor<DD>::Write( this->LowerBound( _begin->DateTime() ), cnt, _begin );
   }
 }
 
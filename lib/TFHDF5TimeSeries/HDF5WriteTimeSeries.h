@@ -32,6 +32,7 @@ public:
   HDF5WriteTimeSeries<TS>( HDF5DataManager& dm, bool bDeflatable, bool bExpandable, int nDeflate = 5, hsize_t nChunkSize = 1024 );
   virtual ~HDF5WriteTimeSeries<TS>( void );
   void Write( const std::string &sPathName, TS* timeseries );
+  void Write( const std::string &sPathName, const DD* bgn, const DD* end ); // eg, values evicted by TimeSeries::Retain
 
 protected:
 private:
@@ -63,6 +64,15 @@ template<class TS> void HDF5WriteTimeSeries<TS>::Write(const std::string &sPathN
     throw std::invalid_argument( "zero length time series found" );
   }
 
+  Write( sPathName, timeseries->First(), timeseries->Last() + 1 );
+}
+
+template<class TS> void HDF5WriteTimeSeries<TS>::Write( const std::string &sPathName, const DD* bgn, const DD* end ) {
+
+  if ( bgn == end ) {
+    throw std::invalid_argument( "zero length time series found" );
+  }
+
   H5::DataSet *dataset;
   bool bNeedToCreateDataSet = false;
   //HDF5DataManager dm( HDF5DataManager::RDWR );
@@ -124,7 +134,7 @@ template<class TS> void HDF5WriteTimeSeries<TS>::Write(const std::string &sPathN
 
   try {
     HDF5TimeSeriesContainer<DD> repository( m_dm, sPathName );
-    repository.Write( timeseries->First(), timeseries->Last() + 1 );
+    repository.Write( bgn, end );
     //dm.AddGroupForSymbol( m_sSymbol );
     //dm.GetH5File()->link( H5L_type_t::H5L_TYPE_HARD, sFileName1, "/symbol/" + m_sSymbol + "/bar.86400" );
   }
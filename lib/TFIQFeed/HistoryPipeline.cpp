@@ -0,0 +1,620 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HistoryPipeline.cpp
+ * Project: lib/TFIQFeed
+ */
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include "HistoryPipeline.h"
+
+namespace {
+
+  // hand rolled field parsers, replies are well formed, so checks are minimal
+  //   each leaves 'p' on the character following the value
+
+  const double c_rdblPow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+  };
+
+  template<typename N>
+  inline bool ParseUnsigned( const char*& p, const char* end, N& n ) {
+    const char* bgn = p;
+    n = 0;
+    while ( ( p != end ) && ( '0' <= *p ) && ( '9' >= *p ) ) {
+      n = n * 10 + ( *p - '0' );
+      ++p;
+    }
+    return bgn != p;
+  }
+
+  // mantissa and power of ten are both exact, so the division is correctly rounded
+  inline bool ParseDouble( const char*& p, const char* end, double& dbl ) {
+    bool bNegative( false );
+    if ( ( p != end ) && ( '-' == *p ) ) {
+      bNegative = true;
+      ++p;
+    }
+    const char* bgn = p;
+    std::uint64_t nMantissa {};
+    size_t nDecimals {};
+    while ( ( p != end ) && ( '0' <= *p ) && ( '9' >= *p ) ) {
+      nMantissa = nMantissa * 10 + ( *p - '0' );
+      ++p;
+    }
+    if ( ( p != end ) && ( '.' == *p ) ) {
+      ++p;
+      while ( ( p != end ) && ( '0' <= *p ) && ( '9' >= *p ) ) {
+        if ( 18 > nDecimals ) {
+          nMantissa = nMantissa * 10 + ( *p - '0' );
+          ++nDecimals;
+        }
+        ++p;
+      }
+    }
+    if ( bgn == p ) return false;
+    dbl = (double)nMantissa / c_rdblPow10[ nDecimals ];
+    if ( bNegative ) dbl = -dbl;
+    return true;
+  }
+
+  inline bool Skip( const char*& p, const char* end, char ch ) {
+    if ( ( p != end ) && ( ch == *p ) ) {
+      ++p;
+      return true;
+    }
+    return false;
+  }
+
+  inline bool SkipField( const char*& p, const char* end ) {
+    while ( ( p != end ) && ( ',' != *p ) ) ++p;
+    return Skip( p, end, ',' );
+  }
+
+  // YYYY-MM-DD[ HH:MM:SS[.ffffff]]
+  inline bool ParseDateTime( const char*& p, const char* end, boost::posix_time::ptime& dt ) {
+    unsigned int nYear, nMonth, nDay;
+    if ( !( ParseUnsigned( p, end, nYear ) && Skip( p, end, '-' )
+         && ParseUnsigned( p, end, nMonth ) && Skip( p, end, '-' )
+         && ParseUnsigned( p, end, nDay ) ) ) return false;
+    boost::gregorian::date date( nYear, nMonth, nDay );
+    if ( Skip( p, end, ' ' ) ) {
+      unsigned int nHour, nMinute, nSecond;
+      if ( !( ParseUnsigned( p, end, nHour ) && Skip( p, end, ':' )
+           && ParseUnsigned( p, end, nMinute ) && Skip( p, end, ':' )
+           && ParseUnsigned( p, end, nSecond ) ) ) return false;
+      boost::posix_time::time_duration td( nHour, nMinute, nSecond );
+      if ( Skip( p, end, '.' ) ) {
+        const char* bgn = p;
+        std::uint64_t nFraction;
+        if ( !ParseUnsigned( p, end, nFraction ) ) return false;
+        for ( auto nDigits = p - bgn; 6 > nDigits; ++nDigits ) nFraction *= 10;
+        td += boost::posix_time::microseconds( nFraction );
+      }
+      dt = boost::posix_time::ptime( date, td );
+    }
+    else {
+      dt = boost::posix_time::ptime( date, boost::posix_time::time_duration( 23, 59, 59 ) ); // as with HistoryQuery
+    }
+    return true;
+  }
+
+  const std::string c_sEndMsg( "!ENDMSG!" );
+  const std::string c_sTooMany( "Too many" ); // iqfeed credit bucket exhausted, re-issue
+
+} // namespace anonymous
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+// ==== HistoryPipeline::Connection
+
+HistoryPipeline::Connection::Connection( HistoryPipeline& pipeline, const std::string& sAddress, unsigned short nPort )
+: ou::Network<Connection>( sAddress, nPort )
+, m_nOutstanding {}
+, m_pipeline( pipeline )
+{}
+
+void HistoryPipeline::Connection::OnNetworkConnected() {
+  this->Send( "S,SET PROTOCOL,6.2\n" );
+  m_pipeline.HandleConnected( *this );
+}
+
+void HistoryPipeline::Connection::OnNetworkDisconnected() {
+}
+
+void HistoryPipeline::Connection::OnNetworkError( size_t e ) {
+  std::cout << "HistoryPipeline::Connection network error " << e << std::endl;
+}
+
+void HistoryPipeline::Connection::OnNetworkLineBuffer( linebuffer_t* buf ) {
+  if ( !buf->empty() ) {
+    const char* bgn = reinterpret_cast<const char*>( buf->data() );
+    const char* end = bgn + buf->size();
+    if ( '\r' == *( end - 1 ) ) --end;
+    m_pipeline.HandleLine( *this, bgn, end );
+  }
+  this->GiveBackBuffer( buf );
+}
+
+// ==== HistoryPipeline
+
+HistoryPipeline::HistoryPipeline( size_t nConnections, size_t nDepth )
+: m_nConnections( nConnections ), m_nDepth( nDepth )
+, m_sAddress( "127.0.0.1" ), m_nPort( 9100 )
+, m_nConnected {}
+, m_eCommand( ECommand::EndOfDays ), m_nInterval {}, m_nCount {}, m_nReserve {}
+, m_bActive( false )
+, m_ixNextRequest {}, m_nRemaining {}
+, m_workPace( boost::asio::make_work_guard( m_contextPace ) )
+, m_bBatchRetrieved( false ), m_bStopConsumer( false )
+, m_bBlocked( false )
+{
+  assert( 0 < m_nConnections );
+  assert( 0 < m_nDepth );
+  SetRequestRate( 45, 15 ); // iqfeed allows 50/s, leave some room for other lookups
+  m_threadPace = std::thread( [this](){ m_contextPace.run(); } );
+  m_threadConsumer = std::thread( &HistoryPipeline::Consumer, this );
+}
+
+HistoryPipeline::~HistoryPipeline() {
+  m_workPace.reset();
+  m_contextPace.stop(); // requests still held back are dropped with their timers
+  m_threadPace.join();
+  Disconnect();
+  {
+    std::lock_guard<std::mutex> lock( m_mutexConsumer );
+    m_bStopConsumer = true;
+  }
+  m_cvConsumer.notify_one();
+  m_threadConsumer.join();
+}
+
+void HistoryPipeline::SetAddress( const std::string& sAddress, unsigned short nPort ) {
+  assert( m_vConnection.empty() );
+  m_sAddress = sAddress;
+  m_nPort = nPort;
+}
+
+void HistoryPipeline::SetRequestRate( size_t nPerSecond, size_t nBurst ) {
+  assert( 0 < nPerSecond );
+  assert( 0 < nBurst );
+  std::lock_guard<std::mutex> lock( m_mutexPace );
+  m_durInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::seconds( 1 ) ) / nPerSecond;
+  m_durBurst = m_durInterval * ( nBurst - 1 );
+  m_tpTheoretical = std::chrono::steady_clock::now();
+}
+
+void HistoryPipeline::Connect( fConnected_t&& fConnected ) {
+  assert( m_vConnection.empty() );
+  assert( fConnected );
+  m_fConnected = std::move( fConnected );
+  m_nConnected = 0;
+  for ( size_t ix = 0; ix < m_nConnections; ++ix ) {
+    m_vConnection.emplace_back( std::make_unique<Connection>( *this, m_sAddress, m_nPort ) );
+  }
+  for ( pConnection_t& pConnection: m_vConnection ) {
+    pConnection->Connect();
+  }
+}
+
+void HistoryPipeline::HandleConnected( Connection& ) {
+  if ( m_nConnections == ( 1 + m_nConnected.fetch_add( 1, std::memory_order_acq_rel ) ) ) {
+    if ( m_fConnected ) m_fConnected();
+  }
+}
+
+void HistoryPipeline::Disconnect() {
+  assert( !m_bActive.load( std::memory_order_acquire ) );
+  for ( pConnection_t& pConnection: m_vConnection ) {
+    pConnection->Disconnect();
+  }
+  m_vConnection.clear();
+  m_nConnected = 0;
+}
+
+void HistoryPipeline::RetrieveNEndOfDays( const std::vector<std::string>& vSymbol, unsigned int n, fResult_t&& fResult, fDone_t&& fDone ) {
+  Start( ECommand::EndOfDays, 0, n, vSymbol, std::move( fResult ), std::move( fDone ) );
+}
+
+void HistoryPipeline::RetrieveNIntervals( const std::vector<std::string>& vSymbol, unsigned int i, unsigned int n, fResult_t&& fResult, fDone_t&& fDone ) {
+  Start( ECommand::Intervals, i, n, vSymbol, std::move( fResult ), std::move( fDone ) );
+}
+
+void HistoryPipeline::RetrieveNDaysOfIntervals( const std::vector<std::string>& vSymbol, unsigned int i, unsigned int n, fResult_t&& fResult, fDone_t&& fDone ) {
+  Start( ECommand::DaysOfIntervals, i, n, vSymbol, std::move( fResult ), std::move( fDone ) );
+}
+
+void HistoryPipeline::RetrieveNDataPoints( const std::vector<std::string>& vSymbol, unsigned int n, fResult_t&& fResult, fDone_t&& fDone ) {
+  Start( ECommand::DataPoints, 0, n, vSymbol, std::move( fResult ), std::move( fDone ) );
+}
+
+void HistoryPipeline::RetrieveNDaysOfDataPoints( const std::vector<std::string>& vSymbol, unsigned int n, fResult_t&& fResult, fDone_t&& fDone ) {
+  Start( ECommand::DaysOfDataPoints, 0, n, vSymbol, std::move( fResult ), std::move( fDone ) );
+}
+
+void HistoryPipeline::Start(
+  ECommand eCommand, unsigned int i, unsigned int n,
+  const std::vector<std::string>& vSymbol,
+  fResult_t&& fResult, fDone_t&& fDone
+) {
+
+  assert( fResult );
+  assert( m_nConnections == m_nConnected.load( std::memory_order_acquire ) );
+
+  bool bActive( false );
+  if ( !m_bActive.compare_exchange_strong( bActive, true, std::memory_order_acq_rel ) ) {
+    throw std::logic_error( "HistoryPipeline::Start: batch already active" );
+  }
+
+  m_eCommand = eCommand;
+  m_nInterval = i;
+  m_nCount = n;
+  switch ( m_eCommand ) {
+    case ECommand::EndOfDays:
+    case ECommand::Intervals:
+    case ECommand::DataPoints:
+      m_nReserve = n;
+      break;
+    case ECommand::DaysOfIntervals:
+    case ECommand::DaysOfDataPoints:
+      m_nReserve = 0; // learned from the replies
+      break;
+  }
+
+  m_fResult = std::move( fResult );
+  m_fDone = std::move( fDone );
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutexRequest );
+    m_vRequest.clear();
+    m_vRequest.reserve( vSymbol.size() );
+    for ( const std::string& sSymbol: vSymbol ) {
+      m_vRequest.emplace_back( sSymbol );
+    }
+    m_ixNextRequest = 0;
+    m_dequeRetry.clear();
+    m_nRemaining = m_vRequest.size();
+    m_statistics = Statistics();
+    m_statistics.nRequests = m_vRequest.size();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutexConsumer );
+    m_bBlocked = true;
+  }
+
+  m_tpStart = std::chrono::steady_clock::now();
+
+  if ( m_vRequest.empty() ) {
+    std::lock_guard<std::mutex> lock( m_mutexConsumer );
+    m_bBatchRetrieved = true;
+    m_cvConsumer.notify_one();
+  }
+  else {
+    for ( pConnection_t& pConnection: m_vConnection ) {
+      Dispatch( *pConnection );
+    }
+  }
+}
+
+void HistoryPipeline::Block() {
+  std::unique_lock<std::mutex> lock( m_mutexConsumer );
+  m_cvBlock.wait( lock, [this]{ return !m_bBlocked; } );
+}
+
+// reserves a send slot, Send holds the request back on a timer until then,
+//   so neither the caller of Start nor a connection's asio thread sleeps
+std::chrono::steady_clock::time_point HistoryPipeline::Pace() {
+  std::lock_guard<std::mutex> lock( m_mutexPace );
+  std::chrono::steady_clock::time_point tpNow( std::chrono::steady_clock::now() );
+  if ( m_tpTheoretical < tpNow ) m_tpTheoretical = tpNow;
+  const std::chrono::steady_clock::time_point tpSend( m_tpTheoretical - m_durBurst );
+  m_tpTheoretical += m_durInterval;
+  return tpSend;
+}
+
+void HistoryPipeline::Dispatch( Connection& connection ) {
+  while ( true ) {
+    ixRequest_t ix;
+    {
+      std::lock_guard<std::mutex> lock( m_mutexRequest );
+      if ( m_nDepth <= connection.m_nOutstanding ) break;
+      if ( !m_dequeRetry.empty() ) {
+        ix = m_dequeRetry.front();
+        m_dequeRetry.pop_front();
+      }
+      else {
+        if ( m_vRequest.size() == m_ixNextRequest ) break;
+        ix = m_ixNextRequest++;
+      }
+      ++connection.m_nOutstanding;
+    }
+    Send( connection, ix );
+  }
+}
+
+void HistoryPipeline::Send( Connection& connection, ixRequest_t ix ) {
+
+  Request& request( m_vRequest[ ix ] );
+
+  Result* pResult = m_reposResult.CheckOutL();
+  pResult->sSymbol = request.sSymbol;
+  size_t nReserve;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexRequest );
+    nReserve = m_nReserve;
+  }
+  switch ( m_eCommand ) {
+    case ECommand::EndOfDays:
+    case ECommand::Intervals:
+    case ECommand::DaysOfIntervals:
+      pResult->bars.Reserve( nReserve );
+      break;
+    case ECommand::DataPoints:
+    case ECommand::DaysOfDataPoints:
+      pResult->quotes.Reserve( nReserve );
+      pResult->trades.Reserve( nReserve );
+      break;
+  }
+  unsigned int nAttempt;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexRequest );
+    request.pResult = pResult;
+    request.pConnection = &connection;
+    request.bComplete = false;
+    nAttempt = ++request.nAttempt;
+  }
+
+  // the request id is the index into m_vRequest, then the attempt:
+  //   the !ENDMSG! trailing a 'Too many' error carries the old attempt, and is ignored
+  std::stringstream ss;
+  switch ( m_eCommand ) {
+    case ECommand::EndOfDays:
+      ss << "HDX," << request.sSymbol << "," << m_nCount << ",1," << ix << "." << nAttempt << "\n";
+      break;
+    case ECommand::Intervals:
+      ss << "HIX," << request.sSymbol << "," << m_nInterval << "," << m_nCount << ",1," << ix << "." << nAttempt << "\n";
+      break;
+    case ECommand::DaysOfIntervals:
+      ss << "HID," << request.sSymbol << "," << m_nInterval << "," << m_nCount << ",,,,1," << ix << "." << nAttempt << "\n";
+      break;
+    case ECommand::DataPoints:
+      ss << "HTX," << request.sSymbol << "," << m_nCount << ",1," << ix << "." << nAttempt << "\n";
+      break;
+    case ECommand::DaysOfDataPoints:
+      ss << "HTD," << request.sSymbol << "," << m_nCount << ",,,,1," << ix << "." << nAttempt << "\n";
+      break;
+  }
+
+  const std::chrono::steady_clock::time_point tpSend( Pace() );
+  if ( std::chrono::steady_clock::now() >= tpSend ) {
+    connection.Send( ss.str() );
+  }
+  else {
+    // the handler holds the timer until it has run
+    std::shared_ptr<boost::asio::steady_timer> pTimer
+      = std::make_shared<boost::asio::steady_timer>( m_contextPace, tpSend );
+    pTimer->async_wait(
+      [&connection, sRequest = ss.str(), pTimer]( const boost::system::error_code& ec ){
+        if ( !ec ) connection.Send( sRequest );
+      } );
+  }
+}
+
+void HistoryPipeline::HandleLine( Connection& connection, const char* bgn, const char* end ) {
+
+  const char* p = bgn;
+  ixRequest_t ix;
+  unsigned int nAttempt;
+
+  if ( !ParseUnsigned( p, end, ix ) ) {
+    if ( ( bgn == end ) || ( 'S' != *bgn ) ) { // 'S,CURRENT PROTOCOL,6.2' is expected
+      std::cout << "HistoryPipeline unknown line: " << std::string( bgn, end ) << std::endl;
+    }
+    return;
+  }
+
+  Result* pResult;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexRequest );
+    if ( !( Skip( p, end, '.' ) && ParseUnsigned( p, end, nAttempt ) && Skip( p, end, ',' ) ) || ( m_vRequest.size() <= ix ) ) {
+      std::cout << "HistoryPipeline bad request id: " << std::string( bgn, end ) << std::endl;
+      return;
+    }
+    const Request& request( m_vRequest[ ix ] );
+    if ( request.bComplete || ( &connection != request.pConnection ) || ( nAttempt != request.nAttempt ) ) {
+      return; // stale, from an earlier attempt
+    }
+    pResult = request.pResult; // only this connection fills or completes the attempt
+  }
+
+  if ( ( p != end ) && ( 'L' == *p ) && ( ( p + 1 ) != end ) && ( 'H' == *( p + 1 ) ) ) {
+    p += 2;
+    if ( Skip( p, end, ',' ) ) {
+      Result& result( *pResult );
+      bool bParsed( false );
+      switch ( m_eCommand ) {
+        case ECommand::EndOfDays:
+          bParsed = ParseEndOfDay( p, end, result );
+          break;
+        case ECommand::Intervals:
+        case ECommand::DaysOfIntervals:
+          bParsed = ParseInterval( p, end, result );
+          break;
+        case ECommand::DataPoints:
+        case ECommand::DaysOfDataPoints:
+          bParsed = ParseTick( p, end, result );
+          break;
+      }
+      if ( !bParsed ) {
+        std::cout << "HistoryPipeline parse error: " << std::string( bgn, end ) << std::endl;
+      }
+    }
+  }
+  else {
+    if ( ( p != end ) && ( 'E' == *p ) ) {
+      p++;
+      Skip( p, end, ',' );
+      std::string sError( p, end );
+      bool bRetry( 0 == sError.compare( 0, c_sTooMany.size(), c_sTooMany ) );
+      if ( !bRetry ) pResult->sError = std::move( sError );
+      Complete( connection, ix, bRetry );
+    }
+    else {
+      if ( 0 == std::string( p, end ).compare( 0, c_sEndMsg.size(), c_sEndMsg ) ) {
+        Complete( connection, ix, false );
+      }
+      else {
+        std::cout << "HistoryPipeline unknown reply: " << std::string( bgn, end ) << std::endl;
+      }
+    }
+  }
+}
+
+void HistoryPipeline::Complete( Connection& connection, ixRequest_t ix, bool bRetry ) {
+
+  Result* pResult;
+  bool bBatchRetrieved( false );
+  {
+    std::lock_guard<std::mutex> lock( m_mutexRequest );
+    Request& request( m_vRequest[ ix ] );
+    pResult = request.pResult;
+    request.pResult = nullptr;
+    request.bComplete = true;
+    --connection.m_nOutstanding;
+    if ( bRetry ) {
+      m_dequeRetry.push_back( ix );
+      ++m_statistics.nRetries;
+    }
+    else {
+      size_t nDatums = pResult->bars.Size() + pResult->trades.Size();
+      m_statistics.nDatums += nDatums;
+      if ( !pResult->sError.empty() ) ++m_statistics.nErrors;
+      if ( m_nReserve < nDatums ) m_nReserve = nDatums;
+      --m_nRemaining;
+      bBatchRetrieved = ( 0 == m_nRemaining );
+    }
+  }
+
+  if ( bRetry ) {
+    pResult->Clear();
+    m_reposResult.CheckInL( pResult );
+  }
+  else {
+    std::lock_guard<std::mutex> lock( m_mutexConsumer );
+    m_dequeFinished.push_back( pResult );
+    if ( bBatchRetrieved ) m_bBatchRetrieved = true;
+    m_cvConsumer.notify_one();
+  }
+
+  Dispatch( connection );
+}
+
+void HistoryPipeline::Consumer() {
+  std::unique_lock<std::mutex> lock( m_mutexConsumer );
+  while ( true ) {
+    m_cvConsumer.wait( lock, [this]{ return m_bStopConsumer || m_bBatchRetrieved || !m_dequeFinished.empty(); } );
+    while ( !m_dequeFinished.empty() ) {
+      Result* pResult = m_dequeFinished.front();
+      m_dequeFinished.pop_front();
+      lock.unlock();
+      m_fResult( *pResult );
+      pResult->Clear();
+      m_reposResult.CheckInL( pResult );
+      lock.lock();
+    }
+    if ( m_bBatchRetrieved ) {
+      m_bBatchRetrieved = false;
+      m_statistics.dblSeconds
+        = std::chrono::duration<double>( std::chrono::steady_clock::now() - m_tpStart ).count();
+      lock.unlock();
+      if ( m_fDone ) m_fDone();
+      m_bActive.store( false, std::memory_order_release );
+      lock.lock();
+      m_bBlocked = false;
+      m_cvBlock.notify_all();
+    }
+    if ( m_bStopConsumer ) break;
+  }
+}
+
+// "LH,2023-06-28 09:30:00.123456,4411.50,3,42885,4411.25,4411.50,123456789,C,43,01,0,0,"
+bool HistoryPipeline::ParseTick( const char* p, const char* end, Result& result ) {
+  boost::posix_time::ptime dt;
+  double dblLast, dblBid, dblAsk;
+  std::uint64_t nLastSize;
+  bool bParsed
+    =  ParseDateTime( p, end, dt ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblLast ) && Skip( p, end, ',' )
+    && ParseUnsigned( p, end, nLastSize ) && Skip( p, end, ',' )
+    && SkipField( p, end ) // total volume
+    && ParseDouble( p, end, dblBid ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblAsk ) && Skip( p, end, ',' );
+  if ( bParsed ) {
+    result.quotes.Append( Quote( dt, dblBid, 0, dblAsk, 0 ) );
+    result.trades.Append( Trade( dt, dblLast, nLastSize ) );
+  }
+  return bParsed;
+}
+
+// "LH,2023-06-28 00:00:00,4411.50,4411.25,4411.25,4411.50,42885,55,0,"
+bool HistoryPipeline::ParseInterval( const char* p, const char* end, Result& result ) {
+  boost::posix_time::ptime dt;
+  double dblHigh, dblLow, dblOpen, dblClose;
+  std::uint64_t nPeriodVolume;
+  bool bParsed
+    =  ParseDateTime( p, end, dt ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblHigh ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblLow ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblOpen ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblClose ) && Skip( p, end, ',' )
+    && SkipField( p, end ) // total volume
+    && ParseUnsigned( p, end, nPeriodVolume );
+  if ( bParsed ) {
+    result.bars.Append( Bar( dt, dblOpen, dblHigh, dblLow, dblClose, nPeriodVolume ) );
+  }
+  return bParsed;
+}
+
+// "LH,2022-08-02,4167.25,4160.00,4167.25,4160.00,3,1103,"
+bool HistoryPipeline::ParseEndOfDay( const char* p, const char* end, Result& result ) {
+  boost::posix_time::ptime dt;
+  double dblHigh, dblLow, dblOpen, dblClose;
+  std::uint64_t nPeriodVolume;
+  bool bParsed
+    =  ParseDateTime( p, end, dt ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblHigh ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblLow ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblOpen ) && Skip( p, end, ',' )
+    && ParseDouble( p, end, dblClose ) && Skip( p, end, ',' )
+    && ParseUnsigned( p, end, nPeriodVolume );
+  if ( bParsed ) {
+    result.bars.Append( Bar( dt, dblOpen, dblHigh, dblLow, dblClose, nPeriodVolume ) );
+  }
+  return bParsed;
+}
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
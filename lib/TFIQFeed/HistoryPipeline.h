@@ -0,0 +1,214 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    HistoryPipeline.h
+ * Project: lib/TFIQFeed
+ */
+
+#pragma once
+
+// bulk history retrieval over a pool of lookup connections
+//   each connection carries several outstanding requests, replies are matched by request id
+//   replies are parsed in place into Bars, or Trades/Quotes, held in re-usable buffers
+//   finished series are handed to a single consumer thread (typically writing to hdf5)
+//   requests are paced with a credit bucket to match the iqfeed requests-per-second limit,
+//     a request held back waits on a timer, so no connection's asio thread is put to sleep
+// an alternative to HistoryBulkQuery, which waits for each reply before issuing the next request
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+
+#include <OUCommon/Network.h>
+#include <OUCommon/ReusableBuffers.h>
+
+#include <TFTimeSeries/TimeSeries.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+class HistoryPipeline {
+public:
+
+  struct Result {
+    std::string sSymbol;
+    std::string sError; // empty when retrieval succeeded
+    Bars bars; // HDX, HIX, HID
+    Quotes quotes; // HTX, HTD: quote added in sequence before trade
+    Trades trades;
+    void Clear() {
+      sSymbol.clear();
+      sError.clear();
+      bars.Clear(); // capacity is retained for the next request
+      quotes.Clear();
+      trades.Clear();
+    }
+  };
+
+  struct Statistics {
+    size_t nRequests;
+    size_t nErrors;
+    size_t nRetries; // requests re-issued after a rate limit error
+    size_t nDatums;
+    double dblSeconds;
+    double SymbolsPerSecond() const { return ( 0.0 < dblSeconds ) ? ( (double)nRequests / dblSeconds ) : 0.0; }
+    Statistics(): nRequests {}, nErrors {}, nRetries {}, nDatums {}, dblSeconds {} {}
+  };
+
+  using fConnected_t = std::function<void()>;
+  using fResult_t = std::function<void(Result&)>; // called on the consumer thread, one result at a time, cleared on return
+  using fDone_t = std::function<void()>; // called on the consumer thread after the last result
+
+  HistoryPipeline( size_t nConnections = 4, size_t nDepth = 4 ); // nDepth: outstanding requests per connection
+  ~HistoryPipeline();
+
+  void SetAddress( const std::string& sAddress, unsigned short nPort ); // prior to Connect, defaults to 127.0.0.1:9100
+  void SetRequestRate( size_t nPerSecond, size_t nBurst ); // defaults to 45/s with burst of 15
+
+  void Connect( fConnected_t&& ); // fConnected called once all connections are up
+  void Disconnect();
+
+  // start a batch with one of these, symbols are copied, one batch at a time
+  void RetrieveNEndOfDays( const std::vector<std::string>& vSymbol, unsigned int n, fResult_t&&, fDone_t&& ); // HDX
+  void RetrieveNIntervals( const std::vector<std::string>& vSymbol, unsigned int i, unsigned int n, fResult_t&&, fDone_t&& ); // HIX
+  void RetrieveNDaysOfIntervals( const std::vector<std::string>& vSymbol, unsigned int i, unsigned int n, fResult_t&&, fDone_t&& ); // HID
+  void RetrieveNDataPoints( const std::vector<std::string>& vSymbol, unsigned int n, fResult_t&&, fDone_t&& ); // HTX
+  void RetrieveNDaysOfDataPoints( const std::vector<std::string>& vSymbol, unsigned int n, fResult_t&&, fDone_t&& ); // HTD
+
+  void Block(); // wait for the batch, including the consumer, to finish
+
+  bool Active() const { return m_bActive.load( std::memory_order_acquire ); }
+  const Statistics& GetStatistics() const { return m_statistics; } // valid once the batch is done
+
+protected:
+private:
+
+  enum class ECommand { EndOfDays, Intervals, DaysOfIntervals, DataPoints, DaysOfDataPoints };
+
+  class Connection: public ou::Network<Connection> {
+    friend ou::Network<Connection>;
+  public:
+    using inherited_t = ou::Network<Connection>;
+    using linebuffer_t = inherited_t::linebuffer_t;
+    Connection( HistoryPipeline&, const std::string& sAddress, unsigned short nPort );
+    size_t m_nOutstanding; // requests in flight, maintained under HistoryPipeline::m_mutexRequest
+  protected:
+    void OnNetworkConnected();
+    void OnNetworkDisconnected();
+    void OnNetworkError( size_t );
+    void OnNetworkLineBuffer( linebuffer_t* );
+  private:
+    HistoryPipeline& m_pipeline;
+  };
+
+  using pConnection_t = std::unique_ptr<Connection>;
+  using vConnection_t = std::vector<pConnection_t>;
+
+  // sSymbol is fixed for the batch, the rest is maintained under m_mutexRequest
+  struct Request {
+    std::string sSymbol;
+    Result* pResult; // checked out when sent, handed to the consumer on completion
+    Connection* pConnection; // connection carrying the current attempt
+    unsigned int nAttempt; // part of the request id, so lines from an earlier attempt are recognized
+    bool bComplete; // late lines for the request id are ignored
+    Request( const std::string& sSymbol_ )
+    : sSymbol( sSymbol_ ), pResult( nullptr ), pConnection( nullptr ), nAttempt {}, bComplete( false ) {}
+  };
+
+  using vRequest_t = std::vector<Request>;
+  using ixRequest_t = vRequest_t::size_type;
+
+  const size_t m_nConnections;
+  const size_t m_nDepth;
+
+  std::string m_sAddress;
+  unsigned short m_nPort;
+
+  vConnection_t m_vConnection;
+  std::atomic<size_t> m_nConnected;
+  fConnected_t m_fConnected;
+
+  ECommand m_eCommand;
+  unsigned int m_nInterval; // seconds, for intervals
+  unsigned int m_nCount; // datums or days
+  size_t m_nReserve; // initial capacity for result series, grows to the largest seen
+
+  std::atomic<bool> m_bActive;
+
+  std::mutex m_mutexRequest;
+  vRequest_t m_vRequest; // index and attempt form the request id sent to iqfeed
+  ixRequest_t m_ixNextRequest;
+  std::deque<ixRequest_t> m_dequeRetry;
+  size_t m_nRemaining; // requests not yet completed
+
+  // request pacing: generic cell rate, each send advances the theoretical arrival time
+  std::mutex m_mutexPace;
+  std::chrono::steady_clock::duration m_durInterval;
+  std::chrono::steady_clock::duration m_durBurst;
+  std::chrono::steady_clock::time_point m_tpTheoretical;
+  boost::asio::io_context m_contextPace; // timers for held back requests
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_workPace;
+  std::thread m_threadPace;
+
+  ou::BufferRepository<Result> m_reposResult;
+
+  // consumer side
+  std::mutex m_mutexConsumer;
+  std::condition_variable m_cvConsumer;
+  std::deque<Result*> m_dequeFinished;
+  bool m_bBatchRetrieved; // all requests finished, consumer drains and signals done
+  bool m_bStopConsumer;
+  std::thread m_threadConsumer;
+  fResult_t m_fResult;
+  fDone_t m_fDone;
+
+  std::condition_variable m_cvBlock;
+  bool m_bBlocked;
+
+  Statistics m_statistics;
+  std::chrono::steady_clock::time_point m_tpStart;
+
+  void Start( ECommand, unsigned int i, unsigned int n, const std::vector<std::string>&, fResult_t&&, fDone_t&& );
+  void Dispatch( Connection& ); // fill the connection's pipeline from the pending requests
+  void Send( Connection&, ixRequest_t );
+  std::chrono::steady_clock::time_point Pace(); // when the next request may be sent
+
+  void HandleConnected( Connection& );
+  void HandleLine( Connection&, const char* bgn, const char* end );
+  void Complete( Connection&, ixRequest_t, bool bRetry );
+
+  void Consumer();
+
+  bool ParseTick( const char* bgn, const char* end, Result& );
+  bool ParseInterval( const char* bgn, const char* end, Result& );
+  bool ParseEndOfDay( const char* bgn, const char* end, Result& );
+
+};
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,411 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Decode.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed/Level2
+ * Created: 2026
+ */
+
+#include <limits>
+#include <cstring>
+
+#include "Decode.hpp"
+
+// http://www.iqfeed.net/dev/api/docs/docsBeta/MarketDepthMessages.cfm
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+namespace l2 { // level 2 data
+namespace msg { // message
+
+namespace {
+
+  // exact as doubles, same values as the qi pow10 table
+  const double rPow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const int nMaxPow10 = 22;
+
+  const int64_t rPow10Int[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+    10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+    1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000
+  };
+  const int nMaxDigits = 18;
+
+  inline bool Digit( const char* p, const char* end ) {
+    return ( end != p ) && ( '0' <= *p ) && ( '9' >= *p );
+  }
+
+  inline bool Char( const char*& p, const char* end, char ch ) {
+    if ( ( end != p ) && ( ch == *p ) ) {
+      ++p;
+      return true;
+    }
+    return false;
+  }
+
+  // qi::ulong_, qi::ulong_long, qi::ushort_: at least one digit, fails on overflow of max
+  inline bool Unsigned( const char*& p, const char* end, uint64_t max, uint64_t& value ) {
+    if ( !Digit( p, end ) ) return false;
+    uint64_t n {};
+    do {
+      const uint64_t d( *p - '0' );
+      if ( n > ( max - d ) / 10 ) return false;
+      n = n * 10 + d;
+      ++p;
+    } while ( Digit( p, end ) );
+    value = n;
+    return true;
+  }
+
+  const uint64_t nMaxULong = std::numeric_limits<unsigned long>::max();
+  const uint64_t nMaxULongLong = std::numeric_limits<unsigned long long>::max();
+  const uint64_t nMaxUShort = std::numeric_limits<unsigned short>::max();
+
+  // up to the next comma, which is consumed
+  inline bool Field( const char*& p, const char* end, std::string_view& sv ) {
+    const char* comma = static_cast<const char*>( std::memchr( p, ',', end - p ) );
+    if ( nullptr == comma ) return false;
+    sv = std::string_view( p, comma - p );
+    p = comma + 1;
+    return true;
+  }
+
+  // optional unsigned followed by a comma
+  inline bool OptionalUnsigned( const char*& p, const char* end, uint64_t max, uint64_t& value ) {
+    if ( Digit( p, end ) ) {
+      if ( !Unsigned( p, end, max, value ) ) return false;
+    }
+    return Char( p, end, ',' );
+  }
+
+  // four character market maker, or empty, followed by a comma
+  inline bool MMID( const char*& p, const char* end, OrderArrival::decoded::MMID& mmid, std::string_view& sv ) {
+    if ( !Field( p, end, sv ) ) return false;
+    if ( 4 < sv.size() ) return false;
+    mmid.id = 0;
+    std::memcpy( mmid.rch, sv.data(), sv.size() );
+    return true;
+  }
+
+  inline bool Side( const char*& p, const char* end, char& chSide ) {
+    if ( ( end != p ) && ( ( 'A' == *p ) || ( 'B' == *p ) ) ) {
+      chSide = *p;
+      ++p;
+      return Char( p, end, ',' );
+    }
+    return false;
+  }
+
+  // qi::double_: [+-] digits [ . digits ] [ e [+-] digits ], as mantissa and decimal exponent
+  //   digits are accumulated as qi does: at most 17 integer digits, the remainder only scale,
+  //   fraction digits until the uint64_t would overflow, the remainder is ignored
+  struct price_t {
+    bool bNegative;
+    uint64_t nMantissa;
+    int nExponent;
+  };
+
+  const int nMaxIntegerDigits = 17; // traits::max_digits10<double>
+
+  inline bool Price( const char*& p, const char* end, price_t& price ) {
+
+    price.bNegative = false;
+    if ( end != p ) {
+      if ( '-' == *p ) { price.bNegative = true; ++p; }
+      else if ( '+' == *p ) { ++p; }
+    }
+
+    uint64_t n {};
+    int nInteger {};
+    int nExcess {};
+    int nFraction {};
+
+    while ( Digit( p, end ) ) {
+      if ( nMaxIntegerDigits > nInteger ) {
+        n = n * 10 + ( *p - '0' );
+        nInteger++;
+      }
+      else nExcess++;
+      ++p;
+    }
+    if ( Char( p, end, '.' ) ) {
+      if ( 0 == nExcess ) {
+        while ( Digit( p, end ) ) {
+          const uint64_t d( *p - '0' );
+          if ( n > ( std::numeric_limits<uint64_t>::max() - d ) / 10 ) break;
+          n = n * 10 + d;
+          nFraction++;
+          ++p;
+        }
+      }
+      while ( Digit( p, end ) ) ++p;
+      if ( ( 0 == nInteger ) && ( 0 == nFraction ) ) return false;
+    }
+    else {
+      if ( 0 == nInteger ) return false; // inf, nan
+    }
+
+    int nExponent {};
+    if ( ( end != p ) && ( ( 'e' == *p ) || ( 'E' == *p ) ) ) {
+      const char* q( p + 1 );
+      bool bNegative( false );
+      if ( end != q ) {
+        if ( '-' == *q ) { bNegative = true; ++q; }
+        else if ( '+' == *q ) { ++q; }
+      }
+      if ( Digit( q, end ) ) {
+        while ( Digit( q, end ) ) {
+          nExponent = nExponent * 10 + ( *q - '0' );
+          ++q;
+          if ( 1000 < nExponent ) return false;
+        }
+        if ( bNegative ) nExponent = -nExponent;
+        p = q;
+      }
+      // else qi leaves the 'e' unconsumed, and the following comma fails
+    }
+
+    price.nMantissa = n;
+    price.nExponent = nExponent + nExcess - nFraction;
+    return true;
+  }
+
+  inline bool Double( const price_t& price, double& dbl ) {
+    if ( ( nMaxPow10 < price.nExponent ) || ( -nMaxPow10 > price.nExponent ) ) return false;
+    const double n( price.nMantissa ); // rounded once, as qi does, when beyond 2^53
+    dbl = ( 0 > price.nExponent ) ? n / rPow10[ -price.nExponent ] : n * rPow10[ price.nExponent ];
+    if ( price.bNegative ) dbl = -dbl;
+    return true;
+  }
+
+  // at nPrecision decimals, rounded half away from zero, 0 when it does not fit in an int64_t
+  inline int64_t Fixed( const price_t& price, uint8_t nPrecision ) {
+    const int nScale( nPrecision + price.nExponent );
+    uint64_t n( price.nMantissa );
+    const uint64_t nMax( std::numeric_limits<int64_t>::max() );
+    if ( 0 == n ) {}
+    else if ( 0 <= nScale ) {
+      if ( nMaxDigits < nScale ) return 0;
+      if ( n > nMax / rPow10Int[ nScale ] ) return 0;
+      n *= rPow10Int[ nScale ];
+    }
+    else {
+      if ( nMaxDigits < -nScale ) n = 0;
+      else {
+        const uint64_t nDivisor( rPow10Int[ -nScale ] );
+        n = n / nDivisor + ( ( n % nDivisor ) >= ( nDivisor + 1 ) / 2 ? 1 : 0 );
+      }
+      if ( n > nMax ) return 0;
+    }
+    return price.bNegative ? -(int64_t) n : (int64_t) n;
+  }
+
+  // [ HH:mm:ss.ffffff ] followed by a comma
+  template<typename time_type>
+  inline bool OptionalTime( const char*& p, const char* end, time_type& time ) {
+    if ( Digit( p, end ) ) {
+      uint64_t hh, mm, ss, ff;
+      if ( !Unsigned( p, end, nMaxULong, hh ) ) return false;
+      if ( !Char( p, end, ':' ) ) return false;
+      if ( !Unsigned( p, end, nMaxULong, mm ) ) return false;
+      if ( !Char( p, end, ':' ) ) return false;
+      if ( !Unsigned( p, end, nMaxULong, ss ) ) return false;
+      if ( !Char( p, end, '.' ) ) return false;
+      if ( !Unsigned( p, end, nMaxULong, ff ) ) return false;
+      time = time_type( (int32_t)(uint32_t) hh, (int32_t)(uint32_t) mm, (int32_t)(uint32_t) ss, (int32_t)(uint32_t) ff );
+    }
+    return Char( p, end, ',' );
+  }
+
+  // YYYY-MM-DD followed by a comma
+  template<typename date_type>
+  inline bool Date( const char*& p, const char* end, date_type& date ) {
+    uint64_t yy, mm, dd;
+    if ( !Unsigned( p, end, nMaxULong, yy ) ) return false;
+    if ( !Char( p, end, '-' ) ) return false;
+    if ( !Unsigned( p, end, nMaxULong, mm ) ) return false;
+    if ( !Char( p, end, '-' ) ) return false;
+    if ( !Unsigned( p, end, nMaxULong, dd ) ) return false;
+    date = date_type( (int32_t)(uint32_t) yy, (int32_t)(uint32_t) mm, (int32_t)(uint32_t) dd );
+    return Char( p, end, ',' );
+  }
+
+} // namespace anonymous
+
+namespace OrderArrival {
+
+// nasdaq l2: '6,QQQ,,AMEX,A,408.8400,100,,4,17:52:38.059128,2022-04-01,'
+bool Parse( const char* p, const char* end, decoded& msg, view& v ) {
+
+  if ( end == p ) return false;
+  switch ( *p ) {
+    case '6': // Order Summary
+    case '3': // Order Add
+    case '4': // Order Update
+    case '0': // Price Level Order
+      msg.chMsgType = *p;
+      ++p;
+      break;
+    default:
+      return false;
+  }
+  if ( !Char( p, end, ',' ) ) return false;
+
+  if ( !Field( p, end, v.svSymbolName ) ) return false;
+
+  uint64_t value {};
+  if ( !OptionalUnsigned( p, end, nMaxULongLong, value ) ) return false;
+  msg.nOrderId = value;
+
+  if ( !MMID( p, end, msg.mmid, v.svMMID ) ) return false;
+  if ( !Side( p, end, msg.chOrderSide ) ) return false;
+
+  price_t price;
+  if ( !Price( p, end, price ) ) return false;
+  if ( !Char( p, end, ',' ) ) return false;
+
+  if ( !Unsigned( p, end, nMaxULong, value ) ) return false;
+  msg.nQuantity = (uint32_t) value; // qi::ulong_ assigned to uint32_t
+  if ( !Char( p, end, ',' ) ) return false;
+
+  value = 0;
+  if ( !OptionalUnsigned( p, end, nMaxULongLong, value ) ) return false;
+  msg.nPriority = value;
+
+  if ( !Unsigned( p, end, nMaxUShort, value ) ) return false;
+  msg.nPrecision = (uint8_t) value; // qi::ushort_ assigned to uint8_t
+  if ( !Char( p, end, ',' ) ) return false;
+
+  msg.time = time_t();
+  if ( !OptionalTime( p, end, msg.time ) ) return false;
+  if ( !Date( p, end, msg.date ) ) return false;
+
+  if ( !Double( price, msg.dblPrice ) ) return false;
+  msg.nPrice = Fixed( price, msg.nPrecision );
+
+  return true;
+}
+
+} // namespace OrderArrival
+
+namespace OrderDelete {
+
+// '5,QQQ,,MEMX,B,,2022-04-06,'
+// "5,@ESZ21,648907593934,,A,20:32:47.333543,2021-10-24,"
+bool Parse( const char* p, const char* end, decoded& msg, view& v ) {
+
+  if ( !Char( p, end, '5' ) ) return false;
+  msg.chMsgType = '5';
+  if ( !Char( p, end, ',' ) ) return false;
+
+  if ( !Field( p, end, v.svSymbolName ) ) return false;
+
+  uint64_t value {};
+  if ( !OptionalUnsigned( p, end, nMaxULongLong, value ) ) return false;
+  msg.nOrderId = value;
+
+  static_assert( sizeof( decoded::MMID ) == sizeof( OrderArrival::decoded::MMID ) );
+  OrderArrival::decoded::MMID mmid;
+  if ( !MMID( p, end, mmid, v.svMMID ) ) return false;
+  msg.mmid.id = mmid.id;
+
+  if ( !Side( p, end, msg.chOrderSide ) ) return false;
+
+  msg.time = time_t();
+  if ( !OptionalTime( p, end, msg.time ) ) return false;
+  if ( !Date( p, end, msg.date ) ) return false;
+
+  return true;
+}
+
+} // namespace OrderDelete
+
+// ==== SymbolIds
+
+SymbolIds::SymbolIds()
+: m_idLast {}
+{
+  m_vName.emplace_back();
+  m_vHash.push_back( 0 );
+  m_vSlot.resize( 64 );
+}
+
+SymbolIds::~SymbolIds() {}
+
+std::uint32_t SymbolIds::Hash( std::string_view sv ) { // FNV-1a
+  std::uint32_t hash( 2166136261u );
+  for ( const char ch: sv ) {
+    hash ^= (unsigned char) ch;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+size_t SymbolIds::Slot( std::string_view sv, std::uint32_t hash ) const {
+  const size_t mask( m_vSlot.size() - 1 );
+  size_t ix( hash & mask );
+  while ( true ) {
+    const idSymbol_t id( m_vSlot[ ix ] );
+    if ( 0 == id ) break;
+    if ( ( hash == m_vHash[ id ] ) && ( sv == m_vName[ id ] ) ) break;
+    ix = ( ix + 1 ) & mask;
+  }
+  return ix;
+}
+
+void SymbolIds::Grow() {
+  std::vector<idSymbol_t> vSlot( 2 * m_vSlot.size() );
+  const size_t mask( vSlot.size() - 1 );
+  for ( idSymbol_t id = 1; id < m_vName.size(); id++ ) {
+    size_t ix( m_vHash[ id ] & mask );
+    while ( 0 != vSlot[ ix ] ) ix = ( ix + 1 ) & mask;
+    vSlot[ ix ] = id;
+  }
+  m_vSlot.swap( vSlot );
+}
+
+idSymbol_t SymbolIds::Find( std::string_view sv ) const {
+  if ( ( 0 != m_idLast ) && ( sv == m_vName[ m_idLast ] ) ) return m_idLast;
+  return m_vSlot[ Slot( sv, Hash( sv ) ) ];
+}
+
+idSymbol_t SymbolIds::Intern( std::string_view sv ) {
+  if ( ( 0 != m_idLast ) && ( sv == m_vName[ m_idLast ] ) ) return m_idLast;
+  const std::uint32_t hash( Hash( sv ) );
+  size_t ix( Slot( sv, hash ) );
+  if ( 0 == m_vSlot[ ix ] ) {
+    const idSymbol_t id( m_vName.size() );
+    m_vName.emplace_back( sv );
+    m_vHash.push_back( hash );
+    m_vSlot[ ix ] = id;
+    if ( m_vSlot.size() < 2 * m_vName.size() ) Grow();
+    m_idLast = id;
+  }
+  else {
+    m_idLast = m_vSlot[ ix ];
+  }
+  return m_idLast;
+}
+
+} // namespace msg
+} // namespace l2
+} // namesapce iqfeed
+} // namespace tf
+} // namespace ou
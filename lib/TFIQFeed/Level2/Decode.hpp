@@ -0,0 +1,97 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Decode.hpp
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed/Level2
+ * Created: 2026
+ */
+
+#pragma once
+
+// hand rolled decoding of the Level II messages, in place in the line buffer
+//   accepts what the grammars in MsgOrderArrival.h and MsgOrderDelete.h accept, except:
+//     a price of inf/nan, or with a scale beyond 10^22, is rejected
+//   nothing is allocated: symbol name and market maker are returned as views into the line,
+//     the optional fields of the decoded structure are reset, so one structure can be reused
+//   the price is decoded to a fixed point integer ( nPrice, at nPrecision decimals, 0 when it does not fit ),
+//     dblPrice is the same value as the grammar's qi::double_, there is no strtod
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include <TFIQFeed/Level2/MsgOrderArrival.h>
+#include <TFIQFeed/Level2/MsgOrderDelete.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+namespace l2 { // level 2 data
+namespace msg { // message
+
+struct view { // into the line buffer, valid until the buffer is given back
+  std::string_view svSymbolName;
+  std::string_view svMMID;
+};
+
+namespace OrderArrival {
+  // '3' Order Add, '4' Order Update, '6' Order Summary, '0' Price Level Order
+  //   sSymbolName and idSymbol are not touched, see Dispatcher
+  bool Parse( const char* begin, const char* end, decoded&, view& );
+} // namespace OrderArrival
+
+namespace OrderDelete {
+  // '5' Order Delete
+  bool Parse( const char* begin, const char* end, decoded&, view& );
+} // namespace OrderDelete
+
+using idSymbol_t = std::uint32_t;
+
+// symbol name to a dense integer id, for lookup of the book by vector index
+//   ids start at 1, are stable for the life of the object
+//   the last symbol is checked first, as a stream tends to repeat a symbol
+class SymbolIds {
+public:
+
+  SymbolIds();
+  ~SymbolIds();
+
+  idSymbol_t Intern( std::string_view ); // adds when not present
+  idSymbol_t Find( std::string_view ) const; // 0 when not present
+
+  const std::string& Name( idSymbol_t id ) const { return m_vName[ id ]; }
+  size_t Size() const { return m_vName.size() - 1; }
+
+protected:
+private:
+
+  idSymbol_t m_idLast;
+
+  std::vector<std::string> m_vName; // by id, 0 is empty
+  std::vector<std::uint32_t> m_vHash; // by id
+  std::vector<idSymbol_t> m_vSlot; // open addressing, linear probe, power of two, 0 is empty
+
+  static std::uint32_t Hash( std::string_view );
+  size_t Slot( std::string_view, std::uint32_t hash ) const; // of the id, or of the empty slot
+  void Grow();
+};
+
+} // namespace msg
+} // namespace l2
+} // namesapce iqfeed
+} // namespace tf
+} // namespace ou
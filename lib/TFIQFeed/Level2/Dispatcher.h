@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <OUCommon/Network.h>
@@ -28,6 +29,7 @@
 #include <TFIQFeed/Level2/MsgOrderClear.h>
 #include <TFIQFeed/Level2/MsgOrderArrival.h>
 #include <TFIQFeed/Level2/MsgOrderDelete.h>
+#include <TFIQFeed/Level2/Decode.hpp>
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -52,6 +54,9 @@ public:
   void StartPriceLevel( const std::string& ); // not implemented
   void StopPriceLevel( const std::string& );  // not implemented
 
+  // symbol names as found in the messages, idSymbol in the decoded messages
+  const msg::SymbolIds& GetSymbolIds() const { return m_symbolIds; }
+
 protected:
 
   // translated from network layer to eliminate name clash
@@ -75,8 +80,30 @@ private:
 
   bool m_bInitialized;
 
-  ou::tf::iqfeed::l2::msg::OrderArrival::parser_decoded<typename l2_linebuffer_t::iterator> m_parserArrival;
-  ou::tf::iqfeed::l2::msg::OrderDelete::parser_decoded<typename l2_linebuffer_t::iterator> m_parserDelete;
+  // decoded in place from the line buffer, reused for each message, see Decode.hpp
+  msg::view m_view;
+  msg::OrderArrival::decoded m_msgArrival;
+  msg::OrderDelete::decoded m_msgDelete;
+
+  msg::SymbolIds m_symbolIds;
+
+  // indexed by the message type, the first character of the line
+  using fMessage_t = void (Dispatcher<T>::*)( const char*, const char* );
+  using rMessage_t = std::array<fMessage_t, 256>;
+  rMessage_t m_rMessage;
+
+  bool DecodeArrival( const char*, const char* );
+  bool DecodeDelete( const char*, const char* );
+
+  void OrderAdd( const char*, const char* );
+  void OrderUpdate( const char*, const char* );
+  void OrderDelete( const char*, const char* );
+  void OrderSummary( const char*, const char* );
+  void PriceLevel( const char*, const char* );
+  void Timestamp( const char*, const char* ) {}
+  void System( const char*, const char* );
+  void Report( const char*, const char* );
+  void Unknown( const char*, const char* );
 
   // called by Network via CRTP
   void OnNetworkConnected();
@@ -91,7 +118,21 @@ template <typename T>
 Dispatcher<T>::Dispatcher()
 : ou::Network<Dispatcher<T> >( "127.0.0.1", 9200 ),
   m_bInitialized( false )
-{}
+{
+  m_rMessage.fill( &Dispatcher<T>::Unknown );
+  m_rMessage[ '3' ] = &Dispatcher<T>::OrderAdd;
+  m_rMessage[ '4' ] = &Dispatcher<T>::OrderUpdate; // Order/Level2 Update
+  m_rMessage[ '5' ] = &Dispatcher<T>::OrderDelete;
+  m_rMessage[ '6' ] = &Dispatcher<T>::OrderSummary; // Order/Level2 Summary
+  m_rMessage[ '7' ] = &Dispatcher<T>::PriceLevel; // Price Level Summary
+  m_rMessage[ '8' ] = &Dispatcher<T>::PriceLevel; // Price Level Update
+  m_rMessage[ '9' ] = &Dispatcher<T>::PriceLevel; // Price Level Delete
+  m_rMessage[ 'T' ] = &Dispatcher<T>::Timestamp;
+  m_rMessage[ 'S' ] = &Dispatcher<T>::System;
+  m_rMessage[ 'n' ] = &Dispatcher<T>::Report; // unknown symbol
+  m_rMessage[ 'q' ] = &Dispatcher<T>::Report; // no depth available
+  m_rMessage[ 'O' ] = &Dispatcher<T>::Report; // ignored
+}
 
 template <typename T>
 Dispatcher<T>::~Dispatcher() {
@@ -180,174 +221,195 @@ bool ParseSystemStatus( const std::string&, SystemStatus& );
 template <typename T>
 void Dispatcher<T>::OnNetworkLineBuffer( l2_linebuffer_t* pBuffer ) {
 
-  typename l2_linebuffer_t::iterator iter = (*pBuffer).begin();
-  typename l2_linebuffer_t::iterator end = (*pBuffer).end();
+  BOOST_ASSERT( 0 < pBuffer->size() );
 
-  BOOST_ASSERT( iter != end );
+  const char* begin = reinterpret_cast<const char*>( pBuffer->data() ); // unsigned char in the network layer
+  const char* end = begin + pBuffer->size();
 
-  switch ( *iter ) {
-    case '3': // Order Add
-      if ( &Dispatcher<T>::OnMBOAdd != &T::OnMBOAdd ) {
-        namespace OrderArrival = ou::tf::iqfeed::l2::msg::OrderArrival;
-        OrderArrival::decoded msg;
-        if ( OrderArrival::Decode( m_parserArrival, msg, iter, end) ) {
-          static_cast<T*>( this )->OnMBOAdd( msg );
-        }
-        else {
-          std::cout << "MarketDepth Order Add error" << std::endl;
-        }
-      }
-      break;
-    case '4': // Order/Level2 Update
-      if ( &Dispatcher<T>::OnMBOUpdate != &T::OnMBOUpdate ) {
-        namespace OrderArrival = ou::tf::iqfeed::l2::msg::OrderArrival;
-        OrderArrival::decoded msg;
-        if ( OrderArrival::Decode( m_parserArrival, msg, iter, end) ) {
-          static_cast<T*>( this )->OnMBOUpdate( msg );
-        }
-        else {
-          std::cout << "MarketDepth Order Update error" << std::endl;
-        }
-      }
-      break;
-    case '5': // Order Delete
-      if ( &Dispatcher<T>::OnMBODelete != &T::OnMBODelete ) {
-        namespace OrderDelete = ou::tf::iqfeed::l2::msg::OrderDelete;
-        OrderDelete::decoded msg;
-        if ( OrderDelete::Decode( m_parserDelete, msg, iter, end) ) {
-          static_cast<T*>( this )->OnMBODelete( msg );
-        }
-        else {
-          std::string str( iter, end );
-          std::cout
-            << "MarketDepth Order Delete error: '"
-            << str
-            << "'"
-            << "|" << ( end - iter )
-            << std::endl;
-        }
-      }
-      break;
-    case '6': // Order/Level2 Summary
-      if ( &Dispatcher<T>::OnMBOSummary != &T::OnMBOSummary ) {
-        namespace OrderArrival = ou::tf::iqfeed::l2::msg::OrderArrival;
-        OrderArrival::decoded msg;
-        if ( OrderArrival::Decode( m_parserArrival, msg, iter, end) ) {
-          static_cast<T*>( this )->OnMBOSummary( msg );
-        }
-        else {
-          std::cout << "MarketDepth Order Summary error" << std::endl;
-        }
-      }
-      break;
-    case '7': // Price Level Summary
+  ( this->*m_rMessage[ (unsigned char) *begin ] )( begin, end );
+
+  l2_inherited_t::GiveBackBuffer( pBuffer );
+
+}
+
+template <typename T>
+bool Dispatcher<T>::DecodeArrival( const char* begin, const char* end ) {
+  if ( msg::OrderArrival::Parse( begin, end, m_msgArrival, m_view ) ) {
+    m_msgArrival.idSymbol = m_symbolIds.Intern( m_view.svSymbolName );
+    m_msgArrival.sSymbolName.assign( m_view.svSymbolName ); // no allocation once the capacity is there
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+bool Dispatcher<T>::DecodeDelete( const char* begin, const char* end ) {
+  if ( msg::OrderDelete::Parse( begin, end, m_msgDelete, m_view ) ) {
+    m_msgDelete.idSymbol = m_symbolIds.Intern( m_view.svSymbolName );
+    m_msgDelete.sSymbolName.assign( m_view.svSymbolName );
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+void Dispatcher<T>::OrderAdd( const char* begin, const char* end ) {
+  if ( &Dispatcher<T>::OnMBOAdd != &T::OnMBOAdd ) {
+    if ( DecodeArrival( begin, end ) ) {
+      static_cast<T*>( this )->OnMBOAdd( m_msgArrival );
+    }
+    else {
+      std::cout << "MarketDepth Order Add error" << std::endl;
+    }
+  }
+}
+
+template <typename T>
+void Dispatcher<T>::OrderUpdate( const char* begin, const char* end ) {
+  if ( &Dispatcher<T>::OnMBOUpdate != &T::OnMBOUpdate ) {
+    if ( DecodeArrival( begin, end ) ) {
+      static_cast<T*>( this )->OnMBOUpdate( m_msgArrival );
+    }
+    else {
+      std::cout << "MarketDepth Order Update error" << std::endl;
+    }
+  }
+}
+
+template <typename T>
+void Dispatcher<T>::OrderDelete( const char* begin, const char* end ) {
+  if ( &Dispatcher<T>::OnMBODelete != &T::OnMBODelete ) {
+    if ( DecodeDelete( begin, end ) ) {
+      static_cast<T*>( this )->OnMBODelete( m_msgDelete );
+    }
+    else {
+      std::string str( begin, end );
+      std::cout
+        << "MarketDepth Order Delete error: '"
+        << str
+        << "'"
+        << "|" << ( end - begin )
+        << std::endl;
+    }
+  }
+}
+
+template <typename T>
+void Dispatcher<T>::OrderSummary( const char* begin, const char* end ) {
+  if ( &Dispatcher<T>::OnMBOSummary != &T::OnMBOSummary ) {
+    if ( DecodeArrival( begin, end ) ) {
+      static_cast<T*>( this )->OnMBOSummary( m_msgArrival );
+    }
+    else {
+      std::cout << "MarketDepth Order Summary error" << std::endl;
+    }
+  }
+}
+
+template <typename T>
+void Dispatcher<T>::PriceLevel( const char* begin, const char* /* end */ ) {
+  switch ( *begin ) {
+    case '7':
       std::cout << "MarketDepth Price Level Summary not implemented" << std::endl;
       break;
-    case '8': // Price Level Update
+    case '8':
       std::cout << "MarketDepth Price Level Update not implemented" << std::endl;
       break;
-    case '9': // Price Level Delete
+    case '9':
       std::cout << "MarketDepth Price Level Delete not implemented" << std::endl;
       break;
-    case 'T':
-      // ignore timestamp message
-      break;
-    case 'S':
-      {
-        std::string str( iter, end );
-        std::cout
-          << "system message: "
-          << str
-          << std::endl;
-        SystemStatus status;
-        bool bResult = ParseSystemStatus( str, status );
-        if ( bResult ) {
-          switch ( status.cmd ) {
-            case SystemStatus::ECmd::ServerConnected:
-              if ( !m_bInitialized ) {
-                m_bInitialized = true;
-                // make a message keyword parser? - from the spirit contribution repository
-                // TODO: for field comparisons, use spirit or the trie method
-                ou::Network<Dispatcher<T> >::Send( "S,TIMESTAMPSOFF\n" );  // TODO: maybe send on S,KEYOK, check that there are no listeners to the event
-                ou::Network<Dispatcher<T> >::Send( "S,SET PROTOCOL,6.2\n" );
-              }
-              break;
-            case SystemStatus::ECmd::CurrentProtocol:
-              if ( "6.2" == status.vString[0] ) {
-                OnL2Initialized();
-              }
-              else {
-                std::cout
-                  << "MarketDepth needs v6.2, found "
-                  << str
-                  << std::endl;
-              }
-              // nothing to do
-              break;
-            case SystemStatus::ECmd::ClearDepth:
-              //S,CLEAR DEPTH,@ESZ22,B,
-              //S,CLEAR DEPTH,@ESZ22,A,
-              // TODO: create an event
-              // may need to inject null message for use in simulator
-              if ( &Dispatcher<T>::OnMBOClear != &T::OnMBOClear ) {
-                namespace OrderClear = ou::tf::iqfeed::l2::msg::OrderClear;
-                assert( 2 == status.vString.size() );
-                assert( 1 == status.vString[1].size() );
-                OrderClear::decoded msg( status.vString[0], status.vString[1][0] );
-                static_cast<T*>( this )->OnMBOClear( msg );
-              }
-              break;
-            case SystemStatus::ECmd::ServerDisconnected:
-              // should get a clear depth after this
-              std::cout
-                << "MarketDepth server disconnected, fix state"
-                << std::endl;
-              break;
-            case SystemStatus::ECmd::Unknown:
-              std::cout
-                << "MarketDepth unknown status: "
-                << str
-                << std::endl;
-              break;
-          }
-        }
-        else {
-          std::cout
-            << "MarketDepth unparsed status: "
-            << str
-            << std::endl;
-        }
-      }
-      break;
+  }
+}
+
+template <typename T>
+void Dispatcher<T>::Report( const char* begin, const char* end ) {
+  std::string str( begin, end );
+  switch ( *begin ) {
     case 'n':
-      {
-        std::string str( iter, end );
-        std::cout << "MarketDepth Unknown symbol: '" << str << "'" << std::endl;
-      }
+      std::cout << "MarketDepth Unknown symbol: '" << str << "'" << std::endl;
       break;
     case 'q':
-      {
-        std::string str( iter, end );
-        std::cout << "MarketDepth no depth available: '" << str << "'" << std::endl;
-      }
+      std::cout << "MarketDepth no depth available: '" << str << "'" << std::endl;
       break;
     case 'O':
-      {
-        std::string str( iter, end );
-        std::cout << "MarketDepth ignored: " << str << std::endl;
-      }
-      break;
-    default:
-      {
-        //throw "Unknown message type in port 9200"; // unknown message type
-        std::string str( iter, end );
-        std::cout << "MarketDepth unknown message type: '" << str << "'" << std::endl;
-      }
+      std::cout << "MarketDepth ignored: " << str << std::endl;
       break;
   }
+}
 
-  l2_inherited_t::GiveBackBuffer( pBuffer );
+template <typename T>
+void Dispatcher<T>::Unknown( const char* begin, const char* end ) {
+  //throw "Unknown message type in port 9200"; // unknown message type
+  std::string str( begin, end );
+  std::cout << "MarketDepth unknown message type: '" << str << "'" << std::endl;
+}
 
+template <typename T>
+void Dispatcher<T>::System( const char* begin, const char* end ) {
+
+  std::string str( begin, end );
+  std::cout
+    << "system message: "
+    << str
+    << std::endl;
+  SystemStatus status;
+  bool bResult = ParseSystemStatus( str, status );
+  if ( bResult ) {
+    switch ( status.cmd ) {
+      case SystemStatus::ECmd::ServerConnected:
+        if ( !m_bInitialized ) {
+          m_bInitialized = true;
+          // make a message keyword parser? - from the spirit contribution repository
+          // TODO: for field comparisons, use spirit or the trie method
+          ou::Network<Dispatcher<T> >::Send( "S,TIMESTAMPSOFF\n" );  // TODO: maybe send on S,KEYOK, check that there are no listeners to the event
+          ou::Network<Dispatcher<T> >::Send( "S,SET PROTOCOL,6.2\n" );
+        }
+        break;
+      case SystemStatus::ECmd::CurrentProtocol:
+        if ( "6.2" == status.vString[0] ) {
+          OnL2Initialized();
+        }
+        else {
+          std::cout
+            << "MarketDepth needs v6.2, found "
+            << str
+            << std::endl;
+        }
+        // nothing to do
+        break;
+      case SystemStatus::ECmd::ClearDepth:
+        //S,CLEAR DEPTH,@ESZ22,B,
+        //S,CLEAR DEPTH,@ESZ22,A,
+        // TODO: create an event
+        // may need to inject null message for use in simulator
+        if ( &Dispatcher<T>::OnMBOClear != &T::OnMBOClear ) {
+          namespace OrderClear = ou::tf::iqfeed::l2::msg::OrderClear;
+          assert( 2 == status.vString.size() );
+          assert( 1 == status.vString[1].size() );
+          OrderClear::decoded msg( status.vString[0], status.vString[1][0], m_symbolIds.Intern( status.vString[0] ) );
+          static_cast<T*>( this )->OnMBOClear( msg );
+        }
+        break;
+      case SystemStatus::ECmd::ServerDisconnected:
+        // should get a clear depth after this
+        std::cout
+          << "MarketDepth server disconnected, fix state"
+          << std::endl;
+        break;
+      case SystemStatus::ECmd::Unknown:
+        std::cout
+          << "MarketDepth unknown status: "
+          << str
+          << std::endl;
+        break;
+    }
+  }
+  else {
+    std::cout
+      << "MarketDepth unparsed status: "
+      << str
+      << std::endl;
+  }
 }
 
 } // namespace l2
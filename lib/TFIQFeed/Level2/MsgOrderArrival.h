@@ -79,7 +79,9 @@ struct decoded {
   uint8_t nPrecision;
   time_t time;
   date_t date;
-  decoded(): nOrderId {}, nQuantity {}, nPriority {} {}
+  int64_t nPrice; // fixed point, dblPrice * 10^nPrecision, from msg::Parse, see Decode.hpp
+  uint32_t idSymbol; // from msg::SymbolIds in the Dispatcher, 0 when not interned
+  decoded(): nOrderId {}, nQuantity {}, nPriority {}, nPrice {}, idSymbol {} {}
   ptime dt() const { return ptime( date.date(), time.time() ); }
 };
 
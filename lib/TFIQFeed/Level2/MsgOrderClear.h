@@ -45,10 +45,11 @@ struct decoded {
   } mmid;
   char chOrderSide;  // 'A' Sell, 'B' Buy
   uint32_t nQuantity;
-  decoded(): nOrderId {}, nQuantity {} {}
-  decoded( const std::string& sSymbolName_, char chOrderSide_ )
-  : chMsgType( 'C' ), sSymbolName( sSymbolName_ ), chOrderSide( chOrderSide_ )
-  , nOrderId {},nQuantity {} {}
+  uint32_t idSymbol; // from msg::SymbolIds in the Dispatcher, 0 when not interned
+  decoded(): nOrderId {}, nQuantity {}, idSymbol {} {}
+  decoded( const std::string& sSymbolName_, char chOrderSide_, uint32_t idSymbol_ = 0 )
+  : chMsgType( 'C' ), sSymbolName( sSymbolName_ ), nOrderId {}
+  , chOrderSide( chOrderSide_ ), nQuantity {}, idSymbol( idSymbol_ ) {}
 };
 
 } // namespace OrderClear
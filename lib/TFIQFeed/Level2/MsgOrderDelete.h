@@ -78,7 +78,8 @@ struct decoded {
   char chOrderSide;  // 'A' Sell, 'B' Buy
   time_t time;
   date_t date;
-  decoded(): nOrderId {} {}
+  uint32_t idSymbol; // from msg::SymbolIds in the Dispatcher, 0 when not interned
+  decoded(): nOrderId {}, idSymbol {} {}
   ptime dt() const { return ptime( date.date(), time.time() ); }
 };
 
@@ -465,7 +465,6 @@ Symbols::Symbols( fConnected_t&& fConnected )
 : inherited_t()
 , m_bSingle( false )
 , m_fConnected( std::move( fConnected ) )
-, m_luSymbol( Carrier(), 20 )
 {}
 
 Symbols::~Symbols() {
@@ -473,7 +472,7 @@ Symbols::~Symbols() {
 
 void Symbols::Single( bool bSingle ) {
   if ( bSingle ) {
-    assert( 1 >= m_luSymbol.GetNodeCount() );
+    assert( m_vCarrier.empty() );
   }
   else {
     assert( m_single.IsNull() );
@@ -534,7 +533,7 @@ void Symbols::WatchDel( const std::string& sSymbol ) {
   StopMarketByOrder( sSymbol );
   mapL2Base_t::iterator iter = m_mapL2Base.find( sSymbol );
   //m_mapL2Base.erase( iter );
-  // TODO: need to update m_luSymbol/m_single as well
+  // TODO: need to update m_vCarrier/m_single as well
   // TODO: may need some sort of sync if values come in during the meantime
 }
 
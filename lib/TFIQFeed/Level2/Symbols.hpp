@@ -22,11 +22,10 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <boost/log/trivial.hpp>
 
-#include <OUCommon/KeyWordMatch.h>
-
 #include <TFTimeSeries/DatedDatum.h>
 #include <TFTimeSeries/TimeSeries.h>
 
@@ -481,12 +480,13 @@ protected:
 
 private:
 
-  bool m_bSingle;  // don't use m_luSymbol, dedicated to single symbol
+  bool m_bSingle;  // don't use m_vCarrier, dedicated to single symbol
   Carrier m_single; // carrier for single symbol
 
   fConnected_t m_fConnected;
 
-  ou::KeyWordMatch<Carrier> m_luSymbol; // contains the carrier as destination for inbound records
+  using vCarrier_t = std::vector<Carrier>; // by idSymbol, see Dispatcher::GetSymbolIds
+  vCarrier_t m_vCarrier; // contains the carrier as destination for inbound records
 
   struct BookChangeFunctions {
 
@@ -595,10 +595,13 @@ private:
       (m_single.pL2Base->*f)( msg );
     }
     else {
-      Carrier carrier = m_luSymbol.FindMatch( msg.sSymbolName );
+      assert( 0 != msg.idSymbol );
+      if ( m_vCarrier.size() <= msg.idSymbol ) {
+        m_vCarrier.resize( msg.idSymbol + 1 );
+      }
+      Carrier& carrier( m_vCarrier[ msg.idSymbol ] );
       if ( carrier.IsNull() ) {
         SetCarrier( carrier, msg );
-        m_luSymbol.AddPattern( msg.sSymbolName, carrier );
       }
       (carrier.pL2Base->*f)( msg );
     }
@@ -0,0 +1,248 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    NewsRouter.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed
+ * Created: 2026
+ */
+
+#include <cctype>
+#include <algorithm>
+
+#include "Messages.h"
+#include "NewsRouter.h"
+
+namespace {
+  // removed patterns leave nodes in the trie, rebuild once they outnumber the live ones
+  const size_t c_nSlackNodes( 1024 );
+
+  inline bool IsWordChar( const char ch ) { return 0 != std::isalnum( (unsigned char) ch ); }
+}
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+NewsRouter::NewsRouter()
+: m_bChanged( false )
+, m_nPatternChars {}
+, m_nScan {}
+{}
+
+NewsRouter::~NewsRouter() {}
+
+size_t NewsRouter::GetKeyCount() const {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  return m_mapKey.size();
+}
+
+size_t NewsRouter::GetPatternCount() const {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  return m_ac.GetPatternCount();
+}
+
+size_t NewsRouter::LockedWatch( const std::string& sKey ) {
+  std::unordered_map<std::string, size_t>::iterator iter = m_mapKey.find( sKey );
+  if ( m_mapKey.end() != iter ) return iter->second;
+
+  size_t ixHandler;
+  if ( m_vHandlerFree.empty() ) {
+    ixHandler = m_vHandler.size();
+    m_vHandler.emplace_back( nullptr );
+    m_vScan.push_back( 0 );
+  }
+  else {
+    ixHandler = m_vHandlerFree.back();
+    m_vHandlerFree.pop_back();
+  }
+  m_vHandler[ ixHandler ] = std::make_shared<Handler>( sKey );
+  m_vScan[ ixHandler ] = m_nScan;
+  m_mapKey.emplace( sKey, ixHandler );
+  return ixHandler;
+}
+
+void NewsRouter::Watch( const std::string& sKey, fMatch_t&& fMatch ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  const size_t ixHandler( LockedWatch( sKey ) );
+  // a copy, a Route in progress may be calling the current handler
+  pHandler_t pHandler( std::make_shared<Handler>( *m_vHandler[ ixHandler ] ) );
+  pHandler->fMatch = std::move( fMatch );
+  m_vHandler[ ixHandler ] = pHandler;
+}
+
+void NewsRouter::WatchSymbol( const std::string& sSymbol, fMatch_t&& fMatch ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  const size_t ixHandler( LockedWatch( sSymbol ) );
+  pHandler_t pHandler( std::make_shared<Handler>( *m_vHandler[ ixHandler ] ) );
+  pHandler->fMatch = std::move( fMatch );
+  m_vHandler[ ixHandler ] = pHandler;
+  LockedAttach( ixHandler, sSymbol );
+}
+
+void NewsRouter::Unwatch( const std::string& sKey ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  std::unordered_map<std::string, size_t>::iterator iter = m_mapKey.find( sKey );
+  if ( m_mapKey.end() != iter ) {
+    const size_t ixHandler( iter->second );
+    for ( const std::string& sPattern: m_vHandler[ ixHandler ]->vPattern ) {
+      LockedDetach( ixHandler, sPattern );
+    }
+    m_vHandler[ ixHandler ].reset();
+    m_vHandlerFree.push_back( ixHandler );
+    m_mapKey.erase( iter );
+  }
+}
+
+void NewsRouter::AddPattern( const std::string& sKey, const std::string& sPattern ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  LockedAttach( LockedWatch( sKey ), sPattern );
+}
+
+void NewsRouter::RemovePattern( const std::string& sKey, const std::string& sPattern ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  std::unordered_map<std::string, size_t>::iterator iter = m_mapKey.find( sKey );
+  if ( m_mapKey.end() != iter ) {
+    const idPattern_t id( m_ac.Find( sPattern ) );
+    if ( 0 != id ) {
+      std::vector<std::string>& vPattern( m_vHandler[ iter->second ]->vPattern );
+      const size_t nPattern( vPattern.size() );
+      vPattern.erase( // as the search, case insensitive
+        std::remove_if(
+          vPattern.begin(), vPattern.end(),
+          [this,id]( const std::string& s ){ return id == m_ac.Find( s ); } ),
+        vPattern.end() );
+      if ( nPattern != vPattern.size() ) {
+        LockedDetach( iter->second, sPattern );
+      }
+    }
+  }
+}
+
+// vPattern of the handler is not shared with a Route in progress, it is only used under the lock
+void NewsRouter::LockedAttach( size_t ixHandler, const std::string& sPattern ) {
+  const idPattern_t id( m_ac.Add( sPattern ) );
+  if ( m_vvPatternHandler.size() <= id ) {
+    m_vvPatternHandler.resize( m_ac.GetNodeCount() );
+  }
+  std::vector<size_t>& vHandler( m_vvPatternHandler[ id ] );
+  if ( vHandler.end() == std::find( vHandler.begin(), vHandler.end(), ixHandler ) ) {
+    if ( vHandler.empty() ) m_nPatternChars += sPattern.size();
+    vHandler.push_back( ixHandler );
+    m_vHandler[ ixHandler ]->vPattern.push_back( sPattern );
+    m_bChanged = true;
+  }
+}
+
+void NewsRouter::LockedDetach( size_t ixHandler, const std::string& sPattern ) {
+  const idPattern_t id( m_ac.Find( sPattern ) );
+  if ( ( 0 == id ) || ( m_vvPatternHandler.size() <= id ) ) return;
+  std::vector<size_t>& vHandler( m_vvPatternHandler[ id ] );
+  std::vector<size_t>::iterator iter = std::find( vHandler.begin(), vHandler.end(), ixHandler );
+  if ( vHandler.end() != iter ) {
+    vHandler.erase( iter );
+    if ( vHandler.empty() ) {
+      m_ac.Remove( id );
+      m_nPatternChars -= sPattern.size();
+    }
+    m_bChanged = true;
+  }
+}
+
+void NewsRouter::Compile() {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  LockedCompile();
+}
+
+// relink the trie, or rebuild it from the patterns in use when removals have left it mostly dead
+void NewsRouter::LockedCompile() {
+
+  if ( m_ac.GetNodeCount() > 2 * m_nPatternChars + c_nSlackNodes ) {
+    m_ac.Clear();
+    m_vvPatternHandler.clear();
+    m_nPatternChars = 0;
+    for ( size_t ixHandler = 0; ixHandler < m_vHandler.size(); ixHandler++ ) {
+      if ( m_vHandler[ ixHandler ] ) {
+        std::vector<std::string> vPattern;
+        vPattern.swap( m_vHandler[ ixHandler ]->vPattern );
+        for ( const std::string& sPattern: vPattern ) {
+          LockedAttach( ixHandler, sPattern );
+        }
+      }
+    }
+  }
+
+  m_ac.Compile();
+  m_bChanged = false;
+}
+
+void NewsRouter::LockedScan( const char* bgn, const char* end ) {
+  m_ac.Search(
+    bgn, end,
+    [this,bgn,end]( idPattern_t id, const char* bgnMatch, const char* endMatch ){
+      if ( ( bgn != bgnMatch ) && IsWordChar( bgnMatch[ -1 ] ) ) return;
+      if ( ( end != endMatch ) && IsWordChar( *endMatch ) ) return;
+      for ( const size_t ixHandler: m_vvPatternHandler[ id ] ) {
+        if ( m_nScan != m_vScan[ ixHandler ] ) {
+          m_vScan[ ixHandler ] = m_nScan;
+          m_vHit.emplace_back( Hit { m_vHandler[ ixHandler ], bgnMatch, endMatch, bgn, end } );
+        }
+      }
+    } );
+}
+
+void NewsRouter::Dispatch( const vHit_t& vHit, const IQFNewsMessage* pMsg ) {
+  for ( const Hit& hit: vHit ) {
+    if ( hit.pHandler->fMatch ) {
+      hit.pHandler->fMatch( Match( hit.pHandler->sKey, hit.bgnMatch, hit.endMatch, hit.bgnLine, hit.endLine, pMsg ) );
+    }
+  }
+}
+
+void NewsRouter::Route( const IQFNewsMessage& msg ) {
+  vHit_t vHit;
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( m_bChanged ) LockedCompile();
+    m_nScan++;
+    auto scan =
+      [this]( const IQFNewsMessage::fielddelimiter_t& fd ){
+        if ( fd.first != fd.second ) {
+          const char* bgn( reinterpret_cast<const char*>( &*fd.first ) );
+          LockedScan( bgn, bgn + ( fd.second - fd.first ) );
+        }
+      };
+    scan( msg.SymbolList_iter() );
+    scan( msg.HeadLine_iter() );
+    vHit.swap( m_vHit ); // a concurrent Route scans into an empty m_vHit
+  }
+  Dispatch( vHit, &msg );
+}
+
+void NewsRouter::Route( const char* bgn, const char* end ) {
+  vHit_t vHit;
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( m_bChanged ) LockedCompile();
+    m_nScan++;
+    LockedScan( bgn, end );
+    vHit.swap( m_vHit );
+  }
+  Dispatch( vHit, nullptr );
+}
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,135 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    NewsRouter.h
+ * Author:  raymond@burkholder.net
+ * Project: TFIQFeed
+ * Created: 2026
+ */
+
+#pragma once
+
+// routes news to handlers by key, usually a symbol
+//   each key has a handler and a set of patterns: the symbol itself, company names, keywords, phrases
+//   all patterns of all keys are compiled into one AhoCorasick automaton,
+//     so a headline or story line is scanned once whatever the size of the watch set
+//   patterns match whole words, case insensitive
+//   a news message is scanned in its symbol list ( :AAPL:MSFT: ) and its headline
+//   a handler is called at most once per message or line, with the first occurrence found
+//   the watch set may be changed from any thread, the automaton is relinked on the next Route,
+//     handlers are called on the thread calling Route, without the lock, so may change the watch set
+//   Route itself is called from one thread, the one delivering the news
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+#include <OUCommon/AhoCorasick.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace iqfeed { // IQFeed
+
+class IQFNewsMessage;
+
+class NewsRouter {
+public:
+
+  struct Match {
+    const std::string& sKey;
+    const char* bgnMatch; // the occurrence
+    const char* endMatch;
+    const char* bgnLine; // the text scanned
+    const char* endLine;
+    const IQFNewsMessage* pMsg; // nullptr for a story line
+    Match( const std::string& sKey_, const char* bgnMatch_, const char* endMatch_, const char* bgnLine_, const char* endLine_, const IQFNewsMessage* pMsg_ )
+    : sKey( sKey_ ), bgnMatch( bgnMatch_ ), endMatch( endMatch_ ), bgnLine( bgnLine_ ), endLine( endLine_ ), pMsg( pMsg_ ) {}
+  };
+
+  using fMatch_t = std::function<void(const Match&)>;
+
+  NewsRouter();
+  ~NewsRouter();
+
+  void Watch( const std::string& sKey, fMatch_t&& ); // replaces the handler of an existing key, patterns are kept
+  void WatchSymbol( const std::string& sSymbol, fMatch_t&& ); // Watch, with the symbol as a pattern
+  void Unwatch( const std::string& sKey ); // the handler and its patterns
+
+  void AddPattern( const std::string& sKey, const std::string& sPattern ); // the key is watched
+  void RemovePattern( const std::string& sKey, const std::string& sPattern );
+
+  void Compile(); // optional, otherwise done by the first Route after a change
+
+  void Route( const IQFNewsMessage& ); // streaming headline
+  void Route( const char* bgn, const char* end ); // eg, a story line from a news query
+
+  size_t GetKeyCount() const;
+  size_t GetPatternCount() const;
+
+protected:
+private:
+
+  using idPattern_t = ou::AhoCorasick::idPattern_t;
+
+  struct Handler {
+    std::string sKey;
+    fMatch_t fMatch;
+    std::vector<std::string> vPattern;
+    Handler( const std::string& sKey_ ): sKey( sKey_ ) {}
+  };
+  using pHandler_t = std::shared_ptr<Handler>;
+  using vHandler_t = std::vector<pHandler_t>;
+
+  struct Hit { // a handler matched in the current scan
+    pHandler_t pHandler;
+    const char* bgnMatch;
+    const char* endMatch;
+    const char* bgnLine;
+    const char* endLine;
+  };
+  using vHit_t = std::vector<Hit>;
+
+  mutable std::mutex m_mutex;
+
+  bool m_bChanged;
+  size_t m_nPatternChars; // of the patterns in use, bounds the live nodes
+
+  ou::AhoCorasick m_ac;
+
+  vHandler_t m_vHandler; // nullptr when free
+  std::vector<size_t> m_vHandlerFree;
+  std::unordered_map<std::string, size_t> m_mapKey; // to m_vHandler
+
+  std::vector<std::vector<size_t> > m_vvPatternHandler; // by idPattern_t, the handlers using the pattern
+
+  std::vector<std::uint32_t> m_vScan; // by handler, the scan which last matched it
+  std::uint32_t m_nScan;
+
+  vHit_t m_vHit; // filled by LockedScan, moved out before the lock is released
+
+  size_t LockedWatch( const std::string& sKey );
+  void LockedAttach( size_t ixHandler, const std::string& sPattern );
+  void LockedDetach( size_t ixHandler, const std::string& sPattern );
+  void LockedCompile();
+  void LockedScan( const char* bgn, const char* end );
+  void Dispatch( const vHit_t&, const IQFNewsMessage* ); // without the lock
+};
+
+} // namespace iqfeed
+} // namespace tf
+} // namespace ou
@@ -18,6 +18,7 @@
 #include <TFTrading/OrderManager.h>
 
 #include "Provider.h"
+#include "NewsRouter.h"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -26,6 +27,7 @@ namespace iqfeed { // IQFeed
 Provider::Provider()
 : ou::tf::sim::SimulationInterface<Provider,IQFeedSymbol>()
 , IQFeed<Provider>()
+, m_pNewsRouter( nullptr )
 {
   m_sName = "IQFeed";
   m_nID = keytypes::EProviderIQF;
@@ -312,6 +314,9 @@ void Provider::OnIQFeedNewsMessage( linebuffer_t* pBuffer, IQFNewsMessage *pMsg
     } while ( 0 != *ixLstColon );
   }
   */
+  if ( nullptr != m_pNewsRouter ) {
+    m_pNewsRouter->Route( *pMsg );
+  }
   this->NewsDone( pBuffer, pMsg );
 }
 
@@ -23,6 +23,8 @@ namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace iqfeed { // IQFeed
 
+class NewsRouter;
+
 class Provider :
   public ou::tf::sim::SimulationInterface<Provider,IQFeedSymbol>
 , public IQFeed<Provider>
@@ -60,6 +62,9 @@ public:
 
   std::string ListedMarket( key_t nListedMarket ) const { return LookupListedMarket( nListedMarket ); }
 
+  // streaming headlines are passed to the router, SetNewsOn to receive them, nullptr to stop
+  void SetNewsRouter( NewsRouter* pNewsRouter ) { m_pNewsRouter = pNewsRouter; }
+
 protected:
 
   // overridden from ProviderInterface, called when application adds/removes watches
@@ -86,6 +91,8 @@ protected:
 
 private:
 
+  NewsRouter* m_pNewsRouter;
+
   void UpdateQuoteTradeWatch( char command, IQFeedSymbol::WatchState next, IQFeedSymbol *pSymbol );
 
   void HandleExecution( Order::idOrder_t orderId, const Execution &exec );
@@ -43,7 +43,8 @@ public:
   Darvas<T>(void);
   ~Darvas<T>(void);
   void operator()( const Bar& bar ) { Calc( bar ); };
-  void Calc( const Bar& bar );
+  void Calc( const Bar& bar ) { Calc( bar.High(), bar.Low(), bar.Close() ); };
+  void Calc( double dblHigh, double dblLow, double dblClose ); // eg, from columns, see TFStatistics/BarKernels.h
   void Clear( void ) { 
     ResetState(); 
     m_dblTop = m_dblBottom = m_dblStop = m_dblGhostHeight = m_cntBreakOuts = 0;
@@ -95,41 +96,41 @@ void Darvas<T>::ResetState( void ) {
 }
 
 template <typename T>
-void Darvas<T>::Calc(const Bar& bar) {
+void Darvas<T>::Calc( double dblHigh, double dblLow, double dblClose ) {
   switch ( m_stateTop ) {
     case ELookingForHigh: 
       ResetState();
-      m_dblTop = bar.High();
+      m_dblTop = dblHigh;
       break;
     case ELookingForLowerHigh1:
-      if ( m_dblTop < bar.High() ) {
+      if ( m_dblTop < dblHigh ) {
         ResetState();
-        m_dblTop = bar.High();
+        m_dblTop = dblHigh;
       }
       else {
         m_stateTop = ELookingForLowerHigh2;
       }
       break;
     case ELookingForLowerHigh2:
-      if ( m_dblTop < bar.High() ) {
+      if ( m_dblTop < dblHigh ) {
         ResetState();
-        m_dblTop = bar.High();
+        m_dblTop = dblHigh;
       }
       else {
         m_stateTop = ELookingForLowerHigh3;
       }
       break;
     case ELookingForLowerHigh3:
-      if ( m_dblTop < bar.High() ) {
+      if ( m_dblTop < dblHigh ) {
         ResetState();
-        m_dblTop = bar.High();
+        m_dblTop = dblHigh;
       }
       else {
         m_stateTop = ETopFound;
       }
       break;
     case ETopFound:
-      if ( m_dblTop < bar.Close() ) {
+      if ( m_dblTop < dblClose ) {
         if ( EBottomFound == m_stateBottom ) {
           // issue conservative trigger
           static_cast<T*>( this )->ConservativeTrigger();
@@ -138,7 +139,7 @@ void Darvas<T>::Calc(const Bar& bar) {
           static_cast<T*>( this )->BreakOutAlert( m_cntBreakOuts );
         }
         ResetState();
-        m_dblTop = bar.High();
+        m_dblTop = dblHigh;
       }
       break;
     case EStopLooking:
@@ -147,29 +148,29 @@ void Darvas<T>::Calc(const Bar& bar) {
 
   switch ( m_stateBottom ) {
     case ELookingForBottom:
-      m_dblBottom = bar.Low();
+      m_dblBottom = dblLow;
       m_stateBottom = ELookingForHigherLow1;
       break;
     case ELookingForHigherLow1:
-      if ( m_dblBottom <= bar.Low() ) {
+      if ( m_dblBottom <= dblLow ) {
         m_stateBottom = ELookingForHigherLow2;
       }
       else {
-        m_dblBottom = bar.Low();
+        m_dblBottom = dblLow;
         m_stateBottom = ELookingForHigherLow1;  // yes stay in the same state
       }
       break;
     case ELookingForHigherLow2:
-      if ( m_dblBottom <= bar.Low() ) {
+      if ( m_dblBottom <= dblLow ) {
         m_stateBottom = ELookingForHigherLow3;
       }
       else {
-        m_dblBottom = bar.Low();
+        m_dblBottom = dblLow;
         m_stateBottom = ELookingForHigherLow1; 
       }
       break;
     case ELookingForHigherLow3:
-      if ( m_dblBottom <= bar.Low() ) {
+      if ( m_dblBottom <= dblLow ) {
         m_stateBottom = EBottomFound;
         m_dblGhostHeight = m_dblTop - m_dblBottom;
 //        if ( m_dblBottom > m_dblStop ) {  // considers if stop has been moved by GhostHeight
@@ -179,7 +180,7 @@ void Darvas<T>::Calc(const Bar& bar) {
         static_cast<T*>( this )->SetStop( m_dblStop );
       }
       else {
-        m_dblBottom = bar.Low();
+        m_dblBottom = dblLow;
         m_stateBottom = ELookingForHigherLow1; 
       }
       break;
@@ -187,7 +188,7 @@ void Darvas<T>::Calc(const Bar& bar) {
       break;
   };
 
-  if ( m_dblStop > bar.Close() ) {
+  if ( m_dblStop > dblClose ) {
     ResetState();  // start looking again
     m_dblTop = 0;
     m_cntBreakOuts = 0;
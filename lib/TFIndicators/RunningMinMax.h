@@ -15,6 +15,8 @@
 #pragma once
 
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <stdexcept>
 
 namespace ou { // One Unified
@@ -32,6 +34,10 @@ public:
   void Add( const value_t& );
   void Remove( const value_t& );
 
+  // batch priming: the value counts do not depend upon order, so the terminal state matches
+  //   Add of each value in turn, UpdateOnAdd is called once with the final min/max
+  void Add( const value_t* bgn, const value_t* end );
+
   value_t Min() const {
     if ( 0 == m_mapValueCount.size() ) throw std::runtime_error( "no value available" );
     return m_mapValueCount.begin()->first;
@@ -87,6 +93,35 @@ void RunningMinMax<CRTP,value_t>::Add(const value_t& value) {
 
 }
 
+template<typename CRTP, typename value_t>
+void RunningMinMax<CRTP,value_t>::Add( const value_t* bgn, const value_t* end ) {
+
+  if ( bgn == end ) return;
+
+  // sort a copy, then one map lookup per distinct value rather than per value
+  std::vector<value_t> vValue( bgn, end );
+  std::sort( vValue.begin(), vValue.end() );
+
+  typename std::vector<value_t>::const_iterator iter = vValue.begin();
+  while ( vValue.end() != iter ) {
+    typename std::vector<value_t>::const_iterator next = std::upper_bound( iter, vValue.cend(), *iter );
+    const unsigned int n = next - iter;
+    typename mapValueCount_t::iterator hint = m_mapValueCount.lower_bound( *iter );
+    if ( ( m_mapValueCount.end() != hint ) && !( *iter < hint->first ) ) {
+      hint->second += n;
+    }
+    else {
+      hint = m_mapValueCount.insert( hint, typename mapValueCount_t::value_type( *iter, n ) );
+    }
+    iter = next;
+  }
+
+  if ( &RunningMinMax<CRTP,value_t>::UpdateOnAdd != &CRTP::UpdateOnAdd ) {
+    static_cast<CRTP*>(this)->UpdateOnAdd( m_mapValueCount.begin()->first, m_mapValueCount.rbegin()->first );
+  }
+
+}
+
 template<typename CRTP, typename value_t>
 void RunningMinMax<CRTP,value_t>::Remove( const value_t& value ) {
 
@@ -75,6 +75,13 @@ void TSDifferential::Init( void ) {
   m_pema5 = new TSEMA<Price>( *m_pema4, m_dtAlphaBetaTau );
   m_pema6 = new TSEMA<Price>( *m_pema5, m_dtAlphaBetaTau );
   m_pema6->OnAppend.Add( MakeDelegate( this, &TSDifferential::HandleTerm3Update ) );
+  // only the most recent value of each stage is used, the stages need not keep their series
+  m_pema1->DisableAppend();
+  m_pema2->DisableAppend();
+  m_pema3->DisableAppend();
+  m_pema4->DisableAppend();
+  m_pema5->DisableAppend();
+  m_pema6->DisableAppend();
 }
 
 void TSDifferential::HandleTerm1Update( const Price& price ) {
@@ -18,6 +18,8 @@
 
 #include <math.h>
 
+#include <algorithm>
+
 #include <TFTimeSeries/TimeSeries.h>
 
 namespace ou { // One Unified
@@ -36,6 +38,11 @@ public:
 
   inline double GetEMA() const { return m_dblRecentEMA; };
 
+  // prime from history loaded into the source with TimeSeries::Append( bgn, end ), pass the same span:
+  //   values match those of the tick path, the ema series is bulk appended (OnAppend is not fired),
+  //   OnUpdate fires once with the final value
+  void WarmStart( const D* bgn, const D* end );
+
   ou::Delegate<const ou::tf::Price&> OnUpdate;
 
 protected:
@@ -50,6 +57,8 @@ private:
 
   void EMA( ptime t, double XatT );
 
+  static const size_t c_nBlock = 256; // WarmStart works through the span in blocks of this size
+
   void HandleAppend( const D& datum ) {
     EMA( datum.DateTime(), GetPrice( datum ) );
   }
@@ -181,6 +190,72 @@ void TSEMA<D>::EMA( ptime dt, double XatT ) {
 
 }
 
+template<class D>
+void TSEMA<D>::WarmStart( const D* bgn, const D* end ) {
+
+  static const time_duration tdOne( microseconds( 1 ) );
+
+  if ( bgn == end ) return;
+
+  if ( 0 == Prices::Size() ) {
+    const double XatT( GetPrice( *bgn ) );
+    m_dblRecentEMA = XatT;
+    m_XatTminus1 = XatT;
+    const ou::tf::Price price( bgn->DateTime(), XatT );
+    ou::tf::Prices::Append( &price, &price + 1 );  // initialize first element of series
+    ++bgn;
+    if ( bgn == end ) return;
+  }
+
+  Prices::Reserve( Prices::Size() + ( end - bgn ) );
+
+  double rX[ c_nBlock ];
+  double rAlpha[ c_nBlock ];
+  double rMu[ c_nBlock ];
+  double rV[ c_nBlock ];
+  ou::tf::Price rPrice[ c_nBlock ];
+
+  ptime dtPrv( ou::tf::Prices::last().DateTime() );
+  double dblPrvEMA( ou::tf::Prices::last().Value() );
+
+  while ( bgn != end ) {
+    const size_t n = std::min<size_t>( c_nBlock, end - bgn );
+
+    // pass 1: weights, independent of the recurrence
+    for ( size_t ix = 0; ix < n; ++ix ) {
+      const D& datum( bgn[ ix ] );
+      const ptime dt( datum.DateTime() );
+      const time_duration tdDif = dt == dtPrv ? tdOne : dt - dtPrv;
+      const double alpha = ( (double) tdDif.total_microseconds() ) / m_dblTimeRange;
+      rAlpha[ ix ] = alpha;
+      rX[ ix ] = GetPrice( datum );
+      dtPrv = dt;
+    }
+    for ( size_t ix = 0; ix < n; ++ix ) {
+      const double alpha( rAlpha[ ix ] );
+      const double mu = std::exp( -alpha );
+      rV[ ix ] = ( 1.0 - mu ) / alpha;
+      rMu[ ix ] = mu;
+    }
+
+    // pass 2: the recurrence, same expression as EMA()
+    for ( size_t ix = 0; ix < n; ++ix ) {
+      const double mu( rMu[ ix ] );
+      const double v( rV[ ix ] );
+      const double XatT( rX[ ix ] );
+      dblPrvEMA = mu * dblPrvEMA + ( v - mu ) * m_XatTminus1 + ( 1.0 - v ) * XatT; // ema calc
+      m_XatTminus1 = XatT;
+      rPrice[ ix ] = ou::tf::Price( bgn[ ix ].DateTime(), dblPrvEMA );
+    }
+
+    ou::tf::Prices::Append( rPrice, rPrice + n );
+    bgn += n;
+  }
+
+  m_dblRecentEMA = dblPrvEMA;
+  OnUpdate( ou::tf::Prices::last() );
+}
+
 } // namespace hf
 } // namespace tf
 } // namespace ou
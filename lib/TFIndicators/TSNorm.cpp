@@ -21,16 +21,18 @@ namespace tf { // TradeFrame
 namespace hf { // high frequency
 
 TSNorm::TSNorm( Prices& series, time_duration dt, unsigned int n, double p ) 
-  : m_seriesSource( series ), m_dtTimeRange( dt ), m_n( n ), m_p( p ), m_ma( *this, dt, n )
+  : m_seriesSource( series ), m_dtTimeRange( dt ), m_n( n ), m_p( p ), m_ma( m_seriesPower, dt, n )
 {
+  m_seriesPower.DisableAppend();
   m_seriesSource.OnAppend.Add( MakeDelegate( this, &TSNorm::HandleUpdate ) );
   m_ma.OnAppend.Add( MakeDelegate( this, &TSNorm::HandleMAUpdate ) );
 }
 
 TSNorm::TSNorm( const TSNorm& rhs ) 
   : m_dtTimeRange( rhs.m_dtTimeRange ), m_n( rhs.m_n ), m_p( rhs.m_p ), m_seriesSource( rhs.m_seriesSource ), 
-  m_ma( *this, rhs.m_dtTimeRange, rhs.m_n )
+  m_ma( m_seriesPower, rhs.m_dtTimeRange, rhs.m_n )
 {
+  m_seriesPower.DisableAppend();
   m_seriesSource.OnAppend.Add( MakeDelegate( this, &TSNorm::HandleUpdate ) );
   m_ma.OnAppend.Add( MakeDelegate( this, &TSNorm::HandleMAUpdate ) );
 }
@@ -42,14 +44,14 @@ TSNorm::~TSNorm(void) {
 
 void TSNorm::HandleUpdate( const Price& price ) {
   if ( 1.0 == m_p ) {
-    m_ma.Append( Price( price.DateTime(), std::abs( price.Value() ) ) );
+    m_seriesPower.Append( Price( price.DateTime(), std::abs( price.Value() ) ) );
   }
   else {
     if ( 2.0 == m_p ) {
-      m_ma.Append( Price( price.DateTime(), price.Value() * price.Value() ) );
+      m_seriesPower.Append( Price( price.DateTime(), price.Value() * price.Value() ) );
     }
     else {
-      m_ma.Append( Price( price.DateTime(), std::pow( std::abs( price.Value() ), m_p ) ) ); 
+      m_seriesPower.Append( Price( price.DateTime(), std::pow( std::abs( price.Value() ), m_p ) ) );
     }
   }
 }
@@ -31,6 +31,7 @@ private:
   unsigned int m_n;
   double m_p;
   Prices& m_seriesSource;
+  Prices m_seriesPower; // |x|^p, the input to m_ma
   TSMA m_ma;  // this needs to be at end of list for proper initialization
   void HandleUpdate( const Price& );
   void HandleMAUpdate( const Price& );
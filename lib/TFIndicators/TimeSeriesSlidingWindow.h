@@ -18,6 +18,9 @@
 // Construct then run Update to process the time series
 // Each time timeseries updated, run Update to continue
 // useful when timeseries serves multiple windows
+// WarmStart catches up on history bulk loaded with TimeSeries::Append( bgn, end ),
+//   each datum is added and expired as it would be on the tick path, PostUpdate runs once at the end
+// indices are absolute, offset by TimeSeries::Evicted(), so they stay valid when a retained series evicts
 
 #include <TFTimeSeries/TimeSeries.h>
 
@@ -36,6 +39,7 @@ public:
   TimeSeriesSlidingWindow<T,D>( TimeSeriesSlidingWindow<T,D>&& ); // limited to the initial emplace operations
   virtual ~TimeSeriesSlidingWindow<T,D>();
   virtual void Reset();
+  void WarmStart(); // process datums appended without OnAppend, OnAppend is not forwarded for these
   ou::Delegate<const D&> OnAppend;
 protected:
   ptime m_dtZero;  // datetime of first element, used as offset
@@ -50,21 +54,27 @@ private:
   TimeSeries<D>& m_Series;
   time_duration m_tdWindowWidth;
   size_type m_nWindowSizeCount;
-  size_type m_ixTrailing;  // index to datums to be processed out (expired)
-  size_type m_ixLeading;  // index to vector end of datums to be processed in
+  size_type m_ixTrailing;  // absolute index to datums to be processed out (expired)
+  size_type m_ixLeading;  // absolute index to vector end of datums to be processed in
   ptime m_dtLeading;
   bool m_bFirstDatumFound;
   bool m_bAutoUpdate; // use the OnAppend event to update stuff, else use the Update method to process
 
   void Init();  // called in constructors
   void HandleDatum( const D& );
+
+  size_type End() const { return m_Series.Evicted() + m_Series.Size(); }
+  const D& Datum( size_type ix ) const {
+    assert( m_Series.Evicted() <= ix ); // evicted before it expired, Retain is narrower than the window
+    return m_Series[ ix - m_Series.Evicted() ];
+  }
 };
 
 template<class T, class D>
 TimeSeriesSlidingWindow<T,D>::TimeSeriesSlidingWindow(
   TimeSeries<D>& Series, time_duration tdWindowWidth, size_type WindowSizeCount )
 : m_Series( Series ), //m_iterTrailing( Series.begin() ),
-  m_ixTrailing( 0 ), m_ixLeading( 0 ), m_dtLeading( not_a_date_time ),
+  m_ixTrailing( Series.Evicted() ), m_ixLeading( Series.Evicted() ), m_dtLeading( not_a_date_time ),
   m_tdWindowWidth( tdWindowWidth ), m_nWindowSizeCount( WindowSizeCount ),
   m_bFirstDatumFound( false ), m_bAutoUpdate( true )
 {
@@ -77,7 +87,7 @@ template<class T, class D>
 TimeSeriesSlidingWindow<T,D>::TimeSeriesSlidingWindow(
   TimeSeries<D>& Series, size_t nPeriods, time_duration tdPeriodWidth, size_type WindowSizeCount )
 : m_Series( Series ), //m_iterTrailing( Series.begin() ),
-  m_ixTrailing( 0 ), m_ixLeading( 0 ), m_dtLeading( not_a_date_time ),
+  m_ixTrailing( Series.Evicted() ), m_ixLeading( Series.Evicted() ), m_dtLeading( not_a_date_time ),
   m_tdWindowWidth( tdPeriodWidth ), m_nWindowSizeCount( WindowSizeCount ),
   m_bFirstDatumFound( false ), m_bAutoUpdate( true )
 {
@@ -128,7 +138,7 @@ void TimeSeriesSlidingWindow<T,D>::Init() {
 
 template<class T, class D>
 void TimeSeriesSlidingWindow<T,D>::Reset() {
-  m_ixTrailing = m_ixLeading = 0;
+  m_ixTrailing = m_ixLeading = m_Series.Evicted();
   m_dtLeading = not_a_date_time;
 }
 
@@ -141,8 +151,8 @@ void TimeSeriesSlidingWindow<T,D>::Update() {
     }
   }
   bool bMovedIndex = false;
-  while ( m_ixLeading < m_Series.Size() ) {
-    const D& datum( m_Series[ m_ixLeading ] );
+  while ( m_ixLeading < End() ) {
+    const D& datum( Datum( m_ixLeading ) );
     m_dtLeading = datum.DateTime();
     if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
       static_cast<T*>( this )->Add( datum ); // add datum to stats
@@ -154,7 +164,7 @@ void TimeSeriesSlidingWindow<T,D>::Update() {
   if ( bMovedIndex ) {
     if ( 0 < m_nWindowSizeCount ) {
       while ( ( m_ixLeading - m_ixTrailing ) > m_nWindowSizeCount ) {
-        const D& datum( m_Series[ m_ixTrailing ] );
+        const D& datum( Datum( m_ixTrailing ) );
         if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
           static_cast<T*>( this )->Expire( datum );  // expire datum from stats
         }
@@ -162,9 +172,9 @@ void TimeSeriesSlidingWindow<T,D>::Update() {
       }
     }
     if ( 0 < m_tdWindowWidth.total_milliseconds() ) {
-      while ( ( m_dtLeading - m_Series[ m_ixTrailing ].DateTime() ) > m_tdWindowWidth ) {
+      while ( ( m_dtLeading - Datum( m_ixTrailing ).DateTime() ) > m_tdWindowWidth ) {
         if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
-          static_cast<T*>( this )->Expire( m_Series[ m_ixTrailing ] );  // expire datum from stats
+          static_cast<T*>( this )->Expire( Datum( m_ixTrailing ) );  // expire datum from stats
         }
         ++m_ixTrailing;
         if ( m_ixTrailing >= m_ixLeading ) {
@@ -178,6 +188,51 @@ void TimeSeriesSlidingWindow<T,D>::Update() {
   }
 }
 
+template<class T, class D>
+void TimeSeriesSlidingWindow<T,D>::WarmStart() {
+  if ( !m_bFirstDatumFound ) {
+    if ( 0 < m_Series.Size() ) {
+      m_dtZero = m_Series[ 0 ].DateTime();  // used for zeroing the statistics
+      m_bFirstDatumFound = true;
+    }
+  }
+  const size_type nSize( End() );
+  if ( m_ixLeading == nSize ) return;
+  const bool bTimeWidth( 0 < m_tdWindowWidth.total_milliseconds() );
+  T* pT( static_cast<T*>( this ) );
+  // one datum at a time, matching the add/expire sequence of Update on each OnAppend
+  while ( m_ixLeading < nSize ) {
+    const D& datum( Datum( m_ixLeading ) );
+    m_dtLeading = datum.DateTime();
+    if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
+      pT->Add( datum );
+    }
+    ++m_ixLeading;
+    if ( 0 < m_nWindowSizeCount ) {
+      while ( ( m_ixLeading - m_ixTrailing ) > m_nWindowSizeCount ) {
+        if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
+          pT->Expire( Datum( m_ixTrailing ) );
+        }
+        ++m_ixTrailing;
+      }
+    }
+    if ( bTimeWidth ) {
+      while ( ( m_dtLeading - Datum( m_ixTrailing ).DateTime() ) > m_tdWindowWidth ) {
+        if ( &TimeSeriesSlidingWindow<T,D>::Add != &T::Add ) {
+          pT->Expire( Datum( m_ixTrailing ) );
+        }
+        ++m_ixTrailing;
+        if ( m_ixTrailing >= m_ixLeading ) {
+          break;
+        }
+      }
+    }
+  }
+  if ( &TimeSeriesSlidingWindow<T,D>::PostUpdate != &T::PostUpdate ) {
+    pT->PostUpdate();
+  }
+}
+
 template<class T, class D>
 void TimeSeriesSlidingWindow<T,D>::HandleDatum( const D& datum ) {
   if ( m_bAutoUpdate ) Update();
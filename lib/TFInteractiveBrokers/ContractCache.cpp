@@ -0,0 +1,383 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    ContractCache.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFInteractiveBrokers
+ * Created: 2026
+ */
+
+#include <tuple>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include <boost/log/trivial.hpp>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <boost/date_time/gregorian/gregorian.hpp>
+
+#include "ContractCache.h"
+
+namespace boost {
+namespace serialization {
+
+// the fields used by TWS::contractDetails and the applications,
+//   combo legs, delta neutral, sec id lists and the bond fields are not kept
+
+template<class Archive>
+void serialize( Archive& ar, ::Contract& contract, const unsigned int ) {
+  ar & contract.conId;
+  ar & contract.symbol;
+  ar & contract.secType;
+  ar & contract.lastTradeDateOrContractMonth;
+  ar & contract.strike;
+  ar & contract.right;
+  ar & contract.multiplier;
+  ar & contract.exchange;
+  ar & contract.primaryExchange;
+  ar & contract.currency;
+  ar & contract.localSymbol;
+  ar & contract.tradingClass;
+}
+
+template<class Archive>
+void serialize( Archive& ar, ::ContractDetails& details, const unsigned int ) {
+  ar & details.contract;
+  ar & details.marketName;
+  ar & details.minTick;
+  ar & details.sizeMinTick;
+  ar & details.orderTypes;
+  ar & details.validExchanges;
+  ar & details.priceMagnifier;
+  ar & details.underConId;
+  ar & details.longName;
+  ar & details.contractMonth;
+  ar & details.industry;
+  ar & details.category;
+  ar & details.subcategory;
+  ar & details.timeZoneId;
+  ar & details.tradingHours;
+  ar & details.liquidHours;
+  ar & details.evRule;
+  ar & details.evMultiplier;
+  ar & details.mdSizeMultiplier;
+  ar & details.aggGroup;
+  ar & details.underSymbol;
+  ar & details.underSecType;
+  ar & details.marketRuleIds;
+  ar & details.realExpirationDate;
+  ar & details.lastTradeTime;
+  ar & details.stockType;
+}
+
+} // namespace serialization
+} // namespace boost
+
+namespace {
+  const std::uint32_t c_nMagic( 0x49424343 ); // IBCC
+  const std::uint32_t c_nVersion( 1 );
+}
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace ib { // Interactive Brokers
+
+ContractCache::Key::Key(): dblStrike {} {}
+
+ContractCache::Key::Key( const Contract& contract )
+: sSecType( contract.secType )
+, sSymbol( contract.symbol )
+, sLocalSymbol( contract.localSymbol )
+, sTradingClass( contract.tradingClass )
+, sExpiry( contract.lastTradeDateOrContractMonth )
+, dblStrike( contract.strike )
+, sRight( contract.right )
+, sExchange( contract.exchange )
+, sCurrency( contract.currency )
+{}
+
+bool ContractCache::Key::operator<( const Key& rhs ) const {
+  return
+    std::tie(     sSecType,     sSymbol,     sExpiry,     dblStrike,     sRight,     sLocalSymbol,     sTradingClass,     sExchange,     sCurrency )
+  < std::tie( rhs.sSecType, rhs.sSymbol, rhs.sExpiry, rhs.dblStrike, rhs.sRight, rhs.sLocalSymbol, rhs.sTradingClass, rhs.sExchange, rhs.sCurrency );
+}
+
+template<class Archive>
+void ContractCache::Key::serialize( Archive& ar, const unsigned int ) {
+  ar & sSecType;
+  ar & sSymbol;
+  ar & sLocalSymbol;
+  ar & sTradingClass;
+  ar & sExpiry;
+  ar & dblStrike;
+  ar & sRight;
+  ar & sExchange;
+  ar & sCurrency;
+}
+
+ContractCache::Record::Record(): nExpiry {}, tRefreshed {}, bRefreshing( false ) {}
+
+template<class Archive>
+void ContractCache::Record::serialize( Archive& ar, const unsigned int ) {
+  ar & details;
+  ar & nExpiry;
+  ar & tRefreshed;
+}
+
+ContractCache::ContractCache()
+: m_durRefresh( std::chrono::hours( 24 ) )
+{}
+
+ContractCache::~ContractCache() {}
+
+void ContractCache::SetRefreshAge( std::chrono::seconds dur ) {
+  std::scoped_lock<std::mutex> lock( m_mutex );
+  m_durRefresh = dur;
+}
+
+std::uint32_t ContractCache::Today() {
+  const boost::gregorian::date date( boost::gregorian::day_clock::local_day() );
+  return date.year() * 10000 + date.month() * 100 + date.day();
+}
+
+std::int64_t ContractCache::Now() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+    std::chrono::system_clock::now().time_since_epoch() ).count();
+}
+
+// options and futures: realExpirationDate, or lastTradeDateOrContractMonth when it is a full date
+std::uint32_t ContractCache::Expiry( const ContractDetails& details ) {
+  const std::string& sExpiry(
+    details.realExpirationDate.empty()
+    ? details.contract.lastTradeDateOrContractMonth
+    : details.realExpirationDate
+    );
+  if ( 8 > sExpiry.size() ) return 0;
+  return std::strtoul( sExpiry.substr( 0, 8 ).c_str(), nullptr, 10 );
+}
+
+ContractCache::EFind ContractCache::Find( const Contract& request, vContractDetails_t& vContractDetails ) {
+
+  vContractDetails.clear();
+
+  const std::uint32_t nToday( Today() );
+
+  std::scoped_lock<std::mutex> lock( m_mutex );
+
+  const std::int64_t tStale( Now() - m_durRefresh.count() );
+
+  vConId_t vConIdByConId;
+  mapKey_t::iterator iterKey( m_mapKey.end() );
+
+  if ( 0 != request.conId ) {
+    vConIdByConId.push_back( request.conId );
+  }
+  else {
+    iterKey = m_mapKey.find( Key( request ) );
+    if ( m_mapKey.end() == iterKey ) {
+      m_stats.nMiss++;
+      return EFind::Miss;
+    }
+  }
+
+  const vConId_t& vConId( m_mapKey.end() == iterKey ? vConIdByConId : iterKey->second );
+
+  bool bStale( false );
+  bool bRefreshing( false );
+
+  for ( const vConId_t::value_type conId: vConId ) {
+    mapRecord_t::iterator iterRecord = m_mapRecord.find( conId );
+    if ( m_mapRecord.end() == iterRecord ) break;
+    const Record& record( iterRecord->second );
+    if ( ( 0 != record.nExpiry ) && ( nToday > record.nExpiry ) ) {
+      m_mapRecord.erase( iterRecord );
+      m_stats.nExpired++;
+      break;
+    }
+    if ( record.tRefreshed < tStale ) bStale = true;
+    if ( record.bRefreshing ) bRefreshing = true;
+    vContractDetails.push_back( record.details );
+  }
+
+  if ( vContractDetails.size() != vConId.size() ) { // some of the set is missing or expired
+    vContractDetails.clear();
+    if ( m_mapKey.end() != iterKey ) m_mapKey.erase( iterKey );
+    m_stats.nMiss++;
+    return EFind::Miss;
+  }
+
+  if ( bStale && !bRefreshing ) { // report once, until the refresh arrives or is abandoned
+    for ( const vConId_t::value_type conId: vConId ) {
+      m_mapRecord[ conId ].bRefreshing = true;
+    }
+    m_stats.nStale++;
+    return EFind::Stale;
+  }
+
+  m_stats.nHit++;
+  return EFind::Hit;
+}
+
+void ContractCache::Update( const ContractDetails& details ) {
+
+  assert( 0 < details.contract.conId );
+
+  std::scoped_lock<std::mutex> lock( m_mutex );
+
+  Record& record( m_mapRecord[ details.contract.conId ] );
+  record.details = details;
+  record.details.contract.comboLegs.reset();
+  record.details.contract.deltaNeutralContract = nullptr; // not owned
+  record.nExpiry = Expiry( details );
+  record.tRefreshed = Now();
+  record.bRefreshing = false;
+}
+
+void ContractCache::Assign( const Contract& request, const vConId_t& vConId ) {
+  if ( 0 != request.conId ) return; // the record is the entry
+  std::scoped_lock<std::mutex> lock( m_mutex );
+  m_mapKey[ Key( request ) ] = vConId;
+}
+
+void ContractCache::Abandon( const Contract& request ) {
+
+  std::scoped_lock<std::mutex> lock( m_mutex );
+
+  auto clear =
+    [this]( long conId ){
+      mapRecord_t::iterator iterRecord = m_mapRecord.find( conId );
+      if ( m_mapRecord.end() != iterRecord ) iterRecord->second.bRefreshing = false;
+    };
+
+  if ( 0 != request.conId ) {
+    clear( request.conId );
+  }
+  else {
+    mapKey_t::const_iterator iterKey = m_mapKey.find( Key( request ) );
+    if ( m_mapKey.end() != iterKey ) {
+      for ( const vConId_t::value_type conId: iterKey->second ) clear( conId );
+    }
+  }
+}
+
+size_t ContractCache::Expire( std::uint32_t nToday ) {
+  std::scoped_lock<std::mutex> lock( m_mutex );
+  return Purge( nToday );
+}
+
+// lock held
+size_t ContractCache::Purge( std::uint32_t nToday ) {
+
+  size_t nPurged {};
+
+  for ( mapRecord_t::iterator iter = m_mapRecord.begin(); m_mapRecord.end() != iter; ) {
+    if ( ( 0 != iter->second.nExpiry ) && ( nToday > iter->second.nExpiry ) ) {
+      iter = m_mapRecord.erase( iter );
+      nPurged++;
+    }
+    else ++iter;
+  }
+
+  if ( 0 < nPurged ) { // drop requests which refer to a purged record
+    for ( mapKey_t::iterator iter = m_mapKey.begin(); m_mapKey.end() != iter; ) {
+      bool bComplete( true );
+      for ( const vConId_t::value_type conId: iter->second ) {
+        if ( m_mapRecord.end() == m_mapRecord.find( conId ) ) {
+          bComplete = false;
+          break;
+        }
+      }
+      if ( bComplete ) ++iter;
+      else iter = m_mapKey.erase( iter );
+    }
+  }
+
+  m_stats.nExpired += nPurged;
+  return nPurged;
+}
+
+bool ContractCache::Load( const std::string& sFileName ) {
+
+  std::ifstream ifs( sFileName, std::ios::binary );
+  if ( !ifs ) return false;
+
+  mapRecord_t mapRecord;
+  mapKey_t mapKey;
+
+  try {
+    boost::archive::binary_iarchive ia( ifs );
+    std::uint32_t nMagic {};
+    std::uint32_t nVersion {};
+    ia >> nMagic >> nVersion;
+    if ( ( c_nMagic != nMagic ) || ( c_nVersion != nVersion ) ) {
+      BOOST_LOG_TRIVIAL(warning) << "ContractCache " << sFileName << " has a different format, ignored";
+      return false;
+    }
+    ia >> mapRecord >> mapKey;
+  }
+  catch ( std::exception& e ) {
+    BOOST_LOG_TRIVIAL(error) << "ContractCache " << sFileName << " load error: " << e.what();
+    return false;
+  }
+
+  std::scoped_lock<std::mutex> lock( m_mutex );
+  m_mapRecord = std::move( mapRecord );
+  m_mapKey = std::move( mapKey );
+  Purge( Today() );
+
+  return true;
+}
+
+void ContractCache::Save( const std::string& sFileName ) const {
+
+  const std::string sTemp( sFileName + ".tmp" ); // replaced in one step, a failed save leaves the previous file
+
+  {
+    std::ofstream ofs( sTemp, std::ios::binary );
+    if ( !ofs ) {
+      BOOST_LOG_TRIVIAL(error) << "ContractCache " << sTemp << " can not be opened";
+      return;
+    }
+    boost::archive::binary_oarchive oa( ofs );
+    std::scoped_lock<std::mutex> lock( m_mutex );
+    oa << c_nMagic << c_nVersion << m_mapRecord << m_mapKey;
+  }
+
+  if ( 0 != std::rename( sTemp.c_str(), sFileName.c_str() ) ) {
+    BOOST_LOG_TRIVIAL(error) << "ContractCache " << sFileName << " can not be replaced";
+  }
+}
+
+size_t ContractCache::Size() const {
+  std::scoped_lock<std::mutex> lock( m_mutex );
+  return m_mapRecord.size();
+}
+
+ContractCache::Stats ContractCache::GetStats() const {
+  std::scoped_lock<std::mutex> lock( m_mutex );
+  return m_stats;
+}
+
+} // namespace ib
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,134 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    ContractCache.h
+ * Author:  raymond@burkholder.net
+ * Project: TFInteractiveBrokers
+ * Created: 2026
+ */
+
+#pragma once
+
+// local copy of contract details returned by TWS
+//   records are keyed by conId, requests are keyed by the fields of the requesting Contract,
+//     a request maps to the conIds returned for it
+//   a record past its expiry is dropped, a record older than the refresh age is still served,
+//     but Find reports it as stale once so the caller can re-request it in the background
+//   persisted with a boost binary archive, as with iqfeed::InMemoryMktSymbolList
+//   thread safe, independent of TWS so it can be filled from canned callbacks
+
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "client/Contract.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace ib { // Interactive Brokers
+
+class ContractCache {
+public:
+
+  using Contract = ::Contract;
+  using ContractDetails = ::ContractDetails;
+  using vContractDetails_t = std::vector<ContractDetails>;
+  using vConId_t = std::vector<long>;
+
+  enum class EFind { Miss, Hit, Stale };
+
+  struct Stats {
+    std::uint64_t nHit;
+    std::uint64_t nStale;
+    std::uint64_t nMiss;
+    std::uint64_t nExpired;
+    Stats(): nHit {}, nStale {}, nMiss {}, nExpired {} {}
+  };
+
+  ContractCache();
+  ~ContractCache();
+
+  void SetRefreshAge( std::chrono::seconds );
+
+  // request side: by contract.conId when set, otherwise by the request fields
+  EFind Find( const Contract& request, vContractDetails_t& );
+
+  // reply side
+  void Update( const ContractDetails& ); // one contractDetails callback
+  void Assign( const Contract& request, const vConId_t& ); // contractDetailsEnd, the conIds returned for the request
+  void Abandon( const Contract& request ); // a refresh failed, a later Find may report stale again
+
+  size_t Expire( std::uint32_t nToday ); // yyyymmdd, drops records expiring before today
+  static std::uint32_t Today();
+
+  bool Load( const std::string& sFileName ); // false when the file is missing or unreadable
+  void Save( const std::string& sFileName ) const;
+
+  size_t Size() const;
+  Stats GetStats() const;
+
+protected:
+private:
+
+  struct Key {
+    std::string sSecType;
+    std::string sSymbol;
+    std::string sLocalSymbol;
+    std::string sTradingClass;
+    std::string sExpiry;
+    double dblStrike;
+    std::string sRight;
+    std::string sExchange;
+    std::string sCurrency;
+    Key();
+    explicit Key( const Contract& );
+    bool operator<( const Key& ) const;
+    template<class Archive> void serialize( Archive&, const unsigned int );
+  };
+
+  struct Record {
+    ContractDetails details;
+    std::uint32_t nExpiry; // yyyymmdd, 0 when the contract doesn't expire
+    std::int64_t tRefreshed; // seconds since the epoch
+    bool bRefreshing; // not persisted
+    Record();
+    template<class Archive> void serialize( Archive&, const unsigned int );
+  };
+
+  using mapRecord_t = std::map<long,Record>; // by conId
+  using mapKey_t = std::map<Key,vConId_t>;
+
+  mutable std::mutex m_mutex;
+
+  std::chrono::seconds m_durRefresh;
+
+  mapRecord_t m_mapRecord;
+  mapKey_t m_mapKey;
+
+  Stats m_stats;
+
+  static std::uint32_t Expiry( const ContractDetails& );
+  static std::int64_t Now();
+
+  size_t Purge( std::uint32_t nToday );
+
+};
+
+} // namespace ib
+} // namespace tf
+} // namespace ou
@@ -44,6 +44,9 @@
 namespace {
 
   const unsigned int maxRequestsInTransit( 5 );
+  const unsigned int ticksToEviction( 20 ); // evictor ticks are 50ms
+  const size_t nRequestSlots( 64 ); // power of two, comfortably more than maxRequestsInTransit
+  const std::chrono::milliseconds intervalRefresh( 100 ); // background cache refresh, at most 10 per second
 
 // TODO: use spirit to parse?  will it be faster?
 struct DecodeStatusWord {
@@ -96,6 +99,9 @@ TWS::TWS( const std::string &acctCode, const std::string &address, unsigned int
 , m_idClient( 0 )
 , m_nxtReqId( 1 )
 , m_bEvictorStarted( false )
+, m_bRequestCached( false )
+, m_nRequestsInTransit( 0 )
+, m_slotsRequestsInTransit( nRequestSlots )
 {
   m_sName = "IB";
   m_nID = keytypes::EProviderIB;
@@ -113,6 +119,14 @@ TWS::~TWS() {
     m_thrdRequestEvictor.join();
   }
 
+  SaveContractCache();
+
+  m_slotsRequestsInTransit.Clear( [this]( Request* pRequest ){ m_vRequestRecycling.push_back( pRequest ); } );
+  for ( dequeRequest_t* pDeque: { &m_dequeRequestPending, &m_dequeRequestRefresh, &m_dequeRequestCached } ) {
+    m_vRequestRecycling.insert( m_vRequestRecycling.end(), pDeque->begin(), pDeque->end() );
+    pDeque->clear();
+  }
+
   for ( vRequest_t::value_type& vt: m_vRequestRecycling ) {
     delete vt;
     vt = nullptr;
@@ -238,6 +252,10 @@ void TWS::processMessages() {
             ;
           errno = 0;
       }
+
+      if ( m_bRequestCached.load( std::memory_order_acquire ) ) {
+        DeliverCachedContractDetails();
+      }
     }
 
   }
@@ -368,119 +386,157 @@ void TWS::RequestContractDetails(
 ) {
 
   // pInstrument can be empty, or can have an instrument
-  // results supplied at contractDetails()
-
-  bool bStartEvictor( false );
-  Request* pRequest = nullptr;
-  mapActiveRequests_t::size_type size {};
+  // results supplied at contractDetails(), or at DeliverCachedContractDetails() when cached
 
   //std::cout << "Requesting " << pInstrument->GetInstrumentName() << std::endl;
 
+  ContractCache::vContractDetails_t vContractDetails;
+  const ContractCache::EFind eFind = m_cacheContract.Find( contract, vContractDetails );
+
+  bool bStartEvictor( false );
+
   {
-    std::scoped_lock<std::mutex> lock( m_mutexActiveRequests );
+    std::scoped_lock<std::mutex> lock( m_mutexRequests );
 
-    if ( 0 == m_vRequestRecycling.size() ) {
-      pRequest = new Request();
-    }
-    else {
-      pRequest = m_vRequestRecycling.back();
-      m_vRequestRecycling.pop_back();
-    }
+    Request* pRequest = AllocateRequest();
 
-    pRequest->id = m_nxtReqId++;
-    pRequest->bIntransit = false;
     pRequest->fOnContractDetail = std::move( fProcess );
     pRequest->fOnContractDetailDone = std::move( fDone );
     pRequest->pInstrument = pInstrument;
     pRequest->contract = contract;
     pRequest->dtSubmitted = std::chrono::system_clock::now();
 
-    m_mapActiveRequests[ pRequest->id ] = pRequest;
+    if ( ContractCache::EFind::Miss == eFind ) {
+      m_dequeRequestPending.push_back( pRequest );
+    }
+    else {
+      pRequest->vContractDetails = std::move( vContractDetails );
+      m_dequeRequestCached.push_back( pRequest );
+      m_bRequestCached.store( true, std::memory_order_release );
+
+      if ( ContractCache::EFind::Stale == eFind ) { // served as is, refreshed when the queue is idle
+        Request* pRefresh = AllocateRequest();
+        pRefresh->bRefresh = true;
+        pRefresh->contract = contract;
+        pRefresh->dtSubmitted = pRequest->dtSubmitted;
+        m_dequeRequestRefresh.push_back( pRefresh );
+      }
+    }
 
-    if ( !m_bEvictorStarted ) {
+    if ( ( ContractCache::EFind::Hit != eFind ) && !m_bEvictorStarted ) {
+      m_bEvictorStarted = true;
       bStartEvictor = true;
     }
   } // end scoped_lock
 
+  if ( ContractCache::EFind::Miss != eFind ) {
+    m_osSignal.issueSignal(); // wake the message thread for delivery
+  }
+
   if ( bStartEvictor ) {
-    //std::cout << "Evictor starting" << std::endl;
+    StartEvictor();
+  }
 
-    if ( m_thrdRequestEvictor.joinable() ) { // wait for previous thread to complete
-      m_thrdRequestEvictor.join();
-    }
+  UpdateActiveRequests();
 
-    m_bEvictorStarted = true;
-
-    // TODO: move this into UpdateActiveRequests()?
-    m_thrdRequestEvictor = std::move( std::thread(
-      [this](){
-        bool bContinue( true );
-        fOnContractDetailDone_t fOnContractDetailDone( nullptr );
-        do {
-          using namespace std::chrono_literals;
-          vRequest_t vRequestsForEvictionNotify;
-          std::this_thread::sleep_for( 50ms );
-
-          {
-            std::scoped_lock<std::mutex> lock( m_mutexActiveRequests );
-
-            for ( mapActiveRequests_t::value_type& vt: m_mapActiveRequests ) {
-              Request* pRequest = vt.second;
-              assert( 0 != pRequest->id );
-              if ( !pRequest->bIntransit ) break;
-
-              pRequest->cntEvictionByTimer++;
-              if ( 20 < pRequest->cntEvictionByTimer ) { // 20 x 50ms is 1 second
-                std::chrono::time_point<std::chrono::system_clock> finished
-                  = std::chrono::system_clock::now();
-                std::chrono::duration<double, std::milli> elapsed = finished - pRequest->dtSubmitted;
-                BOOST_LOG_TRIVIAL(error)
-                  << "IB details failed (timed) id "
-                  <<        pRequest->id
-                  << "," << pRequest->cntEvictionByTimer
-                  << "," << pRequest->pInstrument->GetInstrumentName()
-                  << "," << elapsed.count() << "ms"
-                  ;
-                //m_mapActiveRequests.erase( pRequest->id );
-                vRequestsForEvictionNotify.push_back( pRequest );
-              }
-            }
+}
 
-            bContinue = ( 0 < m_mapActiveRequests.size() );
-            if ( !bContinue ) {
-              m_bEvictorStarted = false;
-            }
-          } // end scoped_lock
+void TWS::SetContractCache( const std::string& sFileName ) {
+  m_sContractCacheFileName = sFileName;
+  if ( m_cacheContract.Load( sFileName ) ) {
+    BOOST_LOG_TRIVIAL(info) << "IB contract cache " << sFileName << " has " << m_cacheContract.Size() << " contracts";
+  }
+}
+
+void TWS::SaveContractCache() {
+  if ( !m_sContractCacheFileName.empty() ) {
+    m_cacheContract.Save( m_sContractCacheFileName );
+  }
+}
+
+TWS::Request* TWS::AllocateRequest() { // m_mutexRequests is held
+  Request* pRequest = nullptr;
+  if ( m_vRequestRecycling.empty() ) {
+    pRequest = new Request();
+  }
+  else {
+    pRequest = m_vRequestRecycling.back();
+    m_vRequestRecycling.pop_back();
+  }
+  return pRequest;
+}
+
+void TWS::RecycleRequest( Request* pRequest ) {
+  pRequest->Clear();
+  std::scoped_lock<std::mutex> lock( m_mutexRequests );
+  m_vRequestRecycling.push_back( pRequest );
+}
+
+void TWS::StartEvictor() {
+
+  //std::cout << "Evictor starting" << std::endl;
+
+  if ( m_thrdRequestEvictor.joinable() ) { // wait for previous thread to complete
+    m_thrdRequestEvictor.join();
+  }
 
-          for ( vRequest_t::value_type pRequest: vRequestsForEvictionNotify ) {
-            fOnContractDetailDone = std::move( pRequest->fOnContractDetailDone );
-            if ( fOnContractDetailDone ) { // need to call endofcontract to clean this up
+  m_thrdRequestEvictor = std::thread(
+    [this](){
+      bool bContinue( true );
+      do {
+        using namespace std::chrono_literals;
+        vRequest_t vRequestsForEvictionNotify;
+        std::this_thread::sleep_for( 50ms );
+
+        m_slotsRequestsInTransit.Tick(
+          ticksToEviction, // 20 x 50ms is 1 second
+          [this,&vRequestsForEvictionNotify]( reqId_t id, Request* pRequest ){
+            m_nRequestsInTransit.fetch_sub( 1, std::memory_order_release );
+            std::chrono::time_point<std::chrono::system_clock> finished
+              = std::chrono::system_clock::now();
+            std::chrono::duration<double, std::milli> elapsed = finished - pRequest->dtSubmitted;
+            BOOST_LOG_TRIVIAL(error)
+              << "IB details failed (timed) id "
+              <<        id
+              << "," << ( pRequest->pInstrument ? pRequest->pInstrument->GetInstrumentName() : pRequest->contract.symbol )
+              << "," << elapsed.count() << "ms"
+              << ( pRequest->bRefresh ? ",refresh" : "" )
+              ;
+            vRequestsForEvictionNotify.push_back( pRequest );
+          } );
+
+        for ( vRequest_t::value_type pRequest: vRequestsForEvictionNotify ) {
+          if ( pRequest->bRefresh ) {
+            m_cacheContract.Abandon( pRequest->contract ); // cached entry is kept
+          }
+          else {
+            fOnContractDetailDone_t fOnContractDetailDone = std::move( pRequest->fOnContractDetailDone );
+            if ( fOnContractDetailDone ) {
               fOnContractDetailDone( false );
-              fOnContractDetailDone = nullptr;
             }
           }
+          RecycleRequest( pRequest );
+        }
 
-          {
-            std::scoped_lock<std::mutex> lock( m_mutexActiveRequests );
-            for ( vRequest_t::value_type pRequest: vRequestsForEvictionNotify ) {
-              m_mapActiveRequests.erase( pRequest->id ); // comes prior to clear
-              pRequest->Clear();
-              m_vRequestRecycling.push_back( pRequest );
-            }
-          }
+        UpdateActiveRequests();
 
-          if ( bContinue ) {
-            UpdateActiveRequests();
+        {
+          std::scoped_lock<std::mutex> lock( m_mutexRequests );
+          bContinue
+            =  ( 0 < m_nRequestsInTransit.load( std::memory_order_acquire ) )
+            || !m_dequeRequestPending.empty()
+            || !m_dequeRequestRefresh.empty()
+            ;
+          if ( !bContinue ) {
+            m_bEvictorStarted = false;
           }
-
         }
-        while ( bContinue );
-        //std::cout << "Evictor stopping" << std::endl;
-      }
-    )); // end eviction thread definition
-  } // if bStartEvictor
 
-  UpdateActiveRequests();
+      }
+      while ( bContinue );
+      //std::cout << "Evictor stopping" << std::endl;
+    }
+  ); // end eviction thread definition
 
 }
 
@@ -489,31 +545,36 @@ void TWS::UpdateActiveRequests() {
   vRequest_t vRequestsToSubmit;
 
   {
-    std::scoped_lock<std::mutex> lock( m_mutexActiveRequests );
+    std::scoped_lock<std::mutex> lock( m_mutexRequests );
 
-    unsigned int cntInTransit {};
+    unsigned int cntInTransit( m_nRequestsInTransit.load( std::memory_order_acquire ) );
 
-    for ( mapActiveRequests_t::value_type& vt: m_mapActiveRequests ) {
-      Request* pRequest = vt.second;
-      assert( 0 != pRequest->id );
-      if ( pRequest->bIntransit ) {
-        cntInTransit++;
+    while ( maxRequestsInTransit > cntInTransit ) {
+      Request* pRequest = nullptr;
+      if ( !m_dequeRequestPending.empty() ) {
+        pRequest = m_dequeRequestPending.front();
+        m_dequeRequestPending.pop_front();
       }
       else {
-        if ( maxRequestsInTransit > cntInTransit ) {
-          vRequestsToSubmit.push_back( pRequest );
-          pRequest->bIntransit = true;
-          cntInTransit++;
-        }
-        else {
-          break;
-        }
+        if ( m_dequeRequestRefresh.empty() ) break;
+        const std::chrono::time_point<std::chrono::steady_clock> now( std::chrono::steady_clock::now() );
+        if ( now < ( m_dtRefreshSubmitted + intervalRefresh ) ) break; // rate limited, resumed by the evictor
+        m_dtRefreshSubmitted = now;
+        pRequest = m_dequeRequestRefresh.front();
+        m_dequeRequestRefresh.pop_front();
       }
+      cntInTransit = 1 + m_nRequestsInTransit.fetch_add( 1, std::memory_order_acq_rel );
+      vRequestsToSubmit.push_back( pRequest );
     }
   }
 
   for ( vRequest_t::value_type pRequest: vRequestsToSubmit ) {
-    m_pTWS->reqContractDetails( pRequest->id, pRequest->contract );
+    reqId_t id;
+    do { // skips ids whose slot is held by an older request
+      id = m_nxtReqId.fetch_add( 1, std::memory_order_relaxed );
+      pRequest->id = id;
+    } while ( !m_slotsRequestsInTransit.Insert( id, pRequest ) );
+    m_pTWS->reqContractDetails( id, pRequest->contract );
   }
 
 }
@@ -1147,20 +1208,33 @@ void TWS::contractDetails( int reqId, const ContractDetails& contractDetails ) {
 
   fOnContractDetail_t handler = nullptr;
   pInstrument_t pInstrument;
+  bool bRefresh( false );
 
   {
-    mapActiveRequests_t::iterator iterRequest;
-    std::scoped_lock<std::mutex> lock( m_mutexActiveRequests );  // locks map updates
-    iterRequest = m_mapActiveRequests.find( reqId );  // entry removed with contractDetailsEnd
-    if ( m_mapActiveRequests.end() == iterRequest ) {
-      throw std::runtime_error( "contractDetails out of sync" );  // this means the requests are in sync, and so could use linked list instead
+    Request* pRequest = m_slotsRequestsInTransit.Lock( reqId );  // entry removed with contractDetailsEnd
+    if ( nullptr == pRequest ) { // evicted by timer, reply arrived late
+      BOOST_LOG_TRIVIAL(error) << "IB contractDetails " << reqId << " no longer in transit";
+      return;
     }
-    handler = std::move( iterRequest->second->fOnContractDetail );
-    iterRequest->second->fOnContractDetail = nullptr;
-    pInstrument = iterRequest->second->pInstrument;  // might be empty
-    // NOTE: request is removed from m_mapActiveRequests in contractDetailsEnd
+    bRefresh = pRequest->bRefresh;
+    pRequest->vConId.push_back( contractDetails.contract.conId );
+    handler = std::move( pRequest->fOnContractDetail );
+    pRequest->fOnContractDetail = nullptr;
+    pInstrument = pRequest->pInstrument;  // might be empty
+    m_slotsRequestsInTransit.Unlock( reqId );
+    // NOTE: request is removed from m_slotsRequestsInTransit in contractDetailsEnd
   }
 
+  m_cacheContract.Update( contractDetails );
+
+  if ( bRefresh ) return; // background refresh only updates the cache
+
+  ProcessContractDetails( contractDetails, pInstrument, handler );
+}
+
+// message thread: replies from TWS, and from the cache
+void TWS::ProcessContractDetails( const ContractDetails& contractDetails, pInstrument_t pInstrument, fOnContractDetail_t& handler ) {
+
   // need some logic here (some or all of which may now be implemented, just needs a cleanup):
   // * if instrument is supplied, only supplement some existing information
   // * if instrument not supplied, then go through whole building instrument exercise, or will BuildInstrument supply additional information
@@ -1317,54 +1391,67 @@ void TWS::contractDetailsEnd( const reqId_t reqId ) {
 
   //std::cout << "contractDetailsEnd request " << reqId << std::endl;
 
-  bool bFound( false );
-  fOnContractDetailDone_t fOnContractDetailDone = nullptr;
-  std::chrono::time_point<std::chrono::system_clock> dtSubmitted;
+  Request* pRequest = m_slotsRequestsInTransit.Remove( reqId );
+  if ( nullptr == pRequest ) {
+    BOOST_LOG_TRIVIAL(error)
+      << "IB request " << reqId << " early eviction **"
+      ;
+    return;
+  }
 
-  {
-    std::scoped_lock<std::mutex> lock( m_mutexActiveRequests );
+  m_nRequestsInTransit.fetch_sub( 1, std::memory_order_release );
 
-    mapActiveRequests_t::iterator iterActiveRequests = m_mapActiveRequests.find( reqId );
-    if ( m_mapActiveRequests.end() ==  iterActiveRequests ) {
-      BOOST_LOG_TRIVIAL(error)
-        << "IB request " << reqId << " early eviction **"
-        ;
-    }
-    else {
+  if ( !pRequest->vConId.empty() ) {
+    m_cacheContract.Assign( pRequest->contract, pRequest->vConId );
+  }
 
-      Request& request( *iterActiveRequests->second );
+  const std::chrono::time_point<std::chrono::system_clock> dtSubmitted( pRequest->dtSubmitted );
+  fOnContractDetailDone_t fOnContractDetailDone = std::move( pRequest->fOnContractDetailDone );
 
-      //std::cout
-      //  << "contractDetailsEnd found "
-      //  << reqId << ","
-      //  << vt.first << ","
-      //  << vt.second->pInstrument->GetInstrumentName()
-      //  << std::endl;
+  RecycleRequest( pRequest );
 
-      dtSubmitted = request.dtSubmitted;
-      fOnContractDetailDone = std::move( request.fOnContractDetailDone );
+  if ( nullptr != fOnContractDetailDone ) {
+    fOnContractDetailDone( true );
+  }
 
-      request.Clear();
-      m_vRequestRecycling.push_back( iterActiveRequests->second );
-      m_mapActiveRequests.erase( iterActiveRequests );
+  UpdateActiveRequests();
 
-      bFound = true;
-    }
+  if ( false ) {
+    std::chrono::time_point<std::chrono::system_clock> finished
+      = std::chrono::system_clock::now();
+    std::chrono::duration<double, std::milli> elapsed = finished - dtSubmitted;
+    BOOST_LOG_TRIVIAL(error) << "IB request roundtrip for " << reqId << ": " << elapsed.count();  // 250 - 650 ms (2022/05/24)
   }
 
-  if ( nullptr != fOnContractDetailDone ) {
-    fOnContractDetailDone( bFound ); // TODO: ensure this is called only once
+}
+
+// message thread, cached replies are processed in the same context as replies from TWS
+void TWS::DeliverCachedContractDetails() {
+
+  dequeRequest_t dequeRequest;
+
+  {
+    std::scoped_lock<std::mutex> lock( m_mutexRequests );
+    dequeRequest.swap( m_dequeRequestCached );
+    m_bRequestCached.store( false, std::memory_order_relaxed );
   }
 
-  if ( bFound ) {
+  for ( dequeRequest_t::value_type pRequest: dequeRequest ) {
+
+    fOnContractDetail_t handler = std::move( pRequest->fOnContractDetail );
+    pRequest->fOnContractDetail = nullptr;
+
+    for ( const ContractDetails& contractDetails: pRequest->vContractDetails ) {
+      ProcessContractDetails( contractDetails, pRequest->pInstrument, handler );
+      handler = nullptr; // as with contractDetails, the handler sees the first of the set
+    }
+
+    fOnContractDetailDone_t fOnContractDetailDone = std::move( pRequest->fOnContractDetailDone );
 
-    UpdateActiveRequests();
+    RecycleRequest( pRequest );
 
-    if ( false ) {
-      std::chrono::time_point<std::chrono::system_clock> finished
-        = std::chrono::system_clock::now();
-      std::chrono::duration<double, std::milli> elapsed = finished - dtSubmitted;
-      BOOST_LOG_TRIVIAL(error) << "IB request roundtrip for " << reqId << ": " << elapsed.count();  // 250 - 650 ms (2022/05/24)
+    if ( nullptr != fOnContractDetailDone ) {
+      fOnContractDetailDone( true );
     }
   }
 
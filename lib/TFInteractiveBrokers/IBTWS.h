@@ -15,7 +15,9 @@
 #pragma once
 
 #include <map>
+#include <deque>
 #include <mutex>
+#include <atomic>
 #include <string>
 #include <vector>
 #include <thread>
@@ -40,6 +42,8 @@
 #include "client/Execution.h"
 
 #include "IBSymbol.h"  // has settings for IBString, which affects the following TWS includes.
+#include "RequestSlots.h"
+#include "ContractCache.h"
 
 class EClientSocket;
 
@@ -102,6 +106,12 @@ public:
   void RequestContractDetails( const Contract& contract, fOnContractDetail_t&& fProcess, fOnContractDetailDone_t&& fDone );
   void RequestContractDetails( const Contract& contract, fOnContractDetail_t&& fProcess, fOnContractDetailDone_t&& fDone, pInstrument_t& );
 
+  // contract details are cached, a cached request is answered without a round trip to TWS,
+  //   on the message thread as with a TWS reply, stale entries are refreshed in the background
+  void SetContractCache( const std::string& sFileName ); // loads the file, saved with SaveContractCache and on destruction
+  void SaveContractCache();
+  ContractCache& GetContractCache() { return m_cacheContract; }
+
   struct PositionDetail {
     std::string sSymbol;
     std::string sLocalSymbol;
@@ -232,44 +242,63 @@ private:
 
   struct Request {
     reqId_t id;
-    bool bIntransit;
-    size_t cntEvictionByTimer;  // last ditch timed eviction
+    bool bRefresh; // background refresh of a stale cache entry, no callbacks
     pInstrument_t pInstrument;  // add info to existing pInstrument, future use with BuildInstrumentFromContract
     fOnContractDetail_t fOnContractDetail;
     fOnContractDetailDone_t fOnContractDetailDone;
     Contract contract; // used when having to resubmit
+    ContractCache::vConId_t vConId; // conIds returned, for the cache
+    ContractCache::vContractDetails_t vContractDetails; // cached reply
     std::chrono::time_point<std::chrono::system_clock> dtSubmitted; // submission turn-around calculation
 
     Request()
       : id {}
-      , bIntransit( false )
-      , cntEvictionByTimer {}
+      , bRefresh( false )
       , fOnContractDetail( nullptr )
       , fOnContractDetailDone( nullptr )
       {};
 
     void Clear() {
       id = 0;
-      bIntransit = false;
-      cntEvictionByTimer = 0;
+      bRefresh = false;
       pInstrument.reset();
       fOnContractDetail = nullptr;
       fOnContractDetailDone = nullptr;
+      vConId.clear();
+      vContractDetails.clear();
     }
   };
 
-  reqId_t m_nxtReqId;
+  std::atomic<reqId_t> m_nxtReqId;
   bool m_bEvictorStarted;
   std::thread m_thrdRequestEvictor;
-  std::mutex m_mutexActiveRequests;
+
+  std::mutex m_mutexRequests; // queues and recycling, not held during callbacks
 
   using vRequest_t = std::vector<Request*>;
   vRequest_t m_vRequestRecycling;
 
-  using mapActiveRequests_t = std::map<reqId_t, Request*>;
-  mapActiveRequests_t m_mapActiveRequests;
+  using dequeRequest_t = std::deque<Request*>;
+  dequeRequest_t m_dequeRequestPending; // waiting for a slot in transit
+  dequeRequest_t m_dequeRequestRefresh; // background, submitted when nothing else is pending
+  dequeRequest_t m_dequeRequestCached; // answered from the cache, delivered on the message thread
+
+  std::atomic<bool> m_bRequestCached;
+  std::atomic<unsigned int> m_nRequestsInTransit;
+  std::chrono::time_point<std::chrono::steady_clock> m_dtRefreshSubmitted;
+
+  using RequestSlots_t = RequestSlots<Request,reqId_t>;
+  RequestSlots_t m_slotsRequestsInTransit;
+
+  ContractCache m_cacheContract;
+  std::string m_sContractCacheFileName;
 
+  Request* AllocateRequest(); // lock held
+  void RecycleRequest( Request* );
+  void StartEvictor();
   void UpdateActiveRequests();
+  void DeliverCachedContractDetails(); // message thread
+  void ProcessContractDetails( const ContractDetails&, pInstrument_t, fOnContractDetail_t& );
 
   // ====
 
@@ -0,0 +1,124 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    RequestSlots.h
+ * Author:  raymond@burkholder.net
+ * Project: TFInteractiveBrokers
+ * Created: 2026
+ */
+
+#pragma once
+
+// lock free table of requests in transit, indexed by request id modulo the table size
+//   ids are positive and increasing, a slot holds id while active, -id while locked by a reader, 0 when free
+//   Insert:  the submitting thread, fails when the slot is still occupied, the caller moves to the next id
+//   Lock/Unlock: the message thread, while a reply is applied, eviction skips a locked slot
+//   Remove:  exactly one of the message thread (end of reply) and the evictor (Tick) obtains the request
+
+#include <atomic>
+#include <memory>
+#include <cassert>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace ib { // Interactive Brokers
+
+template<typename Request, typename Id = int>
+class RequestSlots {
+public:
+
+  explicit RequestSlots( size_t nSlots ) // power of two
+  : m_nMask( nSlots - 1 ), m_rSlot( new Slot[ nSlots ] )
+  {
+    assert( 0 == ( nSlots & m_nMask ) );
+  }
+
+  size_t Size() const { return m_nMask + 1; }
+
+  bool Insert( Id id, Request* pRequest ) {
+    assert( 0 < id );
+    Slot& slot( m_rSlot[ id & m_nMask ] );
+    Request* pExpected( nullptr );
+    if ( !slot.pRequest.compare_exchange_strong( pExpected, pRequest, std::memory_order_acquire ) ) return false;
+    slot.nTicks.store( 0, std::memory_order_relaxed );
+    slot.id.store( id, std::memory_order_release );
+    return true;
+  }
+
+  Request* Lock( Id id ) { // nullptr when id is not active
+    Slot& slot( m_rSlot[ id & m_nMask ] );
+    Id expected( id );
+    if ( !slot.id.compare_exchange_strong( expected, -id, std::memory_order_acquire ) ) return nullptr;
+    return slot.pRequest.load( std::memory_order_relaxed );
+  }
+
+  void Unlock( Id id ) {
+    m_rSlot[ id & m_nMask ].id.store( id, std::memory_order_release );
+  }
+
+  Request* Remove( Id id ) { // nullptr when id is no longer active
+    return Take( m_rSlot[ id & m_nMask ], id );
+  }
+
+  // evictor: ages each active request by a tick, f( id, Request* ) for requests active for more than nTicks
+  template<typename Function>
+  void Tick( unsigned int nTicks, Function&& f ) {
+    for ( size_t ix = 0; ix <= m_nMask; ix++ ) {
+      Slot& slot( m_rSlot[ ix ] );
+      const Id id( slot.id.load( std::memory_order_acquire ) );
+      if ( 0 >= id ) continue; // free or locked
+      if ( nTicks < ( 1 + slot.nTicks.fetch_add( 1, std::memory_order_relaxed ) ) ) {
+        Request* pRequest = Take( slot, id );
+        if ( nullptr != pRequest ) f( id, pRequest );
+      }
+    }
+  }
+
+  template<typename Function>
+  void Clear( Function&& f ) { // f( Request* ) on each remaining request, when no other thread is active
+    for ( size_t ix = 0; ix <= m_nMask; ix++ ) {
+      Slot& slot( m_rSlot[ ix ] );
+      Request* pRequest = slot.pRequest.exchange( nullptr );
+      slot.id.store( 0 );
+      if ( nullptr != pRequest ) f( pRequest );
+    }
+  }
+
+protected:
+private:
+
+  struct Slot {
+    std::atomic<Id> id;
+    std::atomic<Request*> pRequest;
+    std::atomic<unsigned int> nTicks;
+    Slot(): id( 0 ), pRequest( nullptr ), nTicks( 0 ) {}
+  };
+
+  const size_t m_nMask;
+  std::unique_ptr<Slot[]> m_rSlot;
+
+  Request* Take( Slot& slot, Id id ) {
+    Id expected( id );
+    if ( !slot.id.compare_exchange_strong( expected, 0, std::memory_order_acquire ) ) return nullptr;
+    Request* pRequest = slot.pRequest.load( std::memory_order_relaxed );
+    slot.pRequest.store( nullptr, std::memory_order_release ); // slot can be reused
+    return pRequest;
+  }
+
+};
+
+} // namespace ib
+} // namespace tf
+} // namespace ou
@@ -22,13 +22,17 @@
 #ifndef CHAIN_H
 #define CHAIN_H
 
+#include <new>
 #include <memory>
+#include <cstdint>
 #include <cassert>
 #include <iostream>
 #include <algorithm>
 #include <functional>
 
 #include <map>
+#include <deque>
+#include <vector>
 #include <string>
 #include <stdexcept>
 
@@ -86,10 +90,15 @@ public:
 
   using fStrike_t = std::function<void( double, const strike_t& )>;
 
-  Chain() {}
-  Chain( Chain&& rhs ) {
-    m_mapChain = std::move( rhs.m_mapChain );
-  }
+  Chain(): m_dblIndexBase {}, m_dblIndexScale {} {}
+  Chain( Chain&& rhs )
+  : m_dequeStrike( std::move( rhs.m_dequeStrike ) ) // entries keep their addresses
+  , m_vFree( std::move( rhs.m_vFree ) )
+  , m_vStrike( std::move( rhs.m_vStrike ) )
+  , m_vpStrike( std::move( rhs.m_vpStrike ) )
+  , m_dblIndexBase( rhs.m_dblIndexBase ), m_dblIndexScale( rhs.m_dblIndexScale )
+  , m_vIndex( std::move( rhs.m_vIndex ) )
+  {}
   virtual ~Chain() {};
 
   struct exception_strike_not_found: public std::runtime_error {
@@ -129,27 +138,31 @@ public:
   // needs exact match on strikeSource
   int AdjacentStrikes( double strikeSource, double& strikeLower, double& strikeUpper ) const;
 
-  void Strikes( fStrike_t&& fStrike ) const {
-    for ( const typename mapChain_t::value_type& vt: m_mapChain ) {
-      fStrike( vt.first, vt.second );
+  void Strikes( fStrike_t&& fStrike ) const { // ascending
+    for ( size_t ix = 0; ix < m_vStrike.size(); ix++ ) {
+      fStrike( m_vStrike[ ix ], *m_vpStrike[ ix ] );
     }
   }
 
-  using mapChain_t = std::map<double, strike_t>;
-
   struct TrackATM { // inspired by TFOptions/Bundle.cpp
 
     using PriceIV = ou::tf::PriceIV;
     using fIvATM_t = std::function<void( const PriceIV& )>;
 
-    using iterStrike_t = typename mapChain_t::iterator;
     using fWatch_t = std::function<void( strike_t& )>;
 
-    mapChain_t& m_mapStrike;
+    struct Leg { // entries are stable, so a leg survives strikes added to the chain
+      double strike;
+      strike_t* pStrike;
+      Leg(): strike {}, pStrike( nullptr ) {}
+      Leg( double strike_, strike_t* pStrike_ ): strike( strike_ ), pStrike( pStrike_ ) {}
+    };
+
+    const Chain& m_chain;
 
-    iterStrike_t m_iterUpper;
-    iterStrike_t m_iterMid;
-    iterStrike_t m_iterLower;
+    Leg m_upper;
+    Leg m_mid;
+    Leg m_lower;
 
     double m_dblhysteresisUpper;
     double m_dblhysteresisLower;
@@ -161,15 +174,12 @@ public:
 
     enum EOptionWatchState { EOWSNoWatch, EOWSWatching } m_stateOptionWatch;
 
-    TrackATM( mapChain_t& mapChain, fWatch_t&& fWatchOn, fWatch_t&& fWatchOff, fIvATM_t&& fIvATM )
-    : m_mapStrike( mapChain )
+    TrackATM( const Chain& chain, fWatch_t&& fWatchOn, fWatch_t&& fWatchOff, fIvATM_t&& fIvATM )
+    : m_chain( chain )
+    , m_dblhysteresisUpper {}, m_dblhysteresisLower {}
     , m_fWatchOn( std::move( fWatchOn ) )
     , m_fWatchOff( std::move( fWatchOff ) )
     , m_fIvATM( std::move( fIvATM ) )
-    , m_dblhysteresisUpper {}, m_dblhysteresisLower {}
-    , m_iterUpper( m_mapStrike.end() )
-    , m_iterMid(   m_mapStrike.end() )
-    , m_iterLower( m_mapStrike.end() )
     , m_stateOptionWatch( EOWSNoWatch )
     {
       assert( m_fWatchOn );
@@ -183,56 +193,55 @@ public:
       m_fWatchOff = nullptr;
     }
 
+    Leg At( size_t ix ) const { return Leg( m_chain.m_vStrike[ ix ], m_chain.m_vpStrike[ ix ] ); }
+
     void Shift( const double price ) { // called by Track( price )
       // uses a 25% edge hysterisis level to force recalc of three containing options
       //   ie when underlying is within 25% of upper strike or within 25% of lower strike
       // uses a 50% hysterisis level to select new set of three containing options
       //   ie underlying has to be within +/- 50% of mid strike to choose midstrike and corresponding upper/lower strikes
-      iterStrike_t iterUpper;
-      iterStrike_t iterLower;
-      iterUpper = m_mapStrike.lower_bound( price );
-      if ( m_mapStrike.end() == iterUpper ) {
+      const vStrike_t& vStrike( m_chain.m_vStrike );
+      const size_t nStrikes( vStrike.size() );
+      const size_t ixUpper = m_chain.LowerBound( price );
+      if ( nStrikes == ixUpper ) {
         //std::cout << "TrackATM::Shift: no upper strike available" << std::endl; // stay in no watch state
         m_stateOptionWatch = EOWSNoWatch;
       }
       else {
-        iterLower = iterUpper;
-        if ( m_mapStrike.begin() == iterLower ) {
+        if ( 0 == ixUpper ) {
           //std::cout << "TrackATM::Shift: no lower strike available" << std::endl;  // stay in no watch state
           m_stateOptionWatch = EOWSNoWatch;
         }
         else {
-          --iterLower;
-          double dblMidPoint = ( iterUpper->first + iterLower->first ) * 0.5;
+          const size_t ixLower = ixUpper - 1;
+          double dblMidPoint = ( vStrike[ ixUpper ] + vStrike[ ixLower ] ) * 0.5;
           if ( price >= dblMidPoint ) { // third strike is above
-            m_iterUpper = iterUpper;
-            ++m_iterUpper;
-            if ( m_mapStrike.end() == m_iterUpper ) {
+            if ( nStrikes == ( ixUpper + 1 ) ) {
               //std::cout << "TrackATM::Shift: no upper upper strike available" << std::endl;  // stay in no watch state
               m_stateOptionWatch = EOWSNoWatch;
             }
             else {
-              m_iterMid = iterUpper;
-              m_iterLower = iterLower;
+              m_upper = At( ixUpper + 1 );
+              m_mid = At( ixUpper );
+              m_lower = At( ixLower );
               m_stateOptionWatch = EOWSWatching;
             }
           }
           else { // third strike is below
-            m_iterLower = iterLower;
-            if ( m_mapStrike.begin() == m_iterLower ) {
+            if ( 0 == ixLower ) {
               //std::cout << "TrackATM::Shift: no lower lower strike available" << std::endl;  // stay in no watch state
               m_stateOptionWatch = EOWSNoWatch;
             }
             else {
-              --m_iterLower;
-              m_iterMid = iterLower;
-              m_iterUpper = iterUpper;
+              m_upper = At( ixUpper );
+              m_mid = At( ixLower );
+              m_lower = At( ixLower - 1 );
               m_stateOptionWatch = EOWSWatching;
             }
           }
           if ( EOWSWatching == m_stateOptionWatch ) {
-            m_dblhysteresisUpper = m_iterUpper->first - ( m_iterUpper->first - m_iterMid->first ) * 0.25;
-            m_dblhysteresisLower = m_iterLower->first + ( m_iterMid->first - m_iterLower->first ) * 0.25;
+            m_dblhysteresisUpper = m_upper.strike - ( m_upper.strike - m_mid.strike ) * 0.25;
+            m_dblhysteresisLower = m_lower.strike + ( m_mid.strike - m_lower.strike ) * 0.25;
             //std::cout << m_dblhysteresisLower << " < " << price << " < " << m_dblhysteresisUpper << std::endl;
           }
           else {
@@ -247,25 +256,25 @@ public:
         case EOWSNoWatch:
           Shift( price );
           if ( EOWSWatching == m_stateOptionWatch ) { // m_stateOptionWatch updated in Shift
-            m_fWatchOn( m_iterUpper->second );
-            m_fWatchOn( m_iterMid->second );
-            m_fWatchOn( m_iterLower->second );
+            m_fWatchOn( *m_upper.pStrike );
+            m_fWatchOn( *m_mid.pStrike );
+            m_fWatchOn( *m_lower.pStrike );
           }
           break;
         case EOWSWatching:
           if ( ( price > m_dblhysteresisUpper ) || ( price < m_dblhysteresisLower ) ) {
-            iterStrike_t iterUpper( m_iterUpper );
-            iterStrike_t iterMid( m_iterMid );
-            iterStrike_t iterLower( m_iterLower );
+            const Leg upper( m_upper );
+            const Leg mid( m_mid );
+            const Leg lower( m_lower );
             Shift( price );
             if ( EOWSWatching == m_stateOptionWatch ) { // by setting on before off allows continuity of capture
-              m_fWatchOn( m_iterUpper->second );
-              m_fWatchOn( m_iterMid->second );
-              m_fWatchOn( m_iterLower->second );
+              m_fWatchOn( *m_upper.pStrike );
+              m_fWatchOn( *m_mid.pStrike );
+              m_fWatchOn( *m_lower.pStrike );
             }
-            m_fWatchOff( iterUpper->second );
-            m_fWatchOff( iterMid->second );
-            m_fWatchOff( iterLower->second );
+            m_fWatchOff( *upper.pStrike );
+            m_fWatchOff( *mid.pStrike );
+            m_fWatchOff( *lower.pStrike );
           }
           break;
         }
@@ -280,33 +289,33 @@ public:
 
       switch ( m_stateOptionWatch ) {
         case EOWSWatching:
-          if ( dblUnderlying == m_iterMid->first ) {
-            dblIvCall = m_iterMid->second.call.pOption->ImpliedVolatility();
-            dblIvPut = m_iterMid->second.put.pOption->ImpliedVolatility();
+          if ( dblUnderlying == m_mid.strike ) {
+            dblIvCall = m_mid.pStrike->call.pOption->ImpliedVolatility();
+            dblIvPut = m_mid.pStrike->put.pOption->ImpliedVolatility();
           }
           else {
-            if ( dblUnderlying > m_iterMid->first ) { // linear interpolation
-              double ratio = ( dblUnderlying - m_iterMid->first ) / ( m_iterUpper->first - m_iterMid->first );
+            if ( dblUnderlying > m_mid.strike ) { // linear interpolation
+              double ratio = ( dblUnderlying - m_mid.strike ) / ( m_upper.strike - m_mid.strike );
 
               double iv1, iv2;
-              iv1 = m_iterMid->second.call.pOption->ImpliedVolatility();
-              iv2 = m_iterUpper->second.call.pOption->ImpliedVolatility();
+              iv1 = m_mid.pStrike->call.pOption->ImpliedVolatility();
+              iv2 = m_upper.pStrike->call.pOption->ImpliedVolatility();
               dblIvCall = iv1 + ( iv2 - iv1 ) * ratio;
 
-              iv1 = m_iterMid->second.put.pOption->ImpliedVolatility();
-              iv2 = m_iterUpper->second.put.pOption->ImpliedVolatility();
+              iv1 = m_mid.pStrike->put.pOption->ImpliedVolatility();
+              iv2 = m_upper.pStrike->put.pOption->ImpliedVolatility();
               dblIvPut = iv1 + ( iv2 - iv1 ) * ratio;
             }
             else { // linear interpolation
-              double ratio = ( dblUnderlying - m_iterLower->first ) / ( m_iterMid->first - m_iterLower->first );
+              double ratio = ( dblUnderlying - m_lower.strike ) / ( m_mid.strike - m_lower.strike );
 
               double iv1, iv2;
-              iv1 = m_iterLower->second.call.pOption->ImpliedVolatility();
-              iv2 = m_iterMid->second.call.pOption->ImpliedVolatility();
+              iv1 = m_lower.pStrike->call.pOption->ImpliedVolatility();
+              iv2 = m_mid.pStrike->call.pOption->ImpliedVolatility();
               dblIvCall = iv1 + ( iv2 - iv1 ) * ratio;
 
-              iv1 = m_iterLower->second.put.pOption->ImpliedVolatility();
-              iv2 = m_iterMid->second.put.pOption->ImpliedVolatility();
+              iv1 = m_lower.pStrike->put.pOption->ImpliedVolatility();
+              iv2 = m_mid.pStrike->put.pOption->ImpliedVolatility();
               dblIvPut = iv1 + ( iv2 - iv1 ) * ratio;
             }
           }
@@ -329,11 +338,11 @@ public:
     typename TrackATM::fIvATM_t&& fIvATM
   ) {
     return std::make_unique<TrackATM>(
-      m_mapChain, std::move( fWatchOn ), std::move( fWatchOff ), std::move( fIvATM )
+      *this, std::move( fWatchOn ), std::move( fWatchOff ), std::move( fIvATM )
       );
   }
 
-  typename mapChain_t::size_type Size() const { return m_mapChain.size(); }
+  size_t Size() const { return m_vStrike.size(); }
   size_t EmitValues() const;
   size_t EmitSummary() const;
 
@@ -341,57 +350,120 @@ public:
 
 protected:
 
-  typename mapChain_t::const_iterator FindStrike( const double strike ) const;
-  typename mapChain_t::iterator FindStrike( const double strike );
+  size_t FindStrike( const double strike ) const; // index into the strike table
+  size_t FindStrike( const double strike );
 
 private:
 
-  mapChain_t m_mapChain;
+  // strikes are held in a sorted flat table, with the entries parallel to it
+  //   a query maps the price to a slot sized on the smallest strike increment,
+  //   the slot supplies the first candidate strike, which is then at most a step or two away
+  //   the slot index is rebuilt as strikes are added or erased, so queries only read
+
+  using vStrike_t = std::vector<double>;
+  using vpStrike_t = std::vector<strike_t*>;
+  using vIndex_t = std::vector<std::uint32_t>;
+
+  static const size_t c_nMaxSlots = 1 << 16; // beyond this, odd increments fall back to a binary search
+  static const size_t c_npos = size_t( -1 );
+
+  std::deque<strike_t> m_dequeStrike; // entries, references handed out remain valid
+  vpStrike_t m_vFree; // erased entries, re-used on insert
+
+  vStrike_t m_vStrike; // ascending
+  vpStrike_t m_vpStrike; // entry for each of m_vStrike
+
+  double m_dblIndexBase; // lowest strike
+  double m_dblIndexScale; // 1 / smallest strike increment
+  vIndex_t m_vIndex; // slot -> first strike in or above the slot, empty when not usable
+
+  size_t Slot( double value ) const { return size_t( ( value - m_dblIndexBase ) * m_dblIndexScale ); }
+  void BuildIndex();
+
+  size_t LowerBound( double value ) const; // first strike >= value, Size() when none
+  size_t UpperBound( double value ) const; // first strike > value, Size() when none
+  size_t Find( double strike ) const; // exact match, c_npos when none
+
+  double Nearest( double value, size_t ix ) const; // ix from LowerBound
+  strike_t& Insert( double strike ); // existing or new entry
 
 };
 
 // methods:
 
 template<typename Option>
-double Chain<Option>::Put_Itm( double value ) const { // price < strike
-  typename mapChain_t::const_iterator iter = std::upper_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](double value, const typename mapChain_t::value_type& vt)->bool{ return value < vt.first; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Put_Itm not found" );
-  return iter->first;
+void Chain<Option>::BuildIndex() {
+  m_vIndex.clear();
+  const size_t nStrikes( m_vStrike.size() );
+  if ( 2 > nStrikes ) return;
+  double increment( m_vStrike.back() - m_vStrike.front() );
+  for ( size_t ix = 1; ix < nStrikes; ix++ ) {
+    const double gap( m_vStrike[ ix ] - m_vStrike[ ix - 1 ] );
+    if ( gap < increment ) increment = gap;
+  }
+  const double range( m_vStrike.back() - m_vStrike.front() );
+  if ( !( 0.0 < increment ) || !( ( range / increment ) < c_nMaxSlots ) ) return;
+  m_dblIndexBase = m_vStrike.front();
+  m_dblIndexScale = 1.0 / increment;
+  // Slot() is monotonic, so every strike before m_vIndex[ slot ] is below any price mapping to the slot
+  const size_t nSlots( Slot( m_vStrike.back() ) + 1 );
+  m_vIndex.resize( nSlots );
+  size_t ix {};
+  for ( size_t slot = 0; slot < nSlots; slot++ ) {
+    while ( ( ix < nStrikes ) && ( Slot( m_vStrike[ ix ] ) < slot ) ) ix++;
+    m_vIndex[ slot ] = ix;
+  }
 }
 
 template<typename Option>
-double Chain<Option>::Put_ItmAtm( double value ) const { // price <= strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Put_ItmAtm not found" );
-  return iter->first;
+size_t Chain<Option>::LowerBound( double value ) const {
+  const size_t nStrikes( m_vStrike.size() );
+  if ( 0 == nStrikes ) return 0;
+  if ( !( value > m_vStrike.front() ) ) return 0;
+  if ( value > m_vStrike.back() ) return nStrikes;
+  if ( m_vIndex.empty() ) {
+    return std::lower_bound( m_vStrike.begin(), m_vStrike.end(), value ) - m_vStrike.begin();
+  }
+  size_t ix = m_vIndex[ std::min( Slot( value ), m_vIndex.size() - 1 ) ];
+  while ( m_vStrike[ ix ] < value ) ix++; // terminates, value <= back()
+  return ix;
 }
 
 template<typename Option>
-double Chain<Option>::Put_Atm( double value ) const { // closest strike (use itm vs otm)
+size_t Chain<Option>::UpperBound( double value ) const {
+  const size_t nStrikes( m_vStrike.size() );
+  if ( 0 == nStrikes ) return 0;
+  if ( !( value < m_vStrike.back() ) ) return nStrikes;
+  size_t ix = LowerBound( value );
+  if ( value == m_vStrike[ ix ] ) ix++;
+  return ix;
+}
+
+template<typename Option>
+size_t Chain<Option>::Find( double strike ) const {
+  const size_t ix = LowerBound( strike );
+  if ( ( m_vStrike.size() != ix ) && ( strike == m_vStrike[ ix ] ) ) return ix;
+  return c_npos;
+}
+
+template<typename Option>
+double Chain<Option>::Nearest( double value, size_t ix ) const { // closest strike (use itm vs otm)
   double atm {};
-  typename mapChain_t::const_iterator iter1 = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter1 ) throw exception_strike_not_found( "Put_Atm not found" );
-  if ( value == iter1->first ) {
+  const double upper( m_vStrike[ ix ] );
+  if ( value == upper ) {
     atm = value;
   }
   else {
-    if ( m_mapChain.begin() == iter1 ) {
+    if ( 0 == ix ) {
       atm = value;
     }
     else {
-      typename mapChain_t::const_iterator iter2 = iter1;
-      iter2--;
-      if ( ( iter1->first - value ) < ( value - iter2->first ) ) {
-        atm = iter1->first;
+      const double lower( m_vStrike[ ix - 1 ] );
+      if ( ( upper - value ) < ( value - lower ) ) {
+        atm = upper;
       }
       else {
-        atm = iter2->first;
+        atm = lower;
       }
     }
   }
@@ -399,169 +471,144 @@ double Chain<Option>::Put_Atm( double value ) const { // closest strike (use itm
   return atm;
 }
 
+template<typename Option>
+typename Chain<Option>::strike_t& Chain<Option>::Insert( double dblStrike ) {
+  const size_t ix = LowerBound( dblStrike );
+  if ( ( m_vStrike.size() != ix ) && ( dblStrike == m_vStrike[ ix ] ) ) {
+    return *m_vpStrike[ ix ];
+  }
+  strike_t* pStrike;
+  if ( m_vFree.empty() ) {
+    m_dequeStrike.emplace_back();
+    pStrike = &m_dequeStrike.back();
+  }
+  else {
+    pStrike = m_vFree.back();
+    m_vFree.pop_back();
+  }
+  m_vStrike.insert( m_vStrike.begin() + ix, dblStrike );
+  m_vpStrike.insert( m_vpStrike.begin() + ix, pStrike );
+  BuildIndex();
+  return *pStrike;
+}
+
+template<typename Option>
+double Chain<Option>::Put_Itm( double value ) const { // price < strike
+  const size_t ix = UpperBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_Itm not found" );
+  return m_vStrike[ ix ];
+}
+
+template<typename Option>
+double Chain<Option>::Put_ItmAtm( double value ) const { // price <= strike
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_ItmAtm not found" );
+  return m_vStrike[ ix ];
+}
+
+template<typename Option>
+double Chain<Option>::Put_Atm( double value ) const { // closest strike (use itm vs otm)
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_Atm not found" );
+  return Nearest( value, ix );
+}
+
 template<typename Option>
 double Chain<Option>::Put_OtmAtm( double value ) const { // price >= strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Put_OtmAtm not found" );
-  if ( value == iter->first ) {
+  size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_OtmAtm not found" );
+  if ( value == m_vStrike[ ix ] ) {
     // atm
   }
   else {
-    if ( m_mapChain.begin() == iter ) {
+    if ( 0 == ix ) {
       throw exception_at_start_of_chain( "Put_OtmAtm at begin of chain" );
     }
     else {
-      iter--; // strike will be OTM
+      ix--; // strike will be OTM
     }
   }
-  return iter->first;
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Put_Otm( double value ) const { // price > strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Put_Otm not found" );
-  if ( m_mapChain.begin() == iter ) {
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Put_Otm not found" );
+  if ( 0 == ix ) {
     throw exception_at_start_of_chain( "Put_Otm at begin of chain" );
   }
-  else {
-    iter--; // strike will be OTM
-  }
-  return iter->first;
+  return m_vStrike[ ix - 1 ]; // strike will be OTM
 }
 
 template<typename Option>
 double Chain<Option>::Call_Itm( double value ) const { // price > strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Call_Itm not found" );
-    if ( m_mapChain.begin() == iter ) {
-      throw exception_at_start_of_chain( "Call_Itm at begin of chain" );
-    }
-    else {
-      iter--;
-    }
-  return iter->first;
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_Itm not found" );
+  if ( 0 == ix ) {
+    throw exception_at_start_of_chain( "Call_Itm at begin of chain" );
+  }
+  return m_vStrike[ ix - 1 ];
 }
 
 template<typename Option>
 double Chain<Option>::Call_ItmAtm( double value ) const { // price >= strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Call_ItmAtm not found" );
-  if ( value == iter->first ) {
+  size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_ItmAtm not found" );
+  if ( value == m_vStrike[ ix ] ) {
     // atm
   }
   else {
-    if ( m_mapChain.begin() == iter ) {
+    if ( 0 == ix ) {
       throw exception_at_start_of_chain( "Call_ItmAtm at begin of chain" );
     }
     else {
-      iter--; // strike will be Itm
+      ix--; // strike will be Itm
     }
   }
-  return iter->first;
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Call_Atm( double value ) const { // closest strike (use itm vs otm)
-  double atm {};
-  typename mapChain_t::const_iterator iter1 = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter1 ) throw exception_strike_not_found( "Call_Atm not found" );
-  if ( value == iter1->first ) {
-    atm = value;
-  }
-  else {
-    if ( m_mapChain.begin() == iter1 ) {
-      atm = value;
-    }
-    else {
-      typename mapChain_t::const_iterator iter2 = iter1;
-      iter2--;
-      if ( ( iter1->first - value ) < ( value - iter2->first ) ) {
-        atm = iter1->first;
-      }
-      else {
-        atm = iter2->first;
-      }
-    }
-  }
-  assert( 0.0 != atm );
-  return atm;
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_Atm not found" );
+  return Nearest( value, ix );
 }
 
 template<typename Option>
 double Chain<Option>::Call_OtmAtm( double value ) const { // price <= strike
-  typename mapChain_t::const_iterator iter = std::lower_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Call_OtmAtm not found" );
-  return iter->first;
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_OtmAtm not found" );
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Call_Otm( double value ) const { // price < strike
-  typename mapChain_t::const_iterator iter = std::upper_bound(
-    m_mapChain.begin(), m_mapChain.end(), value,
-    [](double value, const typename mapChain_t::value_type& vt)->bool{ return value < vt.first; } );
-  if ( m_mapChain.end() == iter ) throw exception_strike_not_found( "Call_Otm not found" );
-  return iter->first;
+  const size_t ix = UpperBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Call_Otm not found" );
+  return m_vStrike[ ix ];
 }
 
 template<typename Option>
 double Chain<Option>::Atm( double value ) const { // closest strike (use itm vs otm)
-  // https://en.cppreference.com/w/cpp/algorithm/lower_bound std::map::lower_bound preferred
-  //typename mapChain_t::const_iterator iter1 = std::lower_bound(
-  //  [](const typename mapChain_t::value_type& vt, double value)->bool{ return vt.first < value; } );
-  double atm( 0.0 );
-  typename mapChain_t::const_iterator iterStrikeCandidate = m_mapChain.lower_bound( value );
-  if ( m_mapChain.end() == iterStrikeCandidate ) throw exception_strike_not_found( "Atm not found" );
-  if ( value == iterStrikeCandidate->first ) {
-    atm = value;
-  }
-  else {
-    if ( m_mapChain.begin() == iterStrikeCandidate ) {
-      atm = value;
-    }
-    else {
-      typename mapChain_t::const_iterator iterStrikeLower( iterStrikeCandidate );
-      iterStrikeLower--;
-      if ( ( iterStrikeCandidate->first - value ) < ( value - iterStrikeLower->first ) ) {
-        atm = iterStrikeCandidate->first;
-      }
-      else {
-        atm = iterStrikeLower->first;
-      }
-    }
-  }
-  assert( 0.0 != atm );
-  return atm;
+  const size_t ix = LowerBound( value );
+  if ( m_vStrike.size() == ix ) throw exception_strike_not_found( "Atm not found" );
+  return Nearest( value, ix );
 }
 
 template<typename Option>
 int Chain<Option>::AdjacentStrikes( double strikeSource, double& strikeLower, double& strikeUpper ) const {
   strikeLower = strikeUpper = 0.0;
   int nReturn {};
-  typename mapChain_t::const_iterator iterSource = m_mapChain.find( strikeSource );
-  if ( m_mapChain.end() != iterSource ) {
-    typename mapChain_t::const_iterator iterLower = iterSource;
-    if ( m_mapChain.begin() != iterLower ) {
-      iterLower--;
-      strikeLower = iterLower->first;
+  const size_t ix = Find( strikeSource );
+  if ( c_npos != ix ) {
+    if ( 0 != ix ) {
+      strikeLower = m_vStrike[ ix - 1 ];
       nReturn++;
     }
-    typename mapChain_t::const_iterator iterUpper = iterSource;
-    iterUpper++;
-    if ( m_mapChain.end() != iterUpper ) {
-      strikeUpper = iterUpper->first;
+    if ( m_vStrike.size() != ( ix + 1 ) ) {
+      strikeUpper = m_vStrike[ ix + 1 ];
       nReturn++;
     }
   }
@@ -570,81 +617,77 @@ int Chain<Option>::AdjacentStrikes( double strikeSource, double& strikeLower, do
 
 template<typename Option>
 Option& Chain<Option>::SetIQFeedNameCall( double dblStrike, const std::string& sIQFeedSymbolName ) {
-  typename mapChain_t::iterator iter = m_mapChain.find( dblStrike );
-  if ( m_mapChain.end() == iter ) {
-    auto result = m_mapChain.emplace( typename mapChain_t::value_type( dblStrike, strike_t() ) );
-    assert( result.second );
-    iter = result.first;
-  }
-  if ( iter->second.call.sIQFeedSymbolName.empty() ) {
-    iter->second.call.sIQFeedSymbolName = sIQFeedSymbolName;
+  strike_t& strike( Insert( dblStrike ) );
+  if ( strike.call.sIQFeedSymbolName.empty() ) {
+    strike.call.sIQFeedSymbolName = sIQFeedSymbolName;
   }
   else {
     std::cout
       << "Chain<Option>::SetIQFeedNameCall duplicate existing: "
-      << iter->second.call.sIQFeedSymbolName
+      << strike.call.sIQFeedSymbolName
       << ", new "
       << sIQFeedSymbolName
       << ", skipped"
       << std::endl;
     throw std::runtime_error( "duplicate call" );
     // maybe throw an exception and let caller handle it: ignore or not
-    //assert( iter->second.call.sIQFeedSymbolName == sIQFeedSymbolName );
+    //assert( strike.call.sIQFeedSymbolName == sIQFeedSymbolName );
   }
-  return iter->second.call;
+  return strike.call;
 }
 
 template<typename Option>
 Option& Chain<Option>::SetIQFeedNamePut( double dblStrike, const std::string& sIQFeedSymbolName ) {
-  typename mapChain_t::iterator iter = m_mapChain.find( dblStrike );
-  if ( m_mapChain.end() == iter ) {
-    auto result = m_mapChain.emplace( typename mapChain_t::value_type( dblStrike, strike_t() ) );
-    assert( result.second );
-    iter = result.first;
-  }
-  if ( iter->second.put.sIQFeedSymbolName.empty() ) {
-    iter->second.put.sIQFeedSymbolName = sIQFeedSymbolName;
+  strike_t& strike( Insert( dblStrike ) );
+  if ( strike.put.sIQFeedSymbolName.empty() ) {
+    strike.put.sIQFeedSymbolName = sIQFeedSymbolName;
   }
   else {
     std::cout
       << "Chain<Option>::SetIQFeedNamePut duplicate existing: "
-      << iter->second.put.sIQFeedSymbolName
+      << strike.put.sIQFeedSymbolName
       << ", new "
       << sIQFeedSymbolName
       << ", skipped"
       << std::endl;
     throw std::runtime_error( "duplicate put" );
     // maybe throw an exception and let caller handle it: ignore or not
-    //assert( iter->second.put.sIQFeedSymbolName == sIQFeedSymbolName );
+    //assert( strike.put.sIQFeedSymbolName == sIQFeedSymbolName );
   }
-  return iter->second.put;
+  return strike.put;
 }
 
 template<typename Option>
 const std::string Chain<Option>::GetIQFeedNameCall( double dblStrike ) const {
-  typename mapChain_t::const_iterator iter = FindStrike( dblStrike );
-  return iter->second.call.sIQFeedSymbolName;
+  const size_t ix = FindStrike( dblStrike );
+  return m_vpStrike[ ix ]->call.sIQFeedSymbolName;
 }
 
 template<typename Option>
 const std::string Chain<Option>::GetIQFeedNamePut( double dblStrike ) const {
-  typename mapChain_t::const_iterator iter = FindStrike( dblStrike );
-  return iter->second.put.sIQFeedSymbolName;
+  const size_t ix = FindStrike( dblStrike );
+  return m_vpStrike[ ix ]->put.sIQFeedSymbolName;
 }
 
 template<typename Option>
 void Chain<Option>::Erase( double dblStrike ) {
-  typename mapChain_t::const_iterator iter = FindStrike( dblStrike );
-  m_mapChain.erase( iter );
+  const size_t ix = FindStrike( dblStrike );
+  strike_t* pStrike = m_vpStrike[ ix ];
+  m_vStrike.erase( m_vStrike.begin() + ix );
+  m_vpStrike.erase( m_vpStrike.begin() + ix );
+  BuildIndex();
+  pStrike->~strike_t(); // release the options now, as the map erase did
+  new( pStrike ) strike_t();
+  m_vFree.push_back( pStrike );
 }
 
 template<typename Option>
 const chain::Strike<Option>& Chain<Option>::GetExistingStrike( double dblStrike ) const { // this one doesn't make much sense
-  typename mapChain_t::const_iterator citer = m_mapChain.find( dblStrike );
-  if ( m_mapChain.end() == citer ) {
+  const size_t ix = Find( dblStrike );
+  if ( c_npos == ix ) {
     throw exception_strike_not_found( "Chain::GetExistingStrike const: no strike" );
   }
-  return citer->second;
+  return *m_vpStrike[ ix ];
 }
 
 //template<typename Option>
@@ -658,50 +701,44 @@ const chain::Strike<Option>& Chain<Option>::GetExistingStrike( double dblStrike
 
 template<typename Option>
 chain::Strike<Option>& Chain<Option>::GetStrike( double dblStrike ) {
-  typename mapChain_t::iterator iter = m_mapChain.find( dblStrike );
-  if ( m_mapChain.end() == iter ) {
-    auto result = m_mapChain.emplace( typename mapChain_t::value_type( dblStrike, strike_t() ) );
-    assert( result.second );
-    iter = result.first;
-  }
-  return iter->second;
+  return Insert( dblStrike );
 }
 
-// const iterator
+// const lookup
 template<typename Option>
-typename Chain<Option>::mapChain_t::const_iterator Chain<Option>::FindStrike( const double strike ) const {
-  typename mapChain_t::const_iterator iter = m_mapChain.find( strike );
-  if ( m_mapChain.end() == iter ) {
+size_t Chain<Option>::FindStrike( const double strike ) const {
+  const size_t ix = Find( strike );
+  if ( c_npos == ix ) {
     throw exception_strike_not_found( "Chain::FindStrike const: no strike" );
   }
-  return iter;
+  return ix;
 }
 
-// regular iterator
+// regular lookup
 template<typename Option>
-typename Chain<Option>::mapChain_t::iterator Chain<Option>::FindStrike( const double strike ) {
-  typename mapChain_t::iterator iter = m_mapChain.find( strike );
-  if ( m_mapChain.end() == iter ) {
+size_t Chain<Option>::FindStrike( const double strike ) {
+  const size_t ix = Find( strike );
+  if ( c_npos == ix ) {
     std::cout
       << "Chain::FindStrike error: "
       << "strike " << strike
-      << ", m_mapChain size=" << m_mapChain.size()
+      << ", strike count=" << m_vStrike.size()
       << std::endl;
     throw exception_strike_not_found( "Chain::FindStrike: no strike" );
   }
-  return iter;
+  return ix;
 }
 
 template<typename Option>
 size_t Chain<Option>::EmitValues() const { // TODO: supply output stream
   size_t cnt {};
-  std::for_each( m_mapChain.begin(), m_mapChain.end(), [&cnt](const typename mapChain_t::value_type& vt){
+  Strikes( [&cnt]( double strike, const strike_t& entry ){
     cnt++;
     std::cout
-      << vt.first << ": "
-      << vt.second.call.sIQFeedSymbolName
+      << strike << ": "
+      << entry.call.sIQFeedSymbolName
       << ", "
-      << vt.second.put.sIQFeedSymbolName
+      << entry.put.sIQFeedSymbolName
       << std::endl;
   });
   return cnt;
@@ -712,10 +749,10 @@ size_t Chain<Option>::EmitSummary() const { // TODO: supply output stream
   size_t nStrikes {};
   size_t nCalls {};
   size_t nPuts {};
-  std::for_each( m_mapChain.begin(), m_mapChain.end(), [ &nStrikes, &nCalls, &nPuts](const typename mapChain_t::value_type& vt){
+  Strikes( [ &nStrikes, &nCalls, &nPuts]( double, const strike_t& entry ){
     nStrikes++;
-    if ( 0 != vt.second.call.sIQFeedSymbolName.size() ) nCalls++;
-    if ( 0 != vt.second.put.sIQFeedSymbolName.size() ) nPuts++;
+    if ( 0 != entry.call.sIQFeedSymbolName.size() ) nCalls++;
+    if ( 0 != entry.put.sIQFeedSymbolName.size() ) nPuts++;
   });
     std::cout
       << "  #strikes=" << nStrikes
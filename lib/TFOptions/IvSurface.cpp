@@ -0,0 +1,428 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    IvSurface.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFOptions
+ * Created: 2026
+ */
+
+#include <cassert>
+#include <iostream>
+#include <algorithm>
+
+#include "IvSurface.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace option { // options
+
+namespace {
+
+  const double c_dblSecondsPerYear( 365.0 * 24.0 * 60.0 * 60.0 ); // as in Option::CalcRate
+
+  const size_t c_nMinPoints( 5 ); // svi has five parameters
+  const size_t c_nMaxIterationsCold( 200 );
+  const size_t c_nMaxIterationsWarm( 40 );
+  const size_t c_nCheckPoints( 64 ); // arbitrage checks per slice
+
+  double Years( boost::posix_time::time_duration td ) {
+    return (double) td.total_seconds() / c_dblSecondsPerYear;
+  }
+
+  struct Point {
+    double k; // ln( strike / underlying )
+    double w; // total variance
+  };
+
+  using vPoint_t = std::vector<Point>;
+
+  // parameters held as a b rho m sigma
+  using param_t = double[ 5 ];
+
+  void Project( param_t& p ) { // keep the fit within the svi domain, with non-negative total variance
+    if ( 0.0 > p[ 1 ] ) p[ 1 ] = 0.0;
+    if ( 0.999 < p[ 2 ] ) p[ 2 ] = 0.999;
+    if ( -0.999 > p[ 2 ] ) p[ 2 ] = -0.999;
+    if ( 1e-4 > p[ 4 ] ) p[ 4 ] = 1e-4;
+    const double aMin( -p[ 1 ] * p[ 4 ] * std::sqrt( 1.0 - p[ 2 ] * p[ 2 ] ) );
+    if ( aMin > p[ 0 ] ) p[ 0 ] = aMin;
+  }
+
+  double Cost( const vPoint_t& vPoint, const param_t& p ) {
+    double sum {};
+    for ( const Point& point: vPoint ) {
+      const double d( point.k - p[ 3 ] );
+      const double r( p[ 0 ] + p[ 1 ] * ( p[ 2 ] * d + std::sqrt( d * d + p[ 4 ] * p[ 4 ] ) ) - point.w );
+      sum += r * r;
+    }
+    return sum;
+  }
+
+  bool Solve( double A[ 5 ][ 5 ], double x[ 5 ] ) { // gaussian elimination with partial pivoting, x holds rhs on entry
+    for ( size_t col = 0; col < 5; col++ ) {
+      size_t pivot( col );
+      for ( size_t row = col + 1; row < 5; row++ ) {
+        if ( std::abs( A[ row ][ col ] ) > std::abs( A[ pivot ][ col ] ) ) pivot = row;
+      }
+      if ( 1e-300 > std::abs( A[ pivot ][ col ] ) ) return false;
+      if ( pivot != col ) {
+        std::swap( A[ pivot ], A[ col ] );
+        std::swap( x[ pivot ], x[ col ] );
+      }
+      for ( size_t row = col + 1; row < 5; row++ ) {
+        const double f( A[ row ][ col ] / A[ col ][ col ] );
+        for ( size_t ix = col; ix < 5; ix++ ) A[ row ][ ix ] -= f * A[ col ][ ix ];
+        x[ row ] -= f * x[ col ];
+      }
+    }
+    for ( size_t ix = 5; ix-- > 0; ) {
+      double sum( x[ ix ] );
+      for ( size_t jx = ix + 1; jx < 5; jx++ ) sum -= A[ ix ][ jx ] * x[ jx ];
+      x[ ix ] = sum / A[ ix ][ ix ];
+    }
+    return true;
+  }
+
+  void Guess( const vPoint_t& vPoint, IvSurface::svi_t& svi ) { // cold start from the shape of the smile
+    const Point& left( vPoint.front() );
+    const Point& right( vPoint.back() );
+    const Point& low( *std::min_element(
+      vPoint.begin(), vPoint.end(), []( const Point& lhs, const Point& rhs ){ return lhs.w < rhs.w; } ) );
+    const double slopeLeft( ( low.k > left.k ) ? ( left.w - low.w ) / ( low.k - left.k ) : 0.0 );
+    const double slopeRight( ( right.k > low.k ) ? ( right.w - low.w ) / ( right.k - low.k ) : 0.0 );
+    svi.m = low.k;
+    svi.sigma = 0.1;
+    svi.b = std::max( 1e-3, 0.5 * ( slopeLeft + slopeRight ) );
+    svi.rho = ( 0.0 < ( slopeLeft + slopeRight ) ) ? ( slopeRight - slopeLeft ) / ( slopeLeft + slopeRight ) : 0.0;
+    svi.rho = std::max( -0.9, std::min( 0.9, svi.rho ) );
+    svi.a = low.w - svi.b * svi.sigma * std::sqrt( 1.0 - svi.rho * svi.rho );
+  }
+
+  // levenberg-marquardt on total variance, returns iterations used
+  size_t FitSvi( const vPoint_t& vPoint, IvSurface::svi_t& svi, size_t nMaxIterations, double& rmse ) {
+
+    param_t p = { svi.a, svi.b, svi.rho, svi.m, svi.sigma };
+    Project( p );
+
+    double cost( Cost( vPoint, p ) );
+    double lambda( 1e-3 );
+    size_t nIteration {};
+
+    for ( ; nIteration < nMaxIterations; nIteration++ ) {
+
+      double JtJ[ 5 ][ 5 ] = {};
+      double Jtr[ 5 ] = {};
+
+      for ( const Point& point: vPoint ) {
+        const double d( point.k - p[ 3 ] );
+        const double r( std::sqrt( d * d + p[ 4 ] * p[ 4 ] ) );
+        const double J[ 5 ] = {
+          1.0,
+          p[ 2 ] * d + r,
+          p[ 1 ] * d,
+          -p[ 1 ] * ( p[ 2 ] + d / r ),
+          p[ 1 ] * p[ 4 ] / r
+        };
+        const double res( p[ 0 ] + p[ 1 ] * ( p[ 2 ] * d + r ) - point.w );
+        for ( size_t ix = 0; ix < 5; ix++ ) {
+          Jtr[ ix ] += J[ ix ] * res;
+          for ( size_t jx = ix; jx < 5; jx++ ) JtJ[ ix ][ jx ] += J[ ix ] * J[ jx ];
+        }
+      }
+      for ( size_t ix = 0; ix < 5; ix++ ) {
+        for ( size_t jx = 0; jx < ix; jx++ ) JtJ[ ix ][ jx ] = JtJ[ jx ][ ix ];
+      }
+
+      bool bAccepted( false );
+      bool bConverged( false );
+      while ( !bAccepted && ( 1e10 > lambda ) ) {
+        double A[ 5 ][ 5 ];
+        double step[ 5 ];
+        for ( size_t ix = 0; ix < 5; ix++ ) {
+          for ( size_t jx = 0; jx < 5; jx++ ) A[ ix ][ jx ] = JtJ[ ix ][ jx ];
+          A[ ix ][ ix ] += lambda * JtJ[ ix ][ ix ] + 1e-14;
+          step[ ix ] = -Jtr[ ix ];
+        }
+        if ( Solve( A, step ) ) {
+          param_t q;
+          for ( size_t ix = 0; ix < 5; ix++ ) q[ ix ] = p[ ix ] + step[ ix ];
+          Project( q );
+          const double costTrial( Cost( vPoint, q ) );
+          if ( costTrial < cost ) {
+            bConverged = ( ( cost - costTrial ) <= ( 1e-12 * cost + 1e-24 ) );
+            std::copy( q, q + 5, p );
+            cost = costTrial;
+            lambda = std::max( 1e-12, lambda * 0.3 );
+            bAccepted = true;
+          }
+          else lambda *= 10.0;
+        }
+        else lambda *= 10.0;
+      }
+
+      if ( !bAccepted || bConverged ) break;
+    }
+
+    svi.a = p[ 0 ]; svi.b = p[ 1 ]; svi.rho = p[ 2 ]; svi.m = p[ 3 ]; svi.sigma = p[ 4 ];
+    rmse = std::sqrt( cost / vPoint.size() );
+    return nIteration;
+  }
+
+} // namespace anonymous
+
+// ==== svi_t
+
+double IvSurface::svi_t::g( double k ) const { // Gatheral & Jacquier, durrleman's condition
+  const double d( k - m );
+  const double r( std::sqrt( d * d + sigma * sigma ) );
+  const double w0( a + b * ( rho * d + r ) );
+  if ( 0.0 >= w0 ) return -1.0;
+  const double w1( b * ( rho + d / r ) );
+  const double w2( b * sigma * sigma / ( r * r * r ) );
+  const double t( 1.0 - k * w1 / ( 2.0 * w0 ) );
+  return t * t - 0.25 * w1 * w1 * ( 1.0 / w0 + 0.25 ) + 0.5 * w2;
+}
+
+// ==== Snapshot
+
+double IvSurface::Snapshot::TotalVariance( double k, double tau ) const {
+  if ( vSlice.empty() || !( 0.0 < tau ) ) return 0.0;
+  std::vector<Slice>::const_iterator iter = std::lower_bound(
+    vSlice.begin(), vSlice.end(), tau,
+    []( const Slice& slice, double tau )->bool{ return slice.tau < tau; } );
+  if ( vSlice.end() == iter ) { // beyond the last expiry, hold its vol
+    const Slice& slice( vSlice.back() );
+    return slice.svi.w( k ) * tau / slice.tau;
+  }
+  if ( ( vSlice.begin() == iter ) || ( tau == iter->tau ) ) { // before the first expiry, hold its vol
+    return iter->svi.w( k ) * tau / iter->tau;
+  }
+  const Slice& upper( *iter );
+  const Slice& lower( *( iter - 1 ) );
+  const double w1( lower.svi.w( k ) );
+  const double w2( upper.svi.w( k ) );
+  return w1 + ( w2 - w1 ) * ( tau - lower.tau ) / ( upper.tau - lower.tau );
+}
+
+double IvSurface::Snapshot::Vol( double strike, ptime dtUtcExpiry ) const {
+  if ( !( 0.0 < strike ) || !( 0.0 < dblUnderlying ) ) return 0.0;
+  const double tau( Years( dtUtcExpiry - dtUtcNow ) );
+  if ( !( 0.0 < tau ) ) return 0.0;
+  const double w( TotalVariance( std::log( strike / dblUnderlying ), tau ) );
+  return ( 0.0 < w ) ? std::sqrt( w / tau ) : 0.0;
+}
+
+bool IvSurface::Snapshot::Arbitrage() const {
+  for ( const Slice& slice: vSlice ) {
+    if ( slice.bButterflyArbitrage || slice.bCalendarArbitrage ) return true;
+  }
+  return false;
+}
+
+// ==== IvSurface
+
+IvSurface::IvSurface()
+: m_dblRequestUnderlying {}
+, m_bRefitQueued( false )
+, m_work( boost::asio::make_work_guard( m_context ) )
+{
+  m_threadWorker = std::thread( [this](){ m_context.run(); } );
+}
+
+IvSurface::~IvSurface() {
+  m_work.reset(); // a queued fit completes
+  if ( m_threadWorker.joinable() ) m_threadWorker.join();
+  m_fSnapshot = nullptr;
+  for ( mapEntry_t::value_type& vt: m_mapEntry ) {
+    Entry& entry( *vt.second );
+    if ( entry.pOption ) {
+      entry.pOption->OnGreek.Remove( MakeDelegate( &entry, &Entry::HandleGreek ) );
+    }
+  }
+  m_mapEntry.clear();
+}
+
+IvSurface::key_t IvSurface::Key( Option& option ) {
+  return key_t( option.GetInstrument()->GetExpiryUtc(), option.GetStrike(), option.GetOptionSide() );
+}
+
+void IvSurface::Add( pOption_t pOption ) {
+  assert( pOption );
+  std::lock_guard<std::mutex> lock( m_mutexEntry );
+  mapEntry_t::iterator iter = m_mapEntry.find( Key( *pOption ) );
+  if ( m_mapEntry.end() == iter ) {
+    auto result = m_mapEntry.emplace( Key( *pOption ), std::make_unique<Entry>( nullptr ) );
+    assert( result.second );
+    iter = result.first;
+  }
+  Entry& entry( *iter->second );
+  if ( entry.pOption ) {
+    if ( pOption != entry.pOption ) {
+      std::cout << "IvSurface::Add: " << pOption->GetInstrumentName() << " already tracked" << std::endl;
+    }
+  }
+  else {
+    entry.pOption = pOption;
+    entry.iv.store( pOption->ImpliedVolatility(), std::memory_order_relaxed );
+    pOption->OnGreek.Add( MakeDelegate( &entry, &Entry::HandleGreek ) );
+  }
+}
+
+void IvSurface::Remove( pOption_t pOption ) {
+  assert( pOption );
+  std::lock_guard<std::mutex> lock( m_mutexEntry );
+  mapEntry_t::iterator iter = m_mapEntry.find( Key( *pOption ) );
+  if ( m_mapEntry.end() != iter ) {
+    Entry& entry( *iter->second );
+    if ( pOption == entry.pOption ) {
+      pOption->OnGreek.Remove( MakeDelegate( &entry, &Entry::HandleGreek ) );
+      m_mapEntry.erase( iter );
+    }
+  }
+}
+
+void IvSurface::Set( ptime dtUtcExpiry, double strike, ou::tf::OptionSide::EOptionSide side, double iv ) {
+  std::lock_guard<std::mutex> lock( m_mutexEntry );
+  const key_t key( dtUtcExpiry, strike, side );
+  mapEntry_t::iterator iter = m_mapEntry.find( key );
+  if ( m_mapEntry.end() == iter ) {
+    auto result = m_mapEntry.emplace( key, std::make_unique<Entry>( nullptr ) );
+    assert( result.second );
+    iter = result.first;
+  }
+  iter->second->iv.store( iv, std::memory_order_relaxed );
+}
+
+void IvSurface::SetOnSnapshot( fSnapshot_t&& fSnapshot ) {
+  m_fSnapshot = std::move( fSnapshot );
+}
+
+IvSurface::pSnapshot_t IvSurface::GetSnapshot() const {
+  return std::atomic_load( &m_pSnapshot );
+}
+
+void IvSurface::Refit( ptime dtUtcNow, double dblUnderlying ) {
+  {
+    std::lock_guard<std::mutex> lock( m_mutexRequest );
+    m_dtRequest = dtUtcNow;
+    m_dblRequestUnderlying = dblUnderlying;
+  }
+  if ( !m_bRefitQueued.exchange( true ) ) {
+    boost::asio::post( m_context, [this](){ Fit(); } );
+  }
+}
+
+void IvSurface::Fit() {
+
+  m_bRefitQueued.store( false ); // requests from here on queue another fit
+
+  ptime dtUtcNow;
+  double dblUnderlying;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexRequest );
+    dtUtcNow = m_dtRequest;
+    dblUnderlying = m_dblRequestUnderlying;
+  }
+  if ( !( 0.0 < dblUnderlying ) || dtUtcNow.is_special() ) return;
+
+  // gather the otm iv at each strike, keys are ordered by expiry, strike, side
+  using vExpiry_t = std::vector<std::pair<ptime,vPoint_t> >;
+  vExpiry_t vExpiry;
+  {
+    std::lock_guard<std::mutex> lock( m_mutexEntry );
+    mapEntry_t::const_iterator iter = m_mapEntry.begin();
+    while ( m_mapEntry.end() != iter ) {
+      const ptime dtExpiry( std::get<0>( iter->first ) );
+      const double strike( std::get<1>( iter->first ) );
+      const double tau( Years( dtExpiry - dtUtcNow ) );
+      double ivCall {};
+      double ivPut {};
+      for ( ; ( m_mapEntry.end() != iter ) && ( dtExpiry == std::get<0>( iter->first ) ) && ( strike == std::get<1>( iter->first ) ); iter++ ) {
+        const double iv( iter->second->iv.load( std::memory_order_relaxed ) );
+        switch ( std::get<2>( iter->first ) ) {
+          case ou::tf::OptionSide::Call: ivCall = iv; break;
+          case ou::tf::OptionSide::Put: ivPut = iv; break;
+          default: break;
+        }
+      }
+      if ( !( 0.0 < tau ) || !( 0.0 < strike ) ) continue;
+      if ( !std::isfinite( ivCall ) ) ivCall = 0.0;
+      if ( !std::isfinite( ivPut ) ) ivPut = 0.0;
+      double iv = ( strike < dblUnderlying ) ? ivPut : ivCall;
+      if ( !( 0.0 < iv ) ) iv = ( strike < dblUnderlying ) ? ivCall : ivPut;
+      if ( !( 0.0 < iv ) ) continue;
+      if ( vExpiry.empty() || ( dtExpiry != vExpiry.back().first ) ) {
+        vExpiry.emplace_back( dtExpiry, vPoint_t() );
+      }
+      vExpiry.back().second.push_back( Point { std::log( strike / dblUnderlying ), iv * iv * tau } );
+    }
+  }
+
+  std::shared_ptr<Snapshot> pSnapshot = std::make_shared<Snapshot>();
+  pSnapshot->dtUtcNow = dtUtcNow;
+  pSnapshot->dblUnderlying = dblUnderlying;
+  pSnapshot->vSlice.reserve( vExpiry.size() );
+
+  for ( const vExpiry_t::value_type& vt: vExpiry ) {
+
+    const vPoint_t& vPoint( vt.second );
+    if ( c_nMinPoints > vPoint.size() ) continue;
+
+    Slice slice;
+    slice.dtExpiry = vt.first;
+    slice.tau = Years( vt.first - dtUtcNow );
+    slice.nPoints = vPoint.size();
+
+    size_t nMaxIterations;
+    mapSvi_t::iterator iterSvi = m_mapSvi.find( vt.first );
+    if ( m_mapSvi.end() == iterSvi ) {
+      Guess( vPoint, slice.svi );
+      nMaxIterations = c_nMaxIterationsCold;
+    }
+    else {
+      slice.svi = iterSvi->second;
+      nMaxIterations = c_nMaxIterationsWarm;
+    }
+    slice.nIterations = FitSvi( vPoint, slice.svi, nMaxIterations, slice.rmse );
+    m_mapSvi[ vt.first ] = slice.svi;
+
+    // arbitrage checks across the quoted range
+    const double k1( vPoint.front().k );
+    const double k2( vPoint.back().k );
+    const double dk( ( k2 - k1 ) / ( c_nCheckPoints - 1 ) );
+    const Slice* pPrior( pSnapshot->vSlice.empty() ? nullptr : &pSnapshot->vSlice.back() );
+    for ( size_t ix = 0; ix < c_nCheckPoints; ix++ ) {
+      const double k( k1 + dk * ix );
+      if ( -1e-9 > slice.svi.g( k ) ) slice.bButterflyArbitrage = true;
+      if ( pPrior && ( slice.svi.w( k ) < ( pPrior->svi.w( k ) - 1e-9 ) ) ) slice.bCalendarArbitrage = true;
+    }
+
+    pSnapshot->vSlice.emplace_back( std::move( slice ) );
+  }
+
+  // forget parameters of expired slices
+  while ( !m_mapSvi.empty() && ( m_mapSvi.begin()->first <= dtUtcNow ) ) {
+    m_mapSvi.erase( m_mapSvi.begin() );
+  }
+
+  pSnapshot_t pPublish( std::move( pSnapshot ) );
+  std::atomic_store( &m_pSnapshot, pPublish );
+  if ( m_fSnapshot ) m_fSnapshot( pPublish );
+}
+
+} // namespace option
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,162 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    IvSurface.h
+ * Author:  raymond@burkholder.net
+ * Project: TFOptions
+ * Created: 2026
+ */
+
+#pragma once
+
+// implied volatility surface, complements IvAtm / Chain::TrackATM which supply only the atm point
+//   per option implied volatilities arrive through Option::OnGreek (as calculated by option::Engine)
+//   each expiry is fitted with a raw SVI smile in total variance: w(k) = a + b( rho( k - m ) + sqrt( ( k - m )^2 + sigma^2 ) )
+//     k = ln( strike / underlying ), the otm side is used at each strike
+//   refits run on a worker thread, warm started from the previous parameters of the expiry
+//   a refit publishes an immutable Snapshot, lookups on it are lock free, a closed form evaluation once the expiries are bracketed
+//   between expiries, total variance is interpolated linearly in time at constant k
+//   each snapshot is checked for butterfly (negative density) and calendar (decreasing total variance) arbitrage
+
+#include <map>
+#include <cmath>
+#include <mutex>
+#include <tuple>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+
+#include <TFTimeSeries/DatedDatum.h>
+
+#include <TFOptions/Option.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace option { // options
+
+class IvSurface {
+public:
+
+  using pOption_t = Option::pOption_t;
+  using ptime = boost::posix_time::ptime;
+
+  struct svi_t { // raw svi parameters
+    double a;
+    double b;
+    double rho;
+    double m;
+    double sigma;
+    svi_t(): a {}, b {}, rho {}, m {}, sigma {} {}
+    double w( double k ) const { // total variance
+      const double d( k - m );
+      return a + b * ( rho * d + std::sqrt( d * d + sigma * sigma ) );
+    }
+    double g( double k ) const; // risk neutral density factor, negative indicates butterfly arbitrage
+  };
+
+  struct Slice { // one expiry
+    ptime dtExpiry;
+    double tau; // years to expiry at the snapshot
+    svi_t svi;
+    double rmse; // total variance
+    size_t nPoints;
+    size_t nIterations;
+    bool bButterflyArbitrage;
+    bool bCalendarArbitrage; // total variance dips below that of the prior expiry
+    Slice(): tau {}, rmse {}, nPoints {}, nIterations {}, bButterflyArbitrage( false ), bCalendarArbitrage( false ) {}
+  };
+
+  struct Snapshot {
+
+    ptime dtUtcNow;
+    double dblUnderlying;
+    std::vector<Slice> vSlice; // ascending expiry
+
+    Snapshot(): dblUnderlying {} {}
+
+    double TotalVariance( double k, double tau ) const; // 0.0 when no slices
+    double Vol( double strike, ptime dtUtcExpiry ) const; // 0.0 when no slices or expired
+    bool Arbitrage() const;
+  };
+
+  using pSnapshot_t = std::shared_ptr<const Snapshot>;
+  using fSnapshot_t = std::function<void( pSnapshot_t )>; // called on the worker thread
+
+  IvSurface();
+  virtual ~IvSurface();
+
+  void Add( pOption_t ); // iv is tracked via OnGreek
+  void Remove( pOption_t );
+  void Set( ptime dtUtcExpiry, double strike, ou::tf::OptionSide::EOptionSide, double iv ); // iv from elsewhere
+
+  void Refit( ptime dtUtcNow, double dblUnderlying ); // queued, requests arriving during a refit are coalesced
+
+  void SetOnSnapshot( fSnapshot_t&& );
+
+  pSnapshot_t GetSnapshot() const; // latest fit, may be null
+
+  double Vol( double strike, ptime dtUtcExpiry ) const { // from the latest fit
+    pSnapshot_t pSnapshot( GetSnapshot() );
+    return pSnapshot ? pSnapshot->Vol( strike, dtUtcExpiry ) : 0.0;
+  }
+
+protected:
+private:
+
+  using key_t = std::tuple<ptime,double,ou::tf::OptionSide::EOptionSide>; // expiry, strike, side
+
+  struct Entry {
+    pOption_t pOption; // null when supplied via Set
+    std::atomic<double> iv;
+    Entry( pOption_t pOption_ ): pOption( std::move( pOption_ ) ), iv {} {}
+    void HandleGreek( const ou::tf::Greek& greek ) { iv.store( greek.ImpliedVolatility(), std::memory_order_relaxed ); }
+  };
+
+  using pEntry_t = std::unique_ptr<Entry>;
+  using mapEntry_t = std::map<key_t,pEntry_t>;
+
+  std::mutex m_mutexEntry;
+  mapEntry_t m_mapEntry;
+
+  std::mutex m_mutexRequest;
+  ptime m_dtRequest;
+  double m_dblRequestUnderlying;
+  std::atomic<bool> m_bRefitQueued;
+
+  pSnapshot_t m_pSnapshot; // std::atomic_load/store
+  fSnapshot_t m_fSnapshot;
+
+  using mapSvi_t = std::map<ptime,svi_t>;
+  mapSvi_t m_mapSvi; // warm start, worker thread only
+
+  boost::asio::io_context m_context;
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work;
+  std::thread m_threadWorker;
+
+  static key_t Key( Option& );
+
+  void Fit(); // worker thread
+
+};
+
+} // namespace option
+} // namespace tf
+} // namespace ou
@@ -76,25 +76,25 @@ void Calc( MarginRequirement& mr, const LongOption& src ) {
 
 //==== naked short call
 
-void Calc( RegT& mr, const Underlying& under, const ShortCall& call ) {
+void Calc( RegT& mr, const ZeroUnderlying& under, const ShortCall& call ) {
   double otm1 = call.pInstrument->GetStrike() - under.price;
   double otm2 = ( otm1 > 0.0 ) ? otm1 : 0.0;
   mr.margin = call.quantity * ( call.price + std::max<double>( 0.20 * under.price - otm2, 0.10 * under.price ) );
 }
 
-void Calc( CashOrRegTIra& mr, const Underlying& under, const ShortCall& src ) {
+void Calc( CashOrRegTIra& mr, const ZeroUnderlying& /* under */, const ShortCall& src ) {
   // 0
 }
 
 //==== naked short put
 
-void Calc( RegT& mr, const Underlying& under, const ShortPut& put ) {
+void Calc( RegT& mr, const ZeroUnderlying& under, const ShortPut& put ) {
   double otm1 = under.price - put.pInstrument->GetStrike();
   double otm2 = ( otm1 > 0.0 ) ? otm1 : 0.0;
   mr.margin = put.quantity * ( put.price + std::max<double>( 0.20 * under.price - otm2, 0.10 * put.pInstrument->GetStrike() ) );
 }
 
-void Calc( CashOrRegTIra& mr, const Underlying& under, const ShortPut& put ) {
+void Calc( CashOrRegTIra& mr, const ZeroUnderlying& /* under */, const ShortPut& put ) {
   mr.margin = put.quantity * put.pInstrument->GetStrike();
 }
 
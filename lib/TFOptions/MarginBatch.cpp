@@ -0,0 +1,437 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MarginBatch.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFOptions
+ * Created: 2026
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "MarginBatch.h"
+
+// each case corresponds to the Calc overload in Margin.cpp chosen for the account,
+//   and keeps its order of operations, so results are identical
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace option { // options
+namespace margin { // options
+
+namespace {
+
+  template<typename F>
+  inline void Each( size_t n, double* margin, F&& f ) {
+    for ( size_t ix = 0; ix < n; ix++ ) margin[ ix ] = f( ix );
+  }
+
+  inline double Positive( double value ) { return ( value > 0.0 ) ? value : 0.0; }
+
+  inline double ShortUnderlyingMaintenance( double quantity, double price ) {
+    return ( 16.67 <= price ) ? quantity * 0.30 * price
+         : ( 2.50 >= price ) ? quantity * 2.50
+         : ( 5.00 <= price ) ? quantity * 5.00
+         : quantity * price;
+  }
+
+  inline double NakedCall( double underlying, double strike, double quantity, double price ) {
+    const double otm2 = Positive( strike - underlying );
+    return quantity * ( price + std::max<double>( 0.20 * underlying - otm2, 0.10 * underlying ) );
+  }
+
+  inline double NakedPut( double underlying, double strike, double quantity, double price ) {
+    const double otm2 = Positive( underlying - strike );
+    return quantity * ( price + std::max<double>( 0.20 * underlying - otm2, 0.10 * strike ) );
+  }
+
+  inline bool RegT( EAccount eAccount ) {
+    return ( EAccount::Cash != eAccount ) && ( EAccount::RegTIra != eAccount );
+  }
+
+} // namespace anonymous
+
+Columns::Columns()
+: underlying( nullptr ), quantity( nullptr )
+{
+  for ( size_t ix = 0; ix < c_nMaxLegs; ix++ ) {
+    strike[ ix ] = legQuantity[ ix ] = legPrice[ ix ] = nullptr;
+  }
+}
+
+Columns::Columns( const Strategy& strategy )
+: underlying( &strategy.underlying ), quantity( &strategy.quantity )
+{
+  for ( size_t ix = 0; ix < c_nMaxLegs; ix++ ) {
+    strike[ ix ] = &strategy.leg[ ix ].strike;
+    legQuantity[ ix ] = &strategy.leg[ ix ].quantity;
+    legPrice[ ix ] = &strategy.leg[ ix ].price;
+  }
+}
+
+void Calc( EAccount eAccount, ERule eRule, const Columns& c, size_t n, double* margin ) {
+
+  const double* u = c.underlying;
+  const double* uq = c.quantity;
+  const double* k0 = c.strike[ 0 ];
+  const double* k1 = c.strike[ 1 ];
+  const double* k2 = c.strike[ 2 ];
+  const double* k3 = c.strike[ 3 ];
+  const double* q0 = c.legQuantity[ 0 ];
+  const double* q1 = c.legQuantity[ 1 ];
+  const double* q2 = c.legQuantity[ 2 ];
+  const double* q3 = c.legQuantity[ 3 ];
+  const double* p0 = c.legPrice[ 0 ];
+  const double* p1 = c.legPrice[ 1 ];
+  const double* p2 = c.legPrice[ 2 ];
+  const double* p3 = c.legPrice[ 3 ];
+
+  const bool bRegT( RegT( eAccount ) );
+
+  switch ( eRule ) {
+    case ERule::LongUnderlying:
+      switch ( eAccount ) {
+        case EAccount::RegTInitial:
+        case EAccount::RegTMaintenance:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.25 * u[ ix ]; } );
+          break;
+        case EAccount::RegTEndOfDay:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.50 * u[ ix ]; } );
+          break;
+        default:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * u[ ix ]; } );
+          break;
+      }
+      break;
+    case ERule::ShortUnderlying:
+      switch ( eAccount ) {
+        case EAccount::RegTInitial:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.30 * u[ ix ]; } );
+          break;
+        case EAccount::RegTMaintenance:
+          Each( n, margin, [=]( size_t ix ){ return ShortUnderlyingMaintenance( uq[ ix ], u[ ix ] ); } );
+          break;
+        case EAccount::RegTEndOfDay:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.50 * u[ ix ]; } );
+          break;
+        default:
+          std::fill( margin, margin + n, 0.0 );
+          break;
+      }
+      break;
+    case ERule::LongOption:
+      Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * p0[ ix ]; } );
+      break;
+    case ERule::NakedCall:
+      if ( bRegT ) Each( n, margin, [=]( size_t ix ){ return NakedCall( u[ ix ], k0[ ix ], q0[ ix ], p0[ ix ] ); } );
+      else std::fill( margin, margin + n, 0.0 );
+      break;
+    case ERule::NakedPut:
+      if ( bRegT ) Each( n, margin, [=]( size_t ix ){ return NakedPut( u[ ix ], k0[ ix ], q0[ ix ], p0[ ix ] ); } );
+      else Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * k0[ ix ]; } );
+      break;
+    case ERule::CoveredCall:
+      switch ( eAccount ) {
+        case EAccount::Cash:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * u[ ix ]; } );
+          break;
+        case EAccount::RegTIra:
+          std::fill( margin, margin + n, 0.0 );
+          break;
+        default:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.25 * u[ ix ] + uq[ ix ] * Positive( u[ ix ] - k0[ ix ] ); } );
+          break;
+      }
+      break;
+    case ERule::CoveredPut:
+      if ( bRegT ) Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.25 * u[ ix ] + uq[ ix ] * Positive( k0[ ix ] - u[ ix ] ); } );
+      else std::fill( margin, margin + n, 0.0 );
+      break;
+    case ERule::CallSpread:
+      if ( EAccount::Cash == eAccount ) std::fill( margin, margin + n, 0.0 );
+      else Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * std::max<double>( k0[ ix ] - k1[ ix ], 0.0 ); } );
+      break;
+    case ERule::PutSpread:
+      if ( EAccount::Cash == eAccount ) std::fill( margin, margin + n, 0.0 );
+      else Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * std::max<double>( k1[ ix ] - k0[ ix ], 0.0 ); } );
+      break;
+    case ERule::Collar:
+      switch ( eAccount ) {
+        case EAccount::RegTInitial:
+        case EAccount::RegTEndOfDay:
+          Each( n, margin, [=]( size_t ix ){
+            const double initial = uq[ ix ] * 0.25 * u[ ix ];
+            return ( k0[ ix ] != k1[ ix ] ) ? initial + q0[ ix ] * Positive( u[ ix ] - k0[ ix ] ) : initial;
+          } );
+          break;
+        case EAccount::RegTMaintenance:
+          Each( n, margin, [=]( size_t ix ){
+            return ( k0[ ix ] == k1[ ix ] )
+              ? uq[ ix ] * 0.10 * k0[ ix ]
+              : uq[ ix ] * std::min<double>( 0.10 * k1[ ix ] + Positive( u[ ix ] - k1[ ix ] ), 0.25 * k0[ ix ] );
+          } );
+          break;
+        default:
+          std::fill( margin, margin + n, 0.0 );
+          break;
+      }
+      break;
+    case ERule::LongCallPut:
+      Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * p0[ ix ] + q1[ ix ] * p1[ ix ]; } );
+      break;
+    case ERule::ShortCallPut:
+      if ( bRegT ) {
+        Each( n, margin, [=]( size_t ix ){
+          const double call = NakedCall( u[ ix ], k0[ ix ], q0[ ix ], p0[ ix ] );
+          const double put  = NakedPut(  u[ ix ], k1[ ix ], q1[ ix ], p1[ ix ] );
+          return ( call >= put ) ? call + q1[ ix ] * p1[ ix ] : put + q0[ ix ] * p0[ ix ];
+        } );
+      }
+      else std::fill( margin, margin + n, 0.0 );
+      break;
+    case ERule::LongButterfly:
+      if ( EAccount::Cash == eAccount ) std::fill( margin, margin + n, 0.0 );
+      else Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * p0[ ix ] - q1[ ix ] * p1[ ix ] + q2[ ix ] * p2[ ix ]; } );
+      break;
+    case ERule::ShortButterflyPut:
+    case ERule::ShortButterflyCall:
+      if ( bRegT ) {
+        Each( n, margin, [=]( size_t ix ){
+          const double hi = std::max<double>( k0[ ix ], k2[ ix ] );
+          const double lo = std::max<double>( k0[ ix ], k2[ ix ] );
+          return ( hi - k1[ ix ] ) + ( k1[ ix ] - lo );
+        } );
+      }
+      else std::fill( margin, margin + n, 0.0 );
+      break;
+    case ERule::LongBox:
+      if ( EAccount::Cash == eAccount ) std::fill( margin, margin + n, 0.0 );
+      else Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * p0[ ix ] - ( q1[ ix ] * p1[ ix ] ) + q2[ ix ] * p2[ ix ] - ( q3[ ix ] * p3[ ix ] ); } );
+      break;
+    case ERule::ShortBox:
+      if ( EAccount::Cash == eAccount ) std::fill( margin, margin + n, 0.0 );
+      else Each( n, margin, [=]( size_t ix ){
+        const double calc = p0[ ix ] + p3[ ix ] - p1[ ix ] - p2[ ix ];
+        return q0[ ix ] * std::max<double>( 1.02 * calc, k3[ ix ] - k1[ ix ] );
+      } );
+      break;
+    case ERule::ReverseConversion:
+      switch ( eAccount ) {
+        case EAccount::RegTInitial:
+        case EAccount::RegTEndOfDay:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.30 * u[ ix ] + q1[ ix ] * Positive( k1[ ix ] - u[ ix ] ); } );
+          break;
+        case EAccount::RegTMaintenance:
+          Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * 0.10 * k0[ ix ] + q1[ ix ] * Positive( k1[ ix ] - u[ ix ] ); } );
+          break;
+        default:
+          std::fill( margin, margin + n, 0.0 );
+          break;
+      }
+      break;
+    case ERule::ProtectivePut:
+      switch ( eAccount ) {
+        case EAccount::RegTInitial:
+        case EAccount::RegTEndOfDay:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.25 * u[ ix ]; } );
+          break;
+        case EAccount::RegTMaintenance:
+          Each( n, margin, [=]( size_t ix ){
+            return std::min<double>( q0[ ix ] * ( 0.10 * k0[ ix ] + Positive( u[ ix ] - k0[ ix ] ) ), uq[ ix ] * 0.25 * u[ ix ] );
+          } );
+          break;
+        default:
+          std::fill( margin, margin + n, 0.0 );
+          break;
+      }
+      break;
+    case ERule::ProtectiveCall:
+      switch ( eAccount ) {
+        case EAccount::RegTInitial:
+        case EAccount::RegTEndOfDay:
+          Each( n, margin, [=]( size_t ix ){ return uq[ ix ] * 0.30 * u[ ix ]; } );
+          break;
+        case EAccount::RegTMaintenance:
+          Each( n, margin, [=]( size_t ix ){
+            return std::min<double>( q0[ ix ] * ( 0.10 * k0[ ix ] + Positive( k0[ ix ] - u[ ix ] ) ), ShortUnderlyingMaintenance( uq[ ix ], u[ ix ] ) );
+          } );
+          break;
+        default:
+          std::fill( margin, margin + n, 0.0 );
+          break;
+      }
+      break;
+    case ERule::IronCondor:
+      if ( EAccount::Cash == eAccount ) std::fill( margin, margin + n, 0.0 );
+      else Each( n, margin, [=]( size_t ix ){ return q0[ ix ] * k0[ ix ] - q1[ ix ] * k1[ ix ]; } );
+      break;
+    default:
+      throw std::runtime_error( "margin::Calc: unknown rule" );
+      break;
+  }
+}
+
+double Calc( EAccount eAccount, const Strategy& strategy ) {
+  double margin {};
+  Calc( eAccount, strategy.rule, Columns( strategy ), 1, &margin );
+  return margin;
+}
+
+// ==== Book::Bucket
+
+void Book::Bucket::Append( idStrategy_t id_, const Strategy& strategy, double dblMargin ) {
+  underlying.push_back( strategy.underlying );
+  quantity.push_back( strategy.quantity );
+  for ( size_t ix = 0; ix < c_nMaxLegs; ix++ ) {
+    strike[ ix ].push_back( strategy.leg[ ix ].strike );
+    legQuantity[ ix ].push_back( strategy.leg[ ix ].quantity );
+    legPrice[ ix ].push_back( strategy.leg[ ix ].price );
+  }
+  margin.push_back( dblMargin );
+  id.push_back( id_ );
+}
+
+void Book::Bucket::Assign( size_t slot, const Strategy& strategy, double dblMargin ) {
+  underlying[ slot ] = strategy.underlying;
+  quantity[ slot ] = strategy.quantity;
+  for ( size_t ix = 0; ix < c_nMaxLegs; ix++ ) {
+    strike[ ix ][ slot ] = strategy.leg[ ix ].strike;
+    legQuantity[ ix ][ slot ] = strategy.leg[ ix ].quantity;
+    legPrice[ ix ][ slot ] = strategy.leg[ ix ].price;
+  }
+  margin[ slot ] = dblMargin;
+}
+
+Book::idStrategy_t Book::Bucket::Erase( size_t slot ) {
+  auto move = [slot]( auto& v ){ v[ slot ] = v.back(); v.pop_back(); };
+  move( underlying );
+  move( quantity );
+  for ( size_t ix = 0; ix < c_nMaxLegs; ix++ ) {
+    move( strike[ ix ] );
+    move( legQuantity[ ix ] );
+    move( legPrice[ ix ] );
+  }
+  move( margin );
+  move( id );
+  return ( slot < id.size() ) ? id[ slot ] : idStrategy_t( -1 );
+}
+
+Columns Book::Bucket::Get() const {
+  Columns columns;
+  columns.underlying = underlying.data();
+  columns.quantity = quantity.data();
+  for ( size_t ix = 0; ix < c_nMaxLegs; ix++ ) {
+    columns.strike[ ix ] = strike[ ix ].data();
+    columns.legQuantity[ ix ] = legQuantity[ ix ].data();
+    columns.legPrice[ ix ] = legPrice[ ix ].data();
+  }
+  return columns;
+}
+
+// ==== Book
+
+Book::Book( EAccount eAccount )
+: m_eAccount( eAccount ), m_dblMargin {}, m_nStrategies {}
+{}
+
+const Book::Location& Book::Find( idStrategy_t id ) const {
+  if ( ( m_vLocation.size() <= id ) || !m_vLocation[ id ].bActive ) {
+    throw std::runtime_error( "margin::Book: unknown strategy" );
+  }
+  return m_vLocation[ id ];
+}
+
+Book::idStrategy_t Book::Add( const Strategy& strategy ) {
+  const double dblMargin( margin::Calc( m_eAccount, strategy ) );
+  idStrategy_t id;
+  if ( m_vFree.empty() ) {
+    id = m_vLocation.size();
+    m_vLocation.emplace_back();
+  }
+  else {
+    id = m_vFree.back();
+    m_vFree.pop_back();
+  }
+  Bucket& bucket( m_rBucket[ (size_t)strategy.rule ] );
+  m_vLocation[ id ] = Location{ strategy.rule, (std::uint32_t)bucket.Size(), true };
+  bucket.Append( id, strategy, dblMargin );
+  m_dblMargin += dblMargin;
+  m_nStrategies++;
+  return id;
+}
+
+void Book::Update( idStrategy_t id, const Strategy& strategy ) {
+  const Location location( Find( id ) );
+  if ( location.rule == strategy.rule ) {
+    Bucket& bucket( m_rBucket[ (size_t)location.rule ] );
+    const double dblMargin( margin::Calc( m_eAccount, strategy ) );
+    m_dblMargin += dblMargin - bucket.margin[ location.ix ];
+    bucket.Assign( location.ix, strategy, dblMargin );
+  }
+  else { // moves to another bucket, keeps the id
+    Remove( id );
+    const idStrategy_t idAdded = Add( strategy );
+    if ( idAdded != id ) { // id was pushed to the free list by Remove, and re-used by Add
+      m_vLocation[ id ] = m_vLocation[ idAdded ];
+      m_vLocation[ idAdded ].bActive = false;
+      m_rBucket[ (size_t)strategy.rule ].id[ m_vLocation[ id ].ix ] = id;
+      m_vFree.push_back( idAdded );
+    }
+  }
+}
+
+void Book::Remove( idStrategy_t id ) {
+  const Location location( Find( id ) );
+  Bucket& bucket( m_rBucket[ (size_t)location.rule ] );
+  m_dblMargin -= bucket.margin[ location.ix ];
+  const idStrategy_t idMoved = bucket.Erase( location.ix );
+  if ( idStrategy_t( -1 ) != idMoved ) m_vLocation[ idMoved ].ix = location.ix;
+  m_vLocation[ id ].bActive = false;
+  m_vFree.push_back( id );
+  m_nStrategies--;
+}
+
+double Book::Calc() {
+  double total {};
+  for ( size_t ix = 0; ix < (size_t)ERule::Count; ix++ ) {
+    Bucket& bucket( m_rBucket[ ix ] );
+    const size_t n( bucket.Size() );
+    if ( 0 < n ) {
+      margin::Calc( m_eAccount, ERule( ix ), bucket.Get(), n, bucket.margin.data() );
+      for ( size_t slot = 0; slot < n; slot++ ) total += bucket.margin[ slot ];
+    }
+  }
+  m_dblMargin = total;
+  return total;
+}
+
+double Book::Margin( idStrategy_t id ) const {
+  const Location& location( Find( id ) );
+  return m_rBucket[ (size_t)location.rule ].margin[ location.ix ];
+}
+
+double Book::Incremental( const Strategy& strategy ) const {
+  return margin::Calc( m_eAccount, strategy );
+}
+
+double Book::Incremental( idStrategy_t id, const Strategy& strategy ) const {
+  return margin::Calc( m_eAccount, strategy ) - Margin( id );
+}
+
+} // namespace margin
+} // namespace option
+} // namespace tf
+} // namespace ou
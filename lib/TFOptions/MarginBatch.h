@@ -0,0 +1,161 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MarginBatch.h
+ * Author:  raymond@burkholder.net
+ * Project: TFOptions
+ * Created: 2026
+ */
+
+#pragma once
+
+// batch evaluation of the Margin.h rules
+//   strategies are bucketed by rule, each bucket holds its legs as a structure of arrays
+//   a rule is evaluated for a whole bucket in one loop, the expressions mirror Margin.cpp
+//   Book keeps the margin of each strategy, so adding, changing or proposing
+//     a strategy only evaluates that strategy
+
+#include <vector>
+#include <cstdint>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace option { // options
+namespace margin { // options
+
+enum class EAccount: std::uint8_t { RegTInitial, RegTMaintenance, RegTEndOfDay, Cash, RegTIra };
+
+// option legs are supplied in the order listed, the underlying is supplied separately
+enum class ERule: std::uint8_t {
+  LongUnderlying,     // underlying
+  ShortUnderlying,    // underlying
+  LongOption,         // long call or put
+  NakedCall,          // underlying price, short call
+  NakedPut,           // underlying price, short put
+  CoveredCall,        // long underlying, short call
+  CoveredPut,         // long underlying, short put
+  CallSpread,         // long call, short call
+  PutSpread,          // long put, short put
+  Collar,             // long underlying, short call, long put (conversion when strikes match)
+  LongCallPut,        // long call, long put
+  ShortCallPut,       // underlying price, short call, short put
+  LongButterfly,      // long option, short option, long option
+  ShortButterflyPut,  // short put, long put, short put
+  ShortButterflyCall, // short call, long call, short call
+  LongBox,            // long call, short put, long put, short call
+  ShortBox,           // long put, short call, short put, long call
+  ReverseConversion,  // short underlying, long call, short put
+  ProtectivePut,      // long underlying, long put
+  ProtectiveCall,     // short underlying, long call
+  IronCondor,         // short put, long put, short call, long call
+  Count
+};
+
+static const size_t c_nMaxLegs = 4;
+
+struct Leg {
+  double strike;
+  double quantity;
+  double price;
+  Leg(): strike {}, quantity {}, price {} {}
+  Leg( double strike_, double quantity_, double price_ ): strike( strike_ ), quantity( quantity_ ), price( price_ ) {}
+};
+
+struct Strategy {
+  ERule rule;
+  double underlying; // price
+  double quantity; // underlying quantity
+  Leg leg[ c_nMaxLegs ];
+  Strategy(): rule( ERule::LongUnderlying ), underlying {}, quantity {} {}
+  Strategy( ERule rule_, double underlying_, double quantity_ ): rule( rule_ ), underlying( underlying_ ), quantity( quantity_ ) {}
+};
+
+struct Columns { // one rule, n strategies
+  const double* underlying;
+  const double* quantity;
+  const double* strike[ c_nMaxLegs ];
+  const double* legQuantity[ c_nMaxLegs ];
+  const double* legPrice[ c_nMaxLegs ];
+  Columns();
+  explicit Columns( const Strategy& ); // a single strategy
+};
+
+// margin[ 0 .. n ) for strategies of one rule
+void Calc( EAccount, ERule, const Columns&, size_t n, double* margin );
+
+double Calc( EAccount, const Strategy& );
+
+class Book {
+public:
+
+  using idStrategy_t = std::uint32_t;
+
+  Book( EAccount );
+
+  idStrategy_t Add( const Strategy& );
+  void Update( idStrategy_t, const Strategy& ); // new prices, quantities or rule
+  void Remove( idStrategy_t );
+
+  double Calc(); // re-evaluates each bucket, returns the total
+  double Margin() const { return m_dblMargin; } // kept current by Add, Update, Remove
+  double Margin( idStrategy_t ) const;
+
+  // margin the change adds to the book, without applying it
+  double Incremental( const Strategy& ) const; // an added strategy
+  double Incremental( idStrategy_t, const Strategy& ) const; // a replaced strategy, may be negative
+
+  size_t Size() const { return m_nStrategies; }
+
+protected:
+private:
+
+  struct Bucket {
+    std::vector<double> underlying;
+    std::vector<double> quantity;
+    std::vector<double> strike[ c_nMaxLegs ];
+    std::vector<double> legQuantity[ c_nMaxLegs ];
+    std::vector<double> legPrice[ c_nMaxLegs ];
+    std::vector<double> margin;
+    std::vector<idStrategy_t> id; // slot -> strategy
+    size_t Size() const { return margin.size(); }
+    void Append( idStrategy_t, const Strategy&, double dblMargin );
+    void Assign( size_t ix, const Strategy&, double dblMargin );
+    idStrategy_t Erase( size_t ix ); // last slot moves into ix, returns its id
+    Columns Get() const;
+  };
+
+  struct Location {
+    ERule rule;
+    std::uint32_t ix;
+    bool bActive;
+  };
+
+  const EAccount m_eAccount;
+
+  double m_dblMargin;
+  size_t m_nStrategies;
+
+  Bucket m_rBucket[ (size_t)ERule::Count ];
+  std::vector<Location> m_vLocation; // by idStrategy_t
+  std::vector<idStrategy_t> m_vFree;
+
+  const Location& Find( idStrategy_t ) const;
+
+};
+
+} // namespace margin
+} // namespace option
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,108 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    LatencyModel.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: 2026
+ */
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "LatencyModel.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace sim { // simulation
+
+LatencyModel::LatencyModel()
+: m_tdConstant( boost::posix_time::time_duration( 0, 0, 0 ) )
+, m_tdPerMessage( boost::posix_time::time_duration( 0, 0, 0 ) )
+{}
+
+LatencyModel::LatencyModel( const boost::posix_time::time_duration& td )
+: m_tdConstant( td )
+, m_tdPerMessage( boost::posix_time::time_duration( 0, 0, 0 ) )
+{}
+
+void LatencyModel::SetConstant( const boost::posix_time::time_duration& td ) {
+  m_tdConstant = td;
+  m_pHistogram.reset();
+}
+
+void LatencyModel::LoadHistogram( const std::string& sFileName ) {
+
+  std::ifstream file( sFileName );
+  if ( !file.is_open() ) {
+    throw std::runtime_error( "LatencyModel::LoadHistogram: can't open " + sFileName );
+  }
+
+  auto pHistogram = std::make_shared<Histogram>();
+  double dblTotal {};
+
+  std::string sLine;
+  size_t nLine {};
+  while ( std::getline( file, sLine ) ) {
+    nLine++;
+    sLine = sLine.substr( 0, sLine.find( '#' ) );
+    std::replace( sLine.begin(), sLine.end(), ',', ' ' );
+    std::istringstream ss( sLine );
+    double dblMicroseconds;
+    double dblWeight;
+    if ( ss >> dblMicroseconds ) {
+      if ( !( ss >> dblWeight ) || ( 0.0 > dblMicroseconds ) || ( 0.0 > dblWeight ) ) {
+        throw std::runtime_error( "LatencyModel::LoadHistogram: " + sFileName + " bad bucket on line " + std::to_string( nLine ) );
+      }
+      if ( 0.0 < dblWeight ) {
+        dblTotal += dblWeight;
+        pHistogram->vCumulative.push_back( dblTotal );
+        pHistogram->vLatency.push_back( boost::posix_time::microseconds( (int64_t)( dblMicroseconds + 0.5 ) ) );
+      }
+    }
+  }
+
+  if ( pHistogram->vCumulative.empty() ) {
+    throw std::runtime_error( "LatencyModel::LoadHistogram: " + sFileName + " has no buckets" );
+  }
+
+  for ( double& dblCumulative: pHistogram->vCumulative ) {
+    dblCumulative /= dblTotal;
+  }
+  pHistogram->vCumulative.back() = 1.0; // no rounding gap at the top
+
+  m_pHistogram = std::move( pHistogram );
+}
+
+boost::posix_time::time_duration LatencyModel::Sample( rng_t& rng, size_t nInFlight ) const {
+  boost::posix_time::time_duration td( m_tdConstant );
+  if ( m_pHistogram ) {
+    // 53 random bits to [0,1), rather than std::uniform_real_distribution, which may differ between libraries
+    const double u = ( rng() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+    const std::vector<double>& v( m_pHistogram->vCumulative );
+    const size_t ix = std::upper_bound( v.begin(), v.end(), u ) - v.begin();
+    td = m_pHistogram->vLatency[ std::min( ix, v.size() - 1 ) ];
+  }
+  if ( 0 < nInFlight ) {
+    td += m_tdPerMessage * (int)nInFlight;
+  }
+  return td;
+}
+
+} // namespace sim
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,79 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    LatencyModel.h
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: 2026
+ */
+
+#pragma once
+
+// latency of one path ( order entry, cancel, market data ) for the simulated exchange
+//   constant, or drawn from an empirical distribution loaded from a histogram file
+//   either may grow with load:  each message already in flight on the path adds a fixed increment
+//   the random number generator is supplied by the caller, so a run is repeatable for a given seed
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace sim { // simulation
+
+class LatencyModel {
+public:
+
+  using rng_t = std::mt19937_64;
+
+  LatencyModel(); // constant, zero
+  LatencyModel( const boost::posix_time::time_duration& );
+
+  void SetConstant( const boost::posix_time::time_duration& ); // drops a loaded histogram
+
+  // one bucket per line:  latency in microseconds, then its weight ( a count or a fraction )
+  //   separated by white space or a comma, '#' starts a comment
+  //   throws std::runtime_error when the file can't be read or has no usable buckets
+  void LoadHistogram( const std::string& sFileName );
+
+  void SetLoadDependence( const boost::posix_time::time_duration& tdPerMessage ) { m_tdPerMessage = tdPerMessage; }
+
+  boost::posix_time::time_duration Sample( rng_t&, size_t nInFlight = 0 ) const;
+
+  bool IsConstant() const { return !m_pHistogram; }
+
+protected:
+private:
+
+  struct Histogram {
+    std::vector<double> vCumulative; // normalized to 1.0 at the last bucket
+    std::vector<boost::posix_time::time_duration> vLatency;
+  };
+
+  boost::posix_time::time_duration m_tdConstant;
+  boost::posix_time::time_duration m_tdPerMessage;
+
+  std::shared_ptr<const Histogram> m_pHistogram; // shared by copies of the model, as it is not modified once loaded
+
+};
+
+} // namespace sim
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,112 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MergeDatedDatumStream.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: 2026
+ */
+
+#include <cassert>
+#include <iostream>
+#include <algorithm>
+
+#include "MergeDatedDatumStream.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+StreamPrefetch::StreamPrefetch( const std::string& sFileName )
+: m_dm( ou::tf::HDF5DataManager::RO, sFileName )
+, m_nAllocated {}
+, m_bStop( false )
+{}
+
+StreamPrefetch::~StreamPrefetch() {
+  Stop();
+}
+
+void StreamPrefetch::Start( size_t nBudget ) {
+
+  assert( !m_thread.joinable() );
+
+  // each stream has two windows of the same number of datums
+  size_t nBytesPerDatum {};
+  for ( const Stream* pStream: m_vStream ) {
+    nBytesPerDatum += 2 * pStream->DatumSize();
+  }
+
+  m_nAllocated = 0;
+  if ( 0 < nBytesPerDatum ) {
+    const size_t nWindow( std::max<size_t>( 1, nBudget / nBytesPerDatum ) );
+    if ( 1 == nWindow ) {
+      std::cout << "StreamPrefetch: budget of " << nBudget << " bytes is below one datum per window" << std::endl;
+    }
+    for ( Stream* pStream: m_vStream ) {
+      const size_t nBlock( pStream->BlockSize() );
+      const size_t nAligned( ( nBlock <= nWindow ) ? ( nWindow / nBlock ) * nBlock : nWindow );
+      const size_t nUsed( std::min( nAligned, pStream->Size() ) );
+      pStream->Allocate( nUsed );
+      m_nAllocated += 2 * nUsed * pStream->DatumSize();
+    }
+  }
+
+  m_bStop = false;
+  m_thread = std::thread( &StreamPrefetch::Prefetch, this );
+}
+
+void StreamPrefetch::Stop() {
+  if ( m_thread.joinable() ) {
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_bStop = true;
+    }
+    m_cvRequest.notify_one();
+    m_thread.join();
+  }
+  m_dequeFill.clear();
+}
+
+void StreamPrefetch::Request( Stream* pStream, Window& window ) {
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    window.bReady = false;
+    m_dequeFill.push_back( Fill { pStream, &window } );
+  }
+  m_cvRequest.notify_one();
+}
+
+void StreamPrefetch::Wait( Window& window ) {
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cvReady.wait( lock, [&window](){ return window.bReady; } );
+}
+
+void StreamPrefetch::Prefetch() {
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while ( true ) {
+    m_cvRequest.wait( lock, [this](){ return m_bStop || !m_dequeFill.empty(); } );
+    if ( m_bStop ) break;
+    const Fill fill( m_dequeFill.front() );
+    m_dequeFill.pop_front();
+    lock.unlock();
+    fill.pStream->Load( *fill.pWindow );
+    lock.lock();
+    fill.pWindow->bReady = true;
+    m_cvReady.notify_one(); // only the merge thread waits
+  }
+}
+
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,258 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MergeDatedDatumStream.h
+ * Author:  raymond@burkholder.net
+ * Project: TFSimulation
+ * Created: 2026
+ */
+
+#pragma once
+
+// streamed replay: a series is read from the hdf5 file in windows rather than preloaded
+//   each stream has two windows, one being merged while the other is refilled by the prefetch thread
+//   the window size follows from the memory budget shared by all streams, it is at least one datum
+//   one prefetch thread serves all streams: hdf5 serializes access anyway, so more threads would only wait.
+//     Once started, it is the only thread reading the file, so with a library not built thread safe,
+//     the application should not use hdf5 while a streamed simulation runs
+//   the carriers see the same datums in the same order as with MergeCarrier, so the merge is identical
+
+#include <mutex>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include <TFHDF5TimeSeries/HDF5DataManager.h>
+#include <TFHDF5TimeSeries/HDF5TimeSeriesContainer.h>
+
+#include "MergeDatedDatumCarrier.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+class StreamPrefetch {
+public:
+
+  struct Window {
+    size_t ixBegin;
+    size_t nCount; // 0 when past the end of the series
+    bool bReady;   // guarded by the prefetch mutex
+    Window(): ixBegin {}, nCount {}, bReady( false ) {}
+  };
+
+  class Stream {
+    friend class StreamPrefetch;
+  public:
+    virtual ~Stream() {}
+  protected:
+    virtual size_t Size() const = 0; // datums in the series
+    virtual size_t DatumSize() const = 0; // bytes per datum
+    virtual size_t BlockSize() const = 0; // dataset chunking, windows are aligned to it when they are large enough
+    virtual void Allocate( size_t nWindow ) = 0;
+    virtual void Load( Window& ) = 0;
+  };
+
+  StreamPrefetch( const std::string& sFileName );
+  ~StreamPrefetch();
+
+  // nullptr when the series is absent or empty
+  template<class DD>
+  MergeCarrierBase* Add( const std::string& sPath, MergeCarrierBase::OnDatumHandler );
+
+  // size the windows, load the first two of each stream, then start the prefetch thread
+  void Start( size_t nBudget ); // bytes
+  void Stop();
+
+  size_t Allocated() const { return m_nAllocated; } // bytes in windows
+
+  void Request( Stream*, Window& ); // from the merge thread
+  void Wait( Window& );
+
+protected:
+private:
+
+  struct Fill {
+    Stream* pStream;
+    Window* pWindow;
+  };
+
+  ou::tf::HDF5DataManager m_dm;
+
+  std::vector<Stream*> m_vStream; // owned by the merge as carriers
+
+  size_t m_nAllocated;
+
+  bool m_bStop;
+  std::mutex m_mutex;
+  std::condition_variable m_cvRequest;
+  std::condition_variable m_cvReady;
+  std::deque<Fill> m_dequeFill;
+
+  std::thread m_thread;
+
+  void Prefetch(); // the background thread
+};
+
+// MergeCarrierStream
+
+template<class DD> // DD is a DatedDatum type
+class MergeCarrierStream
+: public MergeCarrierBase
+, public StreamPrefetch::Stream
+{
+public:
+  MergeCarrierStream( StreamPrefetch&, std::unique_ptr<HDF5TimeSeriesContainer<DD> >&&, OnDatumHandler );
+  virtual ~MergeCarrierStream();
+  void ProcessDatum();
+protected:
+  size_t Size() const { return m_nSize; }
+  size_t DatumSize() const { return sizeof( DD ); }
+  size_t BlockSize() const { return m_pRepository->BlockSize(); }
+  void Allocate( size_t nWindow );
+  void Load( StreamPrefetch::Window& );
+private:
+
+  struct Window: public StreamPrefetch::Window {
+    std::vector<DD> vDatum;
+  };
+
+  StreamPrefetch& m_prefetch;
+  std::unique_ptr<HDF5TimeSeriesContainer<DD> > m_pRepository; // read by the prefetch thread once started
+
+  size_t m_nSize;
+  size_t m_nWindow;
+  size_t m_ixNext; // start of the next window to request
+
+  std::array<Window,2> m_rWindow;
+  size_t m_ixWindow; // the window being merged
+  size_t m_ixDatum;  // within the window
+
+  void Assign( Window& ); // the next range of the series
+  void Current();
+};
+
+template<class DD>
+MergeCarrierBase* StreamPrefetch::Add( const std::string& sPath, MergeCarrierBase::OnDatumHandler function ) {
+  MergeCarrierStream<DD>* pCarrier( nullptr );
+  try {
+    std::unique_ptr<HDF5TimeSeriesContainer<DD> > pRepository
+      = std::make_unique<HDF5TimeSeriesContainer<DD> >( m_dm, sPath );
+    if ( 0 != pRepository->size() ) {
+      pCarrier = new MergeCarrierStream<DD>( *this, std::move( pRepository ), function );
+      m_vStream.push_back( pCarrier );
+    }
+  }
+  catch ( std::runtime_error& e ) {
+    // couldn't open, so nothing to merge, as with the preload
+  }
+  return pCarrier;
+}
+
+template<class DD>
+MergeCarrierStream<DD>::MergeCarrierStream(
+  StreamPrefetch& prefetch
+, std::unique_ptr<HDF5TimeSeriesContainer<DD> >&& pRepository
+, OnDatumHandler function
+)
+: MergeCarrierBase()
+, m_prefetch( prefetch )
+, m_pRepository( std::move( pRepository ) )
+, m_nSize( m_pRepository->size() )
+, m_nWindow {}, m_ixNext {}
+, m_ixWindow {}, m_ixDatum {}
+{
+  OnDatum = function;
+  m_pDatum = nullptr;
+  m_dt = boost::date_time::special_values::not_a_date_time;
+}
+
+template<class DD>
+MergeCarrierStream<DD>::~MergeCarrierStream() {
+}
+
+template<class DD>
+void MergeCarrierStream<DD>::Allocate( size_t nWindow ) {
+  // called before the prefetch thread starts, so the first windows are loaded directly
+  m_nWindow = nWindow;
+  m_ixNext = 0;
+  for ( Window& window: m_rWindow ) {
+    window.vDatum.resize( std::min( m_nWindow, m_nSize ) );
+    Assign( window );
+    Load( window );
+    window.bReady = true;
+  }
+  m_ixWindow = 0;
+  m_ixDatum = 0;
+  Current();
+}
+
+template<class DD>
+void MergeCarrierStream<DD>::Assign( Window& window ) {
+  window.ixBegin = m_ixNext;
+  window.nCount = std::min( m_nWindow, m_nSize - m_ixNext );
+  m_ixNext += window.nCount;
+}
+
+template<class DD>
+void MergeCarrierStream<DD>::Load( StreamPrefetch::Window& window_ ) {
+  Window& window( static_cast<Window&>( window_ ) );
+  if ( 0 < window.nCount ) {
+    hsize_t nCount( window.nCount );
+    H5::DataSpace dsMemory( 1, &nCount );
+    m_pRepository->HDF5TimeSeriesAccessor<DD>::Read( window.ixBegin, nCount, &dsMemory, window.vDatum.data() );
+    dsMemory.close();
+  }
+}
+
+template<class DD>
+void MergeCarrierStream<DD>::Current() {
+  const Window& window( m_rWindow[ m_ixWindow ] );
+  m_pDatum = ( m_ixDatum < window.nCount ) ? &window.vDatum[ m_ixDatum ] : nullptr;
+  m_dt = ( nullptr == m_pDatum )
+    ? boost::date_time::special_values::not_a_date_time
+    : m_pDatum->DateTime();
+}
+
+template<class DD>
+void MergeCarrierStream<DD>::ProcessDatum() {
+  if ( ou::TimeSource::LocalCommonInstance().GetSimulationMode() ) {
+    ou::TimeSource::LocalCommonInstance().SetSimulationTime( m_pDatum->DateTime() );
+  }
+  if ( nullptr != OnDatum )
+    OnDatum( *m_pDatum );
+  ++m_ixDatum;
+  if ( m_rWindow[ m_ixWindow ].nCount == m_ixDatum ) {
+    // consumed, refill with the range after the other window
+    Window& window( m_rWindow[ m_ixWindow ] );
+    Assign( window );
+    if ( 0 < window.nCount ) {
+      m_prefetch.Request( this, window );
+    }
+    m_ixWindow = 1 - m_ixWindow;
+    m_ixDatum = 0;
+    if ( 0 < m_rWindow[ m_ixWindow ].nCount ) {
+      m_prefetch.Wait( m_rWindow[ m_ixWindow ] );
+    }
+  }
+  Current();
+}
+
+} // namespace tf
+} // namespace ou
@@ -57,6 +57,11 @@ void MergeDatedDatums::Add( TimeSeries<DepthByOrder>& series, MergeDatedDatums::
   m_mhCarriers.Append( new MergeCarrier<DepthByOrder>( series, function ) );
 }
 
+void MergeDatedDatums::Add( MergeCarrierBase* pCarrier ) {
+  assert( nullptr != pCarrier->GetDatedDatum() );
+  m_mhCarriers.Append( pCarrier );
+}
+
 // http://www.codeguru.com/forum/archive/index.php/t-344661.html
 
 /*
@@ -45,6 +45,7 @@ public:
   void Add( TimeSeries<Greek>& series, OnDatumHandler );
   void Add( TimeSeries<DepthByMM>& series, OnDatumHandler );
   void Add( TimeSeries<DepthByOrder>& series, OnDatumHandler );
+  void Add( MergeCarrierBase* ); // takes ownership, eg MergeCarrierStream
   void Run();
   void Stop();
 
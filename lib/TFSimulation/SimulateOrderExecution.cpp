@@ -12,6 +12,10 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <cmath>
+#include <limits>
+#include <ostream>
+
 #include <boost/log/trivial.hpp>
 
 #include <boost/lexical_cast.hpp>
@@ -28,8 +32,11 @@ namespace sim { // simulation
 
 int OrderExecution::m_nExecId( 1000 );
 
+const OrderExecution::quantity_t OrderExecution::c_nAheadUnknown( std::numeric_limits<quantity_t>::max() );
+
 OrderExecution::OrderExecution()
-: m_dtQueueDelay( milliseconds( 250 ) )
+: m_rng( m_model.nSeed )
+, m_dtLastArrival( boost::posix_time::min_date_time )
 , m_dblCommission( 1.00 )
 {
 }
@@ -43,7 +50,19 @@ std::string OrderExecution::GetExecId() {
   return sId;
 }
 
+void OrderExecution::SetModel( const Model& model ) {
+  m_model = model;
+  m_rng.seed( m_model.nSeed );
+  m_stats = Statistics();
+  m_vMarkout.clear();
+  for ( const boost::posix_time::time_duration& td: m_model.vMarkout ) {
+    m_stats.vMarkout.emplace_back( td );
+    m_vMarkout.emplace_back();
+  }
+}
+
 void OrderExecution::NewQuote( const Quote& quote ) {
+  ProcessMarkouts( quote.DateTime() );
   ProcessOrderQueues( quote );
   m_lastQuote = quote; // should this be: before or after?
 }
@@ -58,7 +77,22 @@ void OrderExecution::NewDepthByOrder( const DepthByOrder& depth ) {
 }
 
 void OrderExecution::NewTrade( const Trade& trade ) {
-  ProcessLimitOrders( trade );
+  if ( m_model.bQueue ) {
+    ProcessInFlight( m_lastQuote, trade.DateTime() ); // orders arriving ahead of the print
+    ProcessQueue( trade );
+  }
+  else {
+    ProcessLimitOrders( trade );
+  }
+}
+
+ptime OrderExecution::Arrival( const LatencyModel& latency ) {
+  ptime dtArrival( ou::TimeSource::LocalCommonInstance().Internal() );
+  dtArrival += m_model.latencyMarketData.Sample( m_rng );
+  dtArrival += latency.Sample( m_rng, m_dequeInFlight.size() );
+  if ( dtArrival < m_dtLastArrival ) dtArrival = m_dtLastArrival; // one channel, no overtaking
+  m_dtLastArrival = dtArrival;
+  return dtArrival;
 }
 
 void OrderExecution::SubmitOrder( pOrder_t pOrder ) {
@@ -66,15 +100,14 @@ void OrderExecution::SubmitOrder( pOrder_t pOrder ) {
   Order::idOrder_t idOrder( pOrder->GetOrderId() );
   BOOST_LOG_TRIVIAL(info)
     << "simulate," << idOrder << ",queued,submit," << pOrder->GetInstrument()->GetInstrumentName();
-  m_lOrderDelay.push_back( pOrder );
+  m_dequeInFlight.emplace_back( Arrival( m_model.latencyEntry ), pOrder );
   TrackOrder( idOrder, OrderState::State::Delay ); // might be new or a change
 }
 
 void OrderExecution::CancelOrder( Order::idOrder_t idOrder ) {
   BOOST_LOG_TRIVIAL(info)
     << "simulate," << idOrder << ",queued,cancel";
-  QueuedCancelOrder qco( ou::TimeSource::LocalCommonInstance().Internal(), idOrder );
-  m_lCancelDelay.push_back( qco );
+  m_dequeInFlight.emplace_back( Arrival( m_model.latencyCancel ), idOrder );
   TrackOrder( idOrder, OrderState::State::Delay ); // should match an existing order
 }
 
@@ -122,16 +155,19 @@ void OrderExecution::ProcessOrderQueues( const Quote &quote ) {
   //  return;
   //}
 
-  ProcessCancelQueue( quote );
-
-  ProcessDelayQueue( quote );
+  ProcessInFlight( m_lastQuote, quote.DateTime() ); // at arrival, the previous quote is the one prevailing
 
   ProcessStopOrders( quote ); // places orders into market orders queue
 
   bool bProcessed;
   bProcessed = ProcessMarketOrders( quote );
-  if ( !bProcessed ) {
-    bProcessed = ProcessLimitOrders( quote );
+  if ( m_model.bQueue ) {
+    ProcessQueue( quote );
+  }
+  else {
+    if ( !bProcessed ) {
+      bProcessed = ProcessLimitOrders( quote );
+    }
   }
 
 }
@@ -198,6 +234,7 @@ bool OrderExecution::ProcessMarketOrders( const Quote& quote ) {
     }
 
     CalculateCommission( order, quanApplied );
+    RecordFill( order, dblPrice, quanApplied, false );
 
     // when order done, commission and toss away
     // what happens on cancelled orders and partial fills?
@@ -220,16 +257,16 @@ bool OrderExecution::ProcessLimitOrders( const Quote& quote ) {
   // todo: what about self's own crossing orders, could fill with out qoute
 
   if ( !m_mapAsks.empty() ) {
-    mapOrderBook_ask_t::iterator iterOrderBook( m_mapAsks.begin() );
+    mapLimit_ask_t::iterator iterOrderBook( m_mapAsks.begin() );
     //mapOrderBook_t::value_type& entry( *m_mapAsks.begin() );
-    mapOrderBook_ask_t::value_type& entry( *iterOrderBook );
+    mapLimit_ask_t::value_type& entry( *iterOrderBook );
     const double bid( quote.Bid() );
     if ( bid >= entry.first ) {
       if ( 0 < quote.BidSize() ) {
 
         bProcessed = true;
 
-        ou::tf::Order& order( *entry.second );
+        ou::tf::Order& order( *entry.second.pOrder );
         ou::tf::Order::idOrder_t idOrder( order.GetOrderId() );
         int nId( m_nExecId );  // before it gets incremented in next function
         std::string id = GetExecId();
@@ -270,12 +307,14 @@ bool OrderExecution::ProcessLimitOrders( const Quote& quote ) {
         }
 
         CalculateCommission( order, quanApplied );
+        RecordFill( order, bid, quanApplied, true );
 
         if ( 0 == nOrderQuanRemaining ) {
           BOOST_LOG_TRIVIAL(info)
             << "simulate,lmt_ask,erase=("
             << idOrder << "," << id << ")"
             ;
+          RecordCompletion( order, true );
           m_mapAsks.erase( iterOrderBook );
           MigrateActiveToArchive( idOrder );
         }
@@ -285,16 +324,16 @@ bool OrderExecution::ProcessLimitOrders( const Quote& quote ) {
   }
 
   if ( !m_mapBids.empty() && !bProcessed) {
-    mapOrderBook_bid_t::iterator iterOrderBook( m_mapBids.begin() );
+    mapLimit_bid_t::iterator iterOrderBook( m_mapBids.begin() );
     //mapOrderBook_t::value_type& entry( *m_mapBids.rbegin() );
-    mapOrderBook_bid_t::value_type& entry( *iterOrderBook );
+    mapLimit_bid_t::value_type& entry( *iterOrderBook );
     const double ask( quote.Ask() );
     if ( ask <= entry.first ) {
       if ( 0 < quote.AskSize() ) {
 
         bProcessed = true;
 
-        ou::tf::Order& order( *entry.second );
+        ou::tf::Order& order( *entry.second.pOrder );
         ou::tf::Order::idOrder_t idOrder( order.GetOrderId() );
         int nId( m_nExecId );  // before it gets incremented in next function
         std::string id = GetExecId();
@@ -335,12 +374,14 @@ bool OrderExecution::ProcessLimitOrders( const Quote& quote ) {
         }
 
         CalculateCommission( order, quanApplied );
+        RecordFill( order, ask, quanApplied, true );
 
         if ( 0 == nOrderQuanRemaining ) {
           BOOST_LOG_TRIVIAL(info)
             << "simulate,lmt_bid,erase=("
             << idOrder << "," << id << ")"
             ;
+          RecordCompletion( order, true );
           // https://stackoverflow.com/questions/1830158/how-to-call-erase-with-a-reverse-iterator
           m_mapBids.erase( iterOrderBook );
           MigrateActiveToArchive( idOrder );
@@ -376,233 +417,482 @@ bool OrderExecution::ProcessLimitOrders( const Trade& trade ) {
   return false;
 }
 
-void OrderExecution::ProcessDelayQueue( const Quote& quote ) {
+void OrderExecution::ProcessInFlight( const Quote& quote, const ptime& dtNow ) {
 
-  // process the delay list
-  while ( !m_lOrderDelay.empty() ) {
+  // orders and cancels, in the order they reach the exchange
+  while ( !m_dequeInFlight.empty() ) {
 
-    pOrder_t pOrderFrontOfQueue = m_lOrderDelay.front();
-    ou::tf::Order& order( *pOrderFrontOfQueue );
-
-    if ( ( order.GetDateTimeOrderSubmitted() + m_dtQueueDelay ) >= quote.DateTime() ) {
-      break;
+    if ( m_dequeInFlight.front().dtArrival >= dtNow ) {
+      break;  // havn't waited long enough to simulate submission
     }
     else {
+      InFlight inflight( std::move( m_dequeInFlight.front() ) );
+      m_dequeInFlight.pop_front(); // before processing, fill events may submit further orders
+
+      if ( inflight.pOrder ) {
+        ProcessArrival( std::move( inflight.pOrder ), quote );
+      }
+      else {
+        ProcessCancel( inflight.nOrderId );
+      }
+    }
+  }
 
-      //BOOST_LOG_TRIVIAL(info)
-      //  << "simulate"
-      //  << ",dequeue,"
-      //  << order.GetOrderId()
-      //  ;
+}
 
-      m_lOrderDelay.pop_front();
+void OrderExecution::ProcessArrival( pOrder_t pOrder, const Quote& quote ) {
 
-      Order::idOrder_t idOrder( order.GetOrderId() );
+  ou::tf::Order& order( *pOrder );
+  Order::idOrder_t idOrder( order.GetOrderId() );
 
-      if ( IsOrderArchive( idOrder ) ) {
-        BOOST_LOG_TRIVIAL(info)
-          << "simulate,"
-          << idOrder
-          << ",archived"
-          ;
-      }
-      else {
+  if ( IsOrderArchive( idOrder ) ) {
+    BOOST_LOG_TRIVIAL(info)
+      << "simulate,"
+      << idOrder
+      << ",archived"
+      ;
+    return;
+  }
 
-        if ( IsOrderActive( idOrder ) ) { // a change order is occuring, so remove old version
-          switch ( order.GetOrderType() ) {
-            case OrderType::Market:
-              assert( false ); // doesn't make sense to do anything else
-              break;
-            case OrderType::Limit:
-              // update the order
-                {
-                  bool bFound( false );
-                  for ( mapOrderBook_ask_t::iterator iter = m_mapAsks.begin(); iter != m_mapAsks.end(); ++iter ) {
-                    if ( idOrder == order.GetOrderId() ) {
-                      ou::tf::Order& old( *iter->second );
-                      assert( OrderType::Limit == old.GetOrderType() );
-                      assert( order.GetOrderSide() == old.GetOrderSide() );
-                      m_mapAsks.erase( iter );
-                      bFound = true;
-                      break;
-                    }
-                  }
-                  if ( !bFound ) {
-                    for ( mapOrderBook_bid_t::iterator iter = m_mapBids.begin(); iter != m_mapBids.end(); ++iter ) {
-                      if ( idOrder == order.GetOrderId() ) {
-                        ou::tf::Order& old( *iter->second );
-                        assert( OrderType::Limit == old.GetOrderType() );
-                        assert( order.GetOrderSide() == old.GetOrderSide() );
-                        m_mapBids.erase( iter );
-                        break;
-                      }
-                    }
-                  }
-                }
-              break;
-            case OrderType::Stop:
-              // update the order
-              break;
-            default:
-              assert( false );
+  if ( IsOrderActive( idOrder ) ) { // a change order is occuring, so remove old version
+    switch ( order.GetOrderType() ) {
+      case OrderType::Market:
+        assert( false ); // doesn't make sense to do anything else
+        break;
+      case OrderType::Limit:
+        // update the order, it loses its place in the queue
+        {
+          bool bFound( false );
+          for ( mapLimit_ask_t::iterator iter = m_mapAsks.begin(); iter != m_mapAsks.end(); ++iter ) {
+            ou::tf::Order& old( *iter->second.pOrder );
+            if ( idOrder == old.GetOrderId() ) {
+              assert( OrderType::Limit == old.GetOrderType() );
+              assert( order.GetOrderSide() == old.GetOrderSide() );
+              m_mapAsks.erase( iter );
+              bFound = true;
               break;
+            }
+          }
+          if ( !bFound ) {
+            for ( mapLimit_bid_t::iterator iter = m_mapBids.begin(); iter != m_mapBids.end(); ++iter ) {
+              ou::tf::Order& old( *iter->second.pOrder );
+              if ( idOrder == old.GetOrderId() ) {
+                assert( OrderType::Limit == old.GetOrderType() );
+                assert( order.GetOrderSide() == old.GetOrderSide() );
+                m_mapBids.erase( iter );
+                break;
+              }
+            }
           }
         }
-        else {
-          MigrateDelayToActive( idOrder );
-        }
+        break;
+      case OrderType::Stop:
+        // update the order
+        break;
+      default:
+        assert( false );
+        break;
+    }
+  }
+  else {
+    MigrateDelayToActive( idOrder );
+    if ( OrderType::Limit == order.GetOrderType() ) {
+      m_stats.nLimitOrders++;
+      m_stats.nLimitQuantityOrdered += order.GetQuanOrdered();
+    }
+  }
 
-        switch ( order.GetOrderType() ) {
-          case OrderType::Market:
-            // place into market order book
-            m_lOrderMarket.push_back( pOrderFrontOfQueue );
-            //if ( nullptr != OnOrderCancelled ) OnOrderCancelled( order.GetOrderId() );
-            break;
-          case OrderType::Limit:
-            // place into limit book
-            // TODO: can't have limit orders in two different directions
-            assert( 0 < order.GetPrice1() );
-
-            switch ( order.GetOrderSide() ) {
-              case OrderSide::Sell:
-                m_mapAsks.insert( mapOrderBook_ask_t::value_type( order.GetPrice1(), pOrderFrontOfQueue ) );
-                break;
-              case OrderSide::Buy:
-                m_mapBids.insert( mapOrderBook_bid_t::value_type( order.GetPrice1(), pOrderFrontOfQueue ) );
-                break;
-              default:
-                assert( false );
-                break;
+  switch ( order.GetOrderType() ) {
+    case OrderType::Market:
+      // place into market order book
+      m_lOrderMarket.push_back( pOrder );
+      //if ( nullptr != OnOrderCancelled ) OnOrderCancelled( order.GetOrderId() );
+      break;
+    case OrderType::Limit:
+      // place into limit book
+      // TODO: can't have limit orders in two different directions
+      assert( 0 < order.GetPrice1() );
+
+      if ( m_model.bQueue ) {
+        // take what is displayed at the inside when marketable, the remainder rests
+        const double dblPrice( order.GetPrice1() );
+        quantity_t nRemaining( order.GetQuanRemaining() );
+        switch ( order.GetOrderSide() ) {
+          case OrderSide::Sell:
+            if ( ( 0.0 < quote.Bid() ) && ( dblPrice <= quote.Bid() ) && ( 0 < quote.BidSize() ) ) {
+              const quantity_t nFill( std::min<Trade::tradesize_t>( nRemaining, quote.BidSize() ) );
+              Fill( order, quote.Bid(), nFill, "SIMLmtSell", false );
+              nRemaining -= nFill;
+            }
+            if ( 0 < nRemaining ) {
+              mapLimit_ask_t::iterator iter = m_mapAsks.emplace( dblPrice, Resting( pOrder ) );
+              if ( dblPrice == quote.Ask() ) iter->second.nAhead = quote.AskSize();
+              else if ( ( dblPrice < quote.Ask() ) || ( 0.0 == quote.Ask() ) ) iter->second.nAhead = 0;
             }
             break;
-          case OrderType::Stop:
-            // place into stop book
-            assert( 0 < order.GetPrice1() );
-            switch ( order.GetOrderSide() ) {
-              case OrderSide::Sell:
-                m_mapSellStops.insert( mapOrderBook_ask_t::value_type( order.GetPrice1(), pOrderFrontOfQueue ) );
-                break;
-              case OrderSide::Buy:
-                m_mapBuyStops.insert( mapOrderBook_bid_t::value_type( order.GetPrice1(), pOrderFrontOfQueue ) );
-                break;
-              default:
-                assert( false );
-                break;
+          case OrderSide::Buy:
+            if ( ( 0.0 < quote.Ask() ) && ( dblPrice >= quote.Ask() ) && ( 0 < quote.AskSize() ) ) {
+              const quantity_t nFill( std::min<Trade::tradesize_t>( nRemaining, quote.AskSize() ) );
+              Fill( order, quote.Ask(), nFill, "SIMLmtBuy", false );
+              nRemaining -= nFill;
+            }
+            if ( 0 < nRemaining ) {
+              mapLimit_bid_t::iterator iter = m_mapBids.emplace( dblPrice, Resting( pOrder ) );
+              if ( ( 0.0 < quote.Bid() ) && ( dblPrice == quote.Bid() ) ) iter->second.nAhead = quote.BidSize();
+              else if ( ( dblPrice > quote.Bid() ) || ( 0.0 == quote.Bid() ) ) iter->second.nAhead = 0;
             }
             break;
           default:
             assert( false );
             break;
         }
+        if ( 0 == nRemaining ) {
+          RecordCompletion( order, true );
+          MigrateActiveToArchive( idOrder );
+        }
       }
-    }
+      else {
+        switch ( order.GetOrderSide() ) {
+          case OrderSide::Sell:
+            m_mapAsks.emplace( order.GetPrice1(), Resting( pOrder ) );
+            break;
+          case OrderSide::Buy:
+            m_mapBids.emplace( order.GetPrice1(), Resting( pOrder ) );
+            break;
+          default:
+            assert( false );
+            break;
+        }
+      }
+      break;
+    case OrderType::Stop:
+      // place into stop book
+      assert( 0 < order.GetPrice1() );
+      switch ( order.GetOrderSide() ) {
+        case OrderSide::Sell:
+          m_mapSellStops.insert( mapOrderBook_ask_t::value_type( order.GetPrice1(), pOrder ) );
+          break;
+        case OrderSide::Buy:
+          m_mapBuyStops.insert( mapOrderBook_bid_t::value_type( order.GetPrice1(), pOrder ) );
+          break;
+        default:
+          assert( false );
+          break;
+      }
+      break;
+    default:
+      assert( false );
+      break;
   }
 
 }
 
-void OrderExecution::ProcessCancelQueue( const Quote& quote ) {
+void OrderExecution::ProcessCancel( Order::idOrder_t idOrder ) {
+
+  bool bOrderFound = false;
+
+  // need a fusion array based upon orders so can zero in on order without looping through all the structures
 
-  // process cancels list
-  while ( !m_lCancelDelay.empty() ) {
-    if ( ( m_lCancelDelay.front().dtCancellation + m_dtQueueDelay ) >= quote.DateTime() ) {
-      break;  // havn't waited long enough to simulate cancel submission
+  // the order itself can not still be in flight, the cancel follows it on the same channel
+
+  // check the market order queue
+  if ( !bOrderFound ) {
+    for ( lOrderQueue_iter_t iter = m_lOrderMarket.begin(); iter != m_lOrderMarket.end(); ++iter ) {
+      ou::tf::Order& order( **iter );
+      if ( idOrder == order.GetOrderId() ) {
+        m_lOrderMarket.erase( iter );
+        bOrderFound = true;
+        break;
+      }
     }
-    else {
-      QueuedCancelOrder& qco = m_lCancelDelay.front();  // capture the information
-      bool bOrderFound = false;
-
-      // need a fusion array based upon orders so can zero in on order without looping through all the structures
-
-      // check the delay queue - change this to a while do
-      // not sure if this is even reachable as the cancel comes after an order, which should have no delay remaining
-      // right, don't process the delay queue, doesn't make sense temporaly or logically
-      //for ( lOrderQueue_iter_t iter = m_lOrderDelay.begin(); iter != m_lOrderDelay.end(); ++iter ) {
-      //  ou::tf::Order& order( **iter );
-      //  if ( qco.nOrderId == order.GetOrderId() ) {
-      //    m_lOrderDelay.erase( iter );
-      //    bOrderFound = true;
-      //    break;
-      //  }
-      //}
-
-      // check the market order queue
-      if ( !bOrderFound ) {
-        for ( lOrderQueue_iter_t iter = m_lOrderMarket.begin(); iter != m_lOrderMarket.end(); ++iter ) {
-          ou::tf::Order& order( **iter );
-          if ( qco.nOrderId == order.GetOrderId() ) {
-            m_lOrderMarket.erase( iter );
-            bOrderFound = true;
-            break;
-          }
-        }
+  }
+
+  // need to check orders in ask limit list
+  if ( !bOrderFound ) {
+    for ( mapLimit_ask_t::iterator iter = m_mapAsks.begin(); iter != m_mapAsks.end(); ++iter ) {
+      ou::tf::Order& order( *iter->second.pOrder );
+      if ( idOrder == order.GetOrderId() ) {
+        RecordCompletion( order, false );
+        m_mapAsks.erase( iter );
+        bOrderFound = true;
+        break;
       }
+    }
+  }
 
-      // need to check orders in ask limit list
-      if ( !bOrderFound ) {
-        for ( mapOrderBook_ask_t::iterator iter = m_mapAsks.begin(); iter != m_mapAsks.end(); ++iter ) {
-          ou::tf::Order& order( *iter->second );
-          if ( qco.nOrderId == order.GetOrderId() ) {
-            m_mapAsks.erase( iter );
-            bOrderFound = true;
-            break;
-          }
-        }
+  // need to check orders in bid limit list
+  if ( !bOrderFound ) {
+    for ( mapLimit_bid_t::iterator iter = m_mapBids.begin(); iter != m_mapBids.end(); ++iter ) {
+      ou::tf::Order& order( *iter->second.pOrder );
+      if ( idOrder == order.GetOrderId() ) {
+        RecordCompletion( order, false );
+        m_mapBids.erase( iter );
+        bOrderFound = true;
+        break;
       }
+    }
+  }
 
-      // need to check orders in bid limit list
-      if ( !bOrderFound ) {
-        for ( mapOrderBook_bid_t::iterator iter = m_mapBids.begin(); iter != m_mapBids.end(); ++iter ) {
-          ou::tf::Order& order( *iter->second );
-          if ( qco.nOrderId == order.GetOrderId() ) {
-            m_mapBids.erase( iter );
-            bOrderFound = true;
-            break;
-          }
+  // need to check orders in stop list sells, any partial remaining to commission out? (stop may not be implemented yet)
+  if ( !bOrderFound ) {
+    for ( mapOrderBook_ask_t::iterator iter = m_mapSellStops.begin(); iter != m_mapSellStops.end(); ++iter ) {
+      if ( idOrder == iter->second->GetOrderId() ) {
+        m_mapSellStops.erase( iter );
+        bOrderFound = true;
+        break;
+      }
+    }
+  }
+
+  // need to check orders in stop list buys, any partial remaining to commission out? (stop may not be implemented yet)
+  if ( !bOrderFound ) {
+    for ( mapOrderBook_bid_t::iterator iter = m_mapBuyStops.begin(); iter != m_mapBuyStops.end(); ++iter ) {
+      if ( idOrder == iter->second->GetOrderId() ) {
+        m_mapBuyStops.erase( iter );
+        bOrderFound = true;
+        break;
+      }
+    }
+  }
+
+  if ( bOrderFound ) {  // need an event for this, as it could be legitimate crossing execution prior to cancel
+    if ( nullptr != OnOrderCancelled ) OnOrderCancelled( idOrder );
+    MigrateActiveToArchive( idOrder );
+  }
+  else {
+    //std::cout << "no order found to cancel: " << co.nOrderId << std::endl;
+    // todo:  propogate this into the OrderManager
+    //   this actually means that cancel comes through, but order was actually processed
+    if ( nullptr != OnNoOrderFound ) OnNoOrderFound( idOrder );
+
+    // confirm that the order has already been processed
+    mapOrderState_t::iterator iter = m_mapOrderState.find( idOrder );
+    assert( m_mapOrderState.end() != iter );
+    assert( OrderState::State::Archive == iter->second.state );
+  }
+
+}
+
+void OrderExecution::ProcessQueue( const Quote& quote ) {
+
+  if ( ( 0.0 >= quote.Bid() ) || ( 0.0 >= quote.Ask() ) ) return; // a one sided quote says nothing of the queue
+
+  // resting buys:  the queue ahead is no larger than the displayed bid at the price,
+  //   a price better than the bid has nothing ahead, an ask through the price fills at the price
+  if ( !m_mapBids.empty() ) {
+    const double bid( quote.Bid() );
+    const double ask( quote.Ask() );
+    Trade::tradesize_t nAvailable( quote.AskSize() );
+    mapLimit_bid_t::iterator iter( m_mapBids.begin() );
+    while ( ( m_mapBids.end() != iter ) && ( iter->first >= bid ) ) {
+      const double dblPrice( iter->first );
+      Resting& resting( iter->second );
+      bool bErase( false );
+      if ( ( ask < dblPrice ) || ( ( ask == dblPrice ) && ( 0 == resting.nAhead ) ) ) {
+        resting.nAhead = 0;
+        if ( 0 < nAvailable ) {
+          ou::tf::Order& order( *resting.pOrder );
+          const quantity_t nRemaining( order.GetQuanRemaining() );
+          const quantity_t nFill( std::min<Trade::tradesize_t>( nRemaining, nAvailable ) );
+          Fill( order, dblPrice, nFill, "SIMLmtBuy", true );
+          nAvailable -= nFill;
+          bErase = ( nFill == nRemaining );
         }
       }
+      else {
+        if ( bid == dblPrice ) resting.nAhead = std::min<Trade::tradesize_t>( resting.nAhead, quote.BidSize() );
+        else resting.nAhead = 0;
+      }
+      if ( bErase ) {
+        RecordCompletion( *resting.pOrder, true );
+        MigrateActiveToArchive( resting.pOrder->GetOrderId() );
+        iter = m_mapBids.erase( iter );
+      }
+      else ++iter;
+    }
+  }
 
-      // need to check orders in stop list sells, any partial remaining to commission out? (stop may not be implemented yet)
-      if ( !bOrderFound ) {
-        for ( mapOrderBook_ask_t::iterator iter = m_mapSellStops.begin(); iter != m_mapSellStops.end(); ++iter ) {
-          if ( qco.nOrderId == iter->second->GetOrderId() ) {
-            m_mapSellStops.erase( iter );
-            bOrderFound = true;
-            break;
-          }
+  // resting sells, the mirror image
+  if ( !m_mapAsks.empty() ) {
+    const double bid( quote.Bid() );
+    const double ask( quote.Ask() );
+    Trade::tradesize_t nAvailable( quote.BidSize() );
+    mapLimit_ask_t::iterator iter( m_mapAsks.begin() );
+    while ( ( m_mapAsks.end() != iter ) && ( iter->first <= ask ) ) {
+      const double dblPrice( iter->first );
+      Resting& resting( iter->second );
+      bool bErase( false );
+      if ( ( bid > dblPrice ) || ( ( bid == dblPrice ) && ( 0 == resting.nAhead ) ) ) {
+        resting.nAhead = 0;
+        if ( 0 < nAvailable ) {
+          ou::tf::Order& order( *resting.pOrder );
+          const quantity_t nRemaining( order.GetQuanRemaining() );
+          const quantity_t nFill( std::min<Trade::tradesize_t>( nRemaining, nAvailable ) );
+          Fill( order, dblPrice, nFill, "SIMLmtSell", true );
+          nAvailable -= nFill;
+          bErase = ( nFill == nRemaining );
         }
       }
+      else {
+        if ( ask == dblPrice ) resting.nAhead = std::min<Trade::tradesize_t>( resting.nAhead, quote.AskSize() );
+        else resting.nAhead = 0;
+      }
+      if ( bErase ) {
+        RecordCompletion( *resting.pOrder, true );
+        MigrateActiveToArchive( resting.pOrder->GetOrderId() );
+        iter = m_mapAsks.erase( iter );
+      }
+      else ++iter;
+    }
+  }
 
-      // need to check orders in stop list buys, any partial remaining to commission out? (stop may not be implemented yet)
-      if ( !bOrderFound ) {
-        for ( mapOrderBook_bid_t::iterator iter = m_mapBuyStops.begin(); iter != m_mapBuyStops.end(); ++iter ) {
-          if ( qco.nOrderId == iter->second->GetOrderId() ) {
-            m_mapBuyStops.erase( iter );
-            bOrderFound = true;
-            break;
-          }
+}
+
+void OrderExecution::ProcessQueue( const Trade& trade ) {
+
+  // a print below the ask is a sell into the bids:  it fills resting buys priced through it first,
+  //   then at its price, consumes the displayed queue ahead and our own earlier orders, before the order itself
+  //   a print above the bid does the same to resting sells
+
+  const double dblTrade( trade.Price() );
+
+  if ( !m_mapBids.empty() && ( ( 0.0 == m_lastQuote.Ask() ) || ( dblTrade < m_lastQuote.Ask() ) ) ) {
+    Trade::tradesize_t nVolume( trade.Volume() );
+    Trade::tradesize_t nOwnAhead {}; // remaining on our earlier orders at the print price, prior to this print
+    mapLimit_bid_t::iterator iter( m_mapBids.begin() );
+    while ( ( m_mapBids.end() != iter ) && ( iter->first >= dblTrade ) ) {
+      Resting& resting( iter->second );
+      ou::tf::Order& order( *resting.pOrder );
+      const quantity_t nRemaining( order.GetQuanRemaining() );
+      quantity_t nFill {};
+      if ( iter->first > dblTrade ) { // through the price
+        nFill = std::min<Trade::tradesize_t>( nRemaining, nVolume );
+        nVolume -= nFill;
+      }
+      else {
+        if ( c_nAheadUnknown != resting.nAhead ) {
+          const Trade::tradesize_t nQueue( resting.nAhead + nOwnAhead );
+          if ( nVolume > nQueue ) nFill = std::min<Trade::tradesize_t>( nRemaining, nVolume - nQueue );
+        }
+        nOwnAhead += nRemaining;
+        if ( c_nAheadUnknown != resting.nAhead ) {
+          resting.nAhead = ( nVolume > resting.nAhead ) ? 0 : resting.nAhead - nVolume;
         }
       }
+      if ( 0 < nFill ) {
+        Fill( order, iter->first, nFill, "SIMLmtBuy", true );
+      }
+      if ( nFill == nRemaining ) {
+        RecordCompletion( order, true );
+        MigrateActiveToArchive( order.GetOrderId() );
+        iter = m_mapBids.erase( iter );
+      }
+      else ++iter;
+    }
+  }
 
-      if ( bOrderFound ) {  // need an event for this, as it could be legitimate crossing execution prior to cancel
-        if ( nullptr != OnOrderCancelled ) OnOrderCancelled( qco.nOrderId );
-        MigrateActiveToArchive( qco.nOrderId );
+  if ( !m_mapAsks.empty() && ( dblTrade > m_lastQuote.Bid() ) ) {
+    Trade::tradesize_t nVolume( trade.Volume() );
+    Trade::tradesize_t nOwnAhead {};
+    mapLimit_ask_t::iterator iter( m_mapAsks.begin() );
+    while ( ( m_mapAsks.end() != iter ) && ( iter->first <= dblTrade ) ) {
+      Resting& resting( iter->second );
+      ou::tf::Order& order( *resting.pOrder );
+      const quantity_t nRemaining( order.GetQuanRemaining() );
+      quantity_t nFill {};
+      if ( iter->first < dblTrade ) {
+        nFill = std::min<Trade::tradesize_t>( nRemaining, nVolume );
+        nVolume -= nFill;
       }
       else {
-        //std::cout << "no order found to cancel: " << co.nOrderId << std::endl;
-        // todo:  propogate this into the OrderManager
-        //   this actually means that cancel comes through, but order was actually processed
-        if ( nullptr != OnNoOrderFound ) OnNoOrderFound( qco.nOrderId );
-
-        // confirm that the order has already been processed
-        mapOrderState_t::iterator iter = m_mapOrderState.find( qco.nOrderId );
-        assert( m_mapOrderState.end() != iter );
-        assert( OrderState::State::Archive == iter->second.state );
+        if ( c_nAheadUnknown != resting.nAhead ) {
+          const Trade::tradesize_t nQueue( resting.nAhead + nOwnAhead );
+          if ( nVolume > nQueue ) nFill = std::min<Trade::tradesize_t>( nRemaining, nVolume - nQueue );
+        }
+        nOwnAhead += nRemaining;
+        if ( c_nAheadUnknown != resting.nAhead ) {
+          resting.nAhead = ( nVolume > resting.nAhead ) ? 0 : resting.nAhead - nVolume;
+        }
+      }
+      if ( 0 < nFill ) {
+        Fill( order, iter->first, nFill, "SIMLmtSell", true );
       }
+      if ( nFill == nRemaining ) {
+        RecordCompletion( order, true );
+        MigrateActiveToArchive( order.GetOrderId() );
+        iter = m_mapAsks.erase( iter );
+      }
+      else ++iter;
+    }
+  }
+
+}
 
-      m_lCancelDelay.pop_front();  // remove from list
+void OrderExecution::Fill( Order& order, double dblPrice, quantity_t quan, const char* szExchange, bool bPassive ) {
+
+  ou::tf::Order::idOrder_t idOrder( order.GetOrderId() );
+  int nId( m_nExecId );  // before it gets incremented in next function
+  std::string id = GetExecId();
+  OrderSide::EOrderSide orderSide = order.GetOrderSide();
+
+  BOOST_LOG_TRIVIAL(info)
+    << "simulate,"
+    << idOrder
+    << ( bPassive ? ",queue" : ",take" )
+    << "," << nId
+    << "," << orderSide
+    << "," << order.GetQuanRemaining() << "-" << quan << "," << dblPrice
+    ;
+
+  // the order is updated through OrderManager calling Order::ReportExecution
+  if ( nullptr != OnOrderFill ) {
+    Execution exec( nId, idOrder, dblPrice, quan, orderSide, szExchange, id );
+    OnOrderFill( idOrder, exec );
+  }
+
+  CalculateCommission( order, quan );
+  RecordFill( order, dblPrice, quan, bPassive );
+}
+
+void OrderExecution::RecordFill( const Order& order, double dblPrice, quantity_t quan, bool bPassive ) {
+  if ( bPassive ) m_stats.nFillPassive++;
+  else m_stats.nFillAggressive++;
+  if ( OrderType::Limit == order.GetOrderType() ) m_stats.nLimitQuantityFilled += quan;
+  if ( !m_vMarkout.empty() ) {
+    const ptime dtNow( ou::TimeSource::LocalCommonInstance().Internal() );
+    const double dblQuantity( ( OrderSide::Buy == order.GetOrderSide() ) ? (double) quan : -(double) quan );
+    for ( size_t ix = 0; ix < m_vMarkout.size(); ix++ ) {
+      m_vMarkout[ ix ].emplace_back( dtNow + m_stats.vMarkout[ ix ].tdHorizon, dblPrice, dblQuantity );
     }
   }
+}
 
+void OrderExecution::RecordCompletion( const Order& order, bool bFilled ) {
+  if ( OrderType::Limit == order.GetOrderType() ) {
+    if ( bFilled ) m_stats.nLimitFilled++;
+    else {
+      if ( 0 < order.GetQuanFilled() ) m_stats.nLimitPartial++;
+      else m_stats.nLimitCancelled++;
+    }
+  }
+}
+
+void OrderExecution::ProcessMarkouts( const ptime& dtNow ) {
+  // the mid prevailing when the horizon passed is the one prior to this quote
+  const double dblMid( m_lastQuote.Midpoint() );
+  for ( size_t ix = 0; ix < m_vMarkout.size(); ix++ ) {
+    std::deque<Markout>& deque( m_vMarkout[ ix ] );
+    Statistics::Markout& markout( m_stats.vMarkout[ ix ] );
+    while ( !deque.empty() && ( deque.front().dtDue < dtNow ) ) {
+      const Markout& fill( deque.front() );
+      const double dblQuantity( std::abs( fill.dblQuantity ) );
+      const double dblPerShare( ( 0.0 < fill.dblQuantity ) ? dblMid - fill.dblPrice : fill.dblPrice - dblMid );
+      markout.dblQuantity += dblQuantity;
+      markout.dblSum += dblPerShare * dblQuantity;
+      markout.dblSumSquares += dblPerShare * dblPerShare * dblQuantity;
+      deque.pop_front();
+    }
+  }
 }
 
 void OrderExecution::TrackOrder( Order::idOrder_t idOrder, OrderState::State state ) {
@@ -648,6 +938,23 @@ void OrderExecution::MigrateActiveToArchive( Order::idOrder_t idOrder ) {
   iter->second.state = OrderState::State::Archive;
 }
 
+std::ostream& operator<<( std::ostream& os, const OrderExecution::Statistics& stats ) {
+  os
+    << "limit orders " << stats.nLimitOrders
+    << " filled " << stats.nLimitFilled
+    << " partial " << stats.nLimitPartial
+    << " cancelled " << stats.nLimitCancelled
+    << " fill probability " << stats.FillProbability()
+    << " quantity " << stats.nLimitQuantityFilled << "/" << stats.nLimitQuantityOrdered
+    << " fills passive " << stats.nFillPassive
+    << " aggressive " << stats.nFillAggressive
+    ;
+  for ( const OrderExecution::Statistics::Markout& markout: stats.vMarkout ) {
+    os << " markout " << markout.tdHorizon << " " << markout.Mean() << "/" << markout.dblQuantity;
+  }
+  return os;
+}
+
 } // namespace simulation
 } // namespace tf
 } // namespace ou
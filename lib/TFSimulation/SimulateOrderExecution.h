@@ -19,7 +19,11 @@
 
 #include <map>
 #include <list>
+#include <deque>
+#include <iosfwd>
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <unordered_map>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -32,6 +36,8 @@ using namespace fastdelegate;
 #include <TFTrading/Order.h>
 #include <TFTrading/Execution.h>
 
+#include "LatencyModel.h"
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 namespace sim { // simulation
@@ -41,6 +47,62 @@ public:
 
   using pOrder_t = Order::pOrder_t;
 
+  // how orders reach the simulated exchange, and how they are matched there
+  //   orders and cancels share one channel, so arrive in the order sent, as on a single session
+  //   the strategy acts on market data which is latencyMarketData old, so that is added to both entry and cancel
+  //   with bQueue, limit orders are matched with price-time priority:
+  //     a limit order marketable on arrival takes the displayed size at the inside, the remainder rests
+  //     a resting order joins behind the displayed size at its price, trade prints at the price consume the queue ahead,
+  //     then fill the order at its limit, a quote crossing the limit fills it at its limit
+  //   without bQueue, resting limit orders are filled by the quote crossing the limit, at the quote
+  struct Model {
+    LatencyModel latencyEntry;  // new and changed orders
+    LatencyModel latencyCancel;
+    LatencyModel latencyMarketData;
+    bool bQueue;
+    std::uint64_t nSeed; // for the latency samples, a run is repeatable for a given seed
+    std::vector<boost::posix_time::time_duration> vMarkout; // horizons for the adverse selection statistics
+    Model()
+    : latencyEntry( boost::posix_time::milliseconds( 250 ) )
+    , latencyCancel( boost::posix_time::milliseconds( 250 ) )
+    , bQueue( false ), nSeed( 1 )
+    {}
+  };
+
+  struct Statistics {
+    size_t nLimitOrders; // reached the exchange
+    size_t nLimitFilled; // completely
+    size_t nLimitPartial; // cancelled after a partial fill
+    size_t nLimitCancelled; // cancelled without a fill
+    std::uint64_t nLimitQuantityOrdered;
+    std::uint64_t nLimitQuantityFilled;
+    size_t nFillPassive; // resting limit order
+    size_t nFillAggressive; // market order, or limit order marketable on arrival
+
+    // mid price at the horizon after a fill, relative to the fill price, positive when in favour of the fill
+    struct Markout {
+      boost::posix_time::time_duration tdHorizon;
+      double dblQuantity; // total of the fills resolved
+      double dblSum; // per share, weighted by quantity
+      double dblSumSquares;
+      Markout( const boost::posix_time::time_duration& td )
+      : tdHorizon( td ), dblQuantity {}, dblSum {}, dblSumSquares {} {}
+      double Mean() const { return ( 0.0 < dblQuantity ) ? dblSum / dblQuantity : 0.0; }
+    };
+    std::vector<Markout> vMarkout;
+
+    Statistics()
+    : nLimitOrders {}, nLimitFilled {}, nLimitPartial {}, nLimitCancelled {}
+    , nLimitQuantityOrdered {}, nLimitQuantityFilled {}
+    , nFillPassive {}, nFillAggressive {}
+    {}
+
+    double FillProbability() const { // of the limit orders completed, those filled entirely
+      const size_t nCompleted( nLimitFilled + nLimitPartial + nLimitCancelled );
+      return ( 0 < nCompleted ) ? (double) nLimitFilled / (double) nCompleted : 0.0;
+    }
+  };
+
   OrderExecution();
   ~OrderExecution();
 
@@ -61,7 +123,12 @@ public:
     OnCommission = function;
   }
 
-  void SetOrderDelay( const time_duration &dtOrderDelay ) { m_dtQueueDelay = dtOrderDelay; };
+  void SetOrderDelay( const time_duration& dtOrderDelay ) { // constant, for entry and cancel
+    m_model.latencyEntry.SetConstant( dtOrderDelay );
+    m_model.latencyCancel.SetConstant( dtOrderDelay );
+  };
+  void SetModel( const Model& ); // prior to the first order, resets the statistics
+  const Statistics& GetStatistics() const { return m_stats; }
   void SetCommission( double dblCommission ) { m_dblCommission = dblCommission; };
 
   void NewQuote( const Quote& quote );
@@ -94,13 +161,32 @@ private:
   void MigrateDelayToActive( Order::idOrder_t );
   void MigrateActiveToArchive( Order::idOrder_t );
 
-  struct QueuedCancelOrder {
-    ptime dtCancellation;
+  struct InFlight { // an order or a cancel on its way to the exchange
+    ptime dtArrival;
+    pOrder_t pOrder; // nullptr for a cancel
     Order::idOrder_t nOrderId;
-    QueuedCancelOrder( const ptime &dtCancellation_, unsigned long nOrderId_ )
-      : dtCancellation( dtCancellation_ ), nOrderId( nOrderId_ ) {};
+    InFlight( const ptime& dtArrival_, pOrder_t pOrder_ )
+      : dtArrival( dtArrival_ ), pOrder( std::move( pOrder_ ) ), nOrderId( pOrder->GetOrderId() ) {};
+    InFlight( const ptime& dtArrival_, Order::idOrder_t nOrderId_ )
+      : dtArrival( dtArrival_ ), nOrderId( nOrderId_ ) {};
+  };
+
+  Model m_model;
+  LatencyModel::rng_t m_rng;
+  Statistics m_stats;
+
+  std::deque<InFlight> m_dequeInFlight; // in arrival order
+  ptime m_dtLastArrival;
+
+  struct Markout {
+    ptime dtDue;
+    double dblPrice;
+    double dblQuantity; // negative for a sell
+    Markout( const ptime& dtDue_, double dblPrice_, double dblQuantity_ )
+    : dtDue( dtDue_ ), dblPrice( dblPrice_ ), dblQuantity( dblQuantity_ ) {}
   };
-  boost::posix_time::time_duration m_dtQueueDelay; // used to simulate network / handling delays
+  std::vector<std::deque<Markout> > m_vMarkout; // by horizon, in due order
+
   double m_dblCommission;  // currency, per share (need also per trade)
 
   Quote m_lastQuote;
@@ -113,33 +199,55 @@ private:
   using lOrderQueue_t = std::list<pOrder_t>;
   using lOrderQueue_iter_t = lOrderQueue_t::iterator;
 
-  std::list<QueuedCancelOrder> m_lCancelDelay; // separate structure for the cancellations, since not an order
-
-  lOrderQueue_t m_lOrderDelay;  // all orders put in delay queue, taken out then processed as limit or market or stop
   lOrderQueue_t m_lOrderMarket;  // market orders to be processed
 
+  using quantity_t = Order::quantity_t;
+  static const quantity_t c_nAheadUnknown; // price not yet seen at the inside
+
+  struct Resting { // limit order in the book
+    pOrder_t pOrder;
+    quantity_t nAhead; // displayed quantity ahead of the order at its price, with bQueue
+    Resting( pOrder_t pOrder_ ): pOrder( std::move( pOrder_ ) ), nAhead( c_nAheadUnknown ) {}
+  };
+
+  // multimap keeps equal prices in insertion order, which provides the time priority
+  using mapLimit_ask_t = std::multimap<double,Resting, std::less<double> >;
+  mapLimit_ask_t m_mapAsks; // lowest at beginning
+
+  using mapLimit_bid_t = std::multimap<double,Resting, std::greater<double> >;
+  mapLimit_bid_t m_mapBids; // highest at beginning
+
   using mapOrderBook_ask_t = std::multimap<double,pOrder_t, std::less<double> >;
-  mapOrderBook_ask_t m_mapAsks; // lowest at beginning
   mapOrderBook_ask_t m_mapSellStops;  // pending sell stops, turned into market order when touched
 
   using mapOrderBook_bid_t = std::multimap<double,pOrder_t, std::greater<double> >;
-  mapOrderBook_bid_t m_mapBids; // highest at beginning
   mapOrderBook_bid_t m_mapBuyStops;  // pending buy stops, turned into market order when touched
 
   void ProcessOrderQueues( const Quote& quote );
   void CalculateCommission( Order&, Trade::tradesize_t quan );
-  void ProcessCancelQueue( const Quote& quote );
-  void ProcessDelayQueue( const Quote& quote );
+  void ProcessInFlight( const Quote& quote, const ptime& dtNow ); // orders and cancels which have arrived
+  void ProcessCancel( Order::idOrder_t );
+  void ProcessArrival( pOrder_t, const Quote& quote );
   void ProcessStopOrders( const Quote& quote ); // true if order executed, not yet implemented
   bool ProcessMarketOrders( const Quote& quote ); // true if order executed
   bool ProcessLimitOrders( const Quote& quote ); // true if order executed
   bool ProcessLimitOrders( const Trade& trade );
+  void ProcessQueue( const Quote& quote ); // with bQueue
+  void ProcessQueue( const Trade& trade ); // with bQueue
+
+  ptime Arrival( const LatencyModel& );
+  void Fill( Order&, double dblPrice, quantity_t, const char* szExchange, bool bPassive ); // with bQueue
+  void RecordFill( const Order&, double dblPrice, quantity_t, bool bPassive ); // statistics
+  void RecordCompletion( const Order&, bool bFilled ); // statistics, after the last fill, or a cancel
+  void ProcessMarkouts( const ptime& dtNow );
 
   static int m_nExecId;  // static provides unique number across universe of symbols
   std::string GetExecId();
 
 };
 
+std::ostream& operator<<( std::ostream&, const OrderExecution::Statistics& );
+
 } // namespace sim
 } // namespace tf
 } // namespace ou
@@ -53,6 +53,8 @@ public:
   {}
 
   void SetCommission( const std::string& sSymbol, double commission );
+  void SetExecutionModel( const std::string& sSymbol, const OrderExecution::Model& ); // latency, queue, seed
+  OrderExecution::Statistics GetExecutionStatistics( const std::string& sSymbol );
 
   void PlaceOrder( pOrder_t pOrder );
   void CancelOrder( pOrder_t pOrder );
@@ -269,6 +271,30 @@ void SimulationInterface<P,S>::SetCommission( const std::string& sSymbol, double
 
 }
 
+template <typename P, typename S>
+void SimulationInterface<P,S>::SetExecutionModel( const std::string& sSymbol, const OrderExecution::Model& model ) {
+
+  Update(
+    sSymbol,
+    [&model]( EventHolders& eh ){
+      eh.oe.SetModel( model );
+    } );
+
+}
+
+template <typename P, typename S>
+OrderExecution::Statistics SimulationInterface<P,S>::GetExecutionStatistics( const std::string& sSymbol ) {
+
+  OrderExecution::Statistics stats;
+  Update(
+    sSymbol,
+    [&stats]( EventHolders& eh ){
+      stats = eh.oe.GetStatistics();
+    } );
+  return stats;
+
+}
+
 template <typename P, typename S>
 void SimulationInterface<P,S>::PlaceOrder( pOrder_t pOrder ) {
 
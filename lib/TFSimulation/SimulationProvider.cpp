@@ -12,6 +12,7 @@
  * See the file LICENSE.txt for redistribution information.             *
  ************************************************************************/
 
+#include <vector>
 #include <cassert>
 #include <stdexcept>
 
@@ -21,15 +22,36 @@
 #include <TFTrading/OrderManager.h>
 
 #include "MergeDatedDatums.h"
+#include "MergeDatedDatumStream.h"
 #include "SimulationProvider.h"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
+namespace {
+
+  // a series in memory merges from there, a watched series not in memory is streamed when there is a prefetch
+  template<class DD>
+  MergeCarrierBase* Carrier(
+    TimeSeries<DD>& series, bool bWatched, const std::string& sPath
+  , StreamPrefetch* pPrefetch, MergeCarrierBase::OnDatumHandler function
+  ) {
+    if ( 0 != series.Size() ) {
+      return new MergeCarrier<DD>( series, function );
+    }
+    if ( bWatched && ( nullptr != pPrefetch ) ) {
+      return pPrefetch->Add<DD>( sPath, function );
+    }
+    return nullptr;
+  }
+
+} // namespace anonymous
+
 SimulationProvider::SimulationProvider()
 : sim::SimulationInterface<SimulationProvider,SimulationSymbol>()
-, m_pMerge( nullptr )
 , m_sHdf5FileName( HDF5DataManager::GetHdf5FileDefault() )
+, m_pMerge( nullptr )
+, m_nStreamBudget {}
 {
   m_sName = "Simulator";
   m_nID = keytypes::EProviderSimulator;
@@ -51,6 +73,8 @@ SimulationProvider::~SimulationProvider() {
     delete m_pMerge;
     m_pMerge = nullptr;
   }
+
+  m_pPrefetch.reset(); // after the carriers, which hold its datasets
 }
 
 void SimulationProvider::SetHdf5FileName( const std::string& sHdf5FileName ) {
@@ -98,7 +122,7 @@ SimulationProvider::pSymbol_t SimulationProvider::NewCSymbol( pInstrument_t pIns
 
 // these need to open the data file, load the data, and prepare to simulate
 void SimulationProvider::StartQuoteWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartQuoteWatch();
+  pSymbol->StartQuoteWatch( 0 == m_nStreamBudget );
 }
 
 void SimulationProvider::StopQuoteWatch( pSymbol_t pSymbol ) {
@@ -106,7 +130,7 @@ void SimulationProvider::StopQuoteWatch( pSymbol_t pSymbol ) {
 }
 
 void SimulationProvider::StartTradeWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartTradeWatch();
+  pSymbol->StartTradeWatch( 0 == m_nStreamBudget );
 }
 
 void SimulationProvider::StopTradeWatch( pSymbol_t pSymbol ) {
@@ -114,7 +138,7 @@ void SimulationProvider::StopTradeWatch( pSymbol_t pSymbol ) {
 }
 
 void SimulationProvider::StartDepthByMMWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartDepthByMMWatch();
+  pSymbol->StartDepthByMMWatch( 0 == m_nStreamBudget );
 }
 
 void SimulationProvider::StopDepthByMMWatch( pSymbol_t pSymbol ) {
@@ -122,7 +146,7 @@ void SimulationProvider::StopDepthByMMWatch( pSymbol_t pSymbol ) {
 }
 
 void SimulationProvider::StartDepthByOrderWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartDepthByOrderWatch();
+  pSymbol->StartDepthByOrderWatch( 0 == m_nStreamBudget );
 }
 
 void SimulationProvider::StopDepthByOrderWatch( pSymbol_t pSymbol ) {
@@ -130,7 +154,7 @@ void SimulationProvider::StopDepthByOrderWatch( pSymbol_t pSymbol ) {
 }
 
 void SimulationProvider::StartGreekWatch( pSymbol_t pSymbol ) {
-  pSymbol->StartGreekWatch();
+  pSymbol->StartGreekWatch( 0 == m_nStreamBudget );
 }
 
 void SimulationProvider::StopGreekWatch( pSymbol_t pSymbol ) {
@@ -142,49 +166,50 @@ void SimulationProvider::Merge() {
 
   if ( nullptr != m_OnSimulationThreadStarted ) m_OnSimulationThreadStarted();
 
-  // for each of the symbols, add the quote, trade and greek series
+  if ( 0 != m_nStreamBudget ) {
+    m_pPrefetch = std::make_unique<StreamPrefetch>( m_sHdf5FileName );
+  }
+
+  // for each of the symbols, add the quote, depth, trade and greek series
   // datums from each series will be merged and emitted in chronological order
+  // carriers are appended in this order whether preloaded or streamed, so datums with equal times merge the same way
+  std::vector<MergeCarrierBase*> vCarrier;
   for ( mapSymbols_t::iterator iter = m_mapSymbols.begin();
 
     iter != m_mapSymbols.end(); ++iter ) {
 
       pSymbol_t sym( iter->second );
 
-      Quotes& quotes( sym->m_quotes );
-      if ( 0 != quotes.Size() ) {
-        m_pMerge -> Add(
-          quotes,
-          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleQuoteEvent ) );
-      }
-
-      DepthsByMM& depths_mm( sym->m_depths_mm );
-      if ( 0 != depths_mm.Size() ) {
-        m_pMerge -> Add(
-          depths_mm,
-          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleDepthByMMEvent ) );
-      }
-
-      DepthsByOrder& depths_order( sym->m_depths_order );
-      if ( 0 != depths_order.Size() ) {
-        m_pMerge -> Add(
-          depths_order,
-          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleDepthByOrderEvent ) );
-      }
-
-      Trades& trades( sym->m_trades );
-      if ( 0 != trades.Size() ) {
-        m_pMerge -> Add(
-          trades,
-          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleTradeEvent ) );
-      }
-
-      Greeks& greeks( sym->m_greeks );
-      if ( 0 != greeks.Size() ) {
-        m_pMerge -> Add(
-          greeks,
-          MakeDelegate( iter->second.get(), &SimulationSymbol::HandleGreekEvent ) );
-      }
+      vCarrier.push_back(
+        Carrier( sym->m_quotes, sym->m_bWatchQuotes, sym->Path<Quotes>(), m_pPrefetch.get(),
+          MakeDelegate( sym.get(), &SimulationSymbol::HandleQuoteEvent ) ) );
 
+      vCarrier.push_back(
+        Carrier( sym->m_depths_mm, sym->m_bWatchDepthsByMM, sym->Path<DepthsByMM>(), m_pPrefetch.get(),
+          MakeDelegate( sym.get(), &SimulationSymbol::HandleDepthByMMEvent ) ) );
+
+      vCarrier.push_back(
+        Carrier( sym->m_depths_order, sym->m_bWatchDepthsByOrder, sym->Path<DepthsByOrder>(), m_pPrefetch.get(),
+          MakeDelegate( sym.get(), &SimulationSymbol::HandleDepthByOrderEvent ) ) );
+
+      vCarrier.push_back(
+        Carrier( sym->m_trades, sym->m_bWatchTrades, sym->Path<Trades>(), m_pPrefetch.get(),
+          MakeDelegate( sym.get(), &SimulationSymbol::HandleTradeEvent ) ) );
+
+      vCarrier.push_back(
+        Carrier( sym->m_greeks, sym->m_bWatchGreeks, sym->Path<Greeks>(), m_pPrefetch.get(),
+          MakeDelegate( sym.get(), &SimulationSymbol::HandleGreekEvent ) ) );
+
+  }
+
+  if ( m_pPrefetch ) {
+    m_pPrefetch->Start( m_nStreamBudget ); // loads the first windows, so the carriers have their first datum
+  }
+
+  for ( MergeCarrierBase* pCarrier: vCarrier ) {
+    if ( nullptr != pCarrier ) {
+      m_pMerge->Add( pCarrier );
+    }
   }
 
   m_nProcessedDatums = 0;
@@ -195,6 +220,10 @@ void SimulationProvider::Merge() {
 
   m_pMerge->Run();
 
+  if ( m_pPrefetch ) {
+    m_pPrefetch->Stop();
+  }
+
   m_nProcessedDatums = m_pMerge->GetCountProcessedDatums();
 
   m_dtSimStop = ou::TimeSource::LocalCommonInstance().External();
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <thread>
+#include <memory>
 #include <string>
 #include <sstream>
 
@@ -32,6 +33,7 @@ namespace ou { // One Unified
 namespace tf { // TradeFrame
 
 class MergeDatedDatums;
+class StreamPrefetch;
 
 // simulation provider needs to send an open event on each symbol it does
 //  will need to be based upon time
@@ -76,6 +78,11 @@ public:
   void SetGroupDirectory( const std::string& );  // eg /basket/20080620
   const std::string& GetGroupDirectory() const { return m_sGroupDirectory; }
 
+  // 0, the default, preloads each watched series when the watch starts,
+  // otherwise the series are streamed from the file during Run, in windows held within nBudget bytes
+  void SetStreamBudget( size_t nBudget ) { m_nStreamBudget = nBudget; }
+  size_t GetStreamBudget() const { return m_nStreamBudget; }
+
   void Run( bool bAsync = true );
   void Stop();
 
@@ -106,6 +113,9 @@ protected:
 
   MergeDatedDatums* m_pMerge;
 
+  size_t m_nStreamBudget;
+  std::unique_ptr<StreamPrefetch> m_pPrefetch;
+
   pSymbol_t virtual NewCSymbol( pInstrument_t pInstrument );
 
   void StartQuoteWatch( pSymbol_t pSymbol );
@@ -32,13 +32,17 @@ SimulationSymbol::SimulationSymbol(
 : Symbol<SimulationSymbol>( pInstrument )
 , m_sDirectory( sGroup )
 , m_sFileName( sFileName )
+, m_bWatchQuotes( false ), m_bWatchTrades( false )
+, m_bWatchDepthsByMM( false ), m_bWatchDepthsByOrder( false )
+, m_bWatchGreeks( false )
 {}
 
 SimulationSymbol::~SimulationSymbol() {
 }
 
-void SimulationSymbol::StartTradeWatch() {
-  if ( 0 == m_trades.Size() ) {
+void SimulationSymbol::StartTradeWatch( bool bPreload ) {
+  m_bWatchTrades = true;
+  if ( bPreload && ( 0 == m_trades.Size() ) ) {
     try {
       std::string sPath( m_sDirectory + Trades::Directory() + GetId() );
       ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO, m_sFileName );
@@ -56,10 +60,12 @@ void SimulationSymbol::StartTradeWatch() {
 }
 
 void SimulationSymbol::StopTradeWatch() {
+  m_bWatchTrades = false;
 }
 
-void SimulationSymbol::StartQuoteWatch() {
-  if ( 0 == m_quotes.Size() ) {
+void SimulationSymbol::StartQuoteWatch( bool bPreload ) {
+  m_bWatchQuotes = true;
+  if ( bPreload && ( 0 == m_quotes.Size() ) ) {
     try {
       std::string sPath( m_sDirectory + Quotes::Directory() + GetId() );
       ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO, m_sFileName );
@@ -77,10 +83,12 @@ void SimulationSymbol::StartQuoteWatch() {
 }
 
 void SimulationSymbol::StopQuoteWatch() {
+  m_bWatchQuotes = false;
 }
 
-void SimulationSymbol::StartGreekWatch() {
-  if ( ( 0 == m_greeks.Size() ) && ( m_pInstrument->IsOption() ) )  {
+void SimulationSymbol::StartGreekWatch( bool bPreload ) {
+  m_bWatchGreeks = m_pInstrument->IsOption();
+  if ( bPreload && ( 0 == m_greeks.Size() ) && ( m_pInstrument->IsOption() ) )  {
     try {
       std::string sPath( m_sDirectory + Greeks::Directory() + GetId() );
       ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO, m_sFileName );
@@ -98,10 +106,12 @@ void SimulationSymbol::StartGreekWatch() {
 }
 
 void SimulationSymbol::StopGreekWatch() {
+  m_bWatchGreeks = false;
 }
 
-void SimulationSymbol::StartDepthByMMWatch() {
-  if ( 0 == m_depths_mm.Size() )  {
+void SimulationSymbol::StartDepthByMMWatch( bool bPreload ) {
+  m_bWatchDepthsByMM = true;
+  if ( bPreload && ( 0 == m_depths_mm.Size() ) )  {
     try {
       std::string sPath( m_sDirectory + DepthsByMM::Directory() + GetId() );
       ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO, m_sFileName );
@@ -119,10 +129,12 @@ void SimulationSymbol::StartDepthByMMWatch() {
 }
 
 void SimulationSymbol::StopDepthByMMWatch() {
+  m_bWatchDepthsByMM = false;
 }
 
-void SimulationSymbol::StartDepthByOrderWatch() {
-  if ( 0 == m_depths_order.Size() )  {
+void SimulationSymbol::StartDepthByOrderWatch( bool bPreload ) {
+  m_bWatchDepthsByOrder = true;
+  if ( bPreload && ( 0 == m_depths_order.Size() ) )  {
     try {
       std::string sPath( m_sDirectory + DepthsByOrder::Directory() + GetId() );
       ou::tf::HDF5DataManager dm( ou::tf::HDF5DataManager::RO, m_sFileName );
@@ -140,6 +152,7 @@ void SimulationSymbol::StartDepthByOrderWatch() {
 }
 
 void SimulationSymbol::StopDepthByOrderWatch() {
+  m_bWatchDepthsByOrder = false;
 }
 
 void SimulationSymbol::HandleQuoteEvent( const DatedDatum &datum ) {
@@ -40,19 +40,21 @@ public:
 
 protected:
 
-  void StartQuoteWatch();
+  // each records the series as watched, bPreload reads it into memory, otherwise the provider streams it
+
+  void StartQuoteWatch( bool bPreload );
   void StopQuoteWatch();
 
-  void StartTradeWatch();
+  void StartTradeWatch( bool bPreload );
   void StopTradeWatch();
 
-  void StartGreekWatch();
+  void StartGreekWatch( bool bPreload );
   void StopGreekWatch();
 
-  void StartDepthByMMWatch();
+  void StartDepthByMMWatch( bool bPreload );
   void StopDepthByMMWatch();
 
-  void StartDepthByOrderWatch();
+  void StartDepthByOrderWatch( bool bPreload );
   void StopDepthByOrderWatch();
 
   void HandleQuoteEvent( const DatedDatum &datum );
@@ -62,11 +64,20 @@ protected:
   void HandleDepthByMMEvent( const DatedDatum &datum );
   void HandleDepthByOrderEvent( const DatedDatum &datum );
 
+  template<typename TS> // TS is a TimeSeries type
+  std::string Path() const { return m_sDirectory + TS::Directory() + GetId(); }
+
 private:
 
   std::string m_sFileName;
   std::string m_sDirectory;
 
+  bool m_bWatchQuotes;
+  bool m_bWatchTrades;
+  bool m_bWatchDepthsByMM;
+  bool m_bWatchDepthsByOrder;
+  bool m_bWatchGreeks;
+
   Quotes m_quotes;
   Trades m_trades;
   DepthsByMM m_depths_mm;
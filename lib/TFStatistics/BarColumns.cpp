@@ -0,0 +1,106 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    BarColumns.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFStatistics
+ * Created: 2026
+ */
+
+#include <algorithm>
+
+#include "BarColumns.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace statistics {
+
+BarColumns::Series BarColumns::Series::Last( size_t nBars ) const {
+  if ( n <= nBars ) return *this;
+  const size_t ix( n - nBars );
+  return Series { open + ix, high + ix, low + ix, close + ix, volume + ix, nBars };
+}
+
+BarColumns::BarColumns() {
+  Clear();
+}
+
+BarColumns::~BarColumns() {}
+
+void BarColumns::Reserve( size_t nSymbols, size_t nBars ) {
+  m_vOffset.reserve( nSymbols + 1 );
+  m_vOpen.reserve( nBars );
+  m_vHigh.reserve( nBars );
+  m_vLow.reserve( nBars );
+  m_vClose.reserve( nBars );
+  m_vVolume.reserve( nBars );
+}
+
+void BarColumns::Clear() {
+  m_vOffset.assign( 1, 0 );
+  m_vOpen.clear();
+  m_vHigh.clear();
+  m_vLow.clear();
+  m_vClose.clear();
+  m_vVolume.clear();
+}
+
+size_t BarColumns::Append( const ou::tf::Bars& bars ) {
+  return Append( bars.begin(), bars.end() );
+}
+
+size_t BarColumns::Append( ou::tf::Bars::const_iterator begin, ou::tf::Bars::const_iterator end ) {
+  for ( ou::tf::Bars::const_iterator iter = begin; end != iter; ++iter ) {
+    m_vOpen.push_back( iter->Open() );
+    m_vHigh.push_back( iter->High() );
+    m_vLow.push_back( iter->Low() );
+    m_vClose.push_back( iter->Close() );
+    m_vVolume.push_back( (double) iter->Volume() );
+  }
+  m_vOffset.push_back( m_vClose.size() );
+  return m_vOffset.size() - 2;
+}
+
+BarColumns::Series BarColumns::operator[]( size_t ixSymbol ) const {
+  const size_t ix( m_vOffset[ ixSymbol ] );
+  return Series {
+    m_vOpen.data() + ix, m_vHigh.data() + ix, m_vLow.data() + ix, m_vClose.data() + ix, m_vVolume.data() + ix,
+    m_vOffset[ ixSymbol + 1 ] - ix
+  };
+}
+
+BarColumns::Series BarColumns::Columns( const ou::tf::Bars& bars, std::vector<double>& vScratch ) {
+  const size_t n( bars.Size() );
+  vScratch.resize( 5 * n );
+  double* open( vScratch.data() );
+  double* high( open + n );
+  double* low( high + n );
+  double* close( low + n );
+  double* volume( close + n );
+  size_t ix {};
+  for ( const ou::tf::Bar& bar: bars ) {
+    open[ ix ] = bar.Open();
+    high[ ix ] = bar.High();
+    low[ ix ] = bar.Low();
+    close[ ix ] = bar.Close();
+    volume[ ix ] = (double) bar.Volume();
+    ix++;
+  }
+  return Series { open, high, low, close, volume, n };
+}
+
+} // namespace statistics
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,79 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    BarColumns.h
+ * Author:  raymond@burkholder.net
+ * Project: TFStatistics
+ * Created: 2026
+ */
+
+#pragma once
+
+// ohlcv of a universe of symbols by column, eg, daily bars from an InstrumentFilter pass
+//   each symbol is a contiguous run of its bars in each column, so a kernel walks plain double arrays
+//   rather than Bar objects, see BarKernels.h
+
+#include <vector>
+
+#include <TFTimeSeries/TimeSeries.h>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace statistics {
+
+class BarColumns {
+public:
+
+  struct Series { // the bars of one symbol
+    const double* open;
+    const double* high;
+    const double* low;
+    const double* close;
+    const double* volume;
+    size_t n;
+    Series Last( size_t nBars ) const; // the trailing nBars, or all when fewer
+  };
+
+  BarColumns();
+  ~BarColumns();
+
+  void Reserve( size_t nSymbols, size_t nBars ); // nBars over all symbols
+
+  size_t Append( const ou::tf::Bars& ); // returns the symbol index
+  size_t Append( ou::tf::Bars::const_iterator begin, ou::tf::Bars::const_iterator end );
+
+  void Clear();
+
+  size_t Symbols() const { return m_vOffset.size() - 1; }
+  Series operator[]( size_t ixSymbol ) const;
+
+  static Series Columns( const ou::tf::Bars&, std::vector<double>& vScratch ); // one series, copied into vScratch
+
+protected:
+private:
+
+  std::vector<size_t> m_vOffset; // Symbols() + 1, into the columns
+
+  std::vector<double> m_vOpen;
+  std::vector<double> m_vHigh;
+  std::vector<double> m_vLow;
+  std::vector<double> m_vClose;
+  std::vector<double> m_vVolume;
+
+};
+
+} // namespace statistics
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,284 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    BarKernels.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFStatistics
+ * Created: 2026
+ */
+
+#include <cmath>
+
+#include <TFIndicators/Darvas.h>
+
+#include "BarKernels.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace statistics {
+
+namespace {
+
+  Series Trailing( const BarColumns& columns, size_t ix, size_t nTrailing ) {
+    return 0 == nTrailing ? columns[ ix ] : columns[ ix ].Last( nTrailing );
+  }
+
+  // records what ProcessDarvas in SymbolSelection reports
+  class DarvasCollector: public ou::tf::Darvas<DarvasCollector> {
+    friend ou::tf::Darvas<DarvasCollector>;
+  public:
+    DarvasCollector(): m_bTriggered( false ), m_dblStop {} {}
+    bool Step( double dblHigh, double dblLow, double dblClose ) {
+      m_bTriggered = false;
+      ou::tf::Darvas<DarvasCollector>::Calc( dblHigh, dblLow, dblClose );
+      return m_bTriggered;
+    }
+    double Stop() const { return m_dblStop; }
+  protected:
+    void ConservativeTrigger() { m_bTriggered = true; }
+    void AggressiveTrigger() { m_bTriggered = true; }
+    void SetStop( double stop ) { m_dblStop = stop; }
+    void BreakOutAlert( size_t ) { m_bTriggered = true; }
+  private:
+    bool m_bTriggered;
+    double m_dblStop;
+  };
+
+} // namespace anonymous
+
+void CalcPivots( const Series& series, PivotResult& result ) {
+
+  using E = EPivotItemOfInterest;
+
+  result = PivotResult();
+
+  const double* open( series.open );
+  const double* high( series.high );
+  const double* low( series.low );
+  const double* close( series.close );
+  const size_t n( series.n );
+
+  // counters as 0/1 sums, the populations follow from the encounters
+  std::uint32_t cntAbove {}, cntAboveXPV {}, cntAboveXPVS1 {};
+  std::uint32_t cntBtwnR1 {}, cntBtwnR1XPV {}, cntBtwnR1XR1 {};
+  std::uint32_t cntBelow {}, cntBelowXPV {}, cntBelowXPVR1 {};
+  std::uint32_t cntBtwnS1 {}, cntBtwnS1XPV {}, cntBtwnS1XS1 {};
+  std::uint32_t cntXPV {};
+
+  for ( size_t ix = 1; ix < n; ix++ ) {
+
+    // ou::tf::PivotSet::CalcPivots on the previous bar
+    const double pv = ( high[ ix - 1 ] + low[ ix - 1 ] + close[ ix - 1 ] ) / 3;
+    const double r1 = 2 * pv - low[ ix - 1 ];
+    const double s1 = 2 * pv - high[ ix - 1 ];
+
+    const double hi( high[ ix ] );
+    const double lo( low[ ix ] );
+    const double op( open[ ix ] );
+
+    const std::uint32_t bCrossR1 = ( hi > r1 ) & ( lo < r1 );
+    const std::uint32_t bCrossPV = ( hi > pv ) & ( lo < pv );
+    const std::uint32_t bCrossS1 = ( hi > s1 ) & ( lo < s1 );
+
+    const std::uint32_t bAbovePV = op > pv;
+    const std::uint32_t bBelowPV = op < pv;
+
+    const std::uint32_t bBtwnR1PV = bAbovePV & ( op < r1 );
+    const std::uint32_t bBtwnS1PV = bBelowPV & ( op > s1 );
+
+    cntAbove      += bAbovePV;
+    cntAboveXPV   += bAbovePV & bCrossPV;
+    cntAboveXPVS1 += bAbovePV & bCrossPV & bCrossS1;
+    cntBtwnR1     += bBtwnR1PV;
+    cntBtwnR1XPV  += bBtwnR1PV & bCrossPV;
+    cntBtwnR1XR1  += bBtwnR1PV & bCrossR1;
+
+    cntBelow      += bBelowPV;
+    cntBelowXPV   += bBelowPV & bCrossPV;
+    cntBelowXPVR1 += bBelowPV & bCrossPV & bCrossR1;
+    cntBtwnS1     += bBtwnS1PV;
+    cntBtwnS1XPV  += bBtwnS1PV & bCrossPV;
+    cntBtwnS1XS1  += bBtwnS1PV & bCrossS1;
+
+    cntXPV        += bCrossPV;
+
+  }
+
+  if ( 1 < n ) {
+    const size_t ix( n - 2 );
+    const double dif = high[ ix ] - low[ ix ];
+    result.dblPV = ( high[ ix ] + low[ ix ] + close[ ix ] ) / 3;
+    result.dblR1 = 2 * result.dblPV - low[ ix ];
+    result.dblR2 = result.dblPV + dif;
+    result.dblS1 = 2 * result.dblPV - high[ ix ];
+    result.dblS2 = result.dblPV - dif;
+  }
+
+  const std::uint32_t nBars( 1 < n ? n - 1 : 0 );
+
+  auto set = [&result]( E e, std::uint32_t nEncountered, std::uint32_t nPopulation ){
+    result.rEncountered[ (size_t)e ] = nEncountered;
+    result.rPopulation[ (size_t)e ] = nPopulation;
+  };
+
+  set( E::AbovePV,         cntAbove,      nBars );
+  set( E::AbovePV_X_Down,  cntAboveXPV,   cntAbove );
+  set( E::AbovePV_X_S1,    cntAboveXPVS1, cntAbove );
+  set( E::BtwnPVR1_X_Down, cntBtwnR1XPV,  cntBtwnR1 );
+  set( E::BtwnPVR1_X_Up,   cntBtwnR1XR1,  cntBtwnR1 );
+
+  set( E::BelowPV,         cntBelow,      nBars );
+  set( E::BelowPV_X_Up,    cntBelowXPV,   cntBelow );
+  set( E::BelowPV_X_R1,    cntBelowXPVR1, cntBelow );
+  set( E::BtwnPVS1_X_Up,   cntBtwnS1XPV,  cntBtwnS1 );
+  set( E::BtwnPVS1_X_Down, cntBtwnS1XS1,  cntBtwnS1 );
+
+  set( E::CrossPV,         cntXPV,        nBars );
+
+  // summed in bar order, as Pivot did
+  double dblHiLoRangeSum {};
+  for ( size_t ix = 0; ix < n; ix++ ) {
+    dblHiLoRangeSum += ( high[ ix ] - low[ ix ] );
+  }
+  result.dblHiLoRangeAvg = dblHiLoRangeSum / (double)n;
+
+  double dblHiLoRangeDiffs {};
+  for ( size_t ix = 0; ix < n; ix++ ) {
+    const double diff = ( high[ ix ] - low[ ix ] ) - result.dblHiLoRangeAvg;
+    dblHiLoRangeDiffs += diff * diff;
+  }
+  result.dblHiLoRangeStdDev = std::sqrt( dblHiLoRangeDiffs / (double)n );
+}
+
+void CalcPivots( const BarColumns& columns, std::vector<PivotResult>& vResult, size_t nTrailing ) {
+  vResult.resize( columns.Symbols() );
+  for ( size_t ix = 0; ix < columns.Symbols(); ix++ ) {
+    CalcPivots( Trailing( columns, ix, nTrailing ), vResult[ ix ] );
+  }
+}
+
+double CalcHistoricalVolatility( const double* close, size_t n, std::vector<double>& vReturns ) {
+  vReturns.resize( 1 < n ? n - 1 : 0 );
+  double* rReturn( vReturns.data() );
+  for ( size_t ix = 1; ix < n; ix++ ) {
+    rReturn[ ix - 1 ] = close[ ix ] / close[ ix - 1 ];
+  }
+  double dblSumNatLogReturns {};
+  for ( size_t ix = 0; ix < vReturns.size(); ix++ ) {
+    rReturn[ ix ] = std::log( rReturn[ ix ] );
+    dblSumNatLogReturns += rReturn[ ix ];
+  }
+  const double dblAverage = dblSumNatLogReturns / (int)n;
+  double dblSums {};
+  for ( size_t ix = 0; ix < vReturns.size(); ix++ ) {
+    const double dblDiff = rReturn[ ix ] - dblAverage;
+    dblSums += dblDiff * dblDiff;
+  }
+  const double dblVariance = dblSums / ( (int)n - 1 );
+  return std::sqrt( dblVariance );
+}
+
+double CalcHistoricalVolatility( const double* close, size_t n ) {
+  std::vector<double> vReturns;
+  return CalcHistoricalVolatility( close, n, vReturns );
+}
+
+void CalcHistoricalVolatility( const BarColumns& columns, std::vector<double>& vResult, size_t nTrailing ) {
+  std::vector<double> vReturns;
+  vResult.resize( columns.Symbols() );
+  for ( size_t ix = 0; ix < columns.Symbols(); ix++ ) {
+    const Series series( Trailing( columns, ix, nTrailing ) );
+    vResult[ ix ] = CalcHistoricalVolatility( series.close, series.n, vReturns );
+  }
+}
+
+void CalcRange( const Series& series, RangeResult& result ) {
+
+  const double* open( series.open );
+  const double* high( series.high );
+  const double* low( series.low );
+  const double* close( series.close );
+  const size_t n( series.n );
+
+  std::uint32_t cntAbove {}, cntBelow {}, cntRising {}, cntFalling {};
+  double dblAbove {}, dblBelow {}, dblRange {};
+
+  for ( size_t ix = 0; ix < n; ix++ ) {
+    const double op( open[ ix ] );
+    const bool bAbove( high[ ix ] > op );
+    const bool bBelow( low[ ix ] < op );
+    dblRange += ( high[ ix ] - low[ ix ] );
+    dblAbove += bAbove ? ( high[ ix ] - op ) : 0.0; // adding 0.0 leaves the sum as it was
+    dblBelow += bBelow ? ( op - low[ ix ] ) : 0.0;
+    cntAbove += bAbove;
+    cntBelow += bBelow;
+    cntFalling += ( op > close[ ix ] );
+    cntRising += ( op < close[ ix ] );
+  }
+
+  result.cnt = n;
+  result.cntAbove = cntAbove;
+  result.cntBelow = cntBelow;
+  result.cntRising = cntRising;
+  result.cntFalling = cntFalling;
+  result.dblAbove = dblAbove;
+  result.dblBelow = dblBelow;
+  result.dblRange = dblRange;
+}
+
+void CalcRange( const BarColumns& columns, std::vector<RangeResult>& vResult, size_t nTrailing ) {
+  vResult.resize( columns.Symbols() );
+  for ( size_t ix = 0; ix < columns.Symbols(); ix++ ) {
+    CalcRange( Trailing( columns, ix, nTrailing ), vResult[ ix ] );
+  }
+}
+
+void CalcDarvas( const Series& series, DarvasResult& result, size_t nTriggerWindow ) {
+
+  result = DarvasResult();
+
+  const size_t n( series.n );
+
+  // CalcMaxDate: last of the highest closes
+  size_t ixMax( n );
+  double dblMax {};
+  for ( size_t ix = 0; ix < n; ix++ ) {
+    const bool b( series.close[ ix ] >= dblMax );
+    dblMax = b ? series.close[ ix ] : dblMax;
+    ixMax = b ? ix : ixMax;
+  }
+  result.ixMaxClose = ixMax;
+  result.dblMaxClose = dblMax;
+
+  const Series window( series.Last( nTriggerWindow ) );
+  DarvasCollector darvas;
+  bool bTrigger( false );
+  for ( size_t ix = 0; ix < window.n; ix++ ) {
+    bTrigger = darvas.Step( window.high[ ix ], window.low[ ix ], window.close[ ix ] );
+  }
+  result.bTrigger = bTrigger;
+  result.dblStop = darvas.Stop();
+}
+
+void CalcDarvas( const BarColumns& columns, std::vector<DarvasResult>& vResult, size_t nTriggerWindow ) {
+  vResult.resize( columns.Symbols() );
+  for ( size_t ix = 0; ix < columns.Symbols(); ix++ ) {
+    CalcDarvas( columns[ ix ], vResult[ ix ], nTriggerWindow );
+  }
+}
+
+} // namespace statistics
+} // namespace tf
+} // namespace ou
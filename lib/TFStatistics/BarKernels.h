@@ -0,0 +1,124 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    BarKernels.h
+ * Author:  raymond@burkholder.net
+ * Project: TFStatistics
+ * Created: 2026
+ */
+
+#pragma once
+
+// statistics over BarColumns, one series or a universe per call
+//   the per bar tests are branch free and accumulate into integer counters, so the loops vectorize,
+//   the floating point sums keep the order of the original per Bar code, so results are identical
+//   Pivot and HistoricalVolatility are wrappers for a single series
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "BarColumns.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace statistics {
+
+enum class EPivotItemOfInterest {
+  AbovePV = 0,    // open above PV
+  BelowPV,        // open below PV
+  AbovePV_X_Down, // start above PV crossing downwards
+  AbovePV_X_S1,
+  BtwnPVR1_X_Down,
+  BtwnPVR1_X_Up,
+  CrossPV,        // cross PV during session
+  BelowPV_X_R1,
+  BelowPV_X_Up,   // start below PV crossing upwards
+  BtwnPVS1_X_Up,
+  BtwnPVS1_X_Down,
+  Count
+};
+
+struct PivotResult {
+
+  // pivots from the second last bar, as applied to the last bar
+  double dblR2;
+  double dblR1;
+  double dblPV;
+  double dblS1;
+  double dblS2;
+
+  // each bar against the pivots of the previous bar
+  std::array<std::uint32_t, (size_t)EPivotItemOfInterest::Count> rEncountered;
+  std::array<std::uint32_t, (size_t)EPivotItemOfInterest::Count> rPopulation;
+
+  double dblHiLoRangeAvg;  // use as trailing stop?
+  double dblHiLoRangeStdDev; // use to calculate range percentiles (indicates relative distance between pivot markers
+
+  PivotResult()
+  : dblR2 {}, dblR1 {}, dblPV {}, dblS1 {}, dblS2 {}
+  , rEncountered {}, rPopulation {}
+  , dblHiLoRangeAvg {}, dblHiLoRangeStdDev {}
+  {}
+
+  double ItemOfInterest( EPivotItemOfInterest ioi ) const { // normalized [0.0 .. 1.0]
+    const size_t ix( (size_t)ioi );
+    return 0 == rPopulation[ ix ] ? 0 : (double)rEncountered[ ix ] / (double)rPopulation[ ix ];
+  }
+};
+
+struct RangeResult { // see SymbolSelection::CheckForRange
+  std::uint32_t cnt;
+  std::uint32_t cntAbove;   // high above open
+  std::uint32_t cntBelow;   // low below open
+  std::uint32_t cntRising;  // close above open
+  std::uint32_t cntFalling; // close below open
+  double dblAbove; // sum of high - open
+  double dblBelow; // sum of open - low
+  double dblRange; // sum of high - low
+  RangeResult()
+  : cnt {}, cntAbove {}, cntBelow {}, cntRising {}, cntFalling {}
+  , dblAbove {}, dblBelow {}, dblRange {}
+  {}
+};
+
+struct DarvasResult { // see SymbolSelection::CheckForDarvas
+  size_t ixMaxClose;  // last bar with the highest close, n when no close above 0
+  double dblMaxClose;
+  bool bTrigger;      // conservative trigger or break out on the last bar
+  double dblStop;     // last stop set within the trigger window, 0 when none
+  DarvasResult(): ixMaxClose {}, dblMaxClose {}, bTrigger( false ), dblStop {} {}
+};
+
+using Series = BarColumns::Series;
+
+void CalcPivots( const Series&, PivotResult& );
+void CalcPivots( const BarColumns&, std::vector<PivotResult>&, size_t nTrailing = 0 ); // 0 is all bars
+
+// log returns of the closes, mean over the count of closes, variance over count - 1, see HistoricalVolatility
+double CalcHistoricalVolatility( const double* close, size_t n, std::vector<double>& vScratch );
+double CalcHistoricalVolatility( const double* close, size_t n );
+void CalcHistoricalVolatility( const BarColumns&, std::vector<double>&, size_t nTrailing = 0 );
+
+void CalcRange( const Series&, RangeResult& );
+void CalcRange( const BarColumns&, std::vector<RangeResult>&, size_t nTrailing = 0 );
+
+// the Darvas state machine runs over the trailing nTriggerWindow bars, the max close over all bars
+void CalcDarvas( const Series&, DarvasResult&, size_t nTriggerWindow = 10 );
+void CalcDarvas( const BarColumns&, std::vector<DarvasResult>&, size_t nTriggerWindow = 10 );
+
+} // namespace statistics
+} // namespace tf
+} // namespace ou
@@ -19,40 +19,19 @@
  * Created on May 1, 2019, 10:07 PM
  */
 
+#include "BarKernels.h"
 #include "HistoricalVolatility.h"
 
 namespace ou {
 
-HistoricalVolatility::HistoricalVolatility()
-: bFirstFound( false ), dblPrevious {}, nPrices {}, dblSumNatLogReturns {}
-{}
+HistoricalVolatility::HistoricalVolatility() {}
 
 void HistoricalVolatility::operator()( const ou::tf::Bar& bar ) {
-  if ( bFirstFound ) {
-    double dblPrice = bar.Close();
-    double dblReturn = std::log( dblPrice / dblPrevious );
-    dblPrevious = dblPrice;
-    dblSumNatLogReturns += dblReturn;
-    vReturns.push_back( dblReturn );
-  }
-  else {
-    dblPrevious = bar.Close();
-    bFirstFound = true;
-  }
-  nPrices++;
+  vClose.push_back( bar.Close() );
 }
 
- HistoricalVolatility::operator double() {
-  double dblSums {};
-  double dblAverage = dblSumNatLogReturns / nPrices;  // might be nPrices - 1 or vReturns.size()
-  std::for_each(
-    vReturns.begin(), vReturns.end(),
-    [&dblSums,dblAverage](double dblReturn){
-      double dblDiff = dblReturn - dblAverage;
-      dblSums += dblDiff * dblDiff;
-    });
-  double dblVariance = dblSums / ( nPrices - 1 );
-  return std::sqrt( dblVariance );
+HistoricalVolatility::operator double() {
+  return ou::tf::statistics::CalcHistoricalVolatility( vClose.data(), vClose.size() );
 }
 
 } // namespace ou
@@ -30,6 +30,7 @@
 
 namespace ou {
 
+// closes are collected, the calculation is CalcHistoricalVolatility in BarKernels.h
 class HistoricalVolatility { // may need to normalize to yearly historical volatility
 public:
   HistoricalVolatility();
@@ -37,11 +38,7 @@ public:
   operator double();
 protected:
 private:
-  bool bFirstFound;
-  int nPrices;
-  double dblPrevious;
-  double dblSumNatLogReturns;
-  std::vector<double> vReturns;
+  std::vector<double> vClose;
 };
 
 } // namespace ou
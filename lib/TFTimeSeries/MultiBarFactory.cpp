@@ -0,0 +1,268 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MultiBarFactory.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFTimeSeries
+ * Created: 2026
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "MultiBarFactory.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+void MultiBarFactory::Columns::Clear() {
+  vDateTime.clear();
+  vOpen.clear();
+  vHigh.clear();
+  vLow.clear();
+  vClose.clear();
+  vVolume.clear();
+}
+
+MultiBarFactory::Timeframe::Timeframe( EType eType_, duration_t nWidth_, double dblSize_ )
+: eType( eType_ ), nWidth( nWidth_ ), nWidthBy2( nWidth_ / 2 ), dblSize( dblSize_ ), bNested( false )
+, bOpen( false ), nInterval {}, dblAccumulated {}
+, open {}, high {}, low {}, close {}, volume {}
+{}
+
+void MultiBarFactory::Timeframe::Start( const ptime& dt, price_t price, volume_t volume_ ) {
+  bOpen = true;
+  dtStart = dt;
+  open = high = low = close = price;
+  volume = volume_;
+}
+
+void MultiBarFactory::Timeframe::Update( price_t price, volume_t volume_ ) {
+  close = price;
+  high = std::max( high, price );
+  low = std::min( low, price );
+  volume += volume_;
+}
+
+Bar MultiBarFactory::Timeframe::Get( const ptime& dt ) const {
+  return Bar( dt, open, high, low, close, volume );
+}
+
+MultiBarFactory::MultiBarFactory()
+: m_bStarted( false )
+, m_1Sec( time_duration( 0, 0, 1 ) )
+{}
+
+MultiBarFactory::~MultiBarFactory() {
+  OnNewBarStarted = nullptr;
+  OnBarUpdated = nullptr;
+  OnBarComplete = nullptr;
+}
+
+MultiBarFactory::ixTimeframe_t MultiBarFactory::Append( EType eType, duration_t nWidth, double dblSize ) {
+
+  if ( m_bStarted ) {
+    throw std::runtime_error( "MultiBarFactory: time frames are added before the first tick" );
+  }
+
+  const ixTimeframe_t ix( m_vTimeframe.size() );
+  m_vTimeframe.emplace_back( Timeframe( eType, nWidth, dblSize ) );
+
+  if ( EType::Time == eType ) {
+    m_vTime.push_back( ix );
+    std::stable_sort(
+      m_vTime.begin(), m_vTime.end(),
+      [this]( ixTimeframe_t lhs, ixTimeframe_t rhs ){ return m_vTimeframe[ lhs ].nWidth < m_vTimeframe[ rhs ].nWidth; } );
+    for ( vIndex_t::size_type ixTime = 1; ixTime < m_vTime.size(); ixTime++ ) {
+      Timeframe& tf( m_vTimeframe[ m_vTime[ ixTime ] ] );
+      tf.bNested = ( 0 == ( tf.nWidth % m_vTimeframe[ m_vTime[ ixTime - 1 ] ].nWidth ) );
+    }
+  }
+  else {
+    m_vInformation.push_back( ix );
+  }
+
+  return ix;
+}
+
+MultiBarFactory::ixTimeframe_t MultiBarFactory::AddTime( duration_t nSeconds ) {
+  return Append( EType::Time, std::max<duration_t>( 1, nSeconds ), 0.0 );
+}
+
+MultiBarFactory::ixTimeframe_t MultiBarFactory::AddTicks( unsigned int nTicks ) {
+  return Append( EType::Ticks, 0, std::max<unsigned int>( 1, nTicks ) );
+}
+
+MultiBarFactory::ixTimeframe_t MultiBarFactory::AddVolume( volume_t volume ) {
+  return Append( EType::Volume, 0, std::max<volume_t>( 1, volume ) );
+}
+
+MultiBarFactory::ixTimeframe_t MultiBarFactory::AddDollar( double dollars ) {
+  return Append( EType::Dollar, 0, dollars );
+}
+
+// appends the bar in progress to the columns, the event is emitted once the tick is bucketed
+void MultiBarFactory::Complete( ixTimeframe_t ix, const ptime& dtEnd ) {
+  Timeframe& tf( m_vTimeframe[ ix ] );
+  Columns& columns( tf.columns );
+  m_vCompleted.push_back( Completed{ dtEnd, ix, columns.Size() } );
+  columns.vDateTime.push_back(
+    ( EType::Time == tf.eType )
+    ? tf.dtStart + time_duration( 0, 0, tf.nWidthBy2 ) // slide the bar to be centered in the time slot for chartdir
+    : tf.dtStart
+    );
+  columns.vOpen.push_back( tf.open );
+  columns.vHigh.push_back( tf.high );
+  columns.vLow.push_back( tf.low );
+  columns.vClose.push_back( tf.close );
+  columns.vVolume.push_back( tf.volume );
+}
+
+void MultiBarFactory::Add( const ptime& dt, price_t price, volume_t volume ) {
+
+  const bool bFirst( !m_bStarted );
+  if ( bFirst ) {
+    m_bStarted = true;
+    m_dtLastIntermediateEmission = dt - m_1Sec; // prime the value
+  }
+
+  m_vCompleted.clear();
+  m_vStarted.clear();
+
+  // time: one bucketing pass, finest first
+
+  const duration_t seconds = dt.time_of_day().total_seconds();
+
+  bool bFinerContinues( false );
+  for ( const ixTimeframe_t ix: m_vTime ) {
+    Timeframe& tf( m_vTimeframe[ ix ] );
+    bool bContinues;
+    if ( bFinerContinues && tf.bNested ) {
+      bContinues = true; // inside the finer bucket, so inside this one
+    }
+    else {
+      const duration_t interval = seconds / tf.nWidth;
+      bContinues = tf.bOpen && ( interval == tf.nInterval );
+      if ( !bContinues ) {
+        if ( tf.bOpen ) {
+          Complete( ix, tf.dtStart + time_duration( 0, 0, tf.nWidth ) );
+        }
+        tf.nInterval = interval;
+        tf.Start( ptime( dt.date(), time_duration( 0, 0, interval * tf.nWidth, 0 ) ), price, volume );
+        m_vStarted.push_back( ix );
+      }
+    }
+    if ( bContinues ) {
+      tf.Update( price, volume );
+    }
+    bFinerContinues = bContinues;
+  }
+
+  const size_t nTimeCompleted( m_vCompleted.size() );
+  if ( 1 < nTimeCompleted ) { // widths which are not multiples can end out of order
+    std::stable_sort(
+      m_vCompleted.begin(), m_vCompleted.end(),
+      []( const Completed& lhs, const Completed& rhs ){ return lhs.dtEnd < rhs.dtEnd; } );
+  }
+
+  // ticks, volume, dollars: close on the tick reaching the size
+
+  for ( const ixTimeframe_t ix: m_vInformation ) {
+    Timeframe& tf( m_vTimeframe[ ix ] );
+    if ( tf.bOpen ) {
+      tf.Update( price, volume );
+    }
+    else {
+      tf.Start( dt, price, volume );
+      m_vStarted.push_back( ix );
+    }
+    switch ( tf.eType ) {
+      case EType::Ticks:
+        tf.dblAccumulated += 1.0;
+        break;
+      case EType::Volume:
+        tf.dblAccumulated += volume;
+        break;
+      case EType::Dollar:
+        tf.dblAccumulated += price * volume;
+        break;
+      default:
+        break;
+    }
+    if ( tf.dblSize <= tf.dblAccumulated ) {
+      Complete( ix, dt );
+      tf.bOpen = false;
+      tf.dblAccumulated = 0.0;
+    }
+  }
+
+  // events: completed time bars, started bars, completed information bars, updates
+
+  if ( nullptr != OnBarComplete ) {
+    for ( size_t ix = 0; ix < nTimeCompleted; ix++ ) {
+      const Completed& completed( m_vCompleted[ ix ] );
+      OnBarComplete( completed.ix, m_vTimeframe[ completed.ix ].columns.At( completed.row ) );
+    }
+  }
+
+  if ( nullptr != OnNewBarStarted ) {
+    for ( const ixTimeframe_t ix: m_vStarted ) {
+      const Timeframe& tf( m_vTimeframe[ ix ] );
+      if ( ( EType::Time == tf.eType ) && !bFirst ) { // as BarFactory, the first bar is not shifted
+        OnNewBarStarted( ix, tf.Get( tf.dtStart + time_duration( 0, 0, tf.nWidthBy2 ) ) );
+      }
+      else {
+        OnNewBarStarted( ix, tf.Get( tf.dtStart ) );
+      }
+    }
+  }
+
+  if ( nullptr != OnBarComplete ) {
+    for ( size_t ix = nTimeCompleted; ix < m_vCompleted.size(); ix++ ) {
+      const Completed& completed( m_vCompleted[ ix ] );
+      OnBarComplete( completed.ix, m_vTimeframe[ completed.ix ].columns.At( completed.row ) );
+    }
+  }
+
+  if ( m_1Sec <= ( dt - m_dtLastIntermediateEmission ) ) {
+    if ( nullptr != OnBarUpdated ) {
+      for ( ixTimeframe_t ix = 0; ix < m_vTimeframe.size(); ix++ ) {
+        const Timeframe& tf( m_vTimeframe[ ix ] );
+        if ( tf.bOpen ) {
+          OnBarUpdated(
+            ix,
+            tf.Get( ( EType::Time == tf.eType ) ? tf.dtStart + time_duration( 0, 0, tf.nWidthBy2 ) : tf.dtStart ) );
+        }
+      }
+    }
+    m_dtLastIntermediateEmission = dt;
+  }
+
+}
+
+Bar MultiBarFactory::GetCurrentBar( ixTimeframe_t ix ) const {
+  const Timeframe& tf( m_vTimeframe[ ix ] );
+  if ( tf.bOpen ) return tf.Get( tf.dtStart );
+  else return Bar();
+}
+
+void MultiBarFactory::ClearCompleted() {
+  for ( Timeframe& tf: m_vTimeframe ) {
+    tf.columns.Clear();
+  }
+}
+
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,147 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    MultiBarFactory.h
+ * Author:  raymond@burkholder.net
+ * Project: TFTimeSeries
+ * Created: 2026
+ */
+
+#pragma once
+
+// several bar widths from one pass over the ticks
+//   time bars reproduce BarFactory: same buckets, same timestamps, same events
+//     the time of day is bucketed once per tick, time frames are visited finest first,
+//     and a width which is a multiple of the next finer one is not re-bucketed while the finer bar continues
+//   tick, volume and dollar bars close on the tick which reaches the size, the bar is stamped with its first tick
+//   per tick, events are: bars completed (in order of bar end), bars started, bars updated (at most once a second)
+//   completed bars are also kept per time frame in columns
+
+#include <vector>
+
+#include <OUCommon/FastDelegate.h>
+
+#include "DatedDatum.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+class MultiBarFactory {
+public:
+
+  using duration_t = unsigned long;  // seconds
+  using volume_t = Bar::volume_t;
+  using price_t = Bar::price_t;
+  using ixTimeframe_t = size_t;
+
+  enum class EType { Time, Ticks, Volume, Dollar };
+
+  struct Columns { // completed bars of one time frame
+    std::vector<ptime> vDateTime;
+    std::vector<price_t> vOpen;
+    std::vector<price_t> vHigh;
+    std::vector<price_t> vLow;
+    std::vector<price_t> vClose;
+    std::vector<volume_t> vVolume;
+    size_t Size() const { return vDateTime.size(); }
+    Bar At( size_t ix ) const { return Bar( vDateTime[ ix ], vOpen[ ix ], vHigh[ ix ], vLow[ ix ], vClose[ ix ], vVolume[ ix ] ); }
+    void Clear();
+  };
+
+  MultiBarFactory();
+  ~MultiBarFactory();
+
+  // time frames are added before the first tick
+  ixTimeframe_t AddTime( duration_t nSeconds ); // as BarFactory( nSeconds )
+  ixTimeframe_t AddTicks( unsigned int nTicks );
+  ixTimeframe_t AddVolume( volume_t );
+  ixTimeframe_t AddDollar( double );
+
+  size_t Size() const { return m_vTimeframe.size(); }
+  EType Type( ixTimeframe_t ix ) const { return m_vTimeframe[ ix ].eType; }
+
+  void Add( const ptime&, price_t, volume_t );
+  void Add( const Trade& trade ) { Add( trade.DateTime(), trade.Price(), trade.Volume() ); }
+
+  Bar GetCurrentBar( ixTimeframe_t ) const; // as BarFactory::getCurrentBar
+  const Columns& GetCompleted( ixTimeframe_t ix ) const { return m_vTimeframe[ ix ].columns; }
+  void ClearCompleted();
+
+  using OnBarHandler = fastdelegate::FastDelegate2<ixTimeframe_t,const Bar&>;
+  void SetOnNewBarStarted( OnBarHandler function ) { OnNewBarStarted = function; }
+  void SetOnBarUpdated( OnBarHandler function ) { OnBarUpdated = function; } // called at most once a second
+  void SetOnBarComplete( OnBarHandler function ) { OnBarComplete = function; }
+
+protected:
+private:
+
+  struct Timeframe {
+
+    EType eType;
+    duration_t nWidth; // time
+    duration_t nWidthBy2; // shift bar over half a bar for chartdir
+    double dblSize; // ticks, volume, dollars
+    bool bNested; // time: width is a multiple of the next finer time width
+
+    bool bOpen; // bar in progress
+    duration_t nInterval; // time: current bucket
+    double dblAccumulated; // ticks, volume, dollars
+
+    ptime dtStart;
+    price_t open;
+    price_t high;
+    price_t low;
+    price_t close;
+    volume_t volume;
+
+    Columns columns;
+
+    Timeframe( EType, duration_t, double );
+    void Start( const ptime&, price_t, volume_t );
+    void Update( price_t, volume_t );
+    Bar Get( const ptime& ) const;
+  };
+
+  struct Completed {
+    ptime dtEnd;
+    ixTimeframe_t ix;
+    size_t row; // in columns
+  };
+
+  using vTimeframe_t = std::vector<Timeframe>;
+  vTimeframe_t m_vTimeframe;
+
+  using vIndex_t = std::vector<ixTimeframe_t>;
+  vIndex_t m_vTime; // time frames by width, finest first
+  vIndex_t m_vInformation; // ticks, volume, dollars
+
+  std::vector<Completed> m_vCompleted; // scratch, per tick
+  vIndex_t m_vStarted; // scratch, per tick
+
+  bool m_bStarted; // first tick seen
+  ptime m_dtLastIntermediateEmission; // changes emitted no less than 1 second apart
+  const boost::posix_time::time_duration m_1Sec;
+
+  OnBarHandler OnNewBarStarted;
+  OnBarHandler OnBarUpdated;
+  OnBarHandler OnBarComplete;
+
+  ixTimeframe_t Append( EType, duration_t, double );
+  void Complete( ixTimeframe_t, const ptime& dt );
+
+};
+
+} // namespace tf
+} // namespace ou
@@ -18,6 +18,7 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <functional>
 
 //#include <boost/thread/mutex.hpp>
 //#include <boost/thread/lock_types.hpp>
@@ -123,6 +124,7 @@ public:
 
   void Clear();
   void Append( const T& datum );
+  void Append( const T* bgn, const T* end ); // bulk load, OnAppend is not fired, attached indicators catch up with WarmStart
   void Insert( const dt_t& time, const T& datum );  // time overrides datum.time?
   void Insert( const T& datum );
   void Resize( size_type Size ) { m_vSeries.resize( Size );  }
@@ -175,6 +177,18 @@ public:
   void DisableAppend() { m_bAppendToVector = false; }
   bool AppendEnabled() const { return m_bAppendToVector; }  // affects Append(...) only
 
+  // fixed memory: keep the most recent values rather than the whole series, for long running indicators
+  //   storage for 2 * nRetain is reserved once, when full the older half is passed to fEvicted, then dropped
+  //   between nRetain and 2 * nRetain values are held, Ago( nRetain - 1 ), last(), OnAppend work as before,
+  //   indices for At, [], at, begin/end are of the values held, the storage stays contiguous for First()
+  //   fEvicted can spill to disk, eg, HDF5WriteTimeSeries::Write( path, bgn, end )
+  //   nRetain of 0 returns to an unbounded series
+  //   TimeSeriesSlidingWindow rebases on Evicted(), nRetain needs to cover the widest attached window
+  using fEvicted_t = std::function<void(const T* bgn, const T* end)>;
+  void Retain( size_type nRetain, fEvicted_t&& fEvicted = nullptr );
+  size_type Retained() const { return m_nRetain; }
+  size_type Evicted() const { return m_nEvicted; } // values dropped so far, the absolute index of [ 0 ]
+
   using fForEach_t = std::function<void(const T&)>;
   void ForEach( fForEach_t&& f ) const {
     for ( const typename vTimeSeries_t::value_type& vt: m_vSeries ) {
@@ -203,6 +217,12 @@ private:
   vTimeSeries_t m_vSeries;
   const_iterator m_vIterator;  // belongs after vector declaration
 
+  size_type m_nRetain; // 0 for unbounded
+  size_type m_nEvicted;
+  fEvicted_t m_fEvicted;
+
+  void Evict(); // the older half of a full retained series
+
 };
 
 template<typename T>
@@ -218,7 +238,7 @@ TimeSeries<T>::TimeSeries( size_type size )
 
 template<typename T>
 TimeSeries<T>::TimeSeries( const std::string& sName, size_type nSize )
-  : m_vIterator( m_vSeries.end() ), m_sName( sName ), m_bAppendToVector( true ) {
+  : m_vIterator( m_vSeries.end() ), m_sName( sName ), m_bAppendToVector( true ), m_nRetain( 0 ), m_nEvicted( 0 ) {
   //m_vSeries.get_allocator().lockRequest = fastdelegate::MakeDelegate( this, &TimeSeries<T>::lock );
   //m_lock = boost::unique_lock<boost::mutex>( m_mutex, boost::defer_lock );
   if ( ( 0 != nSize ) && ( m_vSeries.size() < nSize ) ) m_vSeries.reserve( nSize );
@@ -228,7 +248,9 @@ TimeSeries<T>::TimeSeries( const std::string& sName, size_type nSize )
 template<typename T>
 TimeSeries<T>::TimeSeries( const TimeSeries<T>& series )
 : m_bAppendToVector( series.m_bAppendToVector )
+, m_nRetain( series.m_nRetain ), m_nEvicted( series.m_nEvicted ) // the evicted handler is not shared
 {
+  if ( 0 != m_nRetain ) m_vSeries.reserve( 2 * m_nRetain );
   m_vSeries = series.m_vSeries;
   //assert( !m_bLock );
   //m_vSeries.get_allocator().lockRequest = fastdelegate::MakeDelegate( this, &TimeSeries<T>::lock );
@@ -246,6 +268,7 @@ template<typename T>
 void TimeSeries<T>::Append(const T& datum) {
   //strict_lock<TimeSeries<T> > guard(*this);
   if ( m_bAppendToVector ) {
+    if ( ( 0 != m_nRetain ) && ( m_vSeries.size() == 2 * m_nRetain ) ) Evict();
     m_vSeries.push_back( datum );
   }
   else { // provide for .ago(0) capability
@@ -259,11 +282,38 @@ void TimeSeries<T>::Append(const T& datum) {
   OnAppend( datum );
 }
 
+template<typename T>
+void TimeSeries<T>::Append( const T* bgn, const T* end ) {
+  if ( bgn == end ) return;
+  if ( m_bAppendToVector ) {
+    if ( 0 == m_nRetain ) {
+      m_vSeries.insert( m_vSeries.end(), bgn, end );
+    }
+    else {
+      while ( bgn != end ) {
+        if ( m_vSeries.size() == 2 * m_nRetain ) Evict();
+        const size_type n( std::min<size_type>( end - bgn, 2 * m_nRetain - m_vSeries.size() ) );
+        m_vSeries.insert( m_vSeries.end(), bgn, bgn + n );
+        bgn += n;
+      }
+    }
+  }
+  else { // provide for .ago(0) capability
+    if ( 0 == m_vSeries.size() ) {
+      m_vSeries.push_back( *( end - 1 ) );
+    }
+    else {
+      m_vSeries.back() = *( end - 1 );
+    }
+  }
+}
+
 template<typename T>
 void TimeSeries<T>::Insert( const dt_t& dt, const T& datum ) {
   T key( dt );
   std::pair<iterator, iterator> p;
   //strict_lock<TimeSeries<T> > guard(*this);
+  if ( ( 0 != m_nRetain ) && ( m_vSeries.size() == 2 * m_nRetain ) ) Evict();
   p = equal_range( m_vSeries.begin(), m_vSeries.end(), key );
   if ( m_vSeries.end() == p.second ) {
     m_vSeries.push_back( datum );
@@ -277,6 +327,7 @@ template<typename T>
 void TimeSeries<T>::Insert( const T& datum ) {
   std::pair<iterator, iterator> p;
   //strict_lock<TimeSeries<T> > guard(*this);
+  if ( ( 0 != m_nRetain ) && ( m_vSeries.size() == 2 * m_nRetain ) ) Evict();
   p = equal_range( m_vSeries.begin(), m_vSeries.end(), datum );
   if ( m_vSeries.end() == p.second ) {
     m_vSeries.push_back( datum );
@@ -286,6 +337,37 @@ void TimeSeries<T>::Insert( const T& datum ) {
   }
 }
 
+template<typename T>
+void TimeSeries<T>::Retain( size_type nRetain, fEvicted_t&& fEvicted ) {
+  m_nRetain = nRetain;
+  m_fEvicted = std::move( fEvicted );
+  if ( 0 != m_nRetain ) {
+    if ( m_vSeries.size() >= 2 * m_nRetain ) Evict();
+    if ( m_vSeries.capacity() > 2 * m_nRetain ) {
+      vTimeSeries_t v;
+      v.reserve( 2 * m_nRetain );
+      v.assign( m_vSeries.begin(), m_vSeries.end() );
+      m_vSeries.swap( v );
+    }
+    else {
+      m_vSeries.reserve( 2 * m_nRetain );
+    }
+    m_vIterator = m_vSeries.end();
+  }
+}
+
+template<typename T>
+void TimeSeries<T>::Evict() {
+  const size_type n( m_vSeries.size() - m_nRetain );
+  if ( m_fEvicted ) {
+    const T* p( m_vSeries.data() );
+    m_fEvicted( p, p + n );
+  }
+  m_vSeries.erase( m_vSeries.begin(), m_vSeries.begin() + n ); // no reallocation, the rest moves to the front
+  m_vIterator = m_vSeries.end(); // the erase invalidates it, a First/Next walk in progress ends
+  m_nEvicted += n;
+}
+
 template<typename T>
 void TimeSeries<T>::Clear() {
   //strict_lock<TimeSeries<T> > guard(*this);
@@ -63,13 +63,13 @@ public:
       std::string sExchange_, std::string sExchangeExecutionId_ )
       : idOrder( idOrder_ ), nQuantity( nQuantity_ ),
         dblPrice( dblPrice_ ), eOrderSide( eOrderSide_ ),
-        sExchange( sExchange_ ), sExchangeExecutionId( sExchangeExecutionId_ ) {};
+        sExchange( std::move( sExchange_ ) ), sExchangeExecutionId( std::move( sExchangeExecutionId_ ) ) {};
     TableRowDefNoKey( /* idOrder_t idOrder_, */
       boost::uint32_t nQuantity_, double dblPrice_, OrderSide::EOrderSide eOrderSide_,
       std::string sExchange_, std::string sExchangeExecutionId_ )
       : idOrder( 0 ), nQuantity( nQuantity_ ),  // idOrder from owner
         dblPrice( dblPrice_ ), eOrderSide( eOrderSide_ ),
-        sExchange( sExchange_ ), sExchangeExecutionId( sExchangeExecutionId_ ) {};
+        sExchange( std::move( sExchange_ ) ), sExchangeExecutionId( std::move( sExchangeExecutionId_ ) ) {};
   };
 
   struct TableRowDef: TableRowDefNoKey {
@@ -80,17 +80,17 @@ public:
     }
     idExecution_t idExecution;
 
-    TableRowDef() : idExecution( 0 ), TableRowDefNoKey() {};
+    TableRowDef() : TableRowDefNoKey(), idExecution( 0 ) {};
     TableRowDef( idExecution_t idExecution_, idOrder_t idOrder_,
       boost::uint32_t nQuantity_, double dblPrice_, OrderSide::EOrderSide eOrderSide_,
       std::string sExchange_, std::string sExchangeExecutionId_ )
-      : idExecution( idExecution_ ), TableRowDefNoKey( idOrder_, nQuantity_,
-        dblPrice_, eOrderSide_, sExchange_, sExchangeExecutionId_ ) {};
+      : TableRowDefNoKey( idOrder_, nQuantity_,
+        dblPrice_, eOrderSide_, std::move( sExchange_ ), std::move( sExchangeExecutionId_ ) ), idExecution( idExecution_ ) {};
     TableRowDef( /* idExecution_t idExecution_, idOrder_t idOrder_, */
       boost::uint32_t nQuantity_, double dblPrice_, OrderSide::EOrderSide eOrderSide_,
       std::string sExchange_, std::string sExchangeExecutionId_ )
-      : idExecution( 0 ), TableRowDefNoKey( nQuantity_,  // executionid from db, idOrder from owner
-        dblPrice_, eOrderSide_, sExchange_, sExchangeExecutionId_ ) {};
+      : TableRowDefNoKey( nQuantity_,  // executionid from db, idOrder from owner
+        dblPrice_, eOrderSide_, std::move( sExchange_ ), std::move( sExchangeExecutionId_ ) ), idExecution( 0 ) {};
   };
 
   struct TableCreateDef: TableRowDef {
@@ -119,6 +119,7 @@ public:
   const std::string& GetExchangeExecutionId() const { return m_row.sExchangeExecutionId; };
   ptime GetTimeStamp() const { return m_row.dtExecutionTimeStamp; };
   void SetOrderId( idOrder_t idOrder ) { m_row.idOrder = idOrder; };
+  void SetExecutionId( idExecution_t idExecution ) { m_row.idExecution = idExecution; };
 
   const TableRowDef& GetRow() const { return m_row; };
 
@@ -0,0 +1,107 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// integer id to pointer, open addressing with linear probe in a power of two table
+//   the ids are hashed multiplicatively, so the sequential ids handed out by OrderManager spread evenly
+//   the table is kept at most half full, it doubles when that is exceeded
+//   entries are not removed, the pointed to objects are owned elsewhere and do not move when the table grows
+
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <cstdint>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+template<typename Id, typename T>
+class FlatIndex {
+public:
+
+  FlatIndex( size_t nSlots = 1024 ) // rounded up to a power of two
+  : m_nSize {}, m_nShift( 64 )
+  {
+    size_t nCapacity( 2 );
+    m_nShift--;
+    while ( nCapacity < nSlots ) {
+      nCapacity *= 2;
+      m_nShift--;
+    }
+    m_vSlot.resize( nCapacity );
+  }
+
+  T* Find( Id id ) const {
+    return m_vSlot[ Probe( id ) ].p;
+  }
+
+  bool Insert( Id id, T* p ) { // false when already present
+    assert( nullptr != p );
+    size_t ix( Probe( id ) );
+    if ( nullptr != m_vSlot[ ix ].p ) return false;
+    if ( m_vSlot.size() < 2 * ( m_nSize + 1 ) ) {
+      Grow();
+      ix = Probe( id );
+    }
+    m_vSlot[ ix ] = Slot { id, p };
+    m_nSize++;
+    return true;
+  }
+
+  template<typename F>
+  void ForEach( F&& f ) const {
+    for ( const Slot& slot: m_vSlot ) {
+      if ( nullptr != slot.p ) f( slot.id, slot.p );
+    }
+  }
+
+  size_t Size() const { return m_nSize; }
+
+protected:
+private:
+
+  struct Slot {
+    Id id;
+    T* p; // nullptr when empty
+    Slot(): id {}, p( nullptr ) {}
+    Slot( Id id_, T* p_ ): id( id_ ), p( p_ ) {}
+  };
+
+  std::vector<Slot> m_vSlot;
+  size_t m_nSize;
+  unsigned int m_nShift; // 64 - log2( slots )
+
+  size_t Probe( Id id ) const { // slot of the id, or the empty slot where it would go
+    const size_t mask( m_vSlot.size() - 1 );
+    size_t ix( ( static_cast<std::uint64_t>( id ) * 0x9E3779B97F4A7C15ull ) >> m_nShift );
+    while ( ( nullptr != m_vSlot[ ix ].p ) && ( id != m_vSlot[ ix ].id ) ) {
+      ix = ( ix + 1 ) & mask;
+    }
+    return ix;
+  }
+
+  void Grow() {
+    std::vector<Slot> vSlot( 2 * m_vSlot.size() );
+    vSlot.swap( m_vSlot );
+    m_nShift--;
+    for ( const Slot& slot: vSlot ) {
+      if ( nullptr != slot.p ) {
+        m_vSlot[ Probe( slot.id ) ] = slot;
+      }
+    }
+  }
+};
+
+} // namespace tf
+} // namespace ou
@@ -21,8 +21,10 @@
 #pragma once
 
 #include <map>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <cstdint>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/gregorian_calendar.hpp>
@@ -306,6 +308,11 @@ public:
   inline bool ExchangeRuleAvailable() const { return !m_row.sExchangeRules.empty(); }
   int GetExchangeRule();
 
+  // assigned by RiskManager::RegisterInstrument, zero when not registered,
+  //   so the pre-trade check indexes the slot without a lookup by name
+  void SetRiskSlot( std::uint32_t nSlot ) { m_nRiskSlot.store( nSlot, std::memory_order_release ); }
+  std::uint32_t GetRiskSlot() const { return m_nRiskSlot.load( std::memory_order_acquire ); }
+
   bool operator==( const Instrument& rhs ) const;
 
   const TableRowDef& GetRow() const { return m_row; };
@@ -323,6 +330,8 @@ private:
   dtrMarketOpenClose_t m_dtrTimeLiquid;
   dtrMarketOpenClose_t m_dtrTimeTrading;
 
+  std::atomic<std::uint32_t> m_nRiskSlot { 0 }; // slot index + 1
+
   Instrument( const Instrument& );  // copy ctor
   Instrument& operator=( const Instrument& ) = delete; // assignment
 
@@ -31,6 +31,7 @@ const std::string sExecution( "executions" );
 const std::string sExchange( "exchanges" );
 const std::string sInstrument( "instruments" );
 const std::string sAltInstrumentName( "altinstrumentnames" );
+const std::string sRiskLimits( "risklimits" );
 
 } // namespace tablenames
 } // namespace tf
@@ -60,6 +60,7 @@ extern const std::string sExecution;
 extern const std::string sExchange;
 extern const std::string sInstrument;
 extern const std::string sAltInstrumentName;
+extern const std::string sRiskLimits;
 
 } // namespace tablenames
 
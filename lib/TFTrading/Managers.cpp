@@ -16,6 +16,7 @@
 #include "AccountManager.h"
 #include "PortfolioManager.h"
 #include "OrderManager.h"
+#include "RiskManager.h"
 
 #include "Managers.h"
 
@@ -41,6 +42,7 @@ void HandleInitializeManagers( ou::db::Session* pSession ) {
   AccountManager::GlobalInstance().AttachToSession( pSession );
   PortfolioManager::GlobalInstance().AttachToSession( pSession );
   OrderManager::GlobalInstance().AttachToSession( pSession );
+  RiskManager::GlobalInstance().AttachToSession( pSession );
 
   // link up with PortfolioManager for call back
   PortfolioManager::GlobalInstance().SetOnPositionNeedDetails( &HandlePositionDetails );
@@ -58,6 +60,7 @@ void HandleDenitializeManagers( ou::db::Session& session ) {
   AccountManager::GlobalInstance().DetachFromSession( &session );
   PortfolioManager::GlobalInstance().DetachFromSession( &session );
   OrderManager::GlobalInstance().DetachFromSession( &session );
+  RiskManager::GlobalInstance().DetachFromSession( &session );
 }
 
 } // namespace tf
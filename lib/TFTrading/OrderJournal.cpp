@@ -0,0 +1,517 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+
+#include "OrderJournal.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+namespace {
+
+  // journal record: [u32 payload length][payload][u32 fnv-1a of payload]
+  //   payload: [u8 type][fields in Fields() order]
+  //   a torn record at the end of the file fails the length or checksum test, and ends the replay
+
+  const boost::posix_time::ptime c_dtEpoch( boost::gregorian::date( 1970, 1, 1 ) );
+
+  std::uint32_t Checksum( const char* p, size_t n ) {
+    std::uint32_t hash( 2166136261u );
+    while ( 0 != n ) {
+      hash ^= (unsigned char) *p++;
+      hash *= 16777619u;
+      --n;
+    }
+    return hash;
+  }
+
+  // ou::db Field visitors, serialize a row definition in field order
+
+  class Action_Write {
+  public:
+    Action_Write( std::string& s ): m_s( s ) {}
+    template<typename T>
+    void Field( const std::string&, T& var, const std::string& = "" ) { Write( var ); }
+    void Key( const std::string& ) {}
+    void Constraint( const std::string&, const std::string&, const std::string& ) {}
+  private:
+    std::string& m_s;
+    template<typename T>
+    void Write( const T& var ) {
+      static_assert( std::is_arithmetic<T>::value || std::is_enum<T>::value, "Action_Write: unsupported field" );
+      m_s.append( reinterpret_cast<const char*>( &var ), sizeof( T ) );
+    }
+    void Write( const std::string& var ) {
+      const std::uint32_t n( var.size() );
+      Write( n );
+      m_s.append( var );
+    }
+    void Write( const boost::posix_time::ptime& var ) {
+      std::uint8_t special( 0 );
+      std::int64_t ticks( 0 );
+      if ( var.is_not_a_date_time() ) special = 1;
+      else if ( var.is_pos_infinity() ) special = 2;
+      else if ( var.is_neg_infinity() ) special = 3;
+      else ticks = ( var - c_dtEpoch ).ticks();
+      Write( special );
+      Write( ticks );
+    }
+  };
+
+  class Action_Names { // column names, in field order
+  public:
+    Action_Names( std::vector<std::string>& v ): m_v( v ) {}
+    template<typename T>
+    void Field( const std::string& sName, T&, const std::string& = "" ) { m_v.push_back( sName ); }
+    void Key( const std::string& ) {}
+    void Constraint( const std::string&, const std::string&, const std::string& ) {}
+  private:
+    std::vector<std::string>& m_v;
+  };
+
+  class Action_Read {
+  public:
+    Action_Read( const char* bgn, const char* end ): m_p( bgn ), m_end( end ), m_bOk( true ) {}
+    template<typename T>
+    void Field( const std::string&, T& var, const std::string& = "" ) { Read( var ); }
+    void Key( const std::string& ) {}
+    void Constraint( const std::string&, const std::string&, const std::string& ) {}
+    bool Ok() const { return m_bOk && ( m_p == m_end ); }
+  private:
+    const char* m_p;
+    const char* m_end;
+    bool m_bOk;
+    bool Have( size_t n ) {
+      if ( (size_t)( m_end - m_p ) < n ) m_bOk = false;
+      return m_bOk;
+    }
+    template<typename T>
+    void Read( T& var ) {
+      static_assert( std::is_arithmetic<T>::value || std::is_enum<T>::value, "Action_Read: unsupported field" );
+      if ( Have( sizeof( T ) ) ) {
+        std::memcpy( &var, m_p, sizeof( T ) );
+        m_p += sizeof( T );
+      }
+    }
+    void Read( std::string& var ) {
+      std::uint32_t n {};
+      Read( n );
+      if ( Have( n ) ) {
+        var.assign( m_p, n );
+        m_p += n;
+      }
+    }
+    void Read( boost::posix_time::ptime& var ) {
+      std::uint8_t special {};
+      std::int64_t ticks {};
+      Read( special );
+      Read( ticks );
+      switch ( special ) {
+        case 0: var = c_dtEpoch + boost::posix_time::time_duration( 0, 0, 0, ticks ); break;
+        case 1: var = boost::posix_time::ptime( boost::date_time::not_a_date_time ); break;
+        case 2: var = boost::posix_time::ptime( boost::date_time::pos_infin ); break;
+        case 3: var = boost::posix_time::ptime( boost::date_time::neg_infin ); break;
+        default: m_bOk = false; break;
+      }
+    }
+  };
+
+} // namespace anonymous
+
+OrderJournal::OrderJournal()
+: m_pSession( nullptr ), m_pFile( nullptr )
+, m_queue( c_nMaxBatch ), m_pool( c_nMaxBatch )
+, m_nAppended {}, m_nCommitted {}
+, m_bRunning( false ), m_msInterval( 2 )
+, m_bFailed( false ), m_nPending {}
+{
+  m_vBatch.reserve( c_nMaxBatch );
+  m_vCommit.reserve( c_nMaxBatch );
+}
+
+OrderJournal::~OrderJournal() {
+  Close();
+  Entry* pEntry;
+  while ( m_queue.pop( pEntry ) ) delete pEntry; // only when Open was never called
+  while ( m_pool.pop( pEntry ) ) delete pEntry;
+}
+
+void OrderJournal::Open( ou::db::Session* pSession, const std::string& sFileName ) {
+
+  assert( nullptr != pSession );
+  assert( !IsOpen() );
+
+  const std::string& sDbFileName( pSession->GetDbFileName() );
+  if ( sDbFileName.empty() ) {
+    throw std::runtime_error( "OrderJournal::Open: session has no database file" );
+  }
+
+  m_sFileName = sFileName;
+  m_bFailed.store( false, std::memory_order_release );
+
+  {
+    // 'pragma journal_mode' returns a row, run to completion before any transaction
+    //   the session waits on the writer's transaction, rather than failing with 'database is locked'
+    ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
+      = pSession->SQL<ou::db::NoBind>( "pragma journal_mode=WAL", m_noBind ).NoExecute();
+    while ( pSession->Execute( pQuery ) ) {}
+    pQuery = pSession->SQL<ou::db::NoBind>( "pragma busy_timeout=5000", m_noBind ).NoExecute();
+    while ( pSession->Execute( pQuery ) ) {}
+  }
+
+  m_session.Open( sDbFileName );
+  m_pSession = &m_session;
+
+  try {
+    m_pSession->MapRowDefToTableName<Order::TableRowDef>( tablenames::sOrder );
+    m_pSession->MapRowDefToTableName<Execution::TableRowDef>( tablenames::sExecution );
+    ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
+      = m_pSession->SQL<ou::db::NoBind>( "pragma synchronous=NORMAL", m_noBind ).NoExecute();
+    while ( m_pSession->Execute( pQuery ) ) {}
+    pQuery = m_pSession->SQL<ou::db::NoBind>( "pragma busy_timeout=5000", m_noBind ).NoExecute();
+    while ( m_pSession->Execute( pQuery ) ) {}
+    pQuery.reset();
+    PrepareStatements();
+    Replay();
+  }
+  catch ( ... ) {
+    ReleaseStatements();
+    m_session.Close();
+    m_pSession = nullptr;
+    throw;
+  }
+
+  m_pFile = std::fopen( m_sFileName.c_str(), "wb" );
+  if ( nullptr == m_pFile ) {
+    std::cout << "OrderJournal::Open: can not open " << m_sFileName << ", rows are committed without journal" << std::endl;
+  }
+
+  m_bRunning.store( true, std::memory_order_release );
+  m_threadWriter = std::thread( &OrderJournal::Writer, this );
+}
+
+void OrderJournal::Close() {
+  if ( IsOpen() ) {
+    m_bRunning.store( false, std::memory_order_release );
+    if ( m_threadWriter.joinable() ) m_threadWriter.join(); // writer drains the queue on the way out
+    if ( nullptr != m_pFile ) {
+      std::fclose( m_pFile );
+      m_pFile = nullptr;
+    }
+    if ( !m_bFailed.load( std::memory_order_acquire ) ) {
+      boost::filesystem::remove( m_sFileName );
+    }
+    ReleaseStatements();
+    m_session.Close();
+    m_pSession = nullptr;
+  }
+}
+
+void OrderJournal::PrepareStatements() {
+
+  // the latest order row wins, and replay after a crash can repeat rows already committed
+  //   an upsert updates the order row in place, 'insert or replace' would delete it first,
+  //   which the executions foreign key ( on delete restrict ) refuses once the order has a fill
+
+  std::vector<std::string> vName;
+  Action_Names action( vName );
+  m_rowOrder.Fields( action );
+
+  m_pQueryOrder = m_pSession->Insert<Order::TableRowDef>( m_rowOrder ).NoExecute();
+  std::string& sOrder( m_pQueryOrder->UpdateQueryText() );
+  sOrder += " on conflict(orderid) do update set ";
+  bool bFirst( true );
+  for ( const std::string& sName: vName ) {
+    if ( "orderid" != sName ) {
+      if ( !bFirst ) sOrder += ", ";
+      sOrder += sName + "=excluded." + sName;
+      bFirst = false;
+    }
+  }
+
+  // executions are not revised, one already committed is left as is
+  m_pQueryExecution = m_pSession->Insert<Execution::TableRowDef>( m_rowExecution ).NoExecute();
+  m_pQueryExecution->UpdateQueryText() += " on conflict(executionid) do nothing";
+
+  // immediate: take the write lock at the start, waiting out the session's writes
+  m_pQueryBegin = m_pSession->SQL<ou::db::NoBind>( "begin immediate transaction", m_noBind ).NoExecute();
+  m_pQueryCommit = m_pSession->SQL<ou::db::NoBind>( "commit transaction", m_noBind ).NoExecute();
+  m_pQueryRollback = m_pSession->SQL<ou::db::NoBind>( "rollback transaction", m_noBind ).NoExecute();
+}
+
+void OrderJournal::ReleaseStatements() { // prior to the session closing
+  m_pQueryOrder.reset();
+  m_pQueryExecution.reset();
+  m_pQueryBegin.reset();
+  m_pQueryCommit.reset();
+  m_pQueryRollback.reset();
+}
+
+OrderJournal::Entry* OrderJournal::Acquire() {
+  Entry* pEntry;
+  if ( !m_pool.pop( pEntry ) ) {
+    pEntry = new Entry;
+  }
+  return pEntry;
+}
+
+void OrderJournal::Push( Entry* pEntry ) {
+  m_queue.push( pEntry ); // allocates a node only when the pre-allocated nodes are exhausted
+  m_nAppended.fetch_add( 1, std::memory_order_release );
+}
+
+void OrderJournal::Append( const Order::TableRowDef& row ) {
+  Entry* pEntry = Acquire();
+  pEntry->eType = EType::order;
+  pEntry->order = row;
+  Push( pEntry );
+}
+
+void OrderJournal::Append( const Execution::TableRowDef& row ) {
+  Entry* pEntry = Acquire();
+  pEntry->eType = EType::execution;
+  pEntry->execution = row;
+  Push( pEntry );
+}
+
+bool OrderJournal::Flush() {
+  const size_t nTarget = m_nAppended.load( std::memory_order_acquire );
+  while ( IsOpen() && ( m_nCommitted.load( std::memory_order_acquire ) < nTarget ) ) {
+    if ( m_bFailed.load( std::memory_order_acquire ) ) return false; // the writer retries, the rows are in the journal file
+    std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+  }
+  return m_nCommitted.load( std::memory_order_acquire ) >= nTarget;
+}
+
+void OrderJournal::Writer() {
+  while ( m_bRunning.load( std::memory_order_acquire ) ) {
+    if ( !Drain() ) {
+      std::this_thread::sleep_for( m_msInterval );
+    }
+  }
+  while ( Drain() ) {}
+
+  // after a failed commit, rows still queued go to the journal file, for replay on the next start
+  Entry* pEntry;
+  while ( m_queue.pop( pEntry ) ) {
+    m_vBatch.push_back( pEntry );
+  }
+  WriteJournal( m_vBatch );
+  for ( Entry* p: m_vBatch ) m_pool.push( p );
+  for ( Entry* p: m_vCommit ) m_pool.push( p );
+  m_vBatch.clear();
+  m_vCommit.clear();
+  m_mapFirstOrder.clear();
+  m_nPending = 0;
+}
+
+bool OrderJournal::Drain() {
+
+  Entry* pEntry;
+  while ( ( c_nMaxBatch > m_vBatch.size() ) && m_queue.pop( pEntry ) ) {
+    m_vBatch.push_back( pEntry );
+  }
+  if ( m_vBatch.empty() && m_vCommit.empty() ) return false;
+
+  // rows are journaled as appended, ahead of any held over from a failed commit, replay applies them in order
+  WriteJournal( m_vBatch );
+
+  // an order row is a full snapshot, only the latest needs writing
+  //   it is written in the place of the first, so a new order row still precedes its executions
+  //   m_vCommit and m_mapFirstOrder still hold a batch which failed to commit
+  for ( Entry* pEntry: m_vBatch ) {
+    if ( EType::order == pEntry->eType ) {
+      auto result = m_mapFirstOrder.emplace( pEntry->order.idOrder, pEntry );
+      if ( !result.second ) {
+        std::swap( result.first->second->order, pEntry->order );
+        m_pool.push( pEntry );
+        ++m_statistics.nCoalesced;
+        continue;
+      }
+    }
+    m_vCommit.push_back( pEntry );
+  }
+  m_nPending += m_vBatch.size();
+  m_vBatch.clear();
+
+  if ( !Commit( m_vCommit ) ) {
+    m_bFailed.store( true, std::memory_order_release ); // rows are held for the next drain
+    return false; // the writer waits out the interval before retrying
+  }
+
+  TruncateJournal();
+  m_bFailed.store( false, std::memory_order_release );
+
+  for ( Entry* p: m_vCommit ) {
+    m_pool.push( p );
+  }
+  m_vCommit.clear();
+  m_mapFirstOrder.clear();
+  m_nCommitted.fetch_add( m_nPending, std::memory_order_release );
+  m_nPending = 0;
+
+  return true;
+}
+
+void OrderJournal::Execute( const Entry& entry ) {
+  switch ( entry.eType ) {
+    case EType::order:
+      m_rowOrder = entry.order;
+      m_pSession->Reset( m_pQueryOrder );
+      m_pSession->Bind<Order::TableRowDef>( m_pQueryOrder );
+      m_pSession->Execute( m_pQueryOrder );
+      break;
+    case EType::execution:
+      m_rowExecution = entry.execution;
+      m_pSession->Reset( m_pQueryExecution );
+      m_pSession->Bind<Execution::TableRowDef>( m_pQueryExecution );
+      m_pSession->Execute( m_pQueryExecution );
+      break;
+  }
+}
+
+bool OrderJournal::Commit( const std::vector<Entry*>& vEntry ) {
+  try {
+    m_pSession->Reset( m_pQueryBegin );
+    m_pSession->Execute( m_pQueryBegin );
+    try {
+      for ( const Entry* pEntry: vEntry ) {
+        Execute( *pEntry );
+      }
+      m_pSession->Reset( m_pQueryCommit );
+      m_pSession->Execute( m_pQueryCommit );
+      m_statistics.nRows += vEntry.size();
+      ++m_statistics.nBatches;
+      return true;
+    }
+    catch ( ... ) {
+      m_pSession->Reset( m_pQueryRollback );
+      m_pSession->Execute( m_pQueryRollback );
+      throw;
+    }
+  }
+  catch ( const std::exception& e ) {
+    std::cout << "OrderJournal::Commit: " << vEntry.size() << " rows not committed, " << e.what() << std::endl;
+  }
+  catch ( ... ) { // nothing may leave the writer thread
+    std::cout << "OrderJournal::Commit: " << vEntry.size() << " rows not committed, unknown error" << std::endl;
+  }
+  return false;
+}
+
+void OrderJournal::WriteJournal( const std::vector<Entry*>& vEntry ) {
+
+  if ( ( nullptr == m_pFile ) || vEntry.empty() ) return;
+
+  m_sRecord.clear();
+  for ( Entry* pEntry: vEntry ) {
+    const size_t ixLength = m_sRecord.size();
+    m_sRecord.append( sizeof( std::uint32_t ), 0 ); // length, filled in below
+    const size_t ixPayload = m_sRecord.size();
+    Action_Write action( m_sRecord );
+    action.Field( "type", pEntry->eType );
+    switch ( pEntry->eType ) {
+      case EType::order: pEntry->order.Fields( action ); break;
+      case EType::execution: pEntry->execution.Fields( action ); break;
+    }
+    const std::uint32_t nPayload( m_sRecord.size() - ixPayload );
+    std::memcpy( &m_sRecord[ ixLength ], &nPayload, sizeof( nPayload ) );
+    const std::uint32_t check( Checksum( m_sRecord.data() + ixPayload, nPayload ) );
+    m_sRecord.append( reinterpret_cast<const char*>( &check ), sizeof( check ) );
+  }
+
+  // written through to the os before the transaction, survives the process, not the machine
+  if ( ( 1 != std::fwrite( m_sRecord.data(), m_sRecord.size(), 1, m_pFile ) ) || ( 0 != std::fflush( m_pFile ) ) ) {
+    std::cout << "OrderJournal::WriteJournal: write failed for " << m_sFileName << std::endl;
+  }
+}
+
+void OrderJournal::TruncateJournal() {
+  if ( nullptr != m_pFile ) {
+    if ( 0 != ::ftruncate( fileno( m_pFile ), 0 ) ) {
+      std::cout << "OrderJournal::TruncateJournal: truncate failed for " << m_sFileName << std::endl;
+    }
+    std::rewind( m_pFile );
+  }
+}
+
+void OrderJournal::Replay() {
+
+  if ( !boost::filesystem::exists( m_sFileName ) ) return;
+
+  std::FILE* pFile = std::fopen( m_sFileName.c_str(), "rb" );
+  if ( nullptr == pFile ) {
+    throw std::runtime_error( "OrderJournal::Replay: can not open " + m_sFileName );
+  }
+  std::string sContent;
+  char buf[ 8192 ];
+  size_t n;
+  while ( 0 != ( n = std::fread( buf, 1, sizeof( buf ), pFile ) ) ) {
+    sContent.append( buf, n );
+  }
+  std::fclose( pFile );
+
+  std::vector<Entry> vEntry;
+  const char* p = sContent.data();
+  const char* end = p + sContent.size();
+  while ( (size_t)( end - p ) >= ( 2 * sizeof( std::uint32_t ) ) ) {
+    std::uint32_t nPayload;
+    std::memcpy( &nPayload, p, sizeof( nPayload ) );
+    const char* pPayload = p + sizeof( nPayload );
+    if ( (size_t)( end - pPayload ) < ( nPayload + sizeof( std::uint32_t ) ) ) break; // torn
+    std::uint32_t check;
+    std::memcpy( &check, pPayload + nPayload, sizeof( check ) );
+    if ( check != Checksum( pPayload, nPayload ) ) break; // torn
+
+    Entry entry;
+    Action_Read action( pPayload, pPayload + nPayload );
+    action.Field( "type", entry.eType );
+    switch ( entry.eType ) {
+      case EType::order: entry.order.Fields( action ); break;
+      case EType::execution: entry.execution.Fields( action ); break;
+      default: break;
+    }
+    if ( !action.Ok() ) break;
+    vEntry.emplace_back( std::move( entry ) );
+    p = pPayload + nPayload + sizeof( check );
+  }
+
+  if ( p != end ) {
+    std::cout << "OrderJournal::Replay: " << ( end - p ) << " bytes of incomplete record ignored" << std::endl;
+  }
+
+  if ( !vEntry.empty() ) {
+    std::vector<Entry*> vpEntry;
+    vpEntry.reserve( vEntry.size() );
+    for ( Entry& entry: vEntry ) vpEntry.push_back( &entry );
+    if ( !Commit( vpEntry ) ) {
+      throw std::runtime_error( "OrderJournal::Replay: recovery failed, journal retained in " + m_sFileName );
+    }
+    m_statistics.nReplayed += vEntry.size();
+    std::cout << "OrderJournal::Replay: " << vEntry.size() << " rows recovered from " << m_sFileName << std::endl;
+  }
+}
+
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,144 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// write-behind persistence for OrderManager
+//   order and execution rows are queued lock-free from the order path
+//   a writer thread drains the queue, appends the batch to a journal file,
+//     then commits the batch in one transaction with cached statements
+//   the writer has its own connection to the session's database, so its transactions
+//     do not take in statements issued on the session from other threads
+//   the journal file is truncated after each commit, so holds only rows not yet committed
+//   a batch which fails to commit is retried with the next, its rows stay in the journal file meanwhile
+//   on Open, a journal left by a crash is replayed into the database
+//   order rows are upserted, and an execution already present is skipped, so replay is idempotent
+//     ( 'insert or replace' would delete the order row, which the executions foreign key refuses )
+//   the database runs in WAL mode with synchronous=normal
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <unordered_map>
+
+#include <boost/lockfree/queue.hpp>
+
+#include <OUSqlite/Session.h>
+
+#include "Order.h"
+#include "Execution.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+class OrderJournal {
+public:
+
+  using idOrder_t = Order::idOrder_t;
+
+  struct Statistics {
+    size_t nRows; // rows committed
+    size_t nBatches; // transactions committed
+    size_t nCoalesced; // order rows superseded by a later row in the same batch
+    size_t nReplayed; // rows recovered from the journal file on Open
+    Statistics(): nRows {}, nBatches {}, nCoalesced {}, nReplayed {} {}
+  };
+
+  OrderJournal();
+  ~OrderJournal();
+
+  void Open( ou::db::Session*, const std::string& sFileName ); // replays a left over journal, starts the writer
+  void Close(); // commits outstanding rows, stops the writer
+
+  bool IsOpen() const { return nullptr != m_pSession; }
+
+  // called from the order path, rows are copied
+  void Append( const Order::TableRowDef& );
+  void Append( const Execution::TableRowDef& );
+
+  bool Flush(); // blocks until rows appended so far have been committed, false while a failed commit awaits retry
+
+  const Statistics& GetStatistics() const { return m_statistics; } // writer side, read when flushed or closed
+
+protected:
+private:
+
+  enum class EType: std::uint8_t { order = 1, execution = 2 };
+
+  struct Entry {
+    EType eType;
+    Order::TableRowDef order;
+    Execution::TableRowDef execution;
+  };
+
+  static const size_t c_nMaxBatch = 512;
+
+  ou::db::Session m_session; // the writer's connection
+  ou::db::Session* m_pSession; // &m_session while open
+  std::string m_sFileName;
+  std::FILE* m_pFile;
+
+  boost::lockfree::queue<Entry*> m_queue; // to the writer
+  boost::lockfree::queue<Entry*> m_pool; // recycled entries, strings retain their capacity
+
+  std::atomic<size_t> m_nAppended;
+  std::atomic<size_t> m_nCommitted;
+
+  std::atomic<bool> m_bRunning;
+  std::thread m_threadWriter;
+  std::chrono::milliseconds m_msInterval; // writer sleep when the queue is empty
+
+  std::atomic<bool> m_bFailed; // a batch failed to commit, retried on the next drain, the journal file is kept until then
+  size_t m_nPending; // rows appended which m_vCommit represents, superseded order rows included
+
+  // rows bound by the cached statements
+  Order::TableRowDef m_rowOrder;
+  Execution::TableRowDef m_rowExecution;
+  ou::db::NoBind m_noBind;
+
+  ou::db::QueryFields<Order::TableRowDef>::pQueryFields_t m_pQueryOrder;
+  ou::db::QueryFields<Execution::TableRowDef>::pQueryFields_t m_pQueryExecution;
+  ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t m_pQueryBegin;
+  ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t m_pQueryCommit;
+  ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t m_pQueryRollback;
+
+  std::vector<Entry*> m_vBatch; // rows taken from the queue
+  std::vector<Entry*> m_vCommit; // rows to commit, less the superseded order rows, held over when a commit fails
+  std::unordered_map<idOrder_t,Entry*> m_mapFirstOrder; // order id -> its first row in m_vCommit, which receives the latest
+  std::string m_sRecord; // serialization buffer
+
+  Statistics m_statistics;
+
+  Entry* Acquire();
+  void Push( Entry* );
+
+  void Writer();
+  bool Drain(); // false when nothing was waiting, or the commit failed
+
+  void PrepareStatements();
+  void ReleaseStatements();
+  bool Commit( const std::vector<Entry*>& ); // one transaction, false when rolled back
+  void Execute( const Entry& );
+
+  void WriteJournal( const std::vector<Entry*>& );
+  void TruncateJournal();
+  void Replay();
+
+};
+
+} // namespace tf
+} // namespace ou
@@ -22,10 +22,20 @@ namespace tf { // TradeFrame
 // OrderManager
 //
 
-OrderManager::OrderManager() {
+OrderManager::OrderManager()
+: m_pPoolOrder( std::make_shared<SlabPool>() )
+, m_pPoolExecution( std::make_shared<SlabPool>() )
+, m_indexOrders( 1 << 16 ) // a session's worth of orders before the first rehash
+, m_idExecution {}
+{
 }
 
 OrderManager::~OrderManager() {
+  m_journal.Close();
+  m_indexOrders.ForEach(
+    []( idOrder_t, structOrderState* pState ){
+      pState->~structOrderState(); // the memory goes with m_poolOrderState
+    } );
 }
 
 Order::idOrder_t OrderManager::CheckOrderId( idOrder_t id ) {
@@ -43,7 +53,7 @@ OrderManager::pOrder_t OrderManager::ConstructOrder( // market order
     idPosition_t idPosition
     ) {
   assert( nOrderQuantity > 0 );
-  pOrder_t pOrder = std::make_shared<ou::tf::Order>( instrument,  eOrderType, eOrderSide, nOrderQuantity, idPosition );
+  pOrder_t pOrder = MakeOrder( instrument,  eOrderType, eOrderSide, nOrderQuantity, idPosition );
   if ( ConstructOrder( pOrder ) ) {}
   else {
     pOrder.reset();
@@ -59,7 +69,7 @@ OrderManager::pOrder_t OrderManager::ConstructOrder( // limit or stop
     ) {
   assert( nOrderQuantity > 0 );
   assert( dblPrice1 > 0 );
-  pOrder_t pOrder = std::make_shared<ou::tf::Order>( instrument, eOrderType, eOrderSide, nOrderQuantity, dblPrice1, idPosition );
+  pOrder_t pOrder = MakeOrder( instrument, eOrderType, eOrderSide, nOrderQuantity, dblPrice1, idPosition );
   if ( ConstructOrder( pOrder ) ) {}
   else {
     pOrder.reset();
@@ -76,7 +86,7 @@ OrderManager::pOrder_t OrderManager::ConstructOrder( // limit and stop
   assert( nOrderQuantity > 0 );
   assert( dblPrice1 > 0 );
   assert( dblPrice2 > 0 );
-  pOrder_t pOrder = std::make_shared<ou::tf::Order>( instrument, eOrderType, eOrderSide, nOrderQuantity, dblPrice1, dblPrice2, idPosition );
+  pOrder_t pOrder = MakeOrder( instrument, eOrderType, eOrderSide, nOrderQuantity, dblPrice1, dblPrice2, idPosition );
   if ( ConstructOrder( pOrder ) ) {}
   else {
     pOrder.reset();
@@ -85,16 +95,16 @@ OrderManager::pOrder_t OrderManager::ConstructOrder( // limit and stop
 }
 
 bool OrderManager::ConstructOrder( pOrder_t& pOrder ) {
-  // obtain an order id, then insert into maps
+  // obtain an order id, then insert into the index
 
   bool bOk( false );
   idOrder_t idOrder {};
-  iterOrders_t iterOrder;
+  structOrderState* pState;
 
   // repeat attempt for unused order, skip broken ones (when program crashes or is halted with order recorded)
   for ( unsigned int cnt = 0; cnt < 5; cnt++ ) {
     idOrder = m_orderIds.GetNextId();
-    if ( LocateOrder( idOrder, iterOrder ) ) {
+    if ( LocateOrder( idOrder, pState ) ) {
       // try again
     }
     else {
@@ -107,9 +117,13 @@ bool OrderManager::ConstructOrder( pOrder_t& pOrder ) {
     bOk = false;  // reset for another go at it
     pOrder->SetOrderId( idOrder );
     try {
-      pairOrderState_t pair( idOrder, structOrderState( pOrder ) );
-      m_mapOrders.insert( pair );
+      AddOrderState( pOrder );
 
+      if ( m_journal.IsOpen() ) {
+        assert( 0 != pOrder->GetRow().idPosition );
+        m_journal.Append( pOrder->GetRow() );
+      }
+      else
       if ( nullptr != m_pSession ) { // add to database
         assert( 0 != pOrder->GetRow().idPosition );
         ou::db::QueryFields<Order::TableRowDef>::pQueryFields_t pQuery
@@ -172,12 +186,26 @@ namespace OrderManagerQueries {
 void OrderManager::PlaceOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder) {
 
   try {
-    iterOrders_t iter;
-    if ( LocateOrder( pOrder->GetOrderId(), iter ) ) {
+    structOrderState* pState;
+    if ( LocateOrder( pOrder->GetOrderId(), pState ) ) {
       assert( NULL != pProvider );
-      iter->second.pProvider = pProvider;
+      if ( nullptr != OnPreTradeCheck ) {
+        if ( OnPreTradeCheck( *pOrder, true ) ) {
+          pState->bRiskReserved = true;
+        }
+        else {
+          std::cout << "OrderManager::PlaceOrder: " << pOrder->GetOrderId() << " rejected by risk check" << std::endl;
+          ReportErrors( pOrder->GetOrderId(), OrderError::Rejected );
+          return;
+        }
+      }
+      pState->pProvider = pProvider;
       pOrder->SetSendingToProvider();
       pProvider->PlaceOrder( pOrder );
+      if ( m_journal.IsOpen() ) {
+        m_journal.Append( pOrder->GetRow() );
+      }
+      else
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateAtPlaceOrder1
           update(
@@ -224,12 +252,22 @@ namespace OrderManagerQueries {
 void OrderManager::UpdateOrder(ProviderInterfaceBase *pProvider, pOrder_t pOrder) {
 
   try {
-    iterOrders_t iter;
-    if ( LocateOrder( pOrder->GetOrderId(), iter ) ) {
+    structOrderState* pState;
+    if ( LocateOrder( pOrder->GetOrderId(), pState ) ) {
       assert( NULL != pProvider );
-      iter->second.pProvider = pProvider;
+      if ( nullptr != OnPreTradeCheck ) {
+        if ( !OnPreTradeCheck( *pOrder, false ) ) {
+          std::cout << "OrderManager::UpdateOrder: " << pOrder->GetOrderId() << " rejected by risk check" << std::endl;
+          return;
+        }
+      }
+      pState->pProvider = pProvider;
       //pOrder->SetSendingToProvider();  // will generate assertion error
       pProvider->PlaceOrder( pOrder );  // for Interactive Brokers, can 'place' again to update, given same order number
+      if ( m_journal.IsOpen() ) {
+        m_journal.Append( pOrder->GetRow() );
+      }
+      else
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateAtPlaceOrder2
           update( pOrder->GetOrderId(), pOrder->GetRow().dblPrice1, pOrder->GetRow().dblPrice2 );
@@ -267,12 +305,22 @@ namespace OrderManagerQueries {
   };
 }
 
-bool OrderManager::LocateOrder( idOrder_t nOrderId, iterOrders_t& iter ) {
+OrderManager::structOrderState* OrderManager::AddOrderState( pOrder_t& pOrder ) {
+  structOrderState* pState( nullptr );
+  const idOrder_t idOrder( pOrder->GetOrderId() );
+  if ( nullptr == m_indexOrders.Find( idOrder ) ) {
+    void* p = m_poolOrderState.Allocate( sizeof( structOrderState ), alignof( structOrderState ) );
+    pState = new( p ) structOrderState( pOrder );
+    m_indexOrders.Insert( idOrder, pState );
+  }
+  return pState;
+}
+
+bool OrderManager::LocateOrder( idOrder_t nOrderId, structOrderState*& pState ) {
   // if not in memory, the load order and executions from disk
   bool bFound = false;
-//  iterOrders_t iter = m_mapOrders.find( nOrderId );
-  iter = m_mapOrders.find( nOrderId );
-  if ( m_mapOrders.end() != iter ) {
+  pState = m_indexOrders.Find( nOrderId );
+  if ( nullptr != pState ) {
     bFound = true;
   }
   else {
@@ -292,13 +340,11 @@ bool OrderManager::LocateOrder( idOrder_t nOrderId, iterOrders_t& iter ) {
         }
         pInstrument_t pInstrument;
         OnOrderNeedsDetails( rowOrder.idInstrument, pInstrument );
-        pOrder_t pOrder = std::make_shared<ou::tf::Order>( rowOrder, pInstrument );
-        std::pair<iterOrders_t, bool> response;
-        response = m_mapOrders.insert( pairOrderState_t(rowOrder.idOrder, structOrderState( pOrder ) ) );
-        if ( false == response.second ) {
-          throw std::runtime_error( "OrderManager::LocateOrder:  couldn't insert order into map" );
+        pOrder_t pOrder = MakeOrder( rowOrder, pInstrument );
+        pState = AddOrderState( pOrder );
+        if ( nullptr == pState ) {
+          throw std::runtime_error( "OrderManager::LocateOrder:  couldn't insert order into index" );
         }
-        iter = response.first;
 
         // load up executions
         ou::db::QueryFields<OrderManagerQueries::OrderKey>::pQueryFields_t pExecutionQuery
@@ -306,8 +352,7 @@ bool OrderManager::LocateOrder( idOrder_t nOrderId, iterOrders_t& iter ) {
         while ( m_pSession->Execute( pExecutionQuery ) ) {
           Execution::TableRowDef rowExecution;
           m_pSession->Columns<OrderManagerQueries::OrderKey, Execution::TableRowDef>( pExecutionQuery, rowExecution );
-          pExecution_t pExecution = std::make_shared<ou::tf::Execution>( rowExecution );
-          iter->second.pmapExecutions->insert( pairExecution_t( rowExecution.idExecution, pExecution ) );
+          pState->vExecutions.push_back( MakeExecution( rowExecution ) );
         }
       }
     }
@@ -338,10 +383,10 @@ namespace OrderManagerQueries {
 
 void OrderManager::CancelOrder( idOrder_t nOrderId) {  // this needs to work in conjunction with ReportCancellation, database update maybe premature
   try {
-    mapOrders_t::iterator iter;
-    if ( LocateOrder( nOrderId, iter ) ) {
-      pOrder_t pOrder = iter->second.pOrder;
-      iter->second.pProvider->CancelOrder( pOrder );  // check which fields have changed for the db
+    structOrderState* pState;
+    if ( LocateOrder( nOrderId, pState ) ) {
+      pOrder_t pOrder = pState->pOrder;
+      pState->pProvider->CancelOrder( pOrder );  // check which fields have changed for the db
     }
     else {
       std::cout << "OrderManager::CancelOrder:  OrderId Not Found" << std::endl;
@@ -354,10 +399,15 @@ void OrderManager::CancelOrder( idOrder_t nOrderId) {  // this needs to work in
 
 void OrderManager::ReportCancellation( idOrder_t nOrderId ) {
   try {
-    iterOrders_t iter;
-    if ( LocateOrder( nOrderId, iter ) ) {
-      pOrder_t pOrder = iter->second.pOrder;
+    structOrderState* pState;
+    if ( LocateOrder( nOrderId, pState ) ) {
+      pOrder_t pOrder = pState->pOrder;
       pOrder->MarkAsCancelled();
+      ReleaseRisk( *pState );
+      if ( m_journal.IsOpen() ) {
+        m_journal.Append( pOrder->GetRow() );
+      }
+      else
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateAtOrderClose
           close( pOrder->GetOrderId(), pOrder->GetRow().eOrderStatus, pOrder->GetRow().dtOrderClosed );
@@ -404,10 +454,31 @@ namespace OrderManagerQueries {
 
 void OrderManager::ReportExecution( idOrder_t nOrderId, const Execution& exec) {
   try {
-    mapOrders_t::iterator iter;
-    if ( LocateOrder( nOrderId, iter ) ) {
-      pOrder_t pOrder = iter->second.pOrder;
+    structOrderState* pState;
+    if ( LocateOrder( nOrderId, pState ) ) {
+      pOrder_t pOrder = pState->pOrder;
       OrderStatus::EOrderStatus status = pOrder->ReportExecution( exec );
+      if ( pState->bRiskReserved ) {
+        if ( nullptr != OnOrderExecuted ) OnOrderExecuted( *pOrder, exec );
+        switch ( status ) {
+          case OrderStatus::Filled:
+          case OrderStatus::OverFilled:
+          case OrderStatus::CancelledWithPartialFill:
+            pState->bRiskReserved = false; // released by the executed handler
+            break;
+          default:
+            break;
+        }
+      }
+      if ( m_journal.IsOpen() ) {
+        m_journal.Append( pOrder->GetRow() );
+        pExecution_t pExecution = MakeExecution( exec.GetRow() ); // the one copy of the row
+        pExecution->SetOrderId( nOrderId );
+        pExecution->SetExecutionId( ++m_idExecution );
+        m_journal.Append( pExecution->GetRow() );
+        pState->vExecutions.push_back( std::move( pExecution ) );
+      }
+      else
       if ( nullptr != m_pSession ) {
         const Order::TableRowDef& row( pOrder->GetRow() );
         switch ( status ) {
@@ -432,14 +503,14 @@ void OrderManager::ReportExecution( idOrder_t nOrderId, const Execution& exec) {
           break;
         }
         // add execution record
-        pExecution_t pExecution = std::make_shared<ou::tf::Execution>( exec );
+        pExecution_t pExecution = MakeExecution( exec );
         pExecution->SetOrderId( nOrderId );
         ou::db::QueryFields<Execution::TableRowDefNoKey>::pQueryFields_t pQueryExecutionWrite
           = m_pSession->Insert<Execution::TableRowDefNoKey>(
             const_cast<Execution::TableRowDefNoKey&>( dynamic_cast<const Execution::TableRowDefNoKey&>( pExecution->GetRow() ) ) );
         idExecution_t idExecution = m_pSession->GetLastRowId();
-        pairExecution_t pair( idExecution, pExecution );
-        iter->second.pmapExecutions->insert( pair );
+        pExecution->SetExecutionId( idExecution );
+        pState->vExecutions.push_back( std::move( pExecution ) );
       }
   //    switch ( status ) {
   //      case OrderStatus::Filled:
@@ -472,9 +543,15 @@ namespace OrderManagerQueries {
 
 void OrderManager::ReportCommission( idOrder_t nOrderId, double dblCommission ) {
   try {
-    mapOrders_t::iterator iter;
-    if ( LocateOrder( nOrderId, iter ) ) {
-      pOrder_t pOrder = iter->second.pOrder;
+    structOrderState* pState;
+    if ( LocateOrder( nOrderId, pState ) ) {
+      pOrder_t pOrder = pState->pOrder;
+      if ( m_journal.IsOpen() ) {
+        Order::TableRowDef row( pOrder->GetRow() );
+        row.dblCommission = dblCommission;
+        m_journal.Append( row );
+      }
+      else
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateCommission
           commission( pOrder->GetOrderId(), dblCommission );
@@ -512,11 +589,16 @@ namespace OrderManagerQueries {
 
 void OrderManager::ReportErrors( idOrder_t nOrderId, OrderError::EOrderError eError) {
   try {
-    mapOrders_t::iterator iter;
-    if ( LocateOrder( nOrderId, iter ) ) {
-      pOrder_t pOrder = iter->second.pOrder;
+    structOrderState* pState;
+    if ( LocateOrder( nOrderId, pState ) ) {
+      pOrder_t pOrder = pState->pOrder;
       pOrder->ActOnError( eError );
+      ReleaseRisk( *pState );
       //MoveActiveOrderToCompleted( nOrderId );
+      if ( m_journal.IsOpen() ) {
+        m_journal.Append( pOrder->GetRow() );
+      }
+      else
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateOnOrderError
           error( pOrder->GetOrderId(), pOrder->GetRow().eOrderStatus, pOrder->GetRow().dtOrderClosed );
@@ -550,10 +632,14 @@ namespace OrderManagerQueries {
 
 void OrderManager::UpdateReference( idOrder_t idOrder, const std::string& sReference ) {
   try {
-    mapOrders_t::iterator iter;
-    if ( LocateOrder( idOrder, iter ) ) {
-      pOrder_t pOrder = iter->second.pOrder;
+    structOrderState* pState;
+    if ( LocateOrder( idOrder, pState ) ) {
+      pOrder_t pOrder = pState->pOrder;
       pOrder->SetReference( sReference );
+      if ( m_journal.IsOpen() ) {
+        m_journal.Append( pOrder->GetRow() );
+      }
+      else
       if ( nullptr != m_pSession ) {
         OrderManagerQueries::UpdateReference reference( idOrder, sReference );
         ou::db::QueryFields<OrderManagerQueries::UpdateReference>::pQueryFields_t pQuery
@@ -570,6 +656,13 @@ void OrderManager::UpdateReference( idOrder_t idOrder, const std::string& sRefer
   }
 }
 
+void OrderManager::ReleaseRisk( structOrderState& state ) {
+  if ( state.bRiskReserved ) {
+    state.bRiskReserved = false;
+    if ( nullptr != OnOrderReleased ) OnOrderReleased( *state.pOrder );
+  }
+}
+
 void OrderManager::HandleRegisterTables( ou::db::Session& session ) {
   session.RegisterTable<Order::TableCreateDef>( tablenames::sOrder );
   session.RegisterTable<Execution::TableCreateDef>( tablenames::sExecution );
@@ -582,6 +675,7 @@ void OrderManager::HandleRegisterRows( ou::db::Session& session ) {
 }
 
 void OrderManager::HandlePopulateTables( ou::db::Session& session ) {
+  OpenJournal( session ); // new database, nothing to replay
 }
 
 namespace OrderManagerQueries {
@@ -592,9 +686,37 @@ namespace OrderManagerQueries {
     }
     Order::idOrder_t idOrder;
   };
+
+  struct ColumnMaxExecutionId {
+    template<typename A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "executionid", idExecution );
+    }
+    Execution::idExecution_t idExecution;
+    ColumnMaxExecutionId(): idExecution {} {}
+  };
+}
+
+void OrderManager::OpenJournal( ou::db::Session& session ) {
+  if ( !m_sJournalFileName.empty() ) {
+    m_journal.Open( &session, m_sJournalFileName ); // replays rows left from a crash, prior to the max id queries
+  }
 }
 
 void OrderManager::HandleLoadTables( ou::db::Session& session ) {
+  OpenJournal( session );
+  if ( m_journal.IsOpen() ) {
+    try {
+      ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
+        = m_pSession->SQL<ou::db::NoBind>( "select max(executionid) as executionid from executions;" ); // immediately executed
+      OrderManagerQueries::ColumnMaxExecutionId result;
+      m_pSession->Columns<ou::db::NoBind,OrderManagerQueries::ColumnMaxExecutionId>( pQuery, result );
+      m_idExecution = result.idExecution; // produces 0 when no executions present
+    }
+    catch ( const std::runtime_error& error ) {
+      std::cout << "OrderManager::HandleLoadTables: no executions found, " << error.what() << std::endl;
+    }
+  }
   try {
     ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
       = m_pSession->SQL<ou::db::NoBind>( "select max(orderid) as orderid from orders;" ); // immediately executed
@@ -619,9 +741,16 @@ void OrderManager::AttachToSession( ou::db::Session* pSession ) {
   pSession->OnRegisterRows.Add( MakeDelegate( this, &OrderManager::HandleRegisterRows ) );
   pSession->OnPopulate.Add( MakeDelegate( this, &OrderManager::HandlePopulateTables ) );
   pSession->OnLoad.Add( MakeDelegate( this, &OrderManager::HandleLoadTables ) );
+  pSession->OnDenitializeManagers.Add( MakeDelegate( this, &OrderManager::HandleDenitializeManagers ) );
+}
+
+void OrderManager::HandleDenitializeManagers( ou::db::Session& ) {
+  m_journal.Close(); // commits outstanding rows while the session is still open
 }
 
 void OrderManager::DetachFromSession( ou::db::Session* pSession ) {
+  m_journal.Close();
+  pSession->OnDenitializeManagers.Remove( MakeDelegate( this, &OrderManager::HandleDenitializeManagers ) );
   pSession->OnRegisterTables.Remove( MakeDelegate( this, &OrderManager::HandleRegisterTables ) );
   pSession->OnRegisterRows.Remove( MakeDelegate( this, &OrderManager::HandleRegisterRows ) );
   pSession->OnPopulate.Remove( MakeDelegate( this, &OrderManager::HandlePopulateTables ) );
@@ -16,10 +16,11 @@
 // 2010/09/12
 // At some point, make order manager responsible for constructing Order
 
-#include <map>
-#include <vector>
+#include <memory>
 #include <stdexcept>
 
+#include <boost/container/small_vector.hpp>
+
 #include <OUCommon/Delegate.h>
 #include <OUCommon/ManagerBase.h>
 
@@ -29,6 +30,9 @@
 #include "TradingEnumerations.h"
 #include "Order.h"
 #include "Execution.h"
+#include "OrderJournal.h"
+#include "SlabPool.h"
+#include "FlatIndex.h"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -95,33 +99,47 @@ public:
     OnOrderNeedsDetails = function;
   }
 
+  // pre-trade risk gate, see RiskManager::AttachToOrderManager
+  using OnPreTradeCheckHandler = FastDelegate2<const Order&,bool,bool>; // order, new order (vs update), returns true to pass
+  void SetOnPreTradeCheck( OnPreTradeCheckHandler function ) {
+    OnPreTradeCheck = function;
+  }
+  using OnOrderExecutedHandler = FastDelegate2<const Order&,const Execution&>;
+  void SetOnOrderExecuted( OnOrderExecutedHandler function ) {
+    OnOrderExecuted = function;
+  }
+  using OnOrderReleasedHandler = FastDelegate1<const Order&>; // cancelled or in error
+  void SetOnOrderReleased( OnOrderReleasedHandler function ) {
+    OnOrderReleased = function;
+  }
+
+  // write-behind persistence: set prior to opening the session,
+  //   order and execution rows are then committed in batches by OrderJournal rather than in the order path
+  void SetJournal( const std::string& sFileName ) { m_sJournalFileName = sFileName; }
+  void FlushJournal() { m_journal.Flush(); } // block until rows so far are in the database
+
   void AttachToSession( ou::db::Session* pSession );
   void DetachFromSession( ou::db::Session* pSession );
 
 protected:
 
-  using pairExecution_t = std::pair<idExecution_t, pExecution_t>;
-  using mapExecutions_t = std::map<idExecution_t, pExecution_t>;
-  using iterExecutions_t = mapExecutions_t::iterator;
-  using pmapExecutions_t = boost::shared_ptr<mapExecutions_t>;
+  using vExecutions_t = boost::container::small_vector<pExecution_t,2>; // in execution id order, inline for the usual one or two fills
 
   struct structOrderState {
     pOrder_t pOrder;
     ProviderInterfaceBase* pProvider;
-    pmapExecutions_t pmapExecutions;
+    vExecutions_t vExecutions;
+    bool bRiskReserved; // pre-trade check has open order/quantity outstanding
     structOrderState( pOrder_t& pOrder_ )
-      : pOrder( pOrder_ ), pProvider( 0 ), pmapExecutions( new mapExecutions_t ) {};
+      : pOrder( pOrder_ ), pProvider( 0 ), bRiskReserved( false ) {};
     structOrderState( pOrder_t& pOrder_, ProviderInterfaceBase* pProvider_ )
-      : pOrder( pOrder_ ), pProvider( pProvider_ ), pmapExecutions( new mapExecutions_t ) {};
+      : pOrder( pOrder_ ), pProvider( pProvider_ ), bRiskReserved( false ) {};
     ~structOrderState() {
-//      delete pmapExecutions;  // check that executions have been committed to db?
       // check that orders have been committed to db?
     }
   };
 
-  using pairOrderState_t = std::pair<idOrder_t, structOrderState>;
-  using mapOrders_t = std::map<idOrder_t, structOrderState>;  // used for active orders
-  using iterOrders_t = mapOrders_t::iterator;
+  using indexOrders_t = FlatIndex<idOrder_t, structOrderState>;
 
 private:
 
@@ -137,19 +155,45 @@ private:
     int GetCurrentId() { return key; };
   } m_orderIds;
 
-  mapOrders_t m_mapOrders; // all orders for when checking for consistency
+  // orders and executions come from slabs rather than the heap, see SlabPool.h for lifetimes
+  std::shared_ptr<SlabPool> m_pPoolOrder;
+  std::shared_ptr<SlabPool> m_pPoolExecution;
+
+  SlabPool m_poolOrderState; // states stay put, so a state found remains valid across callbacks creating orders
+  indexOrders_t m_indexOrders; // all orders for when checking for consistency
 
-//  iterOrders_t LocateOrder( idOrder_t nOrderId );  // in memory or from disk
-  bool LocateOrder( idOrder_t nOrderId, iterOrders_t& );  // in memory or from disk, return true if order found
+  std::string m_sJournalFileName;
+  OrderJournal m_journal;
+  idExecution_t m_idExecution; // with the journal, execution ids are assigned here rather than by the database
+
+  bool LocateOrder( idOrder_t nOrderId, structOrderState*& );  // in memory or from disk, return true if order found
+  structOrderState* AddOrderState( pOrder_t& ); // nullptr when the id is already present
 
   OnOrderNeedsDetailsHandler OnOrderNeedsDetails;
+  OnPreTradeCheckHandler OnPreTradeCheck;
+  OnOrderExecutedHandler OnOrderExecuted;
+  OnOrderReleasedHandler OnOrderReleased;
+
+  void ReleaseRisk( structOrderState& );
+
+  void OpenJournal( ou::db::Session& );
 
   bool ConstructOrder( pOrder_t& pOrder );
 
+  template<typename... Args>
+  pOrder_t MakeOrder( Args&&... args ) {
+    return std::allocate_shared<ou::tf::Order>( SlabAllocator<ou::tf::Order>( m_pPoolOrder ), std::forward<Args>( args )... );
+  }
+  template<typename... Args>
+  pExecution_t MakeExecution( Args&&... args ) {
+    return std::allocate_shared<ou::tf::Execution>( SlabAllocator<ou::tf::Execution>( m_pPoolExecution ), std::forward<Args>( args )... );
+  }
+
   void HandleRegisterTables( ou::db::Session& session );
   void HandleRegisterRows( ou::db::Session& session );
   void HandlePopulateTables( ou::db::Session& session );
   void HandleLoadTables( ou::db::Session& session );
+  void HandleDenitializeManagers( ou::db::Session& session );
 
 };
 
@@ -15,15 +15,476 @@
 
 #include "stdafx.h"
 
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include "OrderManager.h"
+
 #include "RiskManager.h"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
-RiskManager::RiskManager(void): ou::db::ManagerBase<RiskManager>() {
+namespace RiskReject {
+  const char* Name[] = {
+    "Accepted", "KillSwitch", "NotRegistered", "NoReferencePrice",
+    "OrderQuantity", "OrderNotional", "PriceBand",
+    "InstrumentPosition", "PortfolioPosition",
+    "InstrumentOpenOrders", "PortfolioOpenOrders",
+    "InstrumentMessageRate", "PortfolioMessageRate"
+  };
+}
+
+namespace {
+  const RiskManager::idSlot_t nDefaultCapacity( 1024 );
+
+  inline bool IsBuy( OrderSide::EOrderSide side ) {
+    switch ( side ) {
+      case OrderSide::Buy:
+      case OrderSide::BuyMinus:
+      case OrderSide::BuyStop:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  inline std::int64_t Now() { // coarse second for the message throttles
+    return std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::steady_clock::now().time_since_epoch() ).count();
+  }
+}
+
+const RiskManager::idInstrument_t RiskManager::sPortfolioLimits( "*portfolio*" );
+
+RiskManager::RiskManager()
+: ou::db::ManagerBase<RiskManager>()
+, m_bKillSwitch( false )
+, m_nCapacity( nDefaultCapacity ), m_nSlots( 0 )
+, m_nGrossPosition( 0 ), m_nOpenOrders( 0 )
+{
+  for ( auto& n: m_rnRejects ) n.store( 0 );
+  std::atomic_store( &m_pLimitsPortfolio, PublishLimits( TableRowDef( sPortfolioLimits ) ) );
+}
+
+RiskManager::~RiskManager() {
+  const idSlot_t nSlots( m_nSlots.load() );
+  for ( idSlot_t ix = 0; ix < nSlots; ix++ ) {
+    Slot& slot( m_rSlots[ ix ] );
+    slot.pWatch->OnQuote.Remove( MakeDelegate( &slot, &Slot::HandleQuote ) );
+    slot.pWatch->GetInstrument()->SetRiskSlot( 0 );
+  }
+}
+
+RiskManager::pLimits_t RiskManager::PublishLimits( const TableRowDef& row ) {
+  return std::make_shared<const TableRowDef>( row );
+}
+
+void RiskManager::SetCapacity( idSlot_t nSlots ) {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  if ( m_rSlots ) {
+    throw std::runtime_error( "RiskManager::SetCapacity: slots already allocated" );
+  }
+  m_nCapacity = nSlots;
+}
+
+RiskManager::idSlot_t RiskManager::RegisterInstrument( pWatch_t pWatch ) {
+
+  assert( pWatch );
+  const idInstrument_t& idInstrument( pWatch->GetInstrumentName() );
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  mapSlot_t::const_iterator iterSlot = m_mapSlot.find( idInstrument );
+  if ( m_mapSlot.end() != iterSlot ) {
+    return iterSlot->second;
+  }
+
+  if ( !m_rSlots ) {
+    m_rSlots.reset( new Slot[ m_nCapacity ] );
+  }
+
+  const idSlot_t ix( m_nSlots.load( std::memory_order_relaxed ) );
+  if ( m_nCapacity <= ix ) {
+    throw std::runtime_error( "RiskManager::RegisterInstrument: slot capacity exceeded" );
+  }
+
+  Slot& slot( m_rSlots[ ix ] );
+  slot.pWatch = pWatch;
+  slot.pInstrument = pWatch->GetInstrument().get();
+  slot.dblMultiplier = pWatch->GetInstrument()->GetMultiplier();
+
+  mapLimits_t::const_iterator iterLimits = m_mapLimits.find( idInstrument );
+  std::atomic_store(
+    &slot.pLimits,
+    PublishLimits( ( m_mapLimits.end() != iterLimits ) ? iterLimits->second : TableRowDef( idInstrument ) ) );
+
+  const Quote& quote( pWatch->LastQuote() );
+  slot.dblBid.store( quote.Bid(), std::memory_order_relaxed );
+  slot.dblAsk.store( quote.Ask(), std::memory_order_relaxed );
+  pWatch->OnQuote.Add( MakeDelegate( &slot, &Slot::HandleQuote ) );
+
+  m_mapSlot.emplace( idInstrument, ix );
+  m_nSlots.store( ix + 1, std::memory_order_release );
+  pWatch->GetInstrument()->SetRiskSlot( ix + 1 ); // published last, the slot is complete when seen by Check
+
+  return ix;
+}
+
+bool RiskManager::LocateSlotByName( const idInstrument_t& idInstrument, idSlot_t& ix ) const {
+  mapSlot_t::const_iterator iter = m_mapSlot.find( idInstrument );
+  if ( m_mapSlot.end() == iter ) return false;
+  ix = iter->second;
+  return true;
+}
+
+bool RiskManager::LocateSlot( const idInstrument_t& idInstrument, idSlot_t& ix ) const {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  return LocateSlotByName( idInstrument, ix );
+}
+
+RiskManager::Slot* RiskManager::LocateSlot( const Order& order ) const {
+  const Instrument* pInstrument( order.GetInstrument().get() );
+  const idSlot_t nSlot( pInstrument->GetRiskSlot() );
+  if ( ( 0 == nSlot ) || ( m_nSlots.load( std::memory_order_acquire ) < nSlot ) ) return nullptr;
+  Slot* pSlot( &m_rSlots[ nSlot - 1 ] );
+  return ( pInstrument == pSlot->pInstrument ) ? pSlot : nullptr;
+}
+
+void RiskManager::SetLimits( const TableRowDef& row ) {
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( sPortfolioLimits == row.idInstrument ) {
+      std::atomic_store( &m_pLimitsPortfolio, PublishLimits( row ) );
+    }
+    else {
+      idSlot_t ix;
+      if ( LocateSlotByName( row.idInstrument, ix ) ) {
+        std::atomic_store( &m_rSlots[ ix ].pLimits, PublishLimits( row ) );
+      }
+    }
+    m_mapLimits[ row.idInstrument ] = row;
+  }
+  PersistLimits( row );
+}
+
+RiskManager::TableRowDef RiskManager::GetLimits( const idInstrument_t& idInstrument ) const {
+  std::lock_guard<std::mutex> lock( m_mutex );
+  if ( sPortfolioLimits == idInstrument ) {
+    return *std::atomic_load( &m_pLimitsPortfolio );
+  }
+  idSlot_t ix;
+  if ( LocateSlotByName( idInstrument, ix ) ) {
+    return *std::atomic_load( &m_rSlots[ ix ].pLimits );
+  }
+  mapLimits_t::const_iterator iter = m_mapLimits.find( idInstrument );
+  return ( m_mapLimits.end() != iter ) ? iter->second : TableRowDef( idInstrument );
+}
+
+std::int64_t RiskManager::GetPosition( idSlot_t ix ) const {
+  assert( ix < m_nSlots.load( std::memory_order_acquire ) );
+  return m_rSlots[ ix ].nPosition.load( std::memory_order_relaxed );
+}
+
+std::uint32_t RiskManager::GetOpenOrders( idSlot_t ix ) const {
+  assert( ix < m_nSlots.load( std::memory_order_acquire ) );
+  return m_rSlots[ ix ].nOpenOrders.load( std::memory_order_relaxed );
+}
+
+RiskReject::EReject RiskManager::RecordReject( const Order& order, RiskReject::EReject eReject, double dblValue, double dblLimit ) {
+  m_rnRejects[ eReject ].fetch_add( 1, std::memory_order_relaxed );
+  OnReject( Reject( order.GetRow().idOrder, order.GetRow().idInstrument, eReject, dblValue, dblLimit ) );
+  return eReject;
+}
+
+RiskReject::EReject RiskManager::Check( const Order& order, bool bNewOrder ) {
+
+  if ( m_bKillSwitch.load( std::memory_order_acquire ) ) {
+    return RecordReject( order, RiskReject::KillSwitch, 0.0, 0.0 );
+  }
+
+  const Order::TableRowDef& row( order.GetRow() );
+
+  Slot* pSlot( LocateSlot( order ) );
+  if ( nullptr == pSlot ) {
+    return RecordReject( order, RiskReject::NotRegistered, 0.0, 0.0 );
+  }
+  Slot& slot( *pSlot );
+  const pLimits_t pLimits( std::atomic_load( &slot.pLimits ) ); // held for the check
+  const pLimits_t pPortfolio( std::atomic_load( &m_pLimitsPortfolio ) );
+  const TableRowDef& limits( *pLimits );
+  const TableRowDef& portfolio( *pPortfolio );
+
+  const bool bBuy( IsBuy( row.eOrderSide ) );
+  const std::int64_t nQuantity( bNewOrder ? row.nOrderQuantity : row.nQuantityRemaining );
+
+  const std::uint32_t nMaxOrderQuantity( limits.nMaxOrderQuantity );
+  if ( ( 0 != nMaxOrderQuantity ) && ( nMaxOrderQuantity < nQuantity ) ) {
+    return RecordReject( order, RiskReject::OrderQuantity, nQuantity, nMaxOrderQuantity );
+  }
+  const std::uint32_t nPortfolioMaxOrderQuantity( portfolio.nMaxOrderQuantity );
+  if ( ( 0 != nPortfolioMaxOrderQuantity ) && ( nPortfolioMaxOrderQuantity < nQuantity ) ) {
+    return RecordReject( order, RiskReject::OrderQuantity, nQuantity, nPortfolioMaxOrderQuantity );
+  }
+
+  // reference price from the most recent quote
+  const double dblBid( slot.dblBid.load( std::memory_order_relaxed ) );
+  const double dblAsk( slot.dblAsk.load( std::memory_order_relaxed ) );
+  const double dblMid( ( ( 0.0 < dblBid ) && ( 0.0 < dblAsk ) ) ? ( dblBid + dblAsk ) / 2.0 : 0.0 );
+
+  double dblPrice {};
+  switch ( row.eOrderType ) {
+    case OrderType::Market:
+    case OrderType::MarketClose:
+      dblPrice = bBuy ? dblAsk : dblBid;
+      break;
+    default:
+      dblPrice = row.dblPrice1;
+      {
+        const double dblBand( limits.dblPriceBand );
+        if ( ( 0.0 < dblBand ) && ( 0.0 < dblPrice ) ) {
+          if ( 0.0 == dblMid ) {
+            return RecordReject( order, RiskReject::NoReferencePrice, dblPrice, 0.0 );
+          }
+          const double dblDeviation( std::abs( dblPrice - dblMid ) / dblMid );
+          if ( dblBand < dblDeviation ) {
+            return RecordReject( order, RiskReject::PriceBand, dblDeviation, dblBand );
+          }
+        }
+      }
+      break;
+  }
+
+  const double dblMaxNotional( limits.dblMaxOrderNotional );
+  const double dblPortfolioMaxNotional( portfolio.dblMaxOrderNotional );
+  if ( ( 0.0 < dblMaxNotional ) || ( 0.0 < dblPortfolioMaxNotional ) ) {
+    if ( 0.0 >= dblPrice ) {
+      return RecordReject( order, RiskReject::NoReferencePrice, 0.0, 0.0 );
+    }
+    const double dblNotional( nQuantity * dblPrice * slot.dblMultiplier );
+    if ( ( 0.0 < dblMaxNotional ) && ( dblMaxNotional < dblNotional ) ) {
+      return RecordReject( order, RiskReject::OrderNotional, dblNotional, dblMaxNotional );
+    }
+    if ( ( 0.0 < dblPortfolioMaxNotional ) && ( dblPortfolioMaxNotional < dblNotional ) ) {
+      return RecordReject( order, RiskReject::OrderNotional, dblNotional, dblPortfolioMaxNotional );
+    }
+  }
+
+  if ( bNewOrder ) {
+    // worst case exposure assumes all open orders on the same side fill
+    const std::int64_t nMaxPosition( limits.nMaxPosition );
+    if ( 0 != nMaxPosition ) {
+      const std::int64_t nPosition( slot.nPosition.load( std::memory_order_relaxed ) );
+      const std::int64_t nExposure( bBuy
+        ? nPosition + slot.nOpenBuy.load( std::memory_order_relaxed ) + nQuantity
+        : nPosition - slot.nOpenSell.load( std::memory_order_relaxed ) - nQuantity );
+      if ( nMaxPosition < std::abs( nExposure ) ) {
+        return RecordReject( order, RiskReject::InstrumentPosition, nExposure, nMaxPosition );
+      }
+    }
+    const std::int64_t nPortfolioMaxPosition( portfolio.nMaxPosition );
+    if ( 0 != nPortfolioMaxPosition ) {
+      const std::int64_t nGross( m_nGrossPosition.load( std::memory_order_relaxed ) + nQuantity );
+      if ( nPortfolioMaxPosition < nGross ) {
+        return RecordReject( order, RiskReject::PortfolioPosition, nGross, nPortfolioMaxPosition );
+      }
+    }
+  }
+
+  if ( bNewOrder ) {
+    // reserve, and back out if a concurrent check took the last one
+    const std::uint32_t nMaxOpenOrders( limits.nMaxOpenOrders );
+    const std::uint32_t nOpenOrders( 1 + slot.nOpenOrders.fetch_add( 1, std::memory_order_acq_rel ) );
+    if ( ( 0 != nMaxOpenOrders ) && ( nMaxOpenOrders < nOpenOrders ) ) {
+      slot.nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+      return RecordReject( order, RiskReject::InstrumentOpenOrders, nOpenOrders, nMaxOpenOrders );
+    }
+    const std::uint32_t nPortfolioMaxOpenOrders( portfolio.nMaxOpenOrders );
+    const std::uint32_t nPortfolioOpenOrders( 1 + m_nOpenOrders.fetch_add( 1, std::memory_order_acq_rel ) );
+    if ( ( 0 != nPortfolioMaxOpenOrders ) && ( nPortfolioMaxOpenOrders < nPortfolioOpenOrders ) ) {
+      m_nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+      slot.nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+      return RecordReject( order, RiskReject::PortfolioOpenOrders, nPortfolioOpenOrders, nPortfolioMaxOpenOrders );
+    }
+  }
+
+  // the message budget is taken last, so an order refused by another limit does not use it up
+  const std::int64_t nNow( Now() );
+  const std::uint32_t nMaxRate( limits.nMaxMessagesPerSecond );
+  const std::uint32_t nPortfolioMaxRate( portfolio.nMaxMessagesPerSecond );
+  RiskReject::EReject eReject( RiskReject::Accepted );
+  double dblValue {};
+  double dblLimit {};
+  if ( !slot.throttle.Admit( nNow, nMaxRate ) ) {
+    eReject = RiskReject::InstrumentMessageRate;
+    dblValue = nMaxRate + 1;
+    dblLimit = nMaxRate;
+  }
+  else {
+    if ( !m_throttle.Admit( nNow, nPortfolioMaxRate ) ) {
+      eReject = RiskReject::PortfolioMessageRate;
+      dblValue = nPortfolioMaxRate + 1;
+      dblLimit = nPortfolioMaxRate;
+    }
+  }
+  if ( RiskReject::Accepted != eReject ) {
+    if ( bNewOrder ) { // release the open order reservation
+      m_nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+      slot.nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+    }
+    return RecordReject( order, eReject, dblValue, dblLimit );
+  }
+
+  if ( bNewOrder ) {
+    if ( bBuy ) slot.nOpenBuy.fetch_add( nQuantity, std::memory_order_relaxed );
+    else        slot.nOpenSell.fetch_add( nQuantity, std::memory_order_relaxed );
+  }
+
+  return RiskReject::Accepted;
+}
+
+void RiskManager::UpdatePosition( Slot& slot, std::int64_t nDelta ) {
+  const std::int64_t nOld( slot.nPosition.fetch_add( nDelta, std::memory_order_acq_rel ) );
+  const std::int64_t nNew( nOld + nDelta );
+  m_nGrossPosition.fetch_add( std::abs( nNew ) - std::abs( nOld ), std::memory_order_relaxed );
+}
+
+// called after Order::ReportExecution has updated the order
+void RiskManager::HandleOrderExecuted( const Order& order, const Execution& exec ) {
+  const Order::TableRowDef& row( order.GetRow() );
+  Slot* pSlot( LocateSlot( order ) );
+  if ( nullptr != pSlot ) {
+    Slot& slot( *pSlot );
+    const std::int64_t nQuantity( exec.GetSize() );
+    if ( IsBuy( row.eOrderSide ) ) {
+      slot.nOpenBuy.fetch_sub( nQuantity, std::memory_order_relaxed );
+      UpdatePosition( slot, nQuantity );
+    }
+    else {
+      slot.nOpenSell.fetch_sub( nQuantity, std::memory_order_relaxed );
+      UpdatePosition( slot, -nQuantity );
+    }
+    switch ( row.eOrderStatus ) {
+      case OrderStatus::Filled:
+      case OrderStatus::OverFilled:
+      case OrderStatus::CancelledWithPartialFill:
+        slot.nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+        m_nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// called once an order is finished without (further) fills
+void RiskManager::HandleOrderReleased( const Order& order ) {
+  const Order::TableRowDef& row( order.GetRow() );
+  Slot* pSlot( LocateSlot( order ) );
+  if ( nullptr != pSlot ) {
+    Slot& slot( *pSlot );
+    const std::int64_t nRemaining( row.nQuantityRemaining );
+    if ( IsBuy( row.eOrderSide ) ) slot.nOpenBuy.fetch_sub( nRemaining, std::memory_order_relaxed );
+    else                           slot.nOpenSell.fetch_sub( nRemaining, std::memory_order_relaxed );
+    slot.nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+    m_nOpenOrders.fetch_sub( 1, std::memory_order_acq_rel );
+  }
+}
+
+void RiskManager::AttachToOrderManager( OrderManager& om ) {
+  om.SetOnPreTradeCheck( MakeDelegate( this, &RiskManager::HandlePreTradeCheck ) );
+  om.SetOnOrderExecuted( MakeDelegate( this, &RiskManager::HandleOrderExecuted ) );
+  om.SetOnOrderReleased( MakeDelegate( this, &RiskManager::HandleOrderReleased ) );
+}
+
+void RiskManager::DetachFromOrderManager( OrderManager& om ) {
+  om.SetOnPreTradeCheck( nullptr );
+  om.SetOnOrderExecuted( nullptr );
+  om.SetOnOrderReleased( nullptr );
+}
+
+namespace RiskManagerQueries {
+  struct LimitsKey {
+    template<class A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "instrumentid", idInstrument );
+    }
+    const RiskManager::idInstrument_t& idInstrument;
+    LimitsKey( const RiskManager::idInstrument_t& idInstrument_ ): idInstrument( idInstrument_ ) {}
+  };
+}
+
+void RiskManager::PersistLimits( const TableRowDef& row ) {
+  if ( nullptr != m_pSession ) {
+    try {
+      RiskManagerQueries::LimitsKey key( row.idInstrument );
+      ou::db::QueryFields<RiskManagerQueries::LimitsKey>::pQueryFields_t pQueryDelete
+        = m_pSession->SQL<RiskManagerQueries::LimitsKey>( "delete from " + tablenames::sRiskLimits, key ).Where( "instrumentid=?" );
+      ou::db::QueryFields<TableRowDef>::pQueryFields_t pQueryInsert
+        = m_pSession->Insert<TableRowDef>( const_cast<TableRowDef&>( row ) );
+    }
+    catch ( const std::runtime_error& error ) {
+      std::cout << "RiskManager::PersistLimits: " << row.idInstrument << ", " << error.what() << std::endl;
+    }
+  }
+}
+
+void RiskManager::HandleRegisterTables( ou::db::Session& session ) {
+  session.RegisterTable<TableCreateDef>( tablenames::sRiskLimits );
+}
+
+void RiskManager::HandleRegisterRows( ou::db::Session& session ) {
+  session.MapRowDefToTableName<TableRowDef>( tablenames::sRiskLimits );
+}
+
+void RiskManager::HandlePopulateTables( ou::db::Session& ) {
+}
+
+void RiskManager::HandleLoadTables( ou::db::Session& session ) {
+  try {
+    ou::db::QueryFields<ou::db::NoBind>::pQueryFields_t pQuery
+      = session.SQL<ou::db::NoBind>( "select * from " + tablenames::sRiskLimits ).NoExecute();
+    while ( session.Execute( pQuery ) ) {
+      TableRowDef row;
+      session.Columns<ou::db::NoBind, TableRowDef>( pQuery, row );
+      std::lock_guard<std::mutex> lock( m_mutex );
+      if ( sPortfolioLimits == row.idInstrument ) {
+        std::atomic_store( &m_pLimitsPortfolio, PublishLimits( row ) );
+      }
+      else {
+        idSlot_t ix;
+        if ( LocateSlotByName( row.idInstrument, ix ) ) {
+          std::atomic_store( &m_rSlots[ ix ].pLimits, PublishLimits( row ) );
+        }
+      }
+      m_mapLimits[ row.idInstrument ] = row;
+    }
+  }
+  catch ( const std::runtime_error& error ) {
+    // databases created prior to the risk table
+    std::cout << "RiskManager::HandleLoadTables: creating " << tablenames::sRiskLimits << ", " << error.what() << std::endl;
+    session.RegisterTable<TableCreateDef>( tablenames::sRiskLimits );
+    session.CreateTables();
+  }
+}
+
+// this stuff could probably be rolled into Session with a template
+void RiskManager::AttachToSession( ou::db::Session* pSession ) {
+  ManagerBase::AttachToSession( pSession );
+  pSession->OnRegisterTables.Add( MakeDelegate( this, &RiskManager::HandleRegisterTables ) );
+  pSession->OnRegisterRows.Add( MakeDelegate( this, &RiskManager::HandleRegisterRows ) );
+  pSession->OnPopulate.Add( MakeDelegate( this, &RiskManager::HandlePopulateTables ) );
+  pSession->OnLoad.Add( MakeDelegate( this, &RiskManager::HandleLoadTables ) );
 }
 
-RiskManager::~RiskManager(void) {
+void RiskManager::DetachFromSession( ou::db::Session* pSession ) {
+  pSession->OnRegisterTables.Remove( MakeDelegate( this, &RiskManager::HandleRegisterTables ) );
+  pSession->OnRegisterRows.Remove( MakeDelegate( this, &RiskManager::HandleRegisterRows ) );
+  pSession->OnPopulate.Remove( MakeDelegate( this, &RiskManager::HandlePopulateTables ) );
+  pSession->OnLoad.Remove( MakeDelegate( this, &RiskManager::HandleLoadTables ) );
+  ManagerBase::DetachFromSession( pSession );
 }
 
 } // namespace tf
@@ -13,19 +13,228 @@
 
 // Started 20130407
 
+// pre-trade risk gate, sits between OrderManager::PlaceOrder and the provider
+//   limits are held per instrument 'slot' and for the portfolio as a whole
+//   slots are pre-allocated, the slot index is stored in the Instrument at registration,
+//     so Check is array indexing and atomics, with no lookup by name and no lock of its own
+//   limits are immutable shared snapshots, a change publishes a new one with std::atomic_store,
+//     a check holds a reference for its duration, so a replaced snapshot is freed by its last reader
+//   registration and limit changes are serialized by a mutex, which Check does not take
+//   RegisterInstrument is expected to be called before orders flow for the instrument
+
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <OUCommon/Delegate.h>
 #include <OUCommon/ManagerBase.h>
 
+#include <OUSQL/Functions.h>
+
+#include "KeyTypes.h"
+#include "Order.h"
+#include "Execution.h"
+#include "Watch.h"
+
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
+class OrderManager;
+
+namespace RiskReject {
+  enum EReject {
+    Accepted=0, KillSwitch, NotRegistered, NoReferencePrice,
+    OrderQuantity, OrderNotional, PriceBand,
+    InstrumentPosition, PortfolioPosition,
+    InstrumentOpenOrders, PortfolioOpenOrders,
+    InstrumentMessageRate, PortfolioMessageRate,
+    _Count };
+  extern const char* Name[];
+}
+
 class RiskManager: public ou::db::ManagerBase<RiskManager> {
 public:
-  RiskManager(void);
-  ~RiskManager(void);
+
+  using idInstrument_t = keytypes::idInstrument_t;
+  using idOrder_t = keytypes::idOrder_t;
+  using pWatch_t = Watch::pWatch_t;
+  using idSlot_t = std::uint32_t;
+
+  static const idInstrument_t sPortfolioLimits; // instrumentid used for the portfolio-wide row
+
+  // a value of zero disables the particular check
+  struct TableRowDef {
+    template<class A>
+    void Fields( A& a ) {
+      ou::db::Field( a, "instrumentid", idInstrument );
+      ou::db::Field( a, "maxorderquantity", nMaxOrderQuantity );
+      ou::db::Field( a, "maxordernotional", dblMaxOrderNotional );
+      ou::db::Field( a, "maxposition", nMaxPosition ); // portfolio row: gross quantity across instruments
+      ou::db::Field( a, "maxopenorders", nMaxOpenOrders );
+      ou::db::Field( a, "priceband", dblPriceBand ); // fraction away from quote midpoint, ie 0.05 is 5%
+      ou::db::Field( a, "maxmessagespersecond", nMaxMessagesPerSecond );
+    }
+
+    idInstrument_t idInstrument;
+    std::uint32_t nMaxOrderQuantity;
+    double dblMaxOrderNotional;
+    std::int64_t nMaxPosition;
+    std::uint32_t nMaxOpenOrders;
+    double dblPriceBand;
+    std::uint32_t nMaxMessagesPerSecond;
+
+    TableRowDef()
+    : nMaxOrderQuantity {}, dblMaxOrderNotional {}, nMaxPosition {}
+    , nMaxOpenOrders {}, dblPriceBand {}, nMaxMessagesPerSecond {} {}
+    TableRowDef( const idInstrument_t& idInstrument_ )
+    : idInstrument( idInstrument_ )
+    , nMaxOrderQuantity {}, dblMaxOrderNotional {}, nMaxPosition {}
+    , nMaxOpenOrders {}, dblPriceBand {}, nMaxMessagesPerSecond {} {}
+  };
+
+  struct TableCreateDef: TableRowDef {
+    template<class A>
+    void Fields( A& a ) {
+      TableRowDef::Fields( a );
+      ou::db::Key( a, "instrumentid" );
+    }
+  };
+
+  struct Reject {
+    idOrder_t idOrder;
+    const idInstrument_t& idInstrument;
+    RiskReject::EReject eReject;
+    double dblValue;  // value which tripped the check
+    double dblLimit;  // the limit in force
+    Reject( idOrder_t idOrder_, const idInstrument_t& idInstrument_, RiskReject::EReject eReject_, double dblValue_, double dblLimit_ )
+    : idOrder( idOrder_ ), idInstrument( idInstrument_ ), eReject( eReject_ ), dblValue( dblValue_ ), dblLimit( dblLimit_ ) {}
+  };
+
+  RiskManager();
+  virtual ~RiskManager();
+
+  void SetCapacity( idSlot_t nSlots ); // only prior to first RegisterInstrument
+
+  idSlot_t RegisterInstrument( pWatch_t ); // quote updates maintain the price band reference
+  bool LocateSlot( const idInstrument_t&, idSlot_t& ) const;
+
+  void SetLimits( const TableRowDef& ); // persisted when attached to a session
+  TableRowDef GetLimits( const idInstrument_t& ) const;
+
+  void SetKillSwitch( bool bActive ) { m_bKillSwitch.store( bActive, std::memory_order_release ); }
+  bool IsKillSwitchActive() const { return m_bKillSwitch.load( std::memory_order_acquire ); }
+
+  // bNewOrder: reserves open order & quantity on acceptance, otherwise is a price update
+  RiskReject::EReject Check( const Order&, bool bNewOrder );
+  bool HandlePreTradeCheck( const Order& order, bool bNewOrder ) { return RiskReject::Accepted == Check( order, bNewOrder ); }
+  void HandleOrderExecuted( const Order&, const Execution& );
+  void HandleOrderReleased( const Order& ); // cancelled or in error
+
+  std::int64_t GetPosition( idSlot_t ) const;
+  std::uint32_t GetOpenOrders( idSlot_t ) const;
+  std::uint64_t GetRejectCount( RiskReject::EReject eReject ) const { return m_rnRejects[ eReject ].load( std::memory_order_relaxed ); }
+
+  ou::Delegate<const Reject&> OnReject;
+
+  void AttachToOrderManager( OrderManager& );
+  void DetachFromOrderManager( OrderManager& );
+
+  void AttachToSession( ou::db::Session* pSession );
+  void DetachFromSession( ou::db::Session* pSession );
+
 protected:
 private:
+
+  struct Throttle { // one second window
+    // window ( low 32 bits of the second ) in the upper half, count in the lower half,
+    //   so a new window and its count are installed together
+    std::atomic<std::uint64_t> nState;
+    Throttle(): nState {} {}
+    bool Admit( std::int64_t nNow, std::uint32_t nMax ) {
+      if ( 0 == nMax ) return true;
+      const std::uint32_t nWindow( nNow );
+      std::uint64_t nCurrent = nState.load( std::memory_order_relaxed );
+      std::uint64_t nNext;
+      do {
+        std::uint32_t nWindowCurrent( nCurrent >> 32 );
+        std::uint32_t nCount( nCurrent );
+        if ( 0 < std::int32_t( nWindow - nWindowCurrent ) ) { // a later second, the count restarts
+          nWindowCurrent = nWindow;
+          nCount = 0;
+        } // a check which read the clock before the window moved counts against the current window
+        if ( nMax <= nCount ) return false;
+        nNext = ( std::uint64_t( nWindowCurrent ) << 32 ) | ( nCount + 1 );
+      } while ( !nState.compare_exchange_weak( nCurrent, nNext, std::memory_order_relaxed ) );
+      return true;
+    }
+  };
+
+  using pLimits_t = std::shared_ptr<const TableRowDef>;
+
+  struct alignas( 64 ) Slot {
+    pWatch_t pWatch;
+    const Instrument* pInstrument; // confirms the index stored in the instrument is for this manager
+    double dblMultiplier;
+    pLimits_t pLimits; // by std::atomic_load/std::atomic_store
+    std::atomic<double> dblBid;
+    std::atomic<double> dblAsk;
+    std::atomic<std::int64_t> nPosition;
+    std::atomic<std::int64_t> nOpenBuy;
+    std::atomic<std::int64_t> nOpenSell;
+    std::atomic<std::uint32_t> nOpenOrders;
+    Throttle throttle;
+    Slot()
+    : pInstrument( nullptr ), dblMultiplier( 1.0 ), dblBid {}, dblAsk {}
+    , nPosition {}, nOpenBuy {}, nOpenSell {}, nOpenOrders {} {}
+    void HandleQuote( const Quote& quote ) {
+      dblBid.store( quote.Bid(), std::memory_order_relaxed );
+      dblAsk.store( quote.Ask(), std::memory_order_relaxed );
+    }
+  };
+
+  std::atomic<bool> m_bKillSwitch;
+
+  mutable std::mutex m_mutex; // RegisterInstrument, limits, and the maps
+
+  idSlot_t m_nCapacity;
+  std::atomic<idSlot_t> m_nSlots;
+  std::unique_ptr<Slot[]> m_rSlots;
+
+  using mapSlot_t = std::unordered_map<idInstrument_t, idSlot_t>;
+  mapSlot_t m_mapSlot;
+
+  // limits loaded from, or set prior to, instrument registration
+  using mapLimits_t = std::unordered_map<idInstrument_t, TableRowDef>;
+  mapLimits_t m_mapLimits;
+
+  pLimits_t m_pLimitsPortfolio; // by std::atomic_load/std::atomic_store
+  std::atomic<std::int64_t> m_nGrossPosition;
+  std::atomic<std::uint32_t> m_nOpenOrders;
+  Throttle m_throttle;
+
+  std::array<std::atomic<std::uint64_t>, RiskReject::_Count> m_rnRejects;
+
+  static pLimits_t PublishLimits( const TableRowDef& );
+  bool LocateSlotByName( const idInstrument_t&, idSlot_t& ) const; // with m_mutex held
+  Slot* LocateSlot( const Order& ) const; // from the index in the instrument
+
+  RiskReject::EReject RecordReject( const Order&, RiskReject::EReject, double dblValue, double dblLimit );
+
+  void UpdatePosition( Slot&, std::int64_t nDelta );
+  void PersistLimits( const TableRowDef& );
+
+  void HandleRegisterTables( ou::db::Session& session );
+  void HandleRegisterRows( ou::db::Session& session );
+  void HandlePopulateTables( ou::db::Session& session );
+  void HandleLoadTables( ou::db::Session& session );
+
 };
 
 } // namespace tf
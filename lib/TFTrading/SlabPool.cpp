@@ -0,0 +1,84 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+#include <new>
+#include <cassert>
+
+#include "SlabPool.h"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+SlabPool::SlabPool( size_t nBlocksPerSlab )
+: m_nBlockSize {}, m_nBlockAlign {}
+, m_nBlocksPerSlab( nBlocksPerSlab )
+, m_pFree( nullptr )
+, m_pCarve( nullptr ), m_pCarveEnd( nullptr )
+{
+  assert( 0 < m_nBlocksPerSlab );
+}
+
+SlabPool::~SlabPool() {
+  for ( void* pSlab: m_vSlab ) {
+    ::operator delete( pSlab );
+  }
+}
+
+void* SlabPool::Allocate( size_t nBytes, size_t nAlign ) {
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( 0 == m_nBlockSize ) {
+      if ( ( sizeof( Free ) <= nBytes ) && ( 0 == nBytes % nAlign ) && ( alignof( std::max_align_t ) >= nAlign ) ) {
+        m_nBlockSize = nBytes; // a multiple of the alignment, so consecutive blocks stay aligned
+        m_nBlockAlign = nAlign;
+      }
+    }
+    if ( Pooled( nBytes, nAlign ) ) {
+      if ( nullptr != m_pFree ) {
+        Free* pBlock( m_pFree );
+        m_pFree = pBlock->pNext;
+        return pBlock;
+      }
+      if ( m_pCarve == m_pCarveEnd ) Grow();
+      void* pBlock( m_pCarve );
+      m_pCarve += m_nBlockSize;
+      return pBlock;
+    }
+  }
+  return ::operator new( nBytes );
+}
+
+void SlabPool::Deallocate( void* p, size_t nBytes, size_t nAlign ) {
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if ( Pooled( nBytes, nAlign ) ) {
+      Free* pBlock( static_cast<Free*>( p ) );
+      pBlock->pNext = m_pFree;
+      m_pFree = pBlock;
+      return;
+    }
+  }
+  ::operator delete( p );
+}
+
+void SlabPool::Grow() { // with the lock held
+  // blocks are carved as needed rather than threaded on the free list here,
+  //   which would touch every page of the slab in the one allocation
+  m_pCarve = static_cast<char*>( ::operator new( m_nBlockSize * m_nBlocksPerSlab ) );
+  m_pCarveEnd = m_pCarve + m_nBlockSize * m_nBlocksPerSlab;
+  m_vSlab.push_back( m_pCarve );
+}
+
+} // namespace tf
+} // namespace ou
@@ -0,0 +1,100 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+// fixed size blocks carved from slabs, returned blocks are recycled through a free list ahead of carving
+//   the block size is taken from the first allocation:  allocate_shared rebinds the allocator
+//     to its combined control block and object, so the size is only known at that point,
+//     any other size or alignment is passed on to the global heap
+//   slabs are released only when the pool is destroyed
+//   a mutex guards the free list, as a shared_ptr may be released on a provider thread
+//
+// SlabAllocator holds the pool by shared_ptr, and a copy of the allocator lives in each control block,
+//   so the pool outlives the last object handed out, even when that is after its owner has gone
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+
+class SlabPool {
+public:
+
+  SlabPool( size_t nBlocksPerSlab = 256 );
+  ~SlabPool();
+
+  void* Allocate( size_t nBytes, size_t nAlign );
+  void Deallocate( void*, size_t nBytes, size_t nAlign );
+
+  size_t BlockSize() const { return m_nBlockSize; } // 0 until the first allocation
+  size_t Slabs() const { return m_vSlab.size(); }
+
+protected:
+private:
+
+  struct Free {
+    Free* pNext;
+  };
+
+  std::mutex m_mutex;
+
+  size_t m_nBlockSize;
+  size_t m_nBlockAlign;
+  const size_t m_nBlocksPerSlab;
+
+  Free* m_pFree;
+  char* m_pCarve; // unused remainder of the newest slab
+  char* m_pCarveEnd;
+  std::vector<void*> m_vSlab;
+
+  bool Pooled( size_t nBytes, size_t nAlign ) const {
+    return ( nBytes == m_nBlockSize ) && ( nAlign == m_nBlockAlign );
+  }
+
+  void Grow();
+};
+
+template<typename T>
+class SlabAllocator {
+  template<typename U> friend class SlabAllocator;
+public:
+
+  using value_type = T;
+
+  SlabAllocator( std::shared_ptr<SlabPool> pPool ): m_pPool( std::move( pPool ) ) {}
+  template<typename U>
+  SlabAllocator( const SlabAllocator<U>& rhs ): m_pPool( rhs.m_pPool ) {}
+
+  T* allocate( size_t n ) {
+    return static_cast<T*>( m_pPool->Allocate( n * sizeof( T ), alignof( T ) ) );
+  }
+  void deallocate( T* p, size_t n ) {
+    m_pPool->Deallocate( p, n * sizeof( T ), alignof( T ) );
+  }
+
+  template<typename U>
+  bool operator==( const SlabAllocator<U>& rhs ) const { return m_pPool == rhs.m_pPool; }
+  template<typename U>
+  bool operator!=( const SlabAllocator<U>& rhs ) const { return m_pPool != rhs.m_pPool; }
+
+private:
+  std::shared_ptr<SlabPool> m_pPool;
+};
+
+} // namespace tf
+} // namespace ou
@@ -66,12 +66,16 @@ void GridOptionChain::CreateControls() {
 
   //Bind( EVENT_DRAW_CHART, &WinChartView::HandleGuiDrawChart, this );
 
+  m_pimpl->CreateControls();
+
   // this GuiRefresh initialization should come after all else
-  //m_timerGuiRefresh.SetOwner( this );
-  //Bind( wxEVT_TIMER, &GridOptionDetails::HandleGuiRefresh, this, m_timerGuiRefresh.GetId() );
-  //m_timerGuiRefresh.Start( 250 );
+  m_timerGuiRefresh.SetOwner( this );
+  Bind( wxEVT_TIMER, &GridOptionChain::HandleGuiRefresh, this, m_timerGuiRefresh.GetId() );
+  m_timerGuiRefresh.Start( 250 );
+}
 
-  m_pimpl->CreateControls();
+void GridOptionChain::HandleGuiRefresh( wxTimerEvent& event ) {
+  m_pimpl->RefreshDirty();
 }
 
 void GridOptionChain::Set(
@@ -112,6 +116,10 @@ void GridOptionChain::Refresh() {
   m_pimpl->Refresh();
 }
 
+const grid::Stats& GridOptionChain::GetRefreshStats() const {
+  return m_pimpl->GetRefreshStats();
+}
+
 void GridOptionChain::Add( double strike, ou::tf::OptionSide::EOptionSide side, const std::string& sSymbol ) {
   m_pimpl->Add( strike, side, sSymbol );
 }
@@ -144,8 +152,8 @@ void GridOptionChain::PreDestroy() {
 
 void GridOptionChain::OnDestroy( wxWindowDestroyEvent& event ) {
 
-  //m_timerGuiRefresh.Stop();
-  //Unbind( wxEVT_TIMER, &WinChartView::HandleGuiRefresh, this, m_timerGuiRefresh.GetId() );
+  m_timerGuiRefresh.Stop();
+  Unbind( wxEVT_TIMER, &GridOptionChain::HandleGuiRefresh, this, m_timerGuiRefresh.GetId() );
 
   //m_pimpl->StopWatch();
   m_pimpl->DestroyControls();
@@ -18,10 +18,12 @@
 #include <functional>
 
 #include <wx/grid.h>
+#include <wx/timer.h>
 
 #include <TFOptions/Option.h>
 #include <TFOptions/OptionDelegates.hpp>
 
+#include <TFVuTrading/GridRefresh.hpp>
 #include <TFVuTrading/GridColumnSizer.h>
 #include <TFVuTrading/DragDropInstrument.h>
 
@@ -68,7 +70,9 @@ public:
 
   void Clear(  double strike );
 
-  void Refresh();
+  void Refresh(); // full repaint, visible changed cells are otherwise repainted by the refresh timer
+
+  const grid::Stats& GetRefreshStats() const; // frame time, cells painted, dropped updates
 
   void SaveColumnSizes( ou::tf::GridColumnSizer& ) const;
   void SetColumnSizes( ou::tf::GridColumnSizer& );
@@ -105,6 +109,8 @@ private:
 
   std::unique_ptr<GridOptionChain_impl> m_pimpl;
 
+  wxTimer m_timerGuiRefresh;
+
   fOptionDelegates_t m_fOptionDelegates_Attach;
   fOptionDelegates_t m_fOptionDelegates_Detach;
 
@@ -114,6 +120,7 @@ private:
   void serialize(Archive & ar, const unsigned int file_version);
 
   void HandleSize( wxSizeEvent& event );
+  void HandleGuiRefresh( wxTimerEvent& event );
   void OnDestroy( wxWindowDestroyEvent& event );
 
   wxBitmap GetBitmapResource( const wxString& name );
@@ -177,6 +177,53 @@ void GridOptionChain_impl::Refresh() {
   m_details.ForceRefresh();
 }
 
+void GridOptionChain_impl::RefreshDirty() {
+  m_refresh.Frame(
+    *this, m_vRowIX.size(),
+    [this]( int row )->Slots_t& { return m_vRowIX[ row ]->second.m_slots; }
+    );
+}
+
+bool GridOptionChain_impl::VisibleRows( int& first, int& last ) {
+
+  if ( m_vRowIX.empty() ) return false;
+  if ( !m_details.IsShownOnScreen() ) return false; // eg, a hidden notebook page
+
+  const int height = m_details.GetGridWindow()->GetClientSize().GetHeight();
+  if ( 0 >= height ) return false;
+
+  int x, y;
+  m_details.CalcUnscrolledPosition( 0, 0, &x, &y );
+  first = m_details.YToRow( y, true );
+  last = m_details.YToRow( y + height - 1, true );
+
+  return true;
+}
+
+void GridOptionChain_impl::BeginBatch() {
+  m_details.BeginBatch();
+}
+
+void GridOptionChain_impl::Paint( int row, grid::mask_t dirty, const double* value ) {
+
+  m_vRowIX[ row ]->second.Apply( dirty, value );
+
+  // one invalidated rectangle spanning the changed cells of the row
+  int left( 0 );
+  while ( 0 == ( dirty & ( grid::mask_t( 1 ) << left ) ) ) left++;
+  int right( GRID_ARRAY_COL_COUNT - 1 );
+  while ( 0 == ( dirty & ( grid::mask_t( 1 ) << right ) ) ) right--;
+
+  const wxRect rect( m_details.BlockToDeviceRect( wxGridCellCoords( row, left ), wxGridCellCoords( row, right ) ) );
+  if ( !rect.IsEmpty() ) {
+    m_details.GetGridWindow()->RefreshRect( rect, false );
+  }
+}
+
+void GridOptionChain_impl::EndBatch() {
+  m_details.EndBatch(); // paint events follow
+}
+
 void GridOptionChain_impl::OnMouseMotion( wxMouseEvent& event ) {
   if ( event.Dragging() ) {
 
@@ -427,6 +474,8 @@ wxString GridOptionChain_impl::GetValue( int row, int col ) {
 
   wxString s;
 
+  m_vRowIX[row]->second.Sync( col ); // scrolled into view, or drawn ahead of the refresh timer
+
   #define GRID_EMIT_SwitchGetValue( z, n, data ) \
     case GRID_EXTRACT_COL_DETAILS(z, n, 0):  \
       s = boost::fusion::at_c<GRID_EXTRACT_COL_DETAILS(z, n, 0)>( m_vRowIX[row]->second.m_vModelCells ).GetText(); \
@@ -35,12 +35,14 @@
 #include <TFVuTrading/ModelCell_ops.h>
 #include <TFVuTrading/ModelCell_macros.h>
 
+#include <TFVuTrading/GridRefresh.hpp>
+
 #include "GridOptionChain.hpp"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
 
-struct GridOptionChain_impl: public wxGridTableBase {
+struct GridOptionChain_impl: public wxGridTableBase, public grid::Sink {
 //public:
   GridOptionChain_impl( GridOptionChain& );
   virtual ~GridOptionChain_impl();
@@ -80,6 +82,9 @@ struct GridOptionChain_impl: public wxGridTableBase {
     BOOST_PP_REPEAT(GRID_ARRAY_COL_COUNT,COMPOSE_MODEL_CELL,4)
   >;
 
+  using Refresh_t = grid::Refresh<GRID_ARRAY_COL_COUNT>;
+  using Slots_t = Refresh_t::slots_t;
+
   struct OptionValueRow {
   //public:
     OptionValueRow( wxGrid& grid, double strike )
@@ -100,29 +105,47 @@ struct GridOptionChain_impl: public wxGridTableBase {
     void UpdateGui() { // now updated by update events
       boost::fusion::for_each( m_vModelCells, ModelCell_ops::UpdateGui( m_grid, m_nRow ) );
     }
+
+    // Update* above run on feed threads and only touch m_slots,
+    //   the model cells are brought up to date on the gui thread by the refresh timer, or by GetValue
+    void Apply( grid::mask_t dirty, const double* value ) {
+      #define GRID_EMIT_ApplySlot( z, n, data ) \
+        if ( 0 != ( dirty & ( grid::mask_t( 1 ) << GRID_EXTRACT_COL_DETAILS(z, n, 0) ) ) ) { \
+          boost::fusion::at_c<GRID_EXTRACT_COL_DETAILS(z, n, 0)>( m_vModelCells ).SetValue( value[ GRID_EXTRACT_COL_DETAILS(z, n, 0) ] ); \
+        }
+      BOOST_PP_REPEAT(BOOST_PP_ARRAY_SIZE( GRID_ARRAY ), GRID_EMIT_ApplySlot, 0 )
+    }
+    void Sync( int col ) { // a cell about to be drawn
+      const grid::mask_t dirty( m_slots.Take( grid::mask_t( 1 ) << col ) );
+      if ( 0 != dirty ) {
+        double value[ GRID_ARRAY_COL_COUNT ];
+        value[ col ] = m_slots.Get( col );
+        Apply( dirty, value );
+      }
+    }
     void UpdateCallGreeks( const ou::tf::Greek& greek ) {
-      boost::fusion::at_c<COL_CallIV>( m_vModelCells ).SetValue( greek.ImpliedVolatility() );
-      boost::fusion::at_c<COL_CallDelta>( m_vModelCells ).SetValue( greek.Delta() );
-      boost::fusion::at_c<COL_CallGamma>( m_vModelCells ).SetValue( greek.Gamma() );
+      m_slots.Set( COL_CallIV, greek.ImpliedVolatility() );
+      m_slots.Set( COL_CallDelta, greek.Delta() );
+      m_slots.Set( COL_CallGamma, greek.Gamma() );
     }
     void UpdateCallQuote( const ou::tf::Quote& quote ) {
-      boost::fusion::at_c<COL_CallBid>( m_vModelCells ).SetValue( quote.Bid() );
-      boost::fusion::at_c<COL_CallAsk>( m_vModelCells ).SetValue( quote.Ask() );
+      m_slots.Set( COL_CallBid, quote.Bid() );
+      m_slots.Set( COL_CallAsk, quote.Ask() );
     }
     void UpdateCallTrade( const ou::tf::Trade& trade ) {
-      boost::fusion::at_c<COL_CallLast>( m_vModelCells ).SetValue( trade.Price() );
+      m_slots.Set( COL_CallLast, trade.Price() );
     }
     void UpdatePutGreeks( const ou::tf::Greek& greek ) {
-      boost::fusion::at_c<COL_PutIV>( m_vModelCells ).SetValue( greek.ImpliedVolatility() );
-      boost::fusion::at_c<COL_PutDelta>( m_vModelCells ).SetValue( greek.Delta() );
-      boost::fusion::at_c<COL_PutGamma>( m_vModelCells ).SetValue( greek.Gamma() );
+      m_slots.Set( COL_PutIV, greek.ImpliedVolatility() );
+      m_slots.Set( COL_PutDelta, greek.Delta() );
+      m_slots.Set( COL_PutGamma, greek.Gamma() );
     }
     void UpdatePutQuote( const ou::tf::Quote& quote ) {
-      boost::fusion::at_c<COL_PutBid>( m_vModelCells ).SetValue( quote.Bid() );
-      boost::fusion::at_c<COL_PutAsk>( m_vModelCells ).SetValue( quote.Ask() );
+      m_slots.Set( COL_PutBid, quote.Bid() );
+      m_slots.Set( COL_PutAsk, quote.Ask() );
     }
     void UpdatePutTrade( const ou::tf::Trade& trade ) {
-      boost::fusion::at_c<COL_PutLast>( m_vModelCells ).SetValue( trade.Price() );
+      m_slots.Set( COL_PutLast, trade.Price() );
     }
     // TODO: add open interest
   //protected:
@@ -136,6 +159,7 @@ struct GridOptionChain_impl: public wxGridTableBase {
     wxGrid& m_grid;
     int m_nRow;
     vModelCells_t m_vModelCells;
+    Slots_t m_slots; // latest values from the feed, not carried by the move constructor
 
     void Init() {
       boost::fusion::fold( m_vModelCells, 0, ModelCell_ops::SetCol() );
@@ -152,6 +176,8 @@ struct GridOptionChain_impl: public wxGridTableBase {
   int m_nRow;
   int m_nColumn;
 
+  Refresh_t m_refresh;
+
   using mapOptionValueRow_t = std::map<double,OptionValueRow>;
   using mapOptionValueRow_iter = mapOptionValueRow_t::iterator;
   mapOptionValueRow_t m_mapOptionValueRow;
@@ -168,7 +194,15 @@ struct GridOptionChain_impl: public wxGridTableBase {
   void CreateControls();
   //void OnDestroy( wxWindowDestroyEvent& event );  // can't use this
 
-  void Refresh();
+  void Refresh(); // repaint everything
+  void RefreshDirty(); // timer driven, repaints visible cells changed since the last call
+  const grid::Stats& GetRefreshStats() const { return m_refresh.GetStats(); }
+
+  // grid::Sink
+  virtual bool VisibleRows( int& first, int& last );
+  virtual void BeginBatch();
+  virtual void Paint( int row, grid::mask_t dirty, const double* value );
+  virtual void EndBatch();
 
   void Add( double strike, ou::tf::OptionSide::EOptionSide side, const std::string& sSymbol );
 
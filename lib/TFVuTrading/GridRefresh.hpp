@@ -0,0 +1,171 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    GridRefresh.hpp
+ * Author:  raymond@burkholder.net
+ * Project: TFVuTrading
+ * Created: 2026
+ */
+
+#pragma once
+
+// coalesced grid refresh, independent of wx so it can be driven headless
+//   feed threads write the latest value of a cell into the Slots of its row and set the cell's dirty bit
+//   a timer on the gui thread runs Refresh::Frame, which drains the dirty bits of the visible rows only,
+//     and hands each row's changed cells to a Sink in one batch
+//   a value overwritten before it was painted is counted as a dropped update
+//   rows scrolled out of view keep their dirty bits until they are visible again
+
+#include <array>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace grid {
+
+using mask_t = std::uint32_t; // one bit per column
+
+template<size_t NCols>
+class Slots { // one row
+public:
+
+  static_assert( NCols <= 32, "Slots: one dirty bit per column in mask_t" );
+
+  Slots(): m_dirty( 0 ), m_nOverwritten( 0 ) {
+    for ( std::atomic<double>& value: m_value ) value.store( 0.0, std::memory_order_relaxed );
+  }
+  Slots( const Slots& ) = delete;
+  Slots( Slots&& ) = delete;
+
+  // feed thread, lock free
+  void Set( size_t col, double value ) {
+    m_value[ col ].store( value, std::memory_order_relaxed );
+    const mask_t bit( mask_t( 1 ) << col );
+    if ( 0 != ( bit & m_dirty.fetch_or( bit, std::memory_order_release ) ) ) {
+      m_nOverwritten.fetch_add( 1, std::memory_order_relaxed ); // previous value was never painted
+    }
+  }
+
+  // gui thread
+  mask_t Dirty() const { return m_dirty.load( std::memory_order_relaxed ); }
+  mask_t Take() { return m_dirty.exchange( 0, std::memory_order_acquire ); } // clears and returns the dirty bits
+  mask_t Take( mask_t mask ) { return mask & m_dirty.fetch_and( ~mask, std::memory_order_acquire ); }
+  double Get( size_t col ) const { return m_value[ col ].load( std::memory_order_relaxed ); }
+  std::uint32_t TakeOverwritten() { return m_nOverwritten.exchange( 0, std::memory_order_relaxed ); }
+
+private:
+  std::array<std::atomic<double>,NCols> m_value;
+  std::atomic<mask_t> m_dirty;
+  std::atomic<std::uint32_t> m_nOverwritten;
+};
+
+class Sink { // implemented by the grid, or by a fake for headless use
+public:
+  virtual ~Sink() {}
+  virtual bool VisibleRows( int& first, int& last ) = 0; // inclusive, false when nothing is visible
+  virtual void BeginBatch() = 0;
+  virtual void Paint( int row, mask_t dirty, const double* value ) = 0; // value[ col ] is valid where the dirty bit is set
+  virtual void EndBatch() = 0;
+};
+
+struct Stats {
+  std::uint64_t nFrames;
+  std::uint64_t nFramesPainted; // frames with at least one dirty cell
+  std::uint64_t nRows;
+  std::uint64_t nCells;
+  std::uint64_t nDropped; // updates overwritten before being painted
+  std::chrono::microseconds durLast; // frame time, BeginBatch to EndBatch
+  std::chrono::microseconds durMax;
+  std::chrono::microseconds durTotal;
+  Stats()
+  : nFrames {}, nFramesPainted {}, nRows {}, nCells {}, nDropped {}
+  , durLast( 0 ), durMax( 0 ), durTotal( 0 )
+  {}
+};
+
+template<size_t NCols>
+class Refresh {
+public:
+
+  using slots_t = Slots<NCols>;
+
+  Refresh() {}
+
+  // gui thread, fSlots: slots_t&( int row ), nRows: rows in the grid
+  template<typename FSlots>
+  size_t Frame( Sink& sink, int nRows, FSlots&& fSlots ) {
+
+    m_stats.nFrames++;
+
+    int first {};
+    int last {};
+    if ( !sink.VisibleRows( first, last ) ) return 0;
+    if ( first < 0 ) first = 0;
+    if ( last >= nRows ) last = nRows - 1;
+    if ( last < first ) return 0;
+
+    using clock_t = std::chrono::steady_clock;
+    const clock_t::time_point start( clock_t::now() );
+
+    size_t nCells {};
+    bool bBatch( false );
+    double value[ NCols ];
+
+    for ( int row = first; row <= last; row++ ) {
+      slots_t& slots( fSlots( row ) );
+      m_stats.nDropped += slots.TakeOverwritten();
+      if ( 0 == slots.Dirty() ) continue;
+      const mask_t dirty( slots.Take() );
+      if ( 0 == dirty ) continue;
+      for ( size_t col = 0; col < NCols; col++ ) {
+        if ( 0 != ( dirty & ( mask_t( 1 ) << col ) ) ) {
+          value[ col ] = slots.Get( col );
+          nCells++;
+        }
+      }
+      if ( !bBatch ) {
+        sink.BeginBatch();
+        bBatch = true;
+      }
+      sink.Paint( row, dirty, value );
+      m_stats.nRows++;
+    }
+
+    if ( bBatch ) {
+      sink.EndBatch();
+      const std::chrono::microseconds dur(
+        std::chrono::duration_cast<std::chrono::microseconds>( clock_t::now() - start ) );
+      m_stats.nFramesPainted++;
+      m_stats.nCells += nCells;
+      m_stats.durLast = dur;
+      m_stats.durTotal += dur;
+      if ( m_stats.durMax < dur ) m_stats.durMax = dur;
+    }
+
+    return nCells;
+  }
+
+  const Stats& GetStats() const { return m_stats; }
+  void ResetStats() { m_stats = Stats(); }
+
+private:
+  Stats m_stats;
+};
+
+} // namespace grid
+} // namespace tf
+} // namespace ou
@@ -109,7 +109,7 @@ void ExecutionControl::Set( ou::tf::l2::PanelTrade* pPanelTrade ) {
         switch ( field ) {
           case EField::AskOrder:
             switch ( button ) {
-              case PriceRow::EButton::Left:
+              case EButton::Left:
                 if ( shift ) {
                   AskStop( price ); // need to simulate submission
                 }
@@ -117,9 +117,9 @@ void ExecutionControl::Set( ou::tf::l2::PanelTrade* pPanelTrade ) {
                   AskLimit( price );
                 }
                 break;
-              case PriceRow::EButton::Middle:
+              case EButton::Middle:
                 break;
-              case PriceRow::EButton::Right:
+              case EButton::Right:
                 if ( shift ) {
                   // TODO: cancel all orders on this side
                 }
@@ -131,7 +131,7 @@ void ExecutionControl::Set( ou::tf::l2::PanelTrade* pPanelTrade ) {
             break;
           case EField::BidOrder:
             switch ( button ) {
-              case PriceRow::EButton::Left:
+              case EButton::Left:
                 if ( shift ) {
                   BidStop( price ); // need to simulate submission
                 }
@@ -139,9 +139,9 @@ void ExecutionControl::Set( ou::tf::l2::PanelTrade* pPanelTrade ) {
                   BidLimit( price );
                 }
                 break;
-              case PriceRow::EButton::Middle:
+              case EButton::Middle:
                 break;
-              case PriceRow::EButton::Right:
+              case EButton::Right:
                 if ( shift ) {
                   // TODO: cancel all orders on this side
                 }
@@ -0,0 +1,404 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Ladder.cpp
+ * Author:  raymond@burkholder.net
+ * Project: TFVuTrading/MarketDepth
+ * Created: 2026
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cassert>
+
+#include "Ladder.hpp"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace l2 { // market depth
+
+namespace {
+  const char* szFmtInteger( "%u" );
+  const char* szFmtPrice(   "%0.2f" );
+  const EColour colourColumnHeader( EColour::LightGoldenrodYellow ); // as in WinRow
+}
+
+// Ladder::Row
+
+Ladder::Row::Row() {
+  Clear( 0, 0.0 );
+}
+
+void Ladder::Row::Clear( int ix_, double price_ ) {
+  ix = ix_;
+  price = price_;
+  pl = 0.0;
+  nBuyCount = nBuyVolume = nBidSize = nBidOrder = nAskOrder = 0;
+  nAskSize = nSellVolume = nSellCount = nTicks = nVolume = 0;
+  colourBidOrder = colourAskOrder = c_colourDefault;
+  bBid = bAsk = bTrade = false;
+  sStatic.clear();
+  sDynamic.clear();
+}
+
+bool Ladder::Row::operator==( const Row& rhs ) const {
+  return
+       ( ix == rhs.ix ) && ( price == rhs.price ) && ( pl == rhs.pl )
+    && ( nBuyCount == rhs.nBuyCount ) && ( nBuyVolume == rhs.nBuyVolume )
+    && ( nBidSize == rhs.nBidSize ) && ( nBidOrder == rhs.nBidOrder )
+    && ( nAskOrder == rhs.nAskOrder ) && ( nAskSize == rhs.nAskSize )
+    && ( nSellVolume == rhs.nSellVolume ) && ( nSellCount == rhs.nSellCount )
+    && ( nTicks == rhs.nTicks ) && ( nVolume == rhs.nVolume )
+    && ( colourBidOrder == rhs.colourBidOrder ) && ( colourAskOrder == rhs.colourAskOrder )
+    && ( bBid == rhs.bBid ) && ( bAsk == rhs.bAsk ) && ( bTrade == rhs.bTrade )
+    && ( sStatic == rhs.sStatic ) && ( sDynamic == rhs.sDynamic );
+}
+
+// Ladder::Rung
+
+Ladder::Rung::Rung()
+: ix( c_ixEmpty ), nSequence( 0 ), nWriters( 0 ) {
+  Reset();
+}
+
+void Ladder::Rung::Reset() {
+  for ( std::atomic<unsigned int>& n: value ) n.store( 0, std::memory_order_relaxed );
+  colourBidOrder.store( c_colourDefault, std::memory_order_relaxed );
+  colourAskOrder.store( c_colourDefault, std::memory_order_relaxed );
+}
+
+// Ladder
+
+Ladder::Ladder( size_t nRungs )
+: m_nMask( nRungs - 1 )
+, m_rRung( new Rung[ nRungs ] )
+, m_ixBid( c_ixEmpty ), m_ixAsk( c_ixEmpty ), m_ixTrade( c_ixEmpty )
+, m_nPLQuantity( 0 ), m_ixPLZero( 0 )
+{
+  assert( 0 < nRungs );
+  assert( 0 == ( nRungs & m_nMask ) );
+  SetInterval( 0.01 );
+}
+
+Ladder::~Ladder() {}
+
+void Ladder::SetInterval( double interval ) {
+  assert( 0.0 < interval );
+  m_interval = interval;
+  m_intervalby2 = interval / 2.0;
+}
+
+int Ladder::Cast( double price ) const {
+  return std::floor( ( price + m_intervalby2 ) / m_interval );
+}
+
+double Ladder::Cast( int ix ) const {
+  return ix * m_interval;
+}
+
+Ladder::Rung& Ladder::Claim( int ix ) {
+  Rung& rung( m_rRung[ (unsigned int)ix & m_nMask ] );
+  for ( ;; ) {
+    // register as a writer, then confirm the tick, a reset marks the slot then counts writers,
+    //   so ( sequentially consistent ) either the writer sees the mark or the reset sees the writer
+    rung.nWriters.fetch_add( 1 );
+    int ixHeld = rung.ix.load();
+    if ( ix == ixHeld ) return rung;
+    rung.nWriters.fetch_sub( 1, std::memory_order_release );
+    if ( c_ixClaiming == ixHeld ) { // another writer is resetting the slot for its tick
+      std::this_thread::yield();
+      continue;
+    }
+    // the reset happens only if the slot still holds the tick seen above, otherwise look again
+    if ( rung.ix.compare_exchange_strong( ixHeld, c_ixClaiming ) ) {
+      while ( 0 != rung.nWriters.load() ) { // writers of the older tick, or backing off from the mark
+        std::this_thread::yield();
+      }
+      const unsigned int nSequence( rung.nSequence.load( std::memory_order_relaxed ) );
+      rung.nSequence.store( nSequence + 1, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_release );
+      rung.Reset();
+      rung.nSequence.store( nSequence + 2, std::memory_order_release );
+      rung.ix.store( ix );
+    }
+  }
+}
+
+const Ladder::Rung* Ladder::Find( int ix, unsigned int& nSequence ) const {
+  const Rung& rung( m_rRung[ (unsigned int)ix & m_nMask ] );
+  nSequence = rung.nSequence.load( std::memory_order_acquire );
+  if ( 0 != ( nSequence & 1 ) ) return nullptr;
+  return ( ix == rung.ix.load( std::memory_order_acquire ) ) ? &rung : nullptr;
+}
+
+void Ladder::Set( int ix, EValue value, unsigned int n ) {
+  Write( ix, [value,n]( Rung& rung ){
+    rung.value[ (size_t)value ].store( n, std::memory_order_relaxed );
+  } );
+}
+
+void Ladder::SetBidSize( int ix, unsigned int n ) {
+  Set( ix, EValue::BidSize, n );
+}
+
+void Ladder::SetAskSize( int ix, unsigned int n ) {
+  Set( ix, EValue::AskSize, n );
+}
+
+void Ladder::SetQuote( int ixBid, int ixAsk ) {
+  m_ixBid.store( ixBid, std::memory_order_relaxed );
+  m_ixAsk.store( ixAsk, std::memory_order_relaxed );
+}
+
+void Ladder::Trade( int ix, unsigned int volume, int direction ) {
+  m_ixTrade.store( ix, std::memory_order_relaxed );
+  Write( ix, [volume,direction]( Rung& rung ){
+    rung.value[ (size_t)EValue::Ticks ].fetch_add( 1, std::memory_order_relaxed );
+    rung.value[ (size_t)EValue::Volume ].fetch_add( volume, std::memory_order_relaxed );
+    if ( 0 < direction ) {
+      rung.value[ (size_t)EValue::BuyCount ].fetch_add( 1, std::memory_order_relaxed );
+      rung.value[ (size_t)EValue::BuyVolume ].fetch_add( volume, std::memory_order_relaxed );
+    }
+    if ( 0 > direction ) {
+      rung.value[ (size_t)EValue::SellCount ].fetch_add( 1, std::memory_order_relaxed );
+      rung.value[ (size_t)EValue::SellVolume ].fetch_add( volume, std::memory_order_relaxed );
+    }
+  } );
+}
+
+void Ladder::SetBidOrder( int ix, unsigned int n, EColour bg ) {
+  Write( ix, [n,bg]( Rung& rung ){
+    rung.value[ (size_t)EValue::BidOrder ].store( n, std::memory_order_relaxed );
+    rung.colourBidOrder.store( bg, std::memory_order_relaxed );
+  } );
+}
+
+void Ladder::SetAskOrder( int ix, unsigned int n, EColour bg ) {
+  Write( ix, [n,bg]( Rung& rung ){
+    rung.value[ (size_t)EValue::AskOrder ].store( n, std::memory_order_relaxed );
+    rung.colourAskOrder.store( bg, std::memory_order_relaxed );
+  } );
+}
+
+void Ladder::SetProfitLoss( int quantity, double priceZero ) {
+  m_ixPLZero.store( Cast( priceZero ), std::memory_order_relaxed );
+  m_nPLQuantity.store( quantity, std::memory_order_relaxed );
+}
+
+void Ladder::AppendIndicatorStatic( int ix, const std::string& sIndicator ) {
+  std::scoped_lock<std::mutex> lock( m_mutexIndicator );
+  Indicator& indicator( m_mapIndicator[ ix ] );
+  if ( indicator.sStatic.empty() ) {
+    indicator.sStatic = sIndicator;
+  }
+  else {
+    indicator.sStatic += " " + sIndicator;
+  }
+}
+
+void Ladder::UpdateIndicatorDynamic( const std::string& sIndicator, int ix ) {
+
+  auto Join = []( Indicator& indicator ){
+    indicator.sDynamic.clear();
+    for ( const std::string& s: indicator.setDynamic ) {
+      if ( !indicator.sDynamic.empty() ) indicator.sDynamic += " ";
+      indicator.sDynamic += s;
+    }
+  };
+
+  std::scoped_lock<std::mutex> lock( m_mutexIndicator );
+
+  mapDynamicIndicator_t::iterator iter = m_mapDynamicIndicator.find( sIndicator );
+  if ( m_mapDynamicIndicator.end() == iter ) {
+    iter = m_mapDynamicIndicator.emplace( sIndicator, ix ).first;
+  }
+  else {
+    if ( ix == iter->second ) return;
+    mapIndicator_t::iterator iterOld = m_mapIndicator.find( iter->second );
+    if ( m_mapIndicator.end() != iterOld ) {
+      Indicator& indicator( iterOld->second );
+      indicator.setDynamic.erase( sIndicator );
+      if ( indicator.setDynamic.empty() && indicator.sStatic.empty() ) {
+        m_mapIndicator.erase( iterOld );
+      }
+      else {
+        Join( indicator );
+      }
+    }
+    iter->second = ix;
+  }
+
+  Indicator& indicator( m_mapIndicator[ ix ] );
+  indicator.setDynamic.insert( sIndicator );
+  Join( indicator );
+}
+
+void Ladder::Snapshot( int ixTop, size_t nRows, Frame& frame ) const {
+
+  frame.resize( nRows ); // no reallocation once the frame has been sized for the window
+
+  const int ixBid = m_ixBid.load( std::memory_order_relaxed );
+  const int ixAsk = m_ixAsk.load( std::memory_order_relaxed );
+  const int ixTrade = m_ixTrade.load( std::memory_order_relaxed );
+  const int nPLQuantity = m_nPLQuantity.load( std::memory_order_relaxed );
+  const double priceZero = Cast( m_ixPLZero.load( std::memory_order_relaxed ) );
+
+  int ix( ixTop );
+  for ( Row& row: frame ) {
+
+    const double price( Cast( ix ) );
+    row.Clear( ix, price );
+
+    unsigned int nSequence;
+    const Rung* pRung = Find( ix, nSequence );
+    if ( nullptr != pRung ) {
+      const Rung& rung( *pRung );
+      row.nBuyCount   = rung.value[ (size_t)EValue::BuyCount ].load( std::memory_order_relaxed );
+      row.nBuyVolume  = rung.value[ (size_t)EValue::BuyVolume ].load( std::memory_order_relaxed );
+      row.nBidSize    = rung.value[ (size_t)EValue::BidSize ].load( std::memory_order_relaxed );
+      row.nBidOrder   = rung.value[ (size_t)EValue::BidOrder ].load( std::memory_order_relaxed );
+      row.nAskOrder   = rung.value[ (size_t)EValue::AskOrder ].load( std::memory_order_relaxed );
+      row.nAskSize    = rung.value[ (size_t)EValue::AskSize ].load( std::memory_order_relaxed );
+      row.nSellVolume = rung.value[ (size_t)EValue::SellVolume ].load( std::memory_order_relaxed );
+      row.nSellCount  = rung.value[ (size_t)EValue::SellCount ].load( std::memory_order_relaxed );
+      row.nTicks      = rung.value[ (size_t)EValue::Ticks ].load( std::memory_order_relaxed );
+      row.nVolume     = rung.value[ (size_t)EValue::Volume ].load( std::memory_order_relaxed );
+      row.colourBidOrder = rung.colourBidOrder.load( std::memory_order_relaxed );
+      row.colourAskOrder = rung.colourAskOrder.load( std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_acquire );
+      if ( ( nSequence != rung.nSequence.load( std::memory_order_relaxed ) ) || ( ix != rung.ix.load( std::memory_order_relaxed ) ) ) {
+        row.Clear( ix, price ); // the slot was taken by another tick while it was read
+      }
+    }
+
+    row.bBid = ( ixBid == ix );
+    row.bAsk = ( ixAsk == ix );
+    row.bTrade = ( ixTrade == ix );
+    if ( 0 != nPLQuantity ) {
+      row.pl = nPLQuantity * ( price - priceZero ); // multiply by multiple?
+    }
+
+    ix--;
+  }
+
+  if ( 0 < nRows ) {
+    std::scoped_lock<std::mutex> lock( m_mutexIndicator );
+    const int ixBottom = ixTop - (int)nRows + 1;
+    for (
+      mapIndicator_t::const_iterator iter = m_mapIndicator.lower_bound( ixBottom );
+      ( m_mapIndicator.end() != iter ) && ( iter->first <= ixTop );
+      iter++
+    ) {
+      Row& row( frame[ ixTop - iter->first ] );
+      row.sStatic = iter->second.sStatic;
+      row.sDynamic = iter->second.sDynamic;
+    }
+  }
+}
+
+void Ladder::RenderHeader( const vElement_t& vElement, int x, int y, int nRowHeight, Canvas& canvas ) {
+  for ( const Element& element: vElement ) {
+    canvas.Cell( x, y, element.width - 1, nRowHeight - 1, colourColumnHeader, EColour::Black, element.alignment, element.header.c_str() );
+    x += element.width;
+  }
+}
+
+void Ladder::Render( const vElement_t& vElement, const Frame& frame, int xOrigin, int yOrigin, int nRowHeight, Canvas& canvas ) {
+
+  RenderHeader( vElement, xOrigin, yOrigin, nRowHeight, canvas );
+
+  char szText[ 32 ];
+
+  auto Integer = [&szText]( unsigned int n )->const char* {
+    if ( 0 == n ) return "";
+    std::snprintf( szText, sizeof( szText ), szFmtInteger, n );
+    return szText;
+  };
+
+  auto Price = [&szText]( double value )->const char* {
+    if ( 0.0 == value ) return "";
+    std::snprintf( szText, sizeof( szText ), szFmtPrice, value );
+    return szText;
+  };
+
+  int y( yOrigin + nRowHeight );
+  for ( const Row& row: frame ) {
+    int x( xOrigin );
+    for ( const Element& element: vElement ) {
+
+      const Colours& colours( element.colours );
+      EColour bg( colours.bg );
+      const char* sz( "" );
+
+      switch ( (EField)element.field ) {
+        case EField::PL:
+          sz = Price( row.pl );
+          break;
+        case EField::BuyCount:
+          sz = Integer( row.nBuyCount );
+          break;
+        case EField::BuyVolume:
+          sz = Integer( row.nBuyVolume );
+          break;
+        case EField::BidSize:
+          sz = Integer( row.nBidSize );
+          if ( row.bBid ) bg = colours.hi;
+          break;
+        case EField::BidOrder:
+          sz = Integer( row.nBidOrder );
+          if ( c_colourDefault != row.colourBidOrder ) bg = (EColour)row.colourBidOrder;
+          break;
+        case EField::Price:
+          sz = Price( row.price );
+          if ( row.bTrade ) bg = colours.hi;
+          break;
+        case EField::AskOrder:
+          sz = Integer( row.nAskOrder );
+          if ( c_colourDefault != row.colourAskOrder ) bg = (EColour)row.colourAskOrder;
+          break;
+        case EField::AskSize:
+          sz = Integer( row.nAskSize );
+          if ( row.bAsk ) bg = colours.hi;
+          break;
+        case EField::SellVolume:
+          sz = Integer( row.nSellVolume );
+          break;
+        case EField::SellCount:
+          sz = Integer( row.nSellCount );
+          break;
+        case EField::Ticks:
+          sz = Integer( row.nTicks );
+          break;
+        case EField::Volume:
+          sz = Integer( row.nVolume );
+          break;
+        case EField::Static:
+          sz = row.sStatic.c_str();
+          break;
+        case EField::Dynamic:
+          sz = row.sDynamic.c_str();
+          break;
+      }
+
+      canvas.Cell( x, y, element.width - 1, nRowHeight - 1, bg, colours.fg, element.alignment, sz );
+      x += element.width;
+    }
+    y += nRowHeight;
+  }
+}
+
+} // market depth
+} // namespace tf
+} // namespace ou
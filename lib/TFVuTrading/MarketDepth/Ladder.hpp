@@ -0,0 +1,197 @@
+/************************************************************************
+ * Copyright(c) 2026, One Unified. All rights reserved.                 *
+ * email: info@oneunified.net                                           *
+ *                                                                      *
+ * This file is provided as is WITHOUT ANY WARRANTY                     *
+ *  without even the implied warranty of                                *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                *
+ *                                                                      *
+ * This software may not be used nor distributed without proper license *
+ * agreement.                                                           *
+ *                                                                      *
+ * See the file LICENSE.txt for redistribution information.             *
+ ************************************************************************/
+
+/*
+ * File:    Ladder.hpp
+ * Author:  raymond@burkholder.net
+ * Project: TFVuTrading/MarketDepth
+ * Created: 2026
+ */
+
+// model of the PanelTrade ladder
+//   rungs live in a fixed ring indexed by tick (integerized price), written lock free by the feed threads
+//   a rung is claimed by the first write for its tick, so the ring is never reallocated or recentered
+//   ticks further than the ring size from a claimed rung share its slot, the older tick is reset on reuse,
+//     a writer finding its slot mid-reset waits for the reset, a reset waits out the writers of the older tick,
+//     a snapshot overlapping a reset shows an empty row
+//   the gui timer copies the visible rungs into a Frame (the back buffer), PanelTrade swaps it with the
+//     front buffer when it differs, and Render draws the whole front buffer in one pass
+//   Render is independent of wx, output goes through a Canvas
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "Fields.hpp"
+
+namespace ou { // One Unified
+namespace tf { // TradeFrame
+namespace l2 { // market depth
+
+class Ladder {
+public:
+
+  using EField = rung::EField;
+
+  Ladder( size_t nRungs = 1 << 14 ); // power of two
+  ~Ladder();
+
+  void SetInterval( double ); // price step from rung to rung
+
+  int Cast( double price ) const; // price to index
+  double Cast( int ix ) const;    // index to price
+
+  // feed threads
+
+  void SetBidSize( int ix, unsigned int ); // l2
+  void SetAskSize( int ix, unsigned int ); // l2
+
+  void SetQuote( int ixBid, int ixAsk ); // l1, highlights the sizes at the inside
+  void Trade( int ix, unsigned int volume, int direction ); // direction: 1 buy, -1 sell, 0 at the mid
+
+  void SetBidOrder( int ix, unsigned int, EColour bg );
+  void SetAskOrder( int ix, unsigned int, EColour bg );
+
+  void SetProfitLoss( int quantity, double priceZero ); // a 0 quantity clears
+
+  void AppendIndicatorStatic( int ix, const std::string& );
+  void UpdateIndicatorDynamic( const std::string&, int ix ); // moves the indicator to its new rung
+
+  // gui thread
+
+  struct Row {
+
+    int ix;
+    double price;
+    double pl;
+
+    unsigned int nBuyCount;
+    unsigned int nBuyVolume;
+    unsigned int nBidSize;
+    unsigned int nBidOrder;
+    unsigned int nAskOrder;
+    unsigned int nAskSize;
+    unsigned int nSellVolume;
+    unsigned int nSellCount;
+    unsigned int nTicks;
+    unsigned int nVolume;
+
+    std::uint32_t colourBidOrder; // c_colourDefault for the element colour
+    std::uint32_t colourAskOrder;
+
+    bool bBid; // inside bid
+    bool bAsk; // inside ask
+    bool bTrade; // last trade
+
+    std::string sStatic;
+    std::string sDynamic;
+
+    Row();
+    void Clear( int ix, double price ); // keeps string capacity
+    bool operator==( const Row& ) const;
+    bool operator!=( const Row& rhs ) const { return !( *this == rhs ); }
+  };
+
+  using Frame = std::vector<Row>;
+
+  static const std::uint32_t c_colourDefault = ~std::uint32_t( 0 );
+
+  // rows ixTop, ixTop - 1, ... nRows down, strings in frame are reused
+  void Snapshot( int ixTop, size_t nRows, Frame& ) const;
+
+  class Canvas {
+  public:
+    virtual ~Canvas() {}
+    virtual void Cell( // one element of one row
+      int x, int y, int width, int height,
+      EColour bg, EColour fg, long alignment, const char* szText ) = 0;
+  };
+
+  // header row at origin, frame rows below it
+  static void Render( const vElement_t&, const Frame&, int xOrigin, int yOrigin, int nRowHeight, Canvas& );
+  static void RenderHeader( const vElement_t&, int xOrigin, int yOrigin, int nRowHeight, Canvas& );
+
+protected:
+private:
+
+  enum class EValue: int {
+    BuyCount, BuyVolume, BidSize, BidOrder, AskOrder, AskSize, SellVolume, SellCount, Ticks, Volume,
+    Count
+  };
+
+  static const int c_ixEmpty = -0x7fffffff;
+  static const int c_ixClaiming = c_ixEmpty - 1;
+
+  struct Rung {
+    std::atomic<int> ix; // tick held by the slot
+    std::atomic<unsigned int> nSequence; // odd while the slot is reset for a new tick
+    std::atomic<unsigned int> nWriters; // writers inside Write, a reset waits for them to leave
+    std::atomic<unsigned int> value[ (size_t)EValue::Count ];
+    std::atomic<std::uint32_t> colourBidOrder;
+    std::atomic<std::uint32_t> colourAskOrder;
+    Rung();
+    void Reset();
+  };
+
+  struct Indicator {
+    std::string sStatic;
+    std::set<std::string> setDynamic;
+    std::string sDynamic; // from setDynamic
+  };
+
+  double m_interval;
+  double m_intervalby2;
+
+  const size_t m_nMask;
+  std::unique_ptr<Rung[]> m_rRung;
+
+  std::atomic<int> m_ixBid;
+  std::atomic<int> m_ixAsk;
+  std::atomic<int> m_ixTrade;
+
+  std::atomic<int> m_nPLQuantity;
+  std::atomic<int> m_ixPLZero;
+
+  mutable std::mutex m_mutexIndicator; // indicators are infrequent
+  using mapIndicator_t = std::map<int,Indicator>;
+  mapIndicator_t m_mapIndicator;
+  using mapDynamicIndicator_t = std::map<std::string,int>;
+  mapDynamicIndicator_t m_mapDynamicIndicator;
+
+  Rung& Claim( int ix ); // writer side, returns with the rung held for the tick, pair with Release
+  void Release( Rung& rung ) { rung.nWriters.fetch_sub( 1, std::memory_order_release ); }
+  const Rung* Find( int ix, unsigned int& nSequence ) const; // reader side, nullptr when the tick has no rung
+
+  template<typename F>
+  void Write( int ix, F&& f ) { // f( Rung& ) while the rung is held for the tick
+    Rung& rung( Claim( ix ) );
+    f( rung );
+    Release( rung );
+  }
+
+  void Set( int ix, EValue, unsigned int );
+
+};
+
+} // market depth
+} // namespace tf
+} // namespace ou
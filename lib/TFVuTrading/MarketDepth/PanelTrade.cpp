@@ -22,6 +22,7 @@
 #include <wx/sizer.h>
 //#include <wx/tooltip.h>
 #include <wx/dcclient.h>
+#include <wx/dcbuffer.h>
 
 #include <TFTimeSeries/DatedDatum.h>
 
@@ -40,6 +41,44 @@ namespace {
   static const unsigned int RowHeight   = 18; // pixels
   static const unsigned int BorderWidth =  4; // pixels
   static const unsigned int FramedRows  = 10; // when to move into frame then recenter
+
+  class CanvasDC: public Ladder::Canvas {
+  public:
+    CanvasDC( wxDC& dc ): m_dc( dc ) {
+      m_dc.SetPen( *wxTRANSPARENT_PEN );
+    }
+    virtual void Cell( int x, int y, int width, int height, EColour bg, EColour fg, long alignment, const char* szText ) {
+      if ( bg != m_bg ) {
+        m_bg = bg;
+        m_dc.SetBrush( wxBrush( wxColour( bg ) ) );
+      }
+      m_dc.DrawRectangle( x, y, width, height );
+      if ( 0 != *szText ) {
+        if ( fg != m_fg ) {
+          m_fg = fg;
+          m_dc.SetTextForeground( wxColour( fg ) );
+        }
+        const wxString sText( szText );
+        wxCoord textWidth;
+        wxCoord textHeight;
+        m_dc.GetTextExtent( sText, &textWidth, &textHeight );
+        wxCoord xText( x + 1 ); // as in WinRowElement::Render
+        switch ( alignment ) {
+          case wxRIGHT:
+            if ( textWidth < width ) xText = x + width - textWidth;
+            break;
+          case wxCENTER:
+            if ( textWidth <= width ) xText = x + ( width - textWidth ) / 2;
+            break;
+        }
+        m_dc.DrawText( sText, xText, y + 1 );
+      }
+    }
+  private:
+    wxDC& m_dc;
+    EColour m_bg = (EColour)Ladder::c_colourDefault; // forces the first brush and text colour
+    EColour m_fg = (EColour)Ladder::c_colourDefault;
+  };
 }
 
 PanelTrade::PanelTrade()
@@ -60,12 +99,12 @@ PanelTrade::~PanelTrade() {}
 void PanelTrade::Init() {
 
   m_bReCenter = false;
+  m_ixReCenter = 0;
 
   m_nFramedRows = 0;
   m_nCenteredRows = 0;
 
-  m_cntWinRows_Total = 0;
-  m_cntWinRows_Data = 0;
+  m_cntRows = 0;
 
   m_ixFirstPriceRow = 0; // first visible integerized price
   m_ixLastPriceRow = 0;  // last visible integerized price
@@ -77,6 +116,11 @@ void PanelTrade::Init() {
   m_dblLastPrice = 0.0;
   m_dblLastBid = 0.0;
 
+  m_ixFrameFront = 0;
+
+  m_ixHoverRow = -1;
+  m_ixHoverElement = -1;
+
   m_fClick = nullptr;
 
   //wxToolTip::Enable( true );
@@ -94,6 +138,7 @@ bool PanelTrade::Create( /*wxWindow* parent, const wxString& title, const wxPoin
 ) {
 
   SetExtraStyle(wxWS_EX_BLOCK_EVENTS);
+  SetBackgroundStyle( wxBG_STYLE_PAINT ); // all drawing is in OnPaint
   wxWindow::Create( parent, id, pos, size, style );
 
   CreateControls();
@@ -107,120 +152,183 @@ bool PanelTrade::Create( /*wxWindow* parent, const wxString& title, const wxPoin
 void PanelTrade::CreateControls() {
 
   //PanelTrade* itemPanel1 = this;
-  DrawWinRows();
+  SizeRows();
 
-  //Bind( wxEVT_PAINT, &PanelTrade::OnPaint, this, GetId() );
+  Bind( wxEVT_PAINT, &PanelTrade::OnPaint, this, GetId() );
 
   Bind( wxEVT_SIZE, &PanelTrade::OnResize, this, GetId() );
   Bind( wxEVT_SIZING, &PanelTrade::OnResizing, this, GetId() );
   Bind( wxEVT_DESTROY, &PanelTrade::OnDestroy, this, GetId() );
 
+  Bind( wxEVT_LEFT_UP, &PanelTrade::OnMouseLeftUp, this );
+  Bind( wxEVT_MIDDLE_UP, &PanelTrade::OnMouseMiddleUp, this );
+  Bind( wxEVT_RIGHT_UP, &PanelTrade::OnMouseRightUp, this );
+  Bind( wxEVT_MOTION, &PanelTrade::OnMouseMotion, this );
+  Bind( wxEVT_LEAVE_WINDOW, &PanelTrade::OnMouseLeaveWindow, this );
+
 }
 
+// one pass over the front frame, replaces a child window per element
 void PanelTrade::OnPaint( wxPaintEvent& event ) {
-  wxPaintDC dc( this );
+
+  wxAutoBufferedPaintDC dc( this );
+  dc.SetBackground( wxBrush( GetBackgroundColour() ) );
+  dc.Clear();
+  dc.SetFont( GetFont() );
+
+  CanvasDC canvas( dc );
+  Ladder::Render( rung::vElement, m_rFrame[ m_ixFrameFront ], BorderWidth, BorderWidth, RowHeight, canvas );
+
+  if ( 0 <= m_ixHoverRow ) { // focus box, as in WinRowElement
+    int x( BorderWidth );
+    for ( int ix = 0; ix < m_ixHoverElement; ix++ ) x += rung::vElement[ ix ].width;
+    const int y( BorderWidth + ( m_ixHoverRow + 1 ) * RowHeight );
+    dc.SetBrush( *wxTRANSPARENT_BRUSH );
+    dc.SetPen( *wxBLACK_PEN );
+    dc.DrawRectangle( x + 1, y + 1, rung::vElement[ m_ixHoverElement ].width - 3, RowHeight - 3 );
+  }
 }
 
 void PanelTrade::HandleTimerRefresh( wxTimerEvent& event ) {
+
   if ( m_fTimer ) m_fTimer();
-  //std::scoped_lock<std::mutex> lock( m_mutexTimer );
-  if ( 0 < m_cntWinRows_Data ) {
-    for ( int ix = m_ixFirstPriceRow; ix <= m_ixLastPriceRow; ix++ ) {
-      // TODO: this requires a lookup, maybe do an iteration instead
-      //   had an exception from here, segmentation fault on a WinRowElement
-      //   probably stomped on from elsewhere
-      m_PriceRows[ ix ].Refresh();
+
+  const int ixReCenter = m_ixReCenter.exchange( 0 );
+  if ( 0 != ixReCenter ) {
+    ReCenterVisible( ixReCenter );
+  }
+
+  if ( 0 < m_cntRows ) {
+    const size_t ixBack( 1 - m_ixFrameFront );
+    Ladder::Frame& frameBack( m_rFrame[ ixBack ] );
+    m_ladder.Snapshot( m_ixLastPriceRow, m_cntRows, frameBack );
+    if ( frameBack != m_rFrame[ m_ixFrameFront ] ) {
+      m_ixFrameFront = ixBack;
+      wxWindow::Refresh( false );
     }
   }
 }
 
-void PanelTrade::DrawWinRows() {
-
-  if ( 0 != m_cntWinRows_Data ) {
-    //m_pWinRow_Header.reset();
-    //m_vWinRow.clear();
-    //m_cntTotalWinRows = 0;
-    DeleteWinRows();
-  }
+void PanelTrade::SizeRows() {
 
   wxSize sizeClient = wxWindow::GetClientSize();
 
-  //std::scoped_lock<std::mutex> lock( m_mutexTimer );
   auto BorderWidthTimes2 = 2 * BorderWidth;
   auto Height = sizeClient.GetHeight();
 
+  unsigned int cntRows {};
+
   if ( Height > BorderWidthTimes2 ) {
+    const unsigned int cntRowsTotal = ( Height - BorderWidthTimes2 ) / RowHeight;
+    if ( 1 < cntRowsTotal ) { // space enough for at least header row, and one data row
+      cntRows = cntRowsTotal - 1; // first row is header row
+    }
+  }
 
-    //assert( 0 == m_nRowCount );
-    m_cntWinRows_Total = ( sizeClient.GetHeight() - 2 * BorderWidth ) / RowHeight;
+  const int ixMidPoint = ( m_ixFirstPriceRow + m_ixLastPriceRow ) / 2;
 
-    if ( 1 < m_cntWinRows_Total ) { // space enough for at least header row, and one data row
+  m_cntRows = cntRows;
+  m_nFramedRows = m_cntRows / FramedRows;
+  m_nCenteredRows = ( m_cntRows > m_nFramedRows + 2 ) ? ( ( m_cntRows - m_nFramedRows ) / 2 ) - 1 : 0; // eliminates up/down jitter
 
-      m_cntWinRows_Data = m_cntWinRows_Total - 1; // first row is header row
-      m_nFramedRows = m_cntWinRows_Data / FramedRows;
-      m_nCenteredRows = ( ( m_cntWinRows_Data - m_nFramedRows ) / 2 ) - 1; // eliminates up/down jitter
+  // frames are resized on the next timer, the ladder itself is unaffected
+  m_ixFirstPriceRow = m_ixLastPriceRow = 0;
+  m_ixLoRecenterFrame = m_ixHiRecenterFrame = 0;
+  m_ixHoverRow = -1;
 
-      int yOffset = BorderWidth; // start offset with border
+  if ( 0 != ixMidPoint ) {
+    ReCenterVisible( ixMidPoint );
+  }
+  else {
+    m_rFrame[ m_ixFrameFront ].clear();
+  }
 
-      // should this go into the vector?
-      m_pWinRow_Header.reset();
-      m_pWinRow_Header = WinRow::Construct( this, ou::tf::l2::rung::vElement, wxPoint( BorderWidth, yOffset ), RowHeight, true );
+  wxWindow::Refresh( false );
+}
 
-      yOffset += RowHeight;
+bool PanelTrade::FindCell( const wxPoint& point, int& ixRow, int& ixElement, wxRect& rect ) const {
 
-      int ixWinRow = 0;
-      m_vWinRow.resize( m_cntWinRows_Data );
+  if ( ( (int)BorderWidth > point.x ) || ( (int)BorderWidth > point.y ) ) return false;
 
-      while ( ixWinRow < m_cntWinRows_Data ) {
-        pWinRow_t pWinRow = WinRow::Construct( this, ou::tf::l2::rung::vElement, wxPoint( BorderWidth, yOffset ), RowHeight, false );
-        m_vWinRow[ ixWinRow ] = pWinRow;
-        yOffset += RowHeight;
-        ixWinRow++;
-      }
+  ixRow = ( point.y - BorderWidth ) / RowHeight - 1; // skip the header row
+  if ( ( 0 > ixRow ) || ( (int)m_cntRows <= ixRow ) ) return false;
 
+  int x( BorderWidth );
+  ixElement = 0;
+  for ( const Element& element: rung::vElement ) {
+    if ( point.x < x + element.width ) {
+      rect = wxRect( x, BorderWidth + ( ixRow + 1 ) * RowHeight, element.width, RowHeight );
+      return true;
     }
-    else {
-      m_cntWinRows_Total = 0;
-    }
+    x += element.width;
+    ixElement++;
   }
 
+  return false;
 }
 
-void PanelTrade::DeleteWinRows() {
-
-  for (
-    int ixWinRow = 0, ixPriceRow = m_ixFirstPriceRow;
-    ixWinRow < m_cntWinRows_Data;
-    ixWinRow++, ixPriceRow++
-  ) {
-    PriceRow& rowData( m_PriceRows[ ixPriceRow ] );
-    rowData.DelRowElements();
-    pWinRow_t pWinRow = std::move( m_vWinRow[ ixWinRow ] );
-    //pRow->DestroyWindow();
-    // delete pVRow; pWinRow auto deletes
+void PanelTrade::Click( wxMouseEvent& event, EButton button ) {
+  int ixRow;
+  int ixElement;
+  wxRect rect;
+  if ( FindCell( event.GetPosition(), ixRow, ixElement, rect ) ) {
+    const EField field = (EField)rung::vElement[ ixElement ].field;
+    switch ( field ) {
+      case EField::AskOrder:
+      case EField::BidOrder:
+        if ( m_fClick ) {
+          const double price = m_ladder.Cast( m_ixLastPriceRow - ixRow );
+          m_fClick( price, field, button, event.ShiftDown(), event.ControlDown(), event.AltDown() );
+        }
+        break;
+      default:
+        break;
+    }
   }
-  m_cntWinRows_Total = 1;  // 0 or 1? // header row remains in tact
-  m_cntWinRows_Data = 0;
+  event.Skip();
+}
 
-  m_ixFirstPriceRow = m_ixLastPriceRow = 0;
-  m_ixLoRecenterFrame = m_ixHiRecenterFrame = 0;
+void PanelTrade::OnMouseLeftUp( wxMouseEvent& event ) {
+  Click( event, EButton::Left );
+}
 
+void PanelTrade::OnMouseMiddleUp( wxMouseEvent& event ) {
+  Click( event, EButton::Middle );
 }
 
-void PanelTrade::OnResize( wxSizeEvent& event ) {  // TODO: need to fix this
-  CallAfter(
-    [this](){
-      DrawWinRows(); // probably shouldn't do this
-      //ReCenterVisible( m_DataRows.Cast( m_dblLastPrice ) );
-    });
+void PanelTrade::OnMouseRightUp( wxMouseEvent& event ) {
+  Click( event, EButton::Right );
+}
+
+void PanelTrade::OnMouseMotion( wxMouseEvent& event ) {
+  int ixRow( -1 );
+  int ixElement( -1 );
+  wxRect rect;
+  if ( !FindCell( event.GetPosition(), ixRow, ixElement, rect ) ) {
+    ixRow = ixElement = -1;
+  }
+  if ( ( ixRow != m_ixHoverRow ) || ( ixElement != m_ixHoverElement ) ) {
+    m_ixHoverRow = ixRow;
+    m_ixHoverElement = ixElement;
+    wxWindow::Refresh( false );
+  }
+  event.Skip();
+}
+
+void PanelTrade::OnMouseLeaveWindow( wxMouseEvent& event ) {
+  if ( 0 <= m_ixHoverRow ) {
+    m_ixHoverRow = m_ixHoverElement = -1;
+    wxWindow::Refresh( false );
+  }
+  event.Skip();
+}
+
+void PanelTrade::OnResize( wxSizeEvent& event ) {
+  SizeRows(); // no child windows to rebuild
   event.Skip(); // required when working with sizers
 }
 
 void PanelTrade::OnResizing( wxSizeEvent& event ) {
-  //DrawWinRows();
-  //m_pWinRow_Header.reset();
-  //m_vWinRow.clear();
-  //m_cntTotalRows = 0;
   event.Skip(); // required when working with sizers
 }
 
@@ -228,48 +336,37 @@ void PanelTrade::OnDestroy( wxWindowDestroyEvent& event ) {
 
   if ( event.GetId() == GetId() ) {
 
-    m_pWinRow_Header.reset();
-    m_vWinRow.clear();
+    m_timerRefresh.Stop();
 
-    //Unbind( wxEVT_PAINT, &PanelTrade::OnPaint, this, GetId() );
+    Unbind( wxEVT_PAINT, &PanelTrade::OnPaint, this, GetId() );
 
     Unbind( wxEVT_SIZE, &PanelTrade::OnResize, this, GetId() );
     Unbind( wxEVT_SIZING, &PanelTrade::OnResizing, this, GetId() );
     Unbind( wxEVT_DESTROY, &PanelTrade::OnDestroy, this, GetId() );
     Unbind( wxEVT_TIMER, &PanelTrade::HandleTimerRefresh, this, m_timerRefresh.GetId() );
 
+    Unbind( wxEVT_LEFT_UP, &PanelTrade::OnMouseLeftUp, this );
+    Unbind( wxEVT_MIDDLE_UP, &PanelTrade::OnMouseMiddleUp, this );
+    Unbind( wxEVT_RIGHT_UP, &PanelTrade::OnMouseRightUp, this );
+    Unbind( wxEVT_MOTION, &PanelTrade::OnMouseMotion, this );
+    Unbind( wxEVT_LEAVE_WINDOW, &PanelTrade::OnMouseLeaveWindow, this );
+
     event.Skip();
   }
 
 }
 
 void PanelTrade::SetInterval( double interval ) {
-  m_PriceRows.SetInterval( interval );
-  // TODO: if called more than once, need to rebuild PriceRows with new interval
+  m_ladder.SetInterval( interval );
+  // TODO: if called more than once, existing rungs are re-interpreted with the new interval
 }
 
 void PanelTrade::AppendStaticIndicator( double price, const std::string& sStatic ) {
-  PriceRow& row( m_PriceRows[ price ] );
-  row.AppendIndicatorStatic( sStatic );
+  m_ladder.AppendIndicatorStatic( m_ladder.Cast( price ), sStatic );
 }
 
 void PanelTrade::UpdateDynamicIndicator( const std::string& sIndicator, double value ) {
-  int ix = m_PriceRows.Cast( value );
-  mapDynamicIndicator_t::iterator iter = m_mapDynamicIndicator.find( sIndicator );
-  if ( m_mapDynamicIndicator.end() == iter ) {
-    PriceRow& row( m_PriceRows[ ix ] );
-    row.AddIndicatorDynamic( sIndicator );
-    m_mapDynamicIndicator.emplace( sIndicator, ix );
-  }
-  else {
-    if ( ix != iter->second ) {
-      PriceRow& rowOld( m_PriceRows[ iter->second ] );
-      rowOld.DelIndicatorDynamic( sIndicator );
-      PriceRow& rowNew( m_PriceRows[ ix ] );
-      rowNew.AddIndicatorDynamic( sIndicator );
-      iter->second = ix;
-    }
-  }
+  m_ladder.UpdateIndicatorDynamic( sIndicator, m_ladder.Cast( value ) );
 }
 
 // l1 update
@@ -277,43 +374,20 @@ void PanelTrade::OnQuote( const ou::tf::Quote& quote ) {
   // will need to use quote for tick analysis.
   // don't update the ladder, as it interferes with L2
 
-  int ixAskPrice = m_PriceRows.Cast( quote.Ask() );
-  int ixBidPrice = m_PriceRows.Cast( quote.Bid() );
-
-  if ( 0.0 != m_dblLastAsk ) { // TODO: could keep the index instead, as it is consistent
-    PriceRow& row( m_PriceRows[ m_dblLastAsk ] );
-    row.SetAskVolume( false );
-  }
-
-  if ( 0.0 != m_dblLastBid ) { // TODO: could keep the index instead, as it is consistent
-    PriceRow& row( m_PriceRows[ m_dblLastBid ] );
-    row.SetBidVolume( false );
-  }
+  int ixAskPrice = m_ladder.Cast( quote.Ask() );
+  int ixBidPrice = m_ladder.Cast( quote.Bid() );
 
   m_dblLastAsk = quote.Ask();
   m_dblLastBid = quote.Bid();
 
-  if ( 0.0 != m_dblLastAsk ) {
-    PriceRow& row( m_PriceRows[ m_dblLastAsk ] );
-    row.SetAskVolume( true );
-  }
-
-  if ( 0.0 != m_dblLastBid ) {
-    PriceRow& row( m_PriceRows[ m_dblLastBid ] );
-    row.SetBidVolume( true );
-  }
+  m_ladder.SetQuote( ixBidPrice, ixAskPrice ); // highlights the inside sizes
 
   int ixHiPrice = std::max( ixAskPrice, ixBidPrice );
-  int ixLoPrice = std::max( ixAskPrice, ixBidPrice );
+  int ixLoPrice = std::min( ixAskPrice, ixBidPrice );
   int ixDiffPrice = ixHiPrice - ixLoPrice + 1;
 
   if ( m_bReCenter || ( ixDiffPrice > m_nCenteredRows ) ) {
-    // maybe do this on the timer interval instead?
-    int ixMidPoint = ( ixHiPrice + ixLoPrice ) / 2;
-    CallAfter(
-      [this, ixMidPoint](){
-        ReCenterVisible( ixMidPoint );
-      });
+    m_ixReCenter.store( ( ixHiPrice + ixLoPrice ) / 2 ); // applied on the timer
   }
   else {
     // not sure where to recenter
@@ -322,66 +396,40 @@ void PanelTrade::OnQuote( const ou::tf::Quote& quote ) {
 
 // l2 update
 void PanelTrade::OnQuoteAsk( double price, unsigned int volume ) {
-  int ixPrice = m_PriceRows.Cast( price );
-  PriceRow& row( m_PriceRows[ ixPrice ] );
-  row.SetAskVolume( volume );
+  m_ladder.SetAskSize( m_ladder.Cast( price ), volume );
 }
 
 // l2 update
 void PanelTrade::OnQuoteBid( double price, unsigned int volume ) {
-  int ixPrice = m_PriceRows.Cast( price );
-  PriceRow& row( m_PriceRows[ ixPrice ] );
-  row.SetBidVolume( volume );
+  m_ladder.SetBidSize( m_ladder.Cast( price ), volume );
 }
 
 // l1 update
 void PanelTrade::OnTrade( const ou::tf::Trade& trade ) {
 
-  if ( 0.0 != m_dblLastPrice ) {
-    PriceRow& row( m_PriceRows[ m_dblLastPrice ] );
-    row.SetPrice( m_dblLastPrice, false ); // TODO: needs to reset back to the price, remove highlight
-  }
-
   m_dblLastPrice = trade.Price();
-  int ixPrice = m_PriceRows.Cast( m_dblLastPrice );
-  PriceRow& rowData( m_PriceRows[ ixPrice ] );
-
-  rowData.SetPrice( trade.Volume(), true ); // need to highlight the price level
-
-  rowData.IncTicks();
-  rowData.AddVolume( trade.Volume() );
+  int ixPrice = m_ladder.Cast( m_dblLastPrice );
 
+  int direction {};
   const double mid = ( m_dblLastAsk + m_dblLastBid ) / 2.0;
   if ( mid == m_dblLastPrice ) {
   }
   else {
-    if ( mid < m_dblLastPrice ) {
-      rowData.IncBuyCount();
-      rowData.AddToBuyVolume( trade.Volume() );
-    }
-    else {
-      rowData.IncSellCount();
-      rowData.AddToSellVolume( trade.Volume() );
-    }
+    direction = ( mid < m_dblLastPrice ) ? 1 : -1;
   }
 
-  // maybe do this on the timer interval instead?
-  CallAfter(
-    [this, ixPrice](){
-      ReCenterVisible( ixPrice );
-    });
+  m_ladder.Trade( ixPrice, trade.Volume(), direction ); // highlights the price level
+
+  m_ixReCenter.store( ixPrice ); // applied on the timer
   // TODO: add TickBuyVolume, TickSellVolume
 
 }
 
 void PanelTrade::ReCenterVisible( int ixPrice ) {
-  // does this need a lock from background thread? - no longer, is run in foreground
+  // runs in foreground, on the timer or after a resize
 
   // only does something if ixPrice moves outside of window
 
-  // TODO: check flags so changes aren't made while one thread or the other are updating
-  //   maybe count how many missed opportunties presetn themeselves
-
   if ( 0 == ixPrice ) {
     std::cout << "PanelTrade::ReCenterVisible has 0 ixPrice" << std::endl;
   }
@@ -393,33 +441,11 @@ void PanelTrade::ReCenterVisible( int ixPrice ) {
       || ( m_ixLoRecenterFrame == m_ixHiRecenterFrame )
     ) {
       m_bReCenter = false;
-      //std::scoped_lock<std::mutex> lock( m_mutexTimer );
-      // recalibrate mappings
-      if ( m_ixFirstPriceRow != m_ixLastPriceRow ) {
-        // TODO: should this be performed by DeleteWinRows?
-        for ( int iy = m_ixFirstPriceRow; iy <= m_ixLastPriceRow; iy++ ) {
-          // remove existing string update events
-          PriceRow& rowPrice( m_PriceRows[ iy ] );
-          rowPrice.DelRowElements();
-        }
-      }
-      m_ixFirstPriceRow = ixPrice - ( m_cntWinRows_Data / 2 );
-      m_ixLastPriceRow = m_ixFirstPriceRow + m_cntWinRows_Data - 1;
+      // recalibrate mappings, the next snapshot fills the frame, nothing is reallocated
+      m_ixFirstPriceRow = ixPrice - ( m_cntRows / 2 );
+      m_ixLastPriceRow = m_ixFirstPriceRow + m_cntRows - 1;
       m_ixHiRecenterFrame = m_ixLastPriceRow - m_nFramedRows;
       m_ixLoRecenterFrame = m_ixFirstPriceRow + m_nFramedRows;
-      // need to check that same numbers for each
-      for (
-          int ix = 0, iy = m_ixLastPriceRow;
-          ix < m_cntWinRows_Data;
-          ix++, iy--
-        ) {
-          pWinRow_t pWinRow = m_vWinRow[ ix ];
-          PriceRow& rowPrice( m_PriceRows[ iy ] );
-          rowPrice.SetRowElements( *pWinRow );
-          rowPrice.SetPrice( m_PriceRows.Cast( iy ), false );
-          fClick_t fClick( m_fClick ); // make a copy for each row
-          rowPrice.Set( std::move( fClick ) );  // set each row's copy
-        }
     }
   }
 }
@@ -430,34 +456,15 @@ void PanelTrade::Set( fClick_t&& fClick ) {
 }
 
 void PanelTrade::SetAskQuantity( double price, int n, EColour bg ) {
-  PriceRow& rowPrice( m_PriceRows[ price ] );
-  rowPrice.SetAskOrderSize( n, bg );
+  m_ladder.SetAskOrder( m_ladder.Cast( price ), n, bg );
 }
 
 void PanelTrade::SetBidQuantity( double price, int n, EColour bg ) {
-  PriceRow& rowPrice( m_PriceRows[ price ] );
-  rowPrice.SetBidOrderSize( n, bg );
+  m_ladder.SetBidOrder( m_ladder.Cast( price ), n, bg );
 }
 
 void PanelTrade::UpdateProfitLoss( const int quantity, const double average ) {
-  if ( 0 == quantity ) {
-    m_PriceRows.ForEach(
-      [](int ix, PriceRow& row){
-        row.SetProfitLoss( 0.0 );
-      } );
-  }
-  else {
-    const int ixZero = m_PriceRows.Cast( average ); // find the row
-    const double priceZero = m_PriceRows.Cast( ixZero ); // normalize the value
-
-    m_PriceRows.ForEach(
-      [this,quantity,priceZero](int ixRow, PriceRow& row){
-        const double rowPrice = m_PriceRows.Cast( ixRow );
-        const double pl = quantity * ( rowPrice - priceZero ); // multiply by multiple?
-        //std::cout << "ForEach: " << ixRow << "," << rowPrice << "," << priceZero << "," << pl << "," << std::endl;
-        row.SetProfitLoss( pl );
-      } );
-  }
+  m_ladder.SetProfitLoss( quantity, average ); // evaluated per visible row on the timer
 }
 
 } // market depth
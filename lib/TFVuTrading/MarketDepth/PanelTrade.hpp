@@ -21,14 +21,17 @@
 
 #pragma once
 
-#include <mutex>
-#include <vector>
+#include <atomic>
+#include <functional>
 
 #include <wx/timer.h>
 #include <wx/window.h>
 
-#include "WinRow.hpp"
-#include "PriceRows.hpp"
+#include <OUCommon/Colour.h>
+
+#include <TFVuTrading/Mouse.hpp>
+
+#include "Ladder.hpp"
 
 namespace ou { // One Unified
 namespace tf { // TradeFrame
@@ -83,11 +86,13 @@ public:
   void SetOnTimer( fTimer_t&& fTimer ) { m_fTimer = std::move( fTimer); }
 
   // Interface - In - Events - Execution
-  using fClick_t = ou::tf::l2::PriceRow::fClick_t;
+  using EButton = ou::tf::Mouse::EButton;
+  using EField = rung::EField;
+  using fClick_t = std::function<void(double price,EField,EButton,bool shift,bool control,bool alt)>;
   void Set( fClick_t&& );
 
   // Interface - In - Updates - Pending Orders
-  using EColour = WinRowElement::EColour;
+  using EColour = ou::Colour::wx::EColour;
   void SetAskQuantity( double, int, EColour ); // update l2 quantity@price
   void SetBidQuantity( double, int, EColour ); // update l2 quantity@price
 
@@ -102,13 +107,10 @@ private:
 
   fTimer_t m_fTimer;
 
-  using pWinRow_t = WinRow::pWinRow_t;
-
   unsigned int m_nFramedRows;
   unsigned int m_nCenteredRows;
 
-  unsigned int m_cntWinRows_Total; // includes header row: TODO: verify all usage locations are correct
-  unsigned int m_cntWinRows_Data; // without header row
+  unsigned int m_cntRows; // without header row
 
   int m_ixFirstPriceRow;
   int m_ixLastPriceRow;
@@ -120,31 +122,37 @@ private:
   double m_dblLastBid;
   double m_dblLastPrice;
 
-  pWinRow_t m_pWinRow_Header;
+  Ladder m_ladder; // written by the feed threads
 
-  using vWinRow_t = std::vector<pWinRow_t>;
-  vWinRow_t m_vWinRow; // non header rows only
+  // double buffered: the timer fills the back frame from m_ladder, and swaps when it differs from the front
+  Ladder::Frame m_rFrame[ 2 ];
+  size_t m_ixFrameFront;
 
-  PriceRows m_PriceRows;
+  std::atomic<bool> m_bReCenter;
+  std::atomic<int> m_ixReCenter; // requested by the feed threads, applied by the timer, 0 for none
 
-  bool m_bReCenter;
-
-  std::mutex m_mutexTimer;
-  wxTimer m_timerRefresh; // TODO: need to sync foreground & background
+  wxTimer m_timerRefresh;
 
   fClick_t m_fClick;
 
-  using mapDynamicIndicator_t = std::map<std::string,int>;
-  mapDynamicIndicator_t m_mapDynamicIndicator;
+  int m_ixHoverRow; // -1 for none
+  int m_ixHoverElement;
 
   void ReCenterVisible( int ix );
 
-  void DrawWinRows();
-  void DeleteWinRows();
+  void SizeRows();
+  bool FindCell( const wxPoint&, int& ixRow, int& ixElement, wxRect& ) const;
 
   void OnPaint( wxPaintEvent& );
   void HandleTimerRefresh( wxTimerEvent& );
 
+  void OnMouseLeftUp( wxMouseEvent& );
+  void OnMouseMiddleUp( wxMouseEvent& );
+  void OnMouseRightUp( wxMouseEvent& );
+  void OnMouseMotion( wxMouseEvent& );
+  void OnMouseLeaveWindow( wxMouseEvent& );
+  void Click( wxMouseEvent&, EButton );
+
   void OnResize( wxSizeEvent& );
   void OnResizing( wxSizeEvent& );
   void OnDestroy( wxWindowDestroyEvent& );